@@ -26,6 +26,8 @@
 #include "NDW_Utils.h"
 #include "RegistryData.h"
 #include "MsgHeaders.h"
+#include "NDW_Metrics.h"
+#include "NDW_RegistryReload.h"
 
 /**
  * @file AbstractMessaging.h
@@ -62,13 +64,28 @@ extern "C"
  * 3) NDW_APP_ID - An integer Unique Application Identifier.
  * 4) NDW_VERBOSE - 0 means terseness of output, greater than zero would lead to higher levels of verbosity.
  * 5) NDW_CAPTURE_LATENCY - 0 means off, 1 means on and capture latency information.
+ * 6) NDW_CLOCK_TSC - 0 disables the TSC based clock, so timestamps always come from clock_gettime.
+ * 7) NDW_METRICS_PORT - Serve statistics over HTTP on 127.0.0.1:port (/metrics Prometheus text, /metrics.json).
+ * 8) NDW_METRICS_FILE - Periodically rewrite statistics to this file (JSON if it ends with .json, else Prometheus text).
+ * 9) NDW_METRICS_INTERVAL_MS - Interval for NDW_METRICS_FILE, defaults to 10000.
+ * 10) NDW_LOG_ASYNC - 0 (default) synchronous logging, 1 asynchronous dropping lines when full, 2 asynchronous waiting.
+ * 11) NDW_LOG_ASYNC_BUFFER_KB - Per thread log buffer size for NDW_LOG_ASYNC, defaults to 1024.
+ * 12) NDW_APP_CONFIG_IMAGE - Optional registry image compiled from NDW_APP_CONFIG_FILE (see NDW_RegistryImage.h).
+ *     Used instead of parsing the JSON file, unless it is invalid or older than the JSON file.
+ * 13) NDW_APP_CONFIG_WATCH_MS - Check NDW_APP_CONFIG_FILE for changes at this interval and reload the registry
+ *     when it changed (see NDW_RegistryReload.h). 0 (default) never reloads.
  */
 #define NDW_APP_CONFIG_FILE "NDW_APP_CONFIG_FILE"
+#define NDW_APP_CONFIG_IMAGE "NDW_APP_CONFIG_IMAGE"
+#define NDW_APP_CONFIG_WATCH_MS "NDW_APP_CONFIG_WATCH_MS"
 #define NDW_APP_DOMAINS "NDW_APP_DOMAINS"
 #define NDW_APP_ID "NDW_APP_ID"
 #define NDW_VERBOSE "NDW_VERBOSE"
 #define NDW_DEBUG_MSG_HEADERS "NDW_DEBUG_MSG_HEADERS"
 #define NDW_CAPTURE_LATENCY "NDW_CAPTURE_LATENCY"
+#define NDW_METRICS_PORT "NDW_METRICS_PORT"
+#define NDW_METRICS_FILE "NDW_METRICS_FILE"
+#define NDW_METRICS_INTERVAL_MS "NDW_METRICS_INTERVAL_MS"
 
 
 /**
@@ -172,6 +189,14 @@ typedef INT_T (*ndw_AsyncCallbackPtr_T)(ndw_Topic_T* topic, void* opaque);
  */
 #define NDW_BAD_MESSAGE_FUNCTION_NAME "ndw_HandleBadMessage"
 
+/**
+ * @def NDW_PUBLISH_WOULD_BLOCK
+ * @brief Returned by publish functions when the connection is above its pending bytes high watermark
+ * and the message was NOT sent. Only for connections that opt in to it (for NATS, PublicationWouldBlock=1).
+ * Application can retry later, drop or slow down.
+ */
+#define NDW_PUBLISH_WOULD_BLOCK (-64)
+
 /**
  * @typedef void (*ndw_BadMessageCallbackPtr_T)(ndw_Topic_T*, void* opaque);
  * @brief This is the callback signature used to invoke the application layer
@@ -264,7 +289,8 @@ INT_T ndw_GetAppId();
  * @var extern INT_T ndw_capture_latency
  * @brief Global variable. If set to > 0 then will start capturing latency metrics.
  *
- * @note XXX: To be implemented.
+ * @note Per Topic publish to receive latency (from the header timestamp) and asynchronous queue dwell time
+ *  are captured on receipt into ndw_Histogram_T and reported by ndw_PrintStatsForTopic. Publisher and subscriber clocks must be in sync.
  */
 extern INT_T ndw_capture_latency;
 
@@ -404,9 +430,36 @@ ndw_OutMsgCxt_T* ndw_CreateOutMsgCxt(ndw_Topic_T* topic,
                     INT_T header_id, INT_T msg_encoding_format, UCHAR_T* msg, INT_T msg_size);
 
 /**
- * @brief Publish a message. The header and message body should be in ndw_OutMsgCxt_T data structure.
+ * @brief Reserve a writable message body in the per thread send buffer, so the application can serialize
+ * straight into it and avoid copying the payload (zero copy publish).
+ *
+ * @param[in] topic Topic on which the message will be published.
+ * @param[in] header_id Message header type identifier.
+ * @param[in] msg_encoding_format Message body encoding format.
+ * @param[in] max_msg_size Maximum number of body bytes the application may write.
+ *
+ * @return Pointer to max_msg_size writable bytes, else NULL on errors.
+ *
+ * @note The buffer is per thread and only valid until ndw_PublishReservedMsg or the next ndw_CreateOutMsgCxt.
+ * Its contents are NOT zeroed.
+ * @see ndw_PublishReservedMsg
+ */
+extern UCHAR_T* ndw_ReserveOutMsg(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format, INT_T max_msg_size);
+
+/**
+ * @brief Publish the message body written in place after ndw_ReserveOutMsg.
+ *
+ * @param[in] msg_size Actual number of body bytes written. Must be > 0 and NOT more than the reserved size.
  *
  * @return 0 if successful, else < 0.
+ */
+extern INT_T ndw_PublishReservedMsg(INT_T msg_size);
+
+/**
+ * @brief Publish a message. The header and message body should be in ndw_OutMsgCxt_T data structure.
+ *
+ * @return 0 if successful, NDW_PUBLISH_WOULD_BLOCK if the connection is above its pending bytes high watermark,
+ *  else < 0.
  *
  * @note The reason there is no parameter to this function is because the message body and content
  * should be in ndw_OutMsgCxt_T, and this data structure is per thread.
@@ -414,6 +467,76 @@ ndw_OutMsgCxt_T* ndw_CreateOutMsgCxt(ndw_Topic_T* topic,
  */
 extern INT_T ndw_PublishMsg();
 
+/**
+ * @brief Publish many messages, on any number of Topics, with a single flush per physical connection.
+ * Every header is stamped directly in the per thread batch buffer, with the body copied once behind it,
+ * and the frames are handed to each vendor as one batch. A failed item is not retried; check its ret_code.
+ * Items never back off: a JetStream item gets NDW_PUBLISH_WOULD_BLOCK while its asynchronous ack window is full,
+ * and a synchronous JetStream item waits at most flush_timeout_ms (if > 0) for its ack.
+ *
+ * @param[in,out] items Messages to publish. On return ret_code of each item is 0 if published, else < 0
+ *  (NDW_PUBLISH_WOULD_BLOCK if its connection was above the pending bytes high watermark).
+ * @param[in] count Number of items.
+ * @param[in] flush_timeout_ms If > 0 each connection used is flushed once, waiting up to this long.
+ *  If <= 0 the vendor library sends the buffered data in its own time.
+ *
+ * @return 0 if all messages were published (and flushed), number of failures if some failed, < 0 on bad parameters.
+ *
+ * @note Uses the per thread ndw_OutMsgCxt_T, so do not invoke it between ndw_CreateOutMsgCxt and ndw_PublishMsg.
+ * @see ndw_PublishBatchItem_T
+ */
+extern INT_T ndw_PublishBatch(ndw_PublishBatchItem_T* items, INT_T count, LONG_T flush_timeout_ms);
+
+/**
+ * @struct ndw_PreparedPublisher_T
+ * @brief Topic, Connection, vendor and header type resolved and validated once by ndw_PreparePublisher,
+ *  so ndw_PreparedPublish can skip the per message validation done by ndw_CreateOutMsgCxt and ndw_PublishMsg.
+ *
+ * @note The application owns the structure. It can be shared by threads as it is only read after preparation.
+ */
+typedef struct ndw_PreparedPublisher
+{
+    ndw_Topic_T* topic;                     // Topic to publish on.
+    ndw_Connection_T* connection;           // Topic Connection.
+    ndw_Domain_T* domain;                   // Topic Domain.
+    INT_T vendor_id;                        // Vendor implementation of the Connection.
+    INT_T (*vendor_publish)();              // Vendor PublishMsg implementation.
+    INT_T header_id;                        // Header type identifer.
+    INT_T header_size;                      // (Maximum) LE header size for header_id.
+    INT_T encoding_format;                  // Message body encoding format type.
+    bool prepared;                          // Set once all the checks have passed.
+} ndw_PreparedPublisher_T;
+
+/**
+ * @brief Validate Topic, Connection, vendor and header type once, and fill in a prepared publisher.
+ *
+ * @param[out] pp Prepared publisher to fill in.
+ * @param[in] topic Topic to publish on. Must be enabled for publishing.
+ * @param[in] header_id Header type identifer.
+ * @param[in] msg_encoding_format Message body encoding format type.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_PreparePublisher(ndw_PreparedPublisher_T* pp, ndw_Topic_T* topic, INT_T header_id,
+                                    INT_T msg_encoding_format);
+
+/**
+ * @brief Publish a message body using a prepared publisher.
+ *  Release builds only check the prepared publisher and the message size: the per message validation done by
+ *  ndw_CreateOutMsgCxt is skipped, and a failure of ndw_GetMsgHeaderAndBody is fatal (the process exits).
+ *  Builds with DEBUG defined go through ndw_CreateOutMsgCxt and ndw_PublishMsg so every check is still made.
+ *
+ * @param[in] pp Prepared publisher filled in by ndw_PreparePublisher.
+ * @param[in] msg Message body; can be NULL when msg_size is 0.
+ * @param[in] msg_size Message body size.
+ *
+ * @return 0 if successful, NDW_PUBLISH_WOULD_BLOCK if the connection is above its pending bytes high watermark,
+ *  -1 if pp is NULL or was not prepared, else < 0.
+ *
+ * @note Uses the per thread ndw_OutMsgCxt_T, so do not invoke it between ndw_CreateOutMsgCxt and ndw_PublishMsg.
+ */
+extern INT_T ndw_PreparedPublish(ndw_PreparedPublisher_T* pp, UCHAR_T* msg, INT_T msg_size);
+
 /**
  * @brief Subscribe for Asynchronous message notification on a Topic.
  *
@@ -591,9 +714,94 @@ extern void ndw_PrintStatsForTopic(ndw_Topic_T* topic);
  */
 extern INT_T ndw_HandleVendorAsyncMessage(ndw_Topic_T* topic, UCHAR_T* msg, INT_T msg_size, void *vendor_closure);
 
+/**
+ * @struct ndw_PublishAck_T
+ * @brief Completion of an asynchronous durable publish, reported once the broker acknowledged (or rejected) it.
+ */
+typedef struct ndw_PublishAck
+{
+    ndw_Topic_T* topic;             // Topic the message was published on.
+    ULONG_T stream_sequence;        // Sequence assigned by the durable store, 0 on failure.
+    bool duplicate;                 // Broker detected a duplicate message.
+    INT_T error_code;               // 0 if acknowledged, else vendor error code.
+    const CHAR_T* error_text;       // Vendor error text on failure, else NULL.
+} ndw_PublishAck_T;
+
+/**
+ * @brief Application callback for asynchronous durable publish completions.
+ *
+ * @note Invoked on a vendor thread. The ack structure is only valid for the duration of the call.
+ */
+typedef void (*ndw_PublishAckHandler_T)(ndw_PublishAck_T* ack, void* closure);
+
+/**
+ * @brief Register a callback for asynchronous durable publish completions on a Topic.
+ *
+ * @param[in] topic Topic structure.
+ * @param[in] handler Callback, or NULL to only count acks and failures.
+ * @param[in] closure Application data passed back to the callback.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_SetPublishAckHandler(ndw_Topic_T* topic, ndw_PublishAckHandler_T handler, void* closure);
+
+/**
+ * @brief Vendor implementations invoke this function when an asynchronous durable publish completes.
+ *
+ * @param[in] ack Completion details; ack->topic must be set.
+ *
+ * @return None.
+ */
+extern void ndw_HandleVendorPublishAck(ndw_PublishAck_T* ack);
+
 extern INT_T ndw_PollAsyncQueue(ndw_Topic_T* topic, LONG_T timeout_us);
 extern INT_T ndw_CommitAsyncQueuedMessge(ndw_Topic_T* topic);
 
+/**
+ * @struct ndw_AsyncMsgView_T
+ * @brief A parsed message drained from a Topic asynchronous queue by ndw_PollAsyncQueueBatch.
+ *
+ * @note The header either points in place into the queued message (Little Endian hosts, aligned data)
+ * or is decoded into header_buffer owned by the view, so views remain valid
+ * independently of each other until ndw_CommitAsyncQueuedBatch is invoked.
+ */
+typedef struct ndw_AsyncMsgView
+{
+    UCHAR_T* header;            // Decoded message header. Points into the message or into header_buffer.
+    INT_T header_size;          // Header size.
+    UCHAR_T* msg;               // Message body, does NOT include the header.
+    INT_T msg_size;             // Message body size.
+    LONG_T received_time;       // Time message was drained from the queue in UTC nanoseconds.
+    LONG_T sequence_number;     // Queue insertion sequence number.
+    void* q_item;               // Opaque. Do NOT modify.
+    ULONG_T header_buffer[(NDW_MAX_HEADER_SIZE + sizeof(ULONG_T)) / sizeof(ULONG_T)]; // 8 byte aligned.
+} ndw_AsyncMsgView_T;
+
+/**
+ * @brief Drain up to max_msgs messages from a Topic asynchronous queue.
+ *
+ * @param[in] topic Topic configured with an asynchronous queue.
+ * @param[out] views Caller provided array of at least max_msgs entries.
+ * @param[in] max_msgs Maximum number of messages to drain.
+ * @param[in] timeout_us Time to wait once if the queue is empty.
+ *
+ * @return Number of messages drained (0 if none), else < 0 on errors.
+ *
+ * @note Every non empty batch MUST be committed with ndw_CommitAsyncQueuedBatch before polling for the next one.
+ */
+extern INT_T ndw_PollAsyncQueueBatch(ndw_Topic_T* topic, ndw_AsyncMsgView_T* views, INT_T max_msgs, LONG_T timeout_us);
+
+/**
+ * @brief Commit all messages of a batch returned by ndw_PollAsyncQueueBatch in one pass and release them.
+ *
+ * @param[in] topic Topic the batch was drained from.
+ * @param[in] views Array of views as filled in by ndw_PollAsyncQueueBatch.
+ * @param[in] count Number of views, that is the return value of ndw_PollAsyncQueueBatch.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_CommitAsyncQueuedBatch(ndw_Topic_T* topic, ndw_AsyncMsgView_T* views, INT_T count);
+
 /**
  * @def NDW_LOGTOPICMSG
  * @brief This function log a diagnostic message for a Topic to output stream.
@@ -1,4 +1,3 @@
-
 #ifndef _NWD_MPSCQ_H
 #define _NWD_MPSCQ_H
 
@@ -12,48 +11,139 @@
 #include "NDW_Utils.h"
 #include "RegistryData.h"
 #include "AbstractMessaging.h"
-
+#include "QueueWait.h"
+
+/**
+ * @file MPSCQ.h
+ *
+ * @brief Bounded lock-free Multiple Producer Single Consumer (MPSC) queue.
+ *
+ * The queue is a preallocated ring of slots whose size is a power of two.
+ * Each slot carries a sequence number telling whether it is free for the producer lap
+ * or filled for the consumer lap. Producers claim a free slot with a compare-and-swap on the tail counter,
+ * so no locks and no per item allocation happen on the hot path, and a full queue is reported at once.
+ * The head (consumer) and tail (producer) counters live on separate cache lines to avoid false sharing.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif /* __cplusplus */
 
-typedef struct ndw_MPSCQNode
+/**
+ * @def NDW_MPSCQ_CACHE_LINE_SIZE
+ * @brief Cache line size used to pad the producer and consumer counters.
+ */
+#define NDW_MPSCQ_CACHE_LINE_SIZE 64
+
+/**
+ * @def NDW_MPSCQ_DEFAULT_ITEMS
+ * @brief Capacity used when ndw_CreateMPSCQueue is invoked with max_items <= 0.
+ */
+#define NDW_MPSCQ_DEFAULT_ITEMS 1024
+
+/**
+ * @def NDW_MPSCQ_OK
+ * @brief Item was inserted into the queue.
+ */
+#define NDW_MPSCQ_OK 0
+
+/**
+ * @def NDW_MPSCQ_FULL
+ * @brief Queue is at capacity. Caller should back off (or drop) and retry.
+ */
+#define NDW_MPSCQ_FULL (-1)
+
+/**
+ * @def NDW_MPSCQ_INVALID
+ * @brief Invalid parameters (NULL queue or NULL data).
+ */
+#define NDW_MPSCQ_INVALID (-2)
+
+/**
+ * @struct ndw_MPSCQSlot_T
+ * @brief One slot of the ring buffer.
+ *
+ * @note sequence == position means the slot is free for the producer which claimed that position.
+ * sequence == position + 1 means the slot holds data for the consumer at that position.
+ */
+typedef struct ndw_MPSCQSlot
 {
+    atomic_ulong sequence;          // Lap aware state of the slot.
     void* data;                     // Pointer to the payload
-    struct ndw_MPSCQNode* next;     // Pointer to the next node
-    LONG_T sequence;                // Unique sequence number for testing/debugging
-} ndw_MPSCQNode_T;
+} ndw_MPSCQSlot_T;
 
+/**
+ * @struct ndw_MPSCQ_T
+ * @brief Bounded ring buffer MPSC queue.
+ */
 typedef struct ndw_MPSCQ
 {
-    LONG_T max_queue_items;
-    ndw_MPSCQNode_T* consumer_last_accessed_node; // Used to release previously returned node
+    // Read mostly (set at creation).
+    LONG_T max_queue_items;                     // Requested capacity.
+    ULONG_T capacity;                           // Actual capacity, power of two >= max_queue_items.
+    ULONG_T mask;                               // capacity - 1
+    ndw_MPSCQSlot_T* slots;                     // Preallocated ring of capacity slots.
 
-    ndw_MPSCQNode_T* consumer_cached_head;    // Local cached head pointer for consumer
-    ndw_MPSCQNode_T* consumer_cached_limit;   // Local cached limit pointer for consumer
+    // Written by producers.
+    _Alignas(NDW_MPSCQ_CACHE_LINE_SIZE) atomic_ulong producer_tail; // Next position to be claimed by a producer.
+    atomic_long producer_full_count;            // Number of inserts rejected as queue was full.
 
-    ndw_MPSCQNode_T* _Atomic consumer_limit;                 // Stores pointer cast to (intptr_t)
-                                                // Shared atomic limit pointer updated by producers
+    // Written by the (single) consumer.
+    _Alignas(NDW_MPSCQ_CACHE_LINE_SIZE) atomic_ulong consumer_head; // Next position to be consumed.
+    LONG_T consumer_pull_count;                 // Number of items pulled by the consumer
 
-    atomic_long consumer_pull_count;           // Number of items pulled by the consumer
-    atomic_long producer_push_count;           // Number of items pushed by all producers
+    ndw_QWait_T wait;                           // Adaptive consumer wait (spin, yield, futex).
 
-    pthread_mutex_t producer_lock;             // Mutex to synchronize multiple producers
-
-    ndw_MPSCQNode_T* producer_queue_tail;      // Tail pointer used by producers to append
+    CHAR_T padding[NDW_MPSCQ_CACHE_LINE_SIZE];  // Keep neighbouring allocations off the consumer line.
 } ndw_MPSCQ_T;
 
-
+/**
+ * @brief Create a bounded MPSC queue.
+ *
+ * @param[in] max_items Capacity. Rounded up to the next power of two, at least 2. If <= 0 NDW_MPSCQ_DEFAULT_ITEMS is used.
+ *
+ * @return Pointer to the queue, or NULL on memory allocation failure.
+ */
 extern ndw_MPSCQ_T* ndw_CreateMPSCQueue(LONG_T max_items);
 
-INT_T ndw_mpscq_insert(ndw_MPSCQ_T* queue, void* data);
-
-void* ndw_mpscq_get(ndw_MPSCQ_T* queue, LONG_T timeout_in_milliseconds);
-
-extern void ndw_mpscq_release(ndw_MPSCQNode_T* node);
-
+/**
+ * @brief Insert an item. Safe to be invoked concurrently by many producer threads.
+ *
+ * @param[in] queue Queue created by ndw_CreateMPSCQueue.
+ * @param[in] data Non NULL pointer to the payload.
+ *
+ * @return NDW_MPSCQ_OK on success, NDW_MPSCQ_FULL if the queue is at capacity, NDW_MPSCQ_INVALID on bad parameters.
+ */
+extern INT_T ndw_mpscq_insert(ndw_MPSCQ_T* queue, void* data);
+
+/**
+ * @brief Remove the oldest item. Must only be invoked by the single consumer thread.
+ *
+ * @param[in] queue Queue created by ndw_CreateMPSCQueue.
+ * @param[in] timeout_in_milliseconds If the queue is empty, wait up to this long for an item to arrive.
+ *
+ * @return Pointer to the payload, or NULL if the queue is empty.
+ */
+extern void* ndw_mpscq_get(ndw_MPSCQ_T* queue, LONG_T timeout_in_milliseconds);
+
+/**
+ * @brief Configure how the consumer waits on an empty queue. Negative counts keep current values.
+ */
+extern void ndw_mpscq_set_wait_strategy(ndw_MPSCQ_T* queue, INT_T spins, INT_T yields, bool block);
+
+/**
+ * @brief Approximate number of items in the queue.
+ */
+extern LONG_T ndw_mpscq_size(ndw_MPSCQ_T* queue);
+
+/**
+ * @brief Release the ring. Queue must be quiescent (no producers or consumer active).
+ * Payloads still in the queue are NOT freed, and the ndw_MPSCQ_T itself must be freed by the caller.
+ */
 extern void ndw_mpscq_cleanup(ndw_MPSCQ_T* queue);
 
 #ifdef __cplusplus
@@ -62,4 +152,3 @@ extern void ndw_mpscq_cleanup(ndw_MPSCQ_T* queue);
 
 #endif /*  _NWD_MPSCQ_H */
 
-
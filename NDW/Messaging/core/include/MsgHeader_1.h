@@ -147,6 +147,27 @@ extern INT_T ndw_MsgHeader1_LE_MsgHeaderSize(INT_T header_id);
  */
 extern INT_T ndw_MsgHeader1_SetOutMsgFields(ndw_OutMsgCxt_T* cxt);
 
+/**
+ * @brief Return the publish timestamp from a native Message header.
+ *
+ * @param[in] header_id Header identifier.
+ * @param[in] pHeader Pointer to the native header.
+ *
+ * @return Timestamp in UTC nanoseconds, else 0.
+ */
+extern ULONG_T ndw_MsgHeader1_GetTimestamp(INT_T header_id, UCHAR_T* pHeader);
+
+/**
+ * @brief Build the per Topic LE header image holding the fields that never change for the Topic:
+ *  header number and size, vendor id and version, domain, source (application) id and topic id.
+ *  ndw_MsgHeader1_SetOutMsgFields then copies it and patches only the per message fields.
+ *
+ * @param[in] topic Topic to build the template for.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_MsgHeader1_BuildTemplate(ndw_Topic_T* topic);
+
 /**
  * @brief Given header Pointer convert fields of the header to LE (Little Endian format).
  *
@@ -0,0 +1,213 @@
+#ifndef _MSG_HEADER_2_H
+#define _MSG_HEADER_2_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <endian.h>
+#include <pthread.h>
+#include <limits.h>
+
+#include <cjson/cJSON.h>
+
+#include "ndw_types.h"
+#include "MsgHeaders.h"
+#include "RegistryData.h"
+
+/**
+ * @file MsgHeader_2.h
+ *
+ * @brief Compact variable length message header for small messages.
+ * The 5 mandatory fields (Header Identifier, Header Size, Vendor Identifier, Vendor Version and Encoding format)
+ * are one byte each as with every header type. They are followed by a 16 bit LE presence bitmap, and then
+ * by one unsigned LEB128 varint per field whose bit is set, in bit order. Fields that are zero are not sent at all.
+ *
+ * Wire layout:
+ * | header_number | header_size | vendor_id | vendor_version | encoding_format | presence (2 bytes LE) | varints... |
+ *
+ * On the wire header_size is the encoded size (NDW_MSGHEADER2_MIN_LE_MSG_SIZE to NDW_MSGHEADER2_MAX_LE_MSG_SIZE).
+ * On receipt the header is decoded into the fixed native ndw_MsgHeader2_T whose header_size is sizeof(ndw_MsgHeader2_T),
+ * and whose wire_size holds the encoded size.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_MSGHEADER_2
+ * @brief This is the header identifier for the compact variable length message header.
+ * @note Do NOT use 0 for a header identifier value.
+ */
+#define NDW_MSGHEADER_2            21
+
+/**
+ * @def NDW_MSGHEADER2_MIN_LE_MSG_SIZE
+ * @brief Smallest encoded header: the 5 mandatory bytes plus the presence bitmap.
+ */
+#define NDW_MSGHEADER2_MIN_LE_MSG_SIZE 7
+
+/**
+ * @def NDW_MSGHEADER2_MAX_LE_MSG_SIZE
+ * @brief Space reserved for the encoded header in front of the message body. Worst case encoding is 53 bytes.
+ *  Kept a multiple of 8 so the message body stays aligned.
+ */
+#define NDW_MSGHEADER2_MAX_LE_MSG_SIZE 56
+
+/**
+ * @def NDW_MSGHEADER2_NATIVE_SIZE
+ * @brief Size of the decoded (native) header ndw_MsgHeader2_T.
+ */
+#define NDW_MSGHEADER2_NATIVE_SIZE 48
+
+/**
+ * Presence bitmap bits. Varints follow in this order.
+ */
+#define NDW_MSGHEADER2_HAS_DOMAIN          0x0001
+#define NDW_MSGHEADER2_HAS_PRIORITY        0x0002
+#define NDW_MSGHEADER2_HAS_FLAGS           0x0004
+#define NDW_MSGHEADER2_HAS_MESSAGE_ID      0x0008
+#define NDW_MSGHEADER2_HAS_MESSAGE_SUB_ID  0x0010
+#define NDW_MSGHEADER2_HAS_PAYLOAD_SIZE    0x0020
+#define NDW_MSGHEADER2_HAS_CORRELATION_ID  0x0040
+#define NDW_MSGHEADER2_HAS_TIMESTAMP       0x0080
+#define NDW_MSGHEADER2_HAS_SOURCE_ID       0x0100
+#define NDW_MSGHEADER2_HAS_TENANT_ID       0x0200
+#define NDW_MSGHEADER2_HAS_TOPIC_ID        0x0400
+#define NDW_MSGHEADER2_ALL_FIELDS          0x07FF
+
+/**
+ * @struct ndw_MsgHeader2_T
+ * @brief Decoded (native) form of the compact message header.
+ *
+ * @note The first 5 fields have the same layout as every other header type.
+ */
+typedef struct ndw_MsgHeader2
+{
+    UCHAR_T header_number;      // Header Identifier.
+    UCHAR_T header_size;        // Header Size. Decoded: sizeof(ndw_MsgHeader2_T).
+    UCHAR_T vendor_id;          // Vendor Identifier to identify message is being sent over which vendor implementation.
+    UCHAR_T vendor_version;     // Logic version of the Vendor implementation code base.
+    UCHAR_T encoding_format;    // Message encoding format (e.g., JSON, XML, Binary, etc.)
+    UCHAR_T domain;             // Domain (It is a group of Connections and Topics).
+    UCHAR_T priority;           // Message Priority.
+    UCHAR_T flags;              // Message flags. 8 bits and hence 8 flags value possible.
+
+    USHORT_T presence;          // Presence bitmap as received (NDW_MSGHEADER2_HAS_*).
+    SHORT_T message_id;         // Message Identifiery or Message Type.
+    SHORT_T message_sub_id;     // Message Sub-Identifier for further subdivision within Message Identifier.
+    SHORT_T source_id;          // This is Application identifier who sent the message.
+    INT_T   payload_size;       // The size of the user data (payload). Do not add header size to it.
+    SHORT_T tenant_id;          // Message tentant identifier. Typically used for security.
+    SHORT_T topic_id;           // This is the logical Topic identifier.
+    ULONG_T correlation_id;     // Message correlation identifier.
+    ULONG_T timestamp;          // Timestamp. Should be in UTC format.
+    UCHAR_T wire_size;          // Encoded size of the header on the wire.
+    UCHAR_T padding[7];         // Padding for mutiple of double word size for header.
+
+} ndw_MsgHeader2_T;
+
+_Static_assert(sizeof(ndw_MsgHeader2_T) == NDW_MSGHEADER2_NATIVE_SIZE, "Mismatch in Size of compact header native structure");
+_Static_assert(NDW_MSGHEADER2_NATIVE_SIZE <= NDW_MSGHEADER2_MAX_LE_MSG_SIZE, "Decoded compact header must fit in its reserved size");
+
+
+/**
+ * @brief Initialize Message Header Type.
+ * @return None.
+ */
+extern void ndw_MsgHeader2_Init();
+
+/**
+ * @brief Check if header id is indeed for this Message header type.
+ * @return true if it is a valid Message header of its type, else false.
+ */
+extern bool ndw_MsgHeader2_IsValid(INT_T header_id);
+
+/**
+ * @brief This header type is variable length.
+ * @return true for NDW_MSGHEADER_2.
+ */
+extern bool ndw_MsgHeader2_IsVariableSize(INT_T header_id);
+
+/**
+ * @brief Print out decoded messge header contents. Useful for debugging.
+ *
+ * @param[in] header_id Header identifier.
+ * @param[in] pHeader Pointer to the decoded header.
+ *
+ * @return None.
+ */
+extern void ndw_MsgHeader2_Print(INT_T header_id, ULONG_T* pHeader);
+
+/**
+ * @brief Compare two decoded headers to see if their contents are the same.
+ *
+ * @param[in] header_id Header identifier.
+ * @param[in] pHeader1 Pointer to the first header.
+ * @param[in] pHeader2 Pointer to the second header.
+ * @return 0 if equal, else < 0 indicating field number that diverged.
+ */
+extern INT_T ndw_MsgHeader2_Compare(INT_T header_id, ULONG_T* pHeader1, ULONG_T* pHeader2);
+
+/**
+ * @brief Given Message header identifier return the maximum size of the encoded header.
+ * @param[in] header_id Header identifier.
+ *
+ * @return NDW_MSGHEADER2_MAX_LE_MSG_SIZE, else -1.
+ */
+extern INT_T ndw_MsgHeader2_LE_MsgHeaderSize(INT_T header_id);
+
+/**
+ * @brief Return the publish timestamp from a decoded header.
+ *
+ * @param[in] header_id Header identifier.
+ * @param[in] pHeader Pointer to the decoded header.
+ *
+ * @return Timestamp in UTC nanoseconds, else 0 if it was not sent.
+ */
+extern ULONG_T ndw_MsgHeader2_GetTimestamp(INT_T header_id, UCHAR_T* pHeader);
+
+/**
+ * @brief Encode the header for an outgoing message straight into LE wire format.
+ *  The encoded header is placed immediately in front of the message body, and cxt->header_address
+ *  and cxt->header_size are moved to it, so the frame sent is only as long as the fields present.
+ *
+ * @param[in] cxt Outbound per thread data structure containing header and message body.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_MsgHeader2_SetOutMsgFields(ndw_OutMsgCxt_T* cxt);
+
+/**
+ * @brief Header is already encoded in LE by ndw_MsgHeader2_SetOutMsgFields. This only validates it.
+ *
+ * @param[in] header_address Start of header address.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_MsgHeader2_ConvertToLE(UCHAR_T* header_address);
+
+/**
+ * @brief Decode an LE (Little Endian format) compact header into a native ndw_MsgHeader2_T.
+ *
+ * @param[in] src Start of encoded header.
+ * @param[out] dest Decoded header, at least NDW_MSGHEADER2_NATIVE_SIZE bytes.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_MsgHeader2_ConvertFromLE(UCHAR_T* src, UCHAR_T* dest);
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _MSG_HEADER_2_H */
+
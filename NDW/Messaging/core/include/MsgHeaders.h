@@ -112,6 +112,7 @@ typedef struct ndw_InMsgCxt
     INT_T header_size;          // Header size we insert after we parse minimal part of the header.
 
     UCHAR_T* header_addr;       // Header Pointer address.
+    INT_T header_native_size;   // Size of the header at header_addr. Differs from header_size for variable length headers.
 
     UCHAR_T* msg_addr;          // Message Body Pointer address.
     INT_T msg_size;             // Message Body size, does NOT include size of header.
@@ -163,11 +164,35 @@ typedef struct ndw_OutMsgCxt
     INT_T message_sub_id;           // Message Sub Identifier.
 
     INT_T current_allocation_size; // A hint for memory allocaton. This should be greater than the message_size else things are going wrong!
+    INT_T reserved_size;            // Body bytes reserved by ndw_ReserveOutMsg for in place (zero copy) writing.
+    bool header_is_le;              // Header was built directly in LE wire format, so ConvertToLE is skipped.
 
     bool loopback_test;             // For testing only. Loops the message back without sending it to the message system.
 
 } ndw_OutMsgCxt_T;
 
+/**
+ * @struct ndw_PublishBatchItem_T
+ * @brief One message of a batch handed to ndw_PublishBatch.
+ *  Application fills in the input fields. The abstraction layer stamps the header and fills in frame and frame_size,
+ *  and the vendor sets ret_code for each item it publishes.
+ */
+typedef struct ndw_PublishBatchItem
+{
+    // Input
+    ndw_Topic_T* topic;             // Topic to publish on.
+    INT_T header_id;                // Header type identifer.
+    INT_T msg_encoding_format;      // Message body encoding format type.
+    UCHAR_T* msg;                   // Message body; does NOT include the header.
+    INT_T msg_size;                 // Message body size.
+    bool loopback_test;             // For testing only. Loops the message back without sending it to the message system.
+
+    // Output
+    UCHAR_T* frame;                 // Header and message body in LE wire format (per thread batch buffer).
+    INT_T frame_size;               // Header size + message body size.
+    INT_T ret_code;                 // 0 if published, else < 0.
+} ndw_PublishBatchItem_T;
+
 
 /**
  * @brief Initialize various types of Message Headers we support.
@@ -206,6 +231,8 @@ extern void ndw_print_MessageHeaderInfo(FILE* stream, ndw_InMsgCxt_T* info);
  * @return Pointer to ndw_InMsgCxt_T which holds information of inbound message.
  *
  * @note Do NOT free the returned structure as it is maintained as a TLS (Thread Local Storage or Thread Specific Storage).
+ * @note On Little Endian hosts with an 8 byte aligned le_msg, header_addr points straight into le_msg and is only
+ *  valid as long as le_msg is. Otherwise the header is converted into a per thread buffer.
  */
 extern ndw_InMsgCxt_T* ndw_LE_to_MsgHeader(UCHAR_T* le_msg, INT_T le_msg_size);
 
@@ -282,6 +309,18 @@ extern INT_T ndw_GetMsgHeaderAndBody(ndw_OutMsgCxt_T* mha);
  */
 extern UCHAR_T* ndw_GetReceivedMsgHeader();
 
+/**
+ * @brief Return the per thread buffer used to lay out the frames of a publish batch.
+ *
+ * @param[in] size Minimum number of bytes needed.
+ * @param[in] preserve_size Number of leading bytes to keep if the buffer has to grow.
+ *
+ * @return Buffer address, else NULL on memory allocation failure.
+ *
+ * @note The buffer only grows. Addresses from a previous call are invalid once it grows.
+ */
+extern UCHAR_T* ndw_GetPublishBatchBuffer(INT_T size, INT_T preserve_size);
+
 /**
  * @var extern size_t ndw_max_message_size.
  * @brief Global variable to set the maximum size of message we can send or expect.
@@ -311,6 +350,12 @@ typedef struct ndw_HeaderAndMsg
  */
 extern pthread_key_t ndw_tls_header_and_message;
 
+/**
+ * @var extern pthread_key_t ndw_tls_publish_batch
+ * @brief Thread Local Storage that holds the frames (header and message body) of the current publish batch.
+ */
+extern pthread_key_t ndw_tls_publish_batch;
+
 /**
  * @var extern pthread_key_t ndw_tls_message_header_attributes
  * @brief Thread Local Storage that holds attributes of current outbound message.
@@ -349,9 +394,16 @@ typedef struct ndw_ImplMsgHeader
     // Print the message header for debugging.
     void (*Print)(INT_T header_id, ULONG_T* pHeader);
 
+    // Returns true if the encoded header length varies per message. Such headers are always decoded
+    // into a native structure, and LE_MsgHeaderSize returns the maximum encoded size.
+    bool (*IsVariableSize)(INT_T header_id);
+
     // Given header type identiifer return Message Header Size. LE is for Little Endian designation.
     INT_T (*LE_MsgHeaderSize)(INT_T header_id);
 
+    // Return the publish timestamp (UTC nanoseconds) from a native (decoded) header, or 0 if it has none.
+    ULONG_T (*GetTimestamp)(INT_T header_id, UCHAR_T* pHeader);
+
     // Set all the common and known fields in the outbound message structure.
     // Example of such common fields are: Application identifier, Domain identifer, Topic identifier, etc.
     INT_T (*SetOutMsgFields)(ndw_OutMsgCxt_T* cxt);
@@ -116,6 +116,14 @@ typedef struct ndw_NATS_JS_Attr
     ULONG_T durable_total_delivered;     // Total number of durable numbers delivered so far.
     ULONG_T durable_total_pending;       // Total number of durable numbers yet to be delivered.
 
+    INT_T fetch_batch;                   // PULL mode: messages requested per server round trip.
+    bool fetch_ack_all;                  // PULL mode: consumer uses AckAll, so only the last message of a batch is acked.
+    natsMsgList fetch_list;              // PULL mode: messages fetched but not yet handed to the application.
+    INT_T fetch_next;                    // Index of the next message in fetch_list to hand out.
+    natsMsg* fetch_ack_pending;          // PULL mode, AckAll: last committed message whose ack is deferred.
+    LONG_T fetch_round_trips;            // Number of natsSubscription_Fetch calls that returned messages.
+    LONG_T fetch_acks_coalesced;         // Acks skipped as a later AckAll ack covers them.
+
 } ndw_NATS_JS_Attr_T; 
 
 /*
@@ -171,6 +179,27 @@ typedef struct ndw_NATS_JS_Attr
  */
 #define NDW_NATS_JS_ATTR_BROWSE_MODE            "Browse"
 
+/**
+ * @def NDW_NATS_JS_ATTR_FETCH_BATCH
+ * @brief Tag in configuration for the number of messages a PULL subscriber fetches per server round trip.
+ *  Fetched messages are buffered in the Topic and handed out by subsequent polls. Default is 1.
+ */
+#define NDW_NATS_JS_ATTR_FETCH_BATCH            "FetchBatch"
+
+/**
+ * @def NDW_NATS_JS_ATTR_FETCH_ACK_ALL
+ * @brief Tag in configuration ("true") to create the PULL consumer with AckAll policy, so committing the last
+ *  message of a fetched batch acknowledges the whole batch with a single ack.
+ *  An existing durable consumer must have been created with the same policy.
+ */
+#define NDW_NATS_JS_ATTR_FETCH_ACK_ALL          "FetchAckAll"
+
+/**
+ * @def NDW_NATS_JS_MAX_FETCH_BATCH
+ * @brief Upper bound for NDW_NATS_JS_ATTR_FETCH_BATCH.
+ */
+#define NDW_NATS_JS_MAX_FETCH_BATCH             1024
+
 /*
  * NOTE of great importance!
  *
@@ -200,9 +229,6 @@ typedef struct ndw_NATS_Topic
 {
     bool durable_topic;                         // Is it a durable (persistent) Topic?
     LONG_T initiation_time;                     // Topic initiation time in UTC.
-    LONG_T total_messages_published;            // Total messages published on this Topic since application started.
-    LONG_T total_messages_received;             // Total messages received on this Topic since application started.
-    LONG_T total_messages_get_requestmsg;       // Total messages response received for published on Topic since app started.
 
     ndw_NATS_Connection_T* nats_connection;     // Physical NATS Connection object Pointer.
 
@@ -218,6 +244,9 @@ typedef struct ndw_NATS_Topic
     ULONG_T subscription_DeliveredMsgs;         // Total number of delivered messages on this Subscription.
     ULONG_T subscription_DroppedMsgs;           // Total number of dropped messages for this Subscription.
 
+    INT_T pool_index;                           // Connection pool entry this Topic publishes on. Fixed, so its
+                                                // messages go out on one socket and stay in order.
+
     ndw_NATS_JS_Attr_T   nats_js_attr;          // Jet Stream Attributes: configuration, publication and subscription.
 
 } ndw_NATS_Topic_T;
@@ -271,6 +300,35 @@ typedef struct ndw_NATS_Topic
  */
 #define NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_ATTEMPTS 5
 
+/**
+ * @def NDW_NATS_CONNECTION_PUBLICATION_LOW_WATERMARK_BYTES
+ * @brief Configuration name for the pending bytes low watermark.
+ * PublicationBackoffBytes is the high watermark: once the bytes buffered on the connection reach it, publishers
+ * are held back until the buffered bytes drain to the low watermark. Default is half of the high watermark.
+ */
+#define NDW_NATS_CONNECTION_PUBLICATION_LOW_WATERMARK_BYTES "PublicationLowWatermarkBytes"
+
+/**
+ * @def NDW_NATS_CONNECTION_PUBLICATION_MAX_WAIT_US
+ * @brief Configuration name for how long a publisher may wait for the buffered bytes to drain when the connection
+ * is above its high watermark. After that the message is sent anyway, unless PublicationWouldBlock is set.
+ * Default is 0: the publish is admitted (or refused) at once and counted as a throttle event.
+ */
+#define NDW_NATS_CONNECTION_PUBLICATION_MAX_WAIT_US "PublicationMaxWait_us"
+
+/**
+ * @def NDW_NATS_CONNECTION_PUBLICATION_WOULD_BLOCK
+ * @brief Configuration (1 to enable): refuse a publish with NDW_PUBLISH_WOULD_BLOCK when the connection is still
+ * above its high watermark after PublicationMaxWait_us, instead of sending it. Off by default.
+ */
+#define NDW_NATS_CONNECTION_PUBLICATION_WOULD_BLOCK "PublicationWouldBlock"
+
+/**
+ * @def NDW_NATS_PUBLICATION_WAIT_SLICE_US
+ * @brief Sleep between checks of the buffered bytes while a publisher waits for the connection to drain.
+ */
+#define NDW_NATS_PUBLICATION_WAIT_SLICE_US 50
+
 /**
  * @def NDW_NATS_CONNECTION_FLUSH_TIMEOUT_MS_OPTION
  * @brief Configuration name for Connection Flush Timeout in milliseconds.
@@ -330,6 +388,64 @@ typedef struct ndw_NATS_Topic
  */
 #define NDW_NATS_CONNECTION_NOECHO "ConnectionNoEcho"
 
+/**
+ * @def NDW_NATS_CONNECTION_JS_ASYNC_MAX_PENDING
+ * @brief Configuration: If > 0 JetStream messages on this connection are published asynchronously,
+ * with at most this many messages waiting for their ack. Publishing stalls while the window is full.
+ * Default is 0, i.e. synchronous js_Publish with one round trip per message.
+ */
+#define NDW_NATS_CONNECTION_JS_ASYNC_MAX_PENDING "JSPublishAsyncMaxPending"
+
+/**
+ * @def NDW_NATS_CONNECTION_JS_ASYNC_COMPLETE_WAIT_MS
+ * @brief Configuration: How long disconnect waits for outstanding asynchronous JetStream acks.
+ */
+#define NDW_NATS_CONNECTION_JS_ASYNC_COMPLETE_WAIT_MS "JSPublishAsyncCompleteWaitMS"
+
+/**
+ * @def NDW_NATS_JS_ASYNC_DEFAULT_COMPLETE_WAIT_MS
+ * @brief Default for NDW_NATS_CONNECTION_JS_ASYNC_COMPLETE_WAIT_MS.
+ */
+#define NDW_NATS_JS_ASYNC_DEFAULT_COMPLETE_WAIT_MS 5000
+
+/**
+ * @def NDW_NATS_CONNECTION_POOL_SIZE
+ * @brief Configuration: Number of physical NATS connections opened for the logical Connection. Default is 1.
+ * Core NATS publications are spread over them by a hash of the Topic PubKey, so each Topic always publishes on the
+ * same socket and its messages stay in order. Subscriptions, JetStream and request/reply use the first connection.
+ * Flow control (PublicationBackoffBytes and the low watermark) applies to each physical connection.
+ */
+#define NDW_NATS_CONNECTION_POOL_SIZE "ConnectionPoolSize"
+
+/**
+ * @def NDW_NATS_MAX_CONNECTION_POOL_SIZE
+ * @brief Upper bound for NDW_NATS_CONNECTION_POOL_SIZE.
+ */
+#define NDW_NATS_MAX_CONNECTION_POOL_SIZE 16
+
+/**
+ * @struct ndw_NATS_PoolConnection_T
+ * @brief One physical NATS connection of a Connection pool.
+ */
+typedef struct ndw_NATS_PoolConnection
+{
+    natsConnection* conn;               // Physical NATS Connection. Entry 0 is ndw_NATS_Connection_T conn.
+                                        // Publishers load it atomically; a closed one is retired, not destroyed.
+    bool publication_throttled;         // Set at high watermark, cleared at low watermark (accessed atomically).
+} ndw_NATS_PoolConnection_T;
+
+/**
+ * @struct ndw_NATS_PubKeyTopic_T
+ * @brief Maps a JetStream publish subject back to its Topic so asynchronous acks can be reported per Topic.
+ * Only kept when asynchronous publishing is configured, where a PubKey may belong to one Topic per connection.
+ */
+typedef struct ndw_NATS_PubKeyTopic
+{
+    const CHAR_T* pub_key;          // Publish subject (owned by the Topic).
+    ndw_Topic_T* topic;             // Topic publishing on pub_key.
+    UT_hash_handle hh;              // Hash handle keyed by pub_key.
+} ndw_NATS_PubKeyTopic_T;
+
 
 /**
  * @struct ndw_NATS_Connection_T
@@ -353,7 +469,14 @@ typedef struct ndw_NATS_Connection
     LONG_T backoff_sleep_us;            // Connection backoff sleep in microseconds.
     LONG_T backoff_attempts;            // Number of backoff attempts.
     LONG_T total_backoff_attempts;      // Total number of backoff attempts made so far.
+    LONG_T publication_low_watermark_bytes; // Throttled publishing resumes once buffered bytes drop to this.
+    LONG_T publication_max_wait_us;     // Bounded wait when throttled.
+    bool publication_would_block;       // Refuse with NDW_PUBLISH_WOULD_BLOCK after the wait, else send anyway.
+    LONG_T total_would_block;           // Publishes refused with NDW_PUBLISH_WOULD_BLOCK.
+    LONG_T total_throttle_waits;        // Publishes admitted while throttled (after waiting up to publication_max_wait_us).
     LONG_T iobuf_size;                  // IO Buffer size to use for this NATS Connection.
+    INT_T pool_size;                    // Number of physical NATS connections (ConnectionPoolSize), at least 1.
+    ndw_NATS_PoolConnection_T* pool;    // pool_size physical connections. Topics publish on pool[pool_index].
 
     LONG_T connection_timeout;          // When initiating a connection specify timeout. Default is 2000 ms.
     LONG_T connection_max_reconnects;   // How many times to try to reconnect. Default is 60.
@@ -366,6 +489,12 @@ typedef struct ndw_NATS_Connection
     jsCtx* js_context;                  // Unfortunately, Jetstream is treated different like an... add-on.
     INT_T js_enabled_count;             // Jetstream Topic enablementcount for this NATS connection.
 
+    LONG_T js_async_max_pending;        // > 0 enables asynchronous JetStream publishing with this ack window.
+    LONG_T js_async_complete_wait_ms;   // Time to wait for outstanding acks on disconnect.
+    LONG_T js_async_published;          // Asynchronous JetStream messages handed to NATS.
+    LONG_T js_async_completed;          // Asynchronous JetStream messages acked or failed.
+    ndw_NATS_PubKeyTopic_T* js_pub_topics; // JetStream publish subject to Topic lookup for acks.
+
 } ndw_NATS_Connection_T;
 
 
@@ -435,6 +564,24 @@ extern bool ndw_NATS_IsDraining(ndw_Connection_T* connection);
  */
 extern INT_T ndw_NATS_PublishMsg();
 
+/**
+ * @def NDW_NATS_BATCH_MAX_FLUSH_CONNECTIONS
+ * @brief Distinct physical connections a publish batch tracks for its single flush; beyond this they are flushed inline.
+ */
+#define NDW_NATS_BATCH_MAX_FLUSH_CONNECTIONS 32
+
+/**
+ * @brief Publish a batch of stamped frames for Topics of this vendor, then flush each connection used once.
+ *
+ * @param[in,out] items Batch items. ret_code is set for each item belonging to this vendor.
+ * @param[in] count Number of items.
+ * @param[in] vendor_id Only items whose Topic connection has this vendor_id are published.
+ * @param[in] flush_timeout_ms If > 0 flush each connection used with this timeout.
+ *
+ * @return Number of connection flushes that failed.
+ */
+extern INT_T ndw_NATS_PublishMsgBatch(ndw_PublishBatchItem_T* items, INT_T count, INT_T vendor_id, LONG_T flush_timeout_ms);
+
 /**
  * @brief Subscribe for asynchronous notification from NATS broker. 
  *
@@ -472,6 +619,43 @@ extern INT_T ndw_NATS_SubscribeSynchronously(ndw_Topic_T* topic);
  */
 extern INT_T ndw_NATS_GetQueuedMsgCount(ndw_Topic_T* topic, ULONG_T* count);
 
+/**
+ * @brief Fill in subscription pending, delivered and dropped counts of a Topic for a statistics snapshot.
+ *
+ * @param[in] topic Abstraction Layer Logical Topic object.
+ * @param[out] metrics Topic metrics to update.
+ */
+extern void ndw_NATS_GetTopicMetrics(ndw_Topic_T* topic, ndw_TopicMetrics_T* metrics);
+
+/**
+ * @brief Fill in backoff, throttling, buffered bytes and NATS connection counts for a statistics snapshot.
+ *
+ * @param[in] connection Abstraction Layer Logical Connection object.
+ * @param[out] metrics Connection metrics to update.
+ */
+extern void ndw_NATS_GetConnectionMetrics(ndw_Connection_T* connection, ndw_ConnectionMetrics_T* metrics);
+
+/**
+ * @brief Apply a reloaded registry to a Topic added by it or whose TopicOptions changed:
+ * set up JetStream for a durable Topic on an already connected Connection, and reapply the
+ * MsgsLimit / BytesLimit pending limits to a live subscription.
+ *
+ * @param[in] topic Abstraction Layer Logical Topic object.
+ *
+ * @return 0 on succees, else < 0.
+ */
+extern INT_T ndw_NATS_ReloadTopic(ndw_Topic_T* topic);
+
+/**
+ * @brief Apply reloaded Connection options. Only the publication backoff and flow control options take effect
+ * on a live Connection; the others take effect when the process is restarted.
+ *
+ * @param[in] connection Abstraction Layer Logical Connection object.
+ *
+ * @return 0 on succees, else < 0.
+ */
+extern INT_T ndw_NATS_ReloadConnection(ndw_Connection_T* connection);
+
 // Returns 0 if no messages, 1 if there is a message, else on errors returns < 0.
 /**
  * @brief Synchronously poll NATS broker and get a message back.
@@ -490,6 +674,17 @@ extern INT_T ndw_NATS_SynchronousPollForMsg(ndw_Topic_T* topic, const CHAR_T** m
 
 extern INT_T ndw_NATS_CommitQueuedMsg(ndw_Topic_T* topic, void* vendor_closure);
 
+/**
+ * @brief Commit (ack if JetStream) and release a range of queued messages in one pass.
+ *
+ * @param[in] topic Topic on which the messages arrived.
+ * @param[in] vendor_closures Array of vendor closures of the queued messages.
+ * @param[in] count Number of closures in the array.
+ *
+ * @return 0 if all were committed, else number of failed commits as a negative number.
+ */
+extern INT_T ndw_NATS_CommitQueuedMsgBatch(ndw_Topic_T* topic, void** vendor_closures, INT_T count);
+
 extern INT_T ndw_NATS_CleanupQueuedMsg(ndw_Topic_T* topic, void* vendor_closure);
 
 /**
@@ -0,0 +1,150 @@
+#ifndef _NDW_CLOCK_H
+#define _NDW_CLOCK_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/**
+ * @file NDW_Clock.h
+ *
+ * @brief Cheap wall clock (UTC nanoseconds) for header stamping and latency measurement.
+ *
+ * On x86_64 with an invariant TSC, ndw_ClockInit calibrates the TSC against CLOCK_REALTIME and a background
+ * thread re-syncs it periodically, slewing so the clock does not go backwards unless CLOCK_REALTIME was stepped.
+ * Reads are then a rdtsc plus a multiply under a sequence lock, so readers never block.
+ * Otherwise, and outside ndw_ClockInit/ndw_ClockShutdown, ndw_ClockNowNanos uses clock_gettime(CLOCK_REALTIME).
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_CLOCK_TSC
+ * @brief Environment variable; if set to 0 the TSC clock is not used and clock_gettime is always invoked.
+ */
+#define NDW_CLOCK_TSC "NDW_CLOCK_TSC"
+
+/**
+ * @def NDW_CLOCK_CALIBRATION_MS
+ * @brief Time spent at initialization measuring the TSC frequency.
+ */
+#define NDW_CLOCK_CALIBRATION_MS 20
+
+/**
+ * @def NDW_CLOCK_RESYNC_MS
+ * @brief Interval at which the background thread re-syncs the TSC to CLOCK_REALTIME.
+ */
+#define NDW_CLOCK_RESYNC_MS 1000
+
+/**
+ * @def NDW_CLOCK_MAX_SLEW_PPM
+ * @brief Largest rate correction, in parts per million, applied by a re-sync to converge on CLOCK_REALTIME.
+ */
+#define NDW_CLOCK_MAX_SLEW_PPM 500
+
+/**
+ * @def NDW_CLOCK_STEP_NS
+ * @brief Offset from CLOCK_REALTIME above which a re-sync steps the clock instead of slewing it.
+ */
+#define NDW_CLOCK_STEP_NS 128000000L
+
+/**
+ * @struct ndw_Clock_T
+ * @brief TSC to UTC nanoseconds calibration, published under a sequence lock.
+ *
+ * @note nanos = ns_base + ((tsc - tsc_base) * mult) >> 32
+ */
+typedef struct ndw_Clock
+{
+    _Alignas(64) atomic_uint seq;   // Odd while the calibration is being updated.
+    ULONG_T tsc_base;               // TSC at the last sync point.
+    ULONG_T ns_base;                // UTC nanoseconds at the last sync point.
+    ULONG_T mult;                   // Nanoseconds per TSC tick in 32.32 fixed point, including the slew.
+    atomic_bool tsc_enabled;        // TSC clock is calibrated and in use.
+    LONG_T total_resyncs;           // Number of re-syncs done by the background thread.
+    LONG_T total_steps;             // Re-syncs that stepped the clock as the offset exceeded NDW_CLOCK_STEP_NS.
+    LONG_T last_resync_error_ns;    // TSC clock minus CLOCK_REALTIME measured just before the last re-sync.
+} ndw_Clock_T;
+
+/**
+ * @var extern ndw_Clock_T ndw_clock
+ * @brief Process wide clock calibration.
+ */
+extern ndw_Clock_T ndw_clock;
+
+/**
+ * @brief Calibrate the TSC and start the re-sync thread. Falls back to clock_gettime if the TSC cannot be used.
+ *
+ * @return true if the TSC clock is in use, else false.
+ */
+extern bool ndw_ClockInit();
+
+/**
+ * @brief Stop the re-sync thread and fall back to clock_gettime.
+ */
+extern void ndw_ClockShutdown();
+
+static inline ULONG_T
+ndw_ClockSystemNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (ULONG_T) ts.tv_sec * 1000000000UL + (ULONG_T) ts.tv_nsec;
+}
+
+static inline ULONG_T
+ndw_ClockReadTSC()
+{
+#if defined(__x86_64__)
+    return (ULONG_T) __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Current UTC time in nanoseconds.
+ */
+static inline ULONG_T
+ndw_ClockNowNanos()
+{
+#if defined(__x86_64__)
+    if (__builtin_expect(atomic_load_explicit(&ndw_clock.tsc_enabled, memory_order_relaxed), 1)) {
+        for (;;) {
+            UINT_T seq = atomic_load_explicit(&ndw_clock.seq, memory_order_acquire);
+            if (seq & 1)
+                continue;
+
+            ULONG_T tsc_base = __atomic_load_n(&ndw_clock.tsc_base, __ATOMIC_RELAXED);
+            ULONG_T ns_base = __atomic_load_n(&ndw_clock.ns_base, __ATOMIC_RELAXED);
+            ULONG_T mult = __atomic_load_n(&ndw_clock.mult, __ATOMIC_RELAXED);
+
+            atomic_thread_fence(memory_order_acquire);
+            if (seq != atomic_load_explicit(&ndw_clock.seq, memory_order_relaxed))
+                continue;
+
+            ULONG_T tsc = ndw_ClockReadTSC();
+            ULONG_T delta = (tsc > tsc_base) ? (tsc - tsc_base) : 0;
+            return ns_base + (ULONG_T) (((unsigned __int128) delta * mult) >> 32);
+        }
+    }
+#endif
+    return ndw_ClockSystemNanos();
+}
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_CLOCK_H */
+
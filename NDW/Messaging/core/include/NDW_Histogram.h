@@ -0,0 +1,194 @@
+#ifndef _NDW_HISTOGRAM_H
+#define _NDW_HISTOGRAM_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @file NDW_Histogram.h
+ *
+ * @brief Log-linear (HDR style) latency histogram in nanoseconds.
+ *
+ * Values below 2 * NDW_HISTOGRAM_SUB_BUCKETS are counted exactly. Above that every power of two range is split
+ * into NDW_HISTOGRAM_SUB_BUCKETS linear sub-buckets, so a recorded value is known to within 1/32 of itself and
+ * reported (bucket midpoint) to within 1/64. Percentiles are computed over the whole distribution.
+ *
+ * Recording is lock-free (relaxed atomic adds) and safe from any number of threads. Merge, percentile and
+ * serialize read with relaxed loads, so they can run while other threads keep recording.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_HISTOGRAM_SUB_BUCKET_BITS
+ * @brief log2 of the number of linear sub-buckets per power of two. Sets the precision.
+ */
+#define NDW_HISTOGRAM_SUB_BUCKET_BITS 5
+#define NDW_HISTOGRAM_SUB_BUCKETS (1 << NDW_HISTOGRAM_SUB_BUCKET_BITS)
+
+/**
+ * @def NDW_HISTOGRAM_MAX_BITS
+ * @brief Values of 2^NDW_HISTOGRAM_MAX_BITS nanoseconds (about 68.7 seconds) and above are counted as overflow.
+ */
+#define NDW_HISTOGRAM_MAX_BITS 36
+#define NDW_HISTOGRAM_MAX_VALUE (1UL << NDW_HISTOGRAM_MAX_BITS)
+
+/**
+ * @def NDW_HISTOGRAM_BUCKETS
+ * @brief Number of buckets (1024 with the settings above, that is 8KB of counts).
+ */
+#define NDW_HISTOGRAM_BUCKETS ((NDW_HISTOGRAM_MAX_BITS - NDW_HISTOGRAM_SUB_BUCKET_BITS + 1) * NDW_HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * @struct ndw_Histogram_T
+ * @brief Latency histogram. Allocate with ndw_HistogramCreate.
+ */
+typedef struct ndw_Histogram
+{
+    ULONG_T total_sum;                      // Sum of all recorded values, for the mean.
+    ULONG_T min_value;                      // Smallest recorded value. ~0 if nothing recorded.
+    ULONG_T max_value;                      // Largest recorded value, including overflows.
+    ULONG_T overflow_count;                 // Values >= NDW_HISTOGRAM_MAX_VALUE.
+    ULONG_T counts[NDW_HISTOGRAM_BUCKETS];  // Per bucket counters.
+} ndw_Histogram_T;
+
+/**
+ * @brief Allocate a zeroed histogram.
+ * @return Histogram Pointer, else NULL on memory allocation failure.
+ */
+extern ndw_Histogram_T* ndw_HistogramCreate();
+
+/**
+ * @brief Free a histogram created with ndw_HistogramCreate.
+ */
+extern void ndw_HistogramDestroy(ndw_Histogram_T* h);
+
+/**
+ * @brief Clear all counts.
+ * @note Values recorded concurrently with a reset may be partially lost.
+ */
+extern void ndw_HistogramReset(ndw_Histogram_T* h);
+
+/**
+ * @brief Add all counts of src into dest. Typically used to combine per thread histograms, or to take a snapshot.
+ */
+extern void ndw_HistogramMerge(ndw_Histogram_T* dest, const ndw_Histogram_T* src);
+
+/**
+ * @brief Total number of recorded values, including overflows.
+ */
+extern ULONG_T ndw_HistogramCount(const ndw_Histogram_T* h);
+
+/**
+ * @brief Value at a percentile of the whole distribution.
+ *
+ * @param[in] h Histogram.
+ * @param[in] percentile 0.0 to 100.0, for example 99.9
+ *
+ * @return Value in nanoseconds, or 0 if nothing was recorded.
+ */
+extern ULONG_T ndw_HistogramValueAtPercentile(const ndw_Histogram_T* h, double percentile);
+
+/**
+ * @brief Log count, min, mean, p50, p90, p99, p99.9, p99.99, max and overflow count on one line.
+ *
+ * @param[in] h Histogram.
+ * @param[in] prefix Text put in front of the line.
+ */
+extern void ndw_HistogramPrint(const ndw_Histogram_T* h, const CHAR_T* prefix);
+
+/**
+ * @brief Serialize into text: "NDWH1 <sum> <min> <max> <overflow> <index>:<count> ..." listing non zero buckets only.
+ *
+ * @param[in] h Histogram.
+ * @param[out] buffer Output buffer, NUL terminated on success.
+ * @param[in] size Size of buffer.
+ *
+ * @return Length written (excluding NUL), else -1 if the buffer is too small.
+ */
+extern INT_T ndw_HistogramSerialize(const ndw_Histogram_T* h, CHAR_T* buffer, INT_T size);
+
+/**
+ * @brief Add the counts of a histogram serialized with ndw_HistogramSerialize into h.
+ *
+ * @return 0 on success, else < 0 if the text is malformed.
+ */
+extern INT_T ndw_HistogramDeserialize(ndw_Histogram_T* h, const CHAR_T* text);
+
+/**
+ * @brief Lowest value counted in a bucket.
+ */
+static inline ULONG_T
+ndw_HistogramBucketLowValue(INT_T index)
+{
+    if (index < (2 * NDW_HISTOGRAM_SUB_BUCKETS))
+        return (ULONG_T) index;
+
+    INT_T shift = (index >> NDW_HISTOGRAM_SUB_BUCKET_BITS) - 1;
+    return ((ULONG_T) (NDW_HISTOGRAM_SUB_BUCKETS + (index & (NDW_HISTOGRAM_SUB_BUCKETS - 1)))) << shift;
+}
+
+/**
+ * @brief Number of distinct values counted in a bucket.
+ */
+static inline ULONG_T
+ndw_HistogramBucketWidth(INT_T index)
+{
+    if (index < (2 * NDW_HISTOGRAM_SUB_BUCKETS))
+        return 1;
+
+    return 1UL << ((index >> NDW_HISTOGRAM_SUB_BUCKET_BITS) - 1);
+}
+
+/**
+ * @brief Bucket index for a value below NDW_HISTOGRAM_MAX_VALUE.
+ */
+static inline INT_T
+ndw_HistogramBucketIndex(ULONG_T value)
+{
+    if (value < (2 * NDW_HISTOGRAM_SUB_BUCKETS))
+        return (INT_T) value;
+
+    INT_T shift = (63 - __builtin_clzl(value)) - NDW_HISTOGRAM_SUB_BUCKET_BITS;
+    return ((shift + 1) << NDW_HISTOGRAM_SUB_BUCKET_BITS) + (INT_T) ((value >> shift) - NDW_HISTOGRAM_SUB_BUCKETS);
+}
+
+/**
+ * @brief Record a value in nanoseconds. Lock-free; safe from any thread.
+ */
+static inline void
+ndw_HistogramRecord(ndw_Histogram_T* h, ULONG_T value)
+{
+    if (__builtin_expect(value < NDW_HISTOGRAM_MAX_VALUE, 1))
+        __atomic_fetch_add(&h->counts[ndw_HistogramBucketIndex(value)], 1, __ATOMIC_RELAXED);
+    else
+        __atomic_fetch_add(&h->overflow_count, 1, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&h->total_sum, value, __ATOMIC_RELAXED);
+
+    ULONG_T current = __atomic_load_n(&h->min_value, __ATOMIC_RELAXED);
+    while ((value < current) &&
+           (! __atomic_compare_exchange_n(&h->min_value, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        ;
+
+    current = __atomic_load_n(&h->max_value, __ATOMIC_RELAXED);
+    while ((value > current) &&
+           (! __atomic_compare_exchange_n(&h->max_value, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        ;
+}
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_HISTOGRAM_H */
+
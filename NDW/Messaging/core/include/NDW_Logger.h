@@ -0,0 +1,105 @@
+#ifndef _NDW_LOGGER_H
+#define _NDW_LOGGER_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+/**
+ * @file NDW_Logger.h
+ *
+ * @brief Asynchronous backend for NDW_LOG, NDW_LOGX, NDW_LOGERR, ndw_print, ndw_fprintf and ndw_printf.
+ *
+ * In asynchronous mode the calling thread formats the line into its own single producer ring buffer and returns:
+ * no mutex, no stdio call and no system call. A writer thread drains all rings in timestamp order and
+ * writes them in batches, with one fflush per stream per batch.
+ * Lines of one thread keep their order; lines of different threads are ordered by timestamp within a batch.
+ *
+ * The default remains the synchronous mode (mutex, fprintf and fflush per line).
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_LOG_ASYNC
+ * @brief Environment variable read by ndw_InitThreadSafeLogger.
+ * 0 (default) synchronous logging, 1 asynchronous and drop lines when a thread's ring is full,
+ * 2 asynchronous and wait for room when a thread's ring is full.
+ */
+#define NDW_LOG_ASYNC "NDW_LOG_ASYNC"
+
+/**
+ * @def NDW_LOG_ASYNC_BUFFER_KB
+ * @brief Environment variable; size of each thread's ring in KB, rounded up to a power of two.
+ */
+#define NDW_LOG_ASYNC_BUFFER_KB "NDW_LOG_ASYNC_BUFFER_KB"
+
+#define NDW_LOG_SYNC 0
+#define NDW_LOG_ASYNC_DROP 1
+#define NDW_LOG_ASYNC_WAIT 2
+
+#define NDW_LOG_ASYNC_DEFAULT_BUFFER_KB 1024
+#define NDW_LOG_ASYNC_DRAIN_INTERVAL_MS 2   // Writer sleep when there is nothing to write.
+#define NDW_LOG_ASYNC_MAX_LINE 2048         // Longer lines are formatted on the heap.
+
+/**
+ * @var extern INT_T ndw_log_mode
+ * @brief Current mode, one of NDW_LOG_SYNC, NDW_LOG_ASYNC_DROP or NDW_LOG_ASYNC_WAIT.
+ */
+extern INT_T ndw_log_mode;
+
+/**
+ * @brief Start asynchronous logging. Invoked by ndw_InitThreadSafeLogger from NDW_LOG_ASYNC.
+ *
+ * @param[in] mode NDW_LOG_ASYNC_DROP or NDW_LOG_ASYNC_WAIT.
+ * @param[in] buffer_kb Ring size per thread in KB, <= 0 for NDW_LOG_ASYNC_DEFAULT_BUFFER_KB.
+ *
+ * @return 0 on success, else < 0 and logging stays synchronous.
+ */
+extern INT_T ndw_LogAsyncStart(INT_T mode, INT_T buffer_kb);
+
+/**
+ * @brief Write out everything logged so far and switch back to synchronous logging.
+ * Invoked by ndw_DestroyThreadSafeLogger.
+ */
+extern void ndw_LogAsyncStop();
+
+/**
+ * @brief Write out everything logged so far by all threads. Invoked by ndw_exit and at process exit.
+ */
+extern void ndw_LogAsyncFlush();
+
+/**
+ * @brief Queue one line to the calling thread's ring.
+ *
+ * @param[in] stream Destination stream, stdout if NULL.
+ * @param[in] filename Source file name, or NULL for no prefix.
+ * @param[in] line_number Source line number.
+ * @param[in] function_name Source function name.
+ * @param[in] format printf format.
+ * @param[in] args Arguments for format.
+ */
+extern void ndw_LogAsyncV(FILE* stream, const CHAR_T* filename, INT_T line_number,
+                            const CHAR_T* function_name, const CHAR_T* format, va_list args);
+
+/**
+ * @brief Total lines dropped because a thread's ring was full (NDW_LOG_ASYNC_DROP).
+ */
+extern ULONG_T ndw_LogAsyncDropped();
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_LOGGER_H */
+
@@ -0,0 +1,216 @@
+#ifndef _NDW_METRICS_H
+#define _NDW_METRICS_H
+
+#include "ndw_types.h"
+#include "NDW_Stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @file NDW_Metrics.h
+ *
+ * @brief Machine readable snapshot of Domain, Connection and Topic statistics, and an optional exporter thread.
+ *
+ * ndw_GetStatsSnapshot reads counters with relaxed loads and never takes the logger mutex, so it can be called
+ * from a monitoring thread while application threads keep publishing and consuming.
+ * The snapshot can be formatted as Prometheus text exposition format or as JSON.
+ *
+ * The exporter thread (started by ndw_Init when NDW_METRICS_PORT or NDW_METRICS_FILE is set) serves
+ * the snapshot over HTTP on 127.0.0.1 (/metrics for Prometheus text, /metrics.json for JSON),
+ * and / or periodically rewrites a file (JSON if the name ends with .json, else Prometheus text).
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_METRICS_DEFAULT_INTERVAL_MS
+ * @brief Default interval for rewriting the metrics file.
+ */
+#define NDW_METRICS_DEFAULT_INTERVAL_MS 10000
+
+/**
+ * @struct ndw_LatencyMetrics_T
+ * @brief Summary of a latency histogram in nanoseconds.
+ */
+typedef struct ndw_LatencyMetrics
+{
+    bool captured;                          // False if latency capture is off (NDW_CAPTURE_LATENCY).
+    ULONG_T count;
+    ULONG_T sum;
+    ULONG_T min;
+    ULONG_T p50;
+    ULONG_T p90;
+    ULONG_T p99;
+    ULONG_T p999;
+    ULONG_T max;
+} ndw_LatencyMetrics_T;
+
+/**
+ * @struct ndw_TopicMetrics_T
+ * @brief Statistics of one Topic.
+ */
+typedef struct ndw_TopicMetrics
+{
+    INT_T topic_id;
+    CHAR_T* topic_name;
+    INT_T connection_id;
+    INT_T domain_id;
+    bool disabled;
+
+    ndw_TopicStats_T stats;                 // Message counters, indexed by NDW_TOPIC_STAT_*.
+
+    LONG_T sequence_number;
+    LONG_T q_async_depth;                   // Messages in q_async not yet polled by the application.
+    LONG_T q_async_spill_depth;             // Messages waiting in the spill list (NDW_QOVERFLOW_SPILL).
+    LONG_T q_async_dropped_newest;
+    LONG_T q_async_dropped_oldest;
+    LONG_T q_async_evict_failures;          // DropOldest could not evict, so the newest message was dropped.
+    LONG_T q_async_blocked;
+    LONG_T q_async_block_timeouts;
+    LONG_T q_async_spilled;
+    LONG_T publish_acks;
+    LONG_T publish_ack_failures;
+    LONG_T latency_clock_skew;
+
+    // Filled in by the vendor implementation, zero if it does not track them.
+    LONG_T vendor_pending_msgs;             // Received by the vendor library but not yet delivered to NDW.
+    LONG_T vendor_pending_bytes;
+    LONG_T vendor_delivered_msgs;
+    LONG_T vendor_dropped_msgs;             // Dropped by the vendor library, typically as a slow consumer.
+
+    ndw_LatencyMetrics_T latency;           // Publish to receive latency.
+    ndw_LatencyMetrics_T q_async_dwell;     // Time spent in q_async.
+} ndw_TopicMetrics_T;
+
+/**
+ * @struct ndw_ConnectionMetrics_T
+ * @brief Statistics of one Connection, with the Topic counters summed.
+ */
+typedef struct ndw_ConnectionMetrics
+{
+    INT_T connection_id;
+    CHAR_T* connection_name;
+    CHAR_T* vendor_name;
+    INT_T domain_id;
+    bool disabled;
+    bool connected;
+    INT_T num_topics;
+
+    ndw_TopicStats_T stats;                 // Sum over the Topics of the Connection.
+    LONG_T q_async_depth;                   // Sum over the Topics of the Connection.
+    LONG_T vendor_pending_msgs;             // Sum over the Topics of the Connection.
+    LONG_T vendor_dropped_msgs;             // Sum over the Topics of the Connection.
+
+    // Filled in by the vendor implementation, zero if it does not track them.
+    LONG_T backoff_attempts;                // Publish retries after the vendor refused a message.
+    LONG_T would_block;                     // Publishes refused with NDW_PUBLISH_WOULD_BLOCK.
+    LONG_T throttle_waits;                  // Publishes that waited for the outbound buffer to drain.
+    LONG_T async_publish_pending;           // Durable asynchronous publishes not yet acknowledged.
+    LONG_T vendor_connections;              // Physical vendor connections open.
+    LONG_T vendor_buffered_bytes;           // Bytes in the vendor outbound buffer.
+    LONG_T vendor_reconnects;
+    LONG_T vendor_in_msgs;
+    LONG_T vendor_in_bytes;
+    LONG_T vendor_out_msgs;
+    LONG_T vendor_out_bytes;
+} ndw_ConnectionMetrics_T;
+
+/**
+ * @struct ndw_DomainMetrics_T
+ * @brief Statistics of one Domain, with the Connection counters summed.
+ */
+typedef struct ndw_DomainMetrics
+{
+    INT_T domain_id;
+    CHAR_T* domain_name;
+    INT_T num_connections;
+    INT_T num_topics;
+
+    ndw_TopicStats_T stats;                 // Sum over the Topics of the Domain.
+    LONG_T q_async_depth;
+    LONG_T vendor_pending_msgs;
+    LONG_T vendor_dropped_msgs;
+} ndw_DomainMetrics_T;
+
+/**
+ * @struct ndw_StatsSnapshot_T
+ * @brief Statistics of all Domains, Connections and Topics at one point in time.
+ *
+ * @note Owns all its memory, including names. Release with ndw_FreeStatsSnapshot.
+ */
+typedef struct ndw_StatsSnapshot
+{
+    ULONG_T snapshot_time;                  // UTC nanoseconds.
+    INT_T app_id;
+
+    INT_T num_domains;
+    ndw_DomainMetrics_T* domains;
+
+    INT_T num_connections;
+    ndw_ConnectionMetrics_T* connections;   // Grouped by Domain, in the order of domains.
+
+    INT_T num_topics;
+    ndw_TopicMetrics_T* topics;             // Grouped by Connection, in the order of connections.
+} ndw_StatsSnapshot_T;
+
+/**
+ * @brief Take a snapshot of all statistics. MT safe, lock-free with respect to the publish and receive paths.
+ *
+ * @return Snapshot, else NULL if the registry is not loaded or memory allocation failed.
+ */
+extern ndw_StatsSnapshot_T* ndw_GetStatsSnapshot();
+
+/**
+ * @brief Free a snapshot returned by ndw_GetStatsSnapshot.
+ */
+extern void ndw_FreeStatsSnapshot(ndw_StatsSnapshot_T* snapshot);
+
+/**
+ * @brief Format a snapshot in the Prometheus text exposition format (version 0.0.4).
+ *
+ * @param[in] snapshot Snapshot.
+ *
+ * @return NUL terminated text to be released with free(), else NULL.
+ */
+extern CHAR_T* ndw_StatsSnapshotToPrometheus(const ndw_StatsSnapshot_T* snapshot);
+
+/**
+ * @brief Format a snapshot as JSON.
+ *
+ * @param[in] snapshot Snapshot.
+ *
+ * @return NUL terminated text to be released with free(), else NULL.
+ */
+extern CHAR_T* ndw_StatsSnapshotToJSON(const ndw_StatsSnapshot_T* snapshot);
+
+/**
+ * @brief Start the metrics exporter thread. Invoked by ndw_Init from NDW_METRICS_PORT, NDW_METRICS_FILE
+ * and NDW_METRICS_INTERVAL_MS.
+ *
+ * @param[in] port Serve HTTP on 127.0.0.1:port, 0 for no HTTP.
+ * @param[in] file_path File to rewrite every interval_ms, NULL for no file.
+ * @param[in] interval_ms File rewrite interval, <= 0 for NDW_METRICS_DEFAULT_INTERVAL_MS.
+ *
+ * @return 0 on success, else < 0. Starting an already running exporter returns -1.
+ */
+extern INT_T ndw_MetricsExporterStart(INT_T port, const CHAR_T* file_path, LONG_T interval_ms);
+
+/**
+ * @brief Stop the metrics exporter thread, if running. Invoked by ndw_Shutdown.
+ */
+extern void ndw_MetricsExporterStop();
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_METRICS_H */
+
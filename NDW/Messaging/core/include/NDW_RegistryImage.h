@@ -0,0 +1,211 @@
+#ifndef _NDW_REGISTRY_IMAGE_H
+#define _NDW_REGISTRY_IMAGE_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @file NDW_RegistryImage.h
+ *
+ * @brief Precompiled binary image of the (JSON) registry, loaded with mmap.
+ *
+ * The JSON registry stays the source format. ndw_CompileRegistry loads all of its Domains with ndw_LoadDomains
+ * (so parsing and validation are exactly those of the JSON path) and writes the resulting Domains, Connections,
+ * Topics, parsed option name value pairs and all strings to a flat, versioned image.
+ *
+ * ndw_LoadDomainsFromImage maps the image read only and builds the registry without any parsing:
+ * registry strings (names, keys, descriptions, options, debug descriptions) point into the mapping,
+ * so there is no strdup and no ndw_ParseNVPairs per Connection and Topic.
+ * The image records the size, modification time and hash of the JSON file it was compiled from,
+ * and is rejected if that file has since changed.
+ *
+ * Layout: ndw_RegistryImageHeader_T, then the Domain, Connection, Topic and name value pair records,
+ * then the string table. Each section starts on an 8 byte boundary. Records refer to strings by their offset in the
+ * string table (NDW_REGISTRY_IMAGE_NULL_STRING for NULL) and to their children by first index and count.
+ * Integers are in host byte order; an image is only loaded on a host with the same byte order and record sizes.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_REGISTRY_IMAGE_MAGIC
+ * @brief First 8 bytes of an image (including the terminating NUL).
+ */
+#define NDW_REGISTRY_IMAGE_MAGIC "NDWREGI"
+
+/**
+ * @def NDW_REGISTRY_IMAGE_VERSION
+ * @brief Image format version. Bump on any change to the header or record layouts.
+ */
+#define NDW_REGISTRY_IMAGE_VERSION 1
+
+#define NDW_REGISTRY_IMAGE_BYTE_ORDER 0x01020304   // Written in host byte order, read back to detect a mismatch.
+#define NDW_REGISTRY_IMAGE_NULL_STRING 0xFFFFFFFFU  // String offset standing for a NULL string.
+
+#define NDW_REGISTRY_IMAGE_TOPIC_DISABLED 0x1
+#define NDW_REGISTRY_IMAGE_TOPIC_PUB_ENABLED 0x2
+#define NDW_REGISTRY_IMAGE_TOPIC_SUB_ENABLED 0x4
+
+/**
+ * @struct ndw_RegistryImageHeader_T
+ * @brief Start of an image.
+ */
+typedef struct ndw_RegistryImageHeader
+{
+    CHAR_T magic[8];                    // NDW_REGISTRY_IMAGE_MAGIC
+    UINT_T version;                     // NDW_REGISTRY_IMAGE_VERSION
+    UINT_T header_size;                 // sizeof(ndw_RegistryImageHeader_T)
+    UINT_T byte_order;                  // NDW_REGISTRY_IMAGE_BYTE_ORDER
+    UINT_T domain_record_size;          // sizeof(ndw_RegistryImageDomain_T)
+    UINT_T connection_record_size;      // sizeof(ndw_RegistryImageConnection_T)
+    UINT_T topic_record_size;           // sizeof(ndw_RegistryImageTopic_T)
+    UINT_T nvpair_record_size;          // sizeof(ndw_RegistryImageNVPair_T)
+    UINT_T num_domains;
+    UINT_T num_connections;
+    UINT_T num_topics;
+    UINT_T num_nvpairs;
+    UINT_T reserved;
+    ULONG_T domains_offset;             // Offsets are from the start of the image.
+    ULONG_T connections_offset;
+    ULONG_T topics_offset;
+    ULONG_T nvpairs_offset;
+    ULONG_T strings_offset;
+    ULONG_T strings_size;
+    ULONG_T image_size;                 // Must equal the file size.
+    ULONG_T image_hash;                 // Hash of everything after the header.
+    ULONG_T source_size;                // JSON file the image was compiled from.
+    LONG_T source_mtime_sec;
+    LONG_T source_mtime_nsec;
+    ULONG_T source_hash;
+} ndw_RegistryImageHeader_T;
+
+/**
+ * @struct ndw_RegistryImageDomain_T
+ * @brief Image record of an ndw_Domain_T.
+ */
+typedef struct ndw_RegistryImageDomain
+{
+    UINT_T domain_name;
+    UINT_T domain_description;
+    UINT_T debug_desc;
+    INT_T domain_id;
+    UINT_T first_connection;
+    UINT_T num_connections;
+} ndw_RegistryImageDomain_T;
+
+/**
+ * @struct ndw_RegistryImageConnection_T
+ * @brief Image record of an ndw_Connection_T.
+ */
+typedef struct ndw_RegistryImageConnection
+{
+    UINT_T connection_unique_name;
+    UINT_T vendor_name;
+    UINT_T vendor_real_version;
+    UINT_T connection_url;
+    UINT_T connection_comments;
+    UINT_T debug_desc;
+    UINT_T vendor_connection_options;
+    INT_T connection_unique_id;
+    INT_T vendor_id;
+    INT_T vendor_logical_version;
+    INT_T tenant_id;
+    UINT_T disabled;
+    UINT_T first_nvpair;                // vendor_connection_options_nvpairs
+    UINT_T num_nvpairs;
+    UINT_T first_topic;
+    UINT_T num_topics;
+} ndw_RegistryImageConnection_T;
+
+/**
+ * @struct ndw_RegistryImageTopic_T
+ * @brief Image record of an ndw_Topic_T.
+ */
+typedef struct ndw_RegistryImageTopic
+{
+    UINT_T topic_unique_name;
+    UINT_T topic_description;
+    UINT_T pub_key;
+    UINT_T sub_key;
+    UINT_T q_async_name;
+    UINT_T debug_desc;
+    UINT_T topic_options;
+    UINT_T vendor_topic_options;
+    INT_T topic_unique_id;
+    INT_T q_async_size;
+    UINT_T flags;                       // NDW_REGISTRY_IMAGE_TOPIC_*
+    UINT_T first_nvpair;                // topic_options_nvpairs
+    UINT_T num_nvpairs;
+    UINT_T first_vendor_nvpair;         // vendor_topic_options_nvpairs
+    UINT_T num_vendor_nvpairs;
+    UINT_T reserved;
+} ndw_RegistryImageTopic_T;
+
+/**
+ * @struct ndw_RegistryImageNVPair_T
+ * @brief Image record of one parsed option name and value.
+ */
+typedef struct ndw_RegistryImageNVPair
+{
+    UINT_T name;
+    UINT_T value;
+} ndw_RegistryImageNVPair_T;
+
+/**
+ * @brief Compile a JSON registry into a binary image.
+ * All Domains of the JSON file are loaded with ndw_LoadDomains and written to the image,
+ * which is written to a temporary file and renamed, so a running loader never sees a partial image.
+ *
+ * @param[in] json_path JSON registry.
+ * @param[in] image_path Image file to (re)write.
+ *
+ * @return 0 on success, else < 0.
+ *
+ * @note The registry must not be loaded in this process; it is loaded and cleaned up again.
+ */
+extern INT_T ndw_CompileRegistry(const CHAR_T* json_path, const CHAR_T* image_path);
+
+/**
+ * @brief Load Domains from a binary image. The counterpart of ndw_LoadDomains.
+ * The whole image is validated before any registry data structure is created, so on failure the caller can
+ * still fall back to ndw_LoadDomains.
+ *
+ * @param[in] image_path Image written by ndw_CompileRegistry.
+ * @param[in] json_path JSON registry the image should have been compiled from, or NULL to skip the check.
+ * If the file changed since, the image is rejected. If it cannot be read, the image is used with a warning.
+ * @param[in] domain_names NULL terminated list of Domains to load, or NULL for all Domains in the image.
+ *
+ * @return 0 on success, -1 if the registry is already loaded, -2 if the image cannot be mapped,
+ * -3 if the image is invalid, -4 if the image is stale relative to json_path,
+ * -5 if the Topic table cannot be built.
+ */
+extern INT_T ndw_LoadDomainsFromImage(const CHAR_T* image_path, const CHAR_T* json_path, CHAR_T** domain_names);
+
+/**
+ * @brief Free a registry string or buffer unless it lives in the mapped image.
+ * Use instead of free() for strings of Domains, Connections and Topics.
+ *
+ * @param[in] ptr Pointer to free; may be NULL.
+ */
+extern void ndw_RegistryFree(void* ptr);
+
+/**
+ * @brief Unmap the image, if any. Invoked by ndw_CleanupRegistry after all registry data structures are freed.
+ */
+extern void ndw_UnmapRegistryImage();
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_REGISTRY_IMAGE_H */
+
@@ -0,0 +1,91 @@
+#ifndef _NDW_REGISTRY_RELOAD_H
+#define _NDW_REGISTRY_RELOAD_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @file NDW_RegistryReload.h
+ *
+ * @brief Reload the (JSON) registry of a running process, on request or when the file changes.
+ *
+ * ndw_ReloadRegistry parses the JSON file into a separate staging registry (for the Domains already loaded),
+ * compares it with the running registry by name, and applies the differences in place:
+ *  - Added Topics and Connections are created, configured by the vendor implementation and linked in.
+ *    Added Connections are not connected; call ndw_Connect for them. A Topic whose vendor configuration is
+ *    rejected (for NATS, a bad JetStream configuration) is logged, counted as not applied and not added.
+ *  - Removed or newly disabled Topics are disabled and then unsubscribed; removed or disabled Connections are
+ *    also disconnected. Registry entries are never freed before ndw_Shutdown, so Topic pointers and handles held
+ *    by the application stay valid: publishing on them is simply skipped, as for a Topic disabled in the JSON file.
+ *    Vendor implementations close their subscriptions and connections at once but must keep the vendor objects
+ *    until ndw_Shutdown, as another thread may be using them (NATS does).
+ *  - Newly enabled Topics are enabled. Subscribe to them again to receive messages.
+ *  - Changed TopicOptions are published as a new ndw_TopicCold_T, and the vendor implementation reapplies them
+ *    to a live subscription (for NATS, the MsgsLimit and BytesLimit pending limits).
+ *  - Changed ConnectionOptions are handed to the vendor implementation (for NATS, the publication backoff and
+ *    flow control options).
+ * Other changes (keys, queue names and sizes, VendorTopicOptions, URLs, vendor and identifiers) are logged
+ * and take effect when the process is restarted.
+ *
+ * Publishing threads never wait for a reload. They read a Topic's disabled flag and cold record, and the
+ * Topic table, through a single pointer or flag; a reload publishes replacements with atomic stores and keeps whatever it
+ * replaced until ndw_CleanupRegistry, so a reader that still holds an old pointer never sees freed memory.
+ * Only lookups by name or identifier and the ndw_GetAll* functions briefly wait while a reload links new
+ * Domains, Connections or Topics into the registry hash tables.
+ *
+ * The file must be a valid registry: errors that make ndw_Init exit also end the process on a reload.
+ * Write it to a temporary file and rename it into place, so the watch never reads a partial file.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @brief Reload the registry from a JSON file and apply the differences to the running registry.
+ * Reloads are serialized; the registry must have been loaded by ndw_Init.
+ *
+ * @param[in] json_path JSON registry, or NULL for NDW_APP_CONFIG_FILE.
+ *
+ * @return Number of changes applied (0 if nothing changed), -1 if no registry is loaded,
+ * -2 if there is no JSON file path, -3 if the JSON file cannot be read or parsed.
+ */
+extern INT_T ndw_ReloadRegistry(const CHAR_T* json_path);
+
+/**
+ * @brief Start a thread that reloads the registry whenever the JSON file changes.
+ * The file is checked every interval_ms and reloaded once it is unchanged for one more interval.
+ * Invoked by ndw_Init when NDW_APP_CONFIG_WATCH_MS is set.
+ *
+ * @param[in] json_path JSON registry to watch.
+ * @param[in] interval_ms Check interval in milliseconds, > 0.
+ *
+ * @return 0 on success, else < 0. Starting an already running watch returns -1.
+ */
+extern INT_T ndw_StartRegistryWatch(const CHAR_T* json_path, LONG_T interval_ms);
+
+/**
+ * @brief Stop the registry watch thread, if running. Invoked by ndw_Shutdown.
+ */
+extern void ndw_StopRegistryWatch();
+
+/**
+ * @brief Free the Topic cold records, options and name value pairs replaced by reloads.
+ * Invoked by ndw_CleanupRegistry.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_FreeRetiredRegistryData();
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_REGISTRY_RELOAD_H */
+
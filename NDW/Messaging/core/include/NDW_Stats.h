@@ -0,0 +1,172 @@
+#ifndef _NDW_STATS_H
+#define _NDW_STATS_H
+
+#include "ndw_types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+/**
+ * @file NDW_Stats.h
+ *
+ * @brief Per Topic message counters, sharded per thread.
+ *
+ * Every thread that updates a counter gets its own shard, and within it each Topic has its own cache line
+ * of counters, so updates are a plain load and store with no lock prefix and no cache line shared between cores.
+ * Readers sum the shards of all threads. Shards are never freed: when a thread exits its shard (with its counts)
+ * is handed to the next new thread, so totals stay correct and readers need no lock.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * Per Topic counters.
+ */
+#define NDW_TOPIC_STAT_PUBLISHED_MSGS           0   // Messages accepted by the vendor for publishing.
+#define NDW_TOPIC_STAT_RECEIVED_MSGS            1   // Messages received, including bad ones.
+#define NDW_TOPIC_STAT_BAD_MSGS_RECEIVED        2   // Messages received whose header could not be parsed.
+#define NDW_TOPIC_STAT_MSGS_COMMITS             3   // Commits of received messages.
+#define NDW_TOPIC_STAT_MSGS_ACKS                4   // Commits that resulted in acks.
+#define NDW_TOPIC_STAT_MSGS_FAILED_ACKS         5   // Commits that resulted in failed acks.
+#define NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS    6   // Messages handed to the vendor messaging system.
+#define NDW_TOPIC_STAT_VENDOR_REQUEST_REPLIES   7   // Replies received for request messages.
+
+/**
+ * @def NDW_TOPIC_STATS_COUNTERS
+ * @brief Number of counters per Topic. 8 counters fill exactly one cache line.
+ */
+#define NDW_TOPIC_STATS_COUNTERS 8
+
+/**
+ * @def NDW_STATS_CHUNK_BITS
+ * @brief Rows of a shard are allocated in chunks of 1 << NDW_STATS_CHUNK_BITS Topics.
+ */
+#define NDW_STATS_CHUNK_BITS 6
+#define NDW_STATS_CHUNK_TOPICS (1 << NDW_STATS_CHUNK_BITS)
+#define NDW_STATS_MAX_CHUNKS 256
+
+/**
+ * @def NDW_STATS_MAX_TOPICS
+ * @brief Maximum number of Topics that can have counters.
+ */
+#define NDW_STATS_MAX_TOPICS (NDW_STATS_CHUNK_TOPICS * NDW_STATS_MAX_CHUNKS)
+
+/**
+ * @struct ndw_TopicStatsRow_T
+ * @brief Counters of one Topic in one thread shard. One cache line.
+ */
+typedef struct ndw_TopicStatsRow
+{
+    _Alignas(64) LONG_T counters[NDW_TOPIC_STATS_COUNTERS];
+} ndw_TopicStatsRow_T;
+
+_Static_assert(sizeof(ndw_TopicStatsRow_T) == 64, "ndw_TopicStatsRow_T must be one cache line");
+
+/**
+ * @struct ndw_StatsShard_T
+ * @brief Counters owned by one thread. Rows are allocated in chunks of NDW_STATS_CHUNK_TOPICS Topics on first use.
+ */
+typedef struct ndw_StatsShard
+{
+    ndw_TopicStatsRow_T* chunks[NDW_STATS_MAX_CHUNKS];
+    struct ndw_StatsShard* next;    // All shards ever created; the list only grows.
+    bool in_use;                    // Owned by a live thread.
+} ndw_StatsShard_T;
+
+/**
+ * @struct ndw_TopicStats_T
+ * @brief Snapshot of all counters of a Topic, indexed by NDW_TOPIC_STAT_*.
+ */
+typedef struct ndw_TopicStats
+{
+    LONG_T counters[NDW_TOPIC_STATS_COUNTERS];
+} ndw_TopicStats_T;
+
+/**
+ * @var extern pthread_key_t ndw_tls_stats_shard
+ * @brief Per thread shard. Created by ndw_StatsInit.
+ */
+extern pthread_key_t ndw_tls_stats_shard;
+
+/**
+ * @brief Create the per thread shard key. Invoked by ndw_Init, and safe to invoke more than once.
+ */
+extern void ndw_StatsInit();
+
+/**
+ * @brief Assign counters to a new Topic. Invoked for every live Topic, including Topics added by a registry reload.
+ *
+ * @return Index to store in the Topic (stats_index), else -1 if NDW_STATS_MAX_TOPICS is reached.
+ *
+ * @note A Topic with stats_index -1 has no counters: ndw_TopicStatsAdd ignores it and readers get 0,
+ *  so call sites do not need to check stats_index.
+ */
+extern INT_T ndw_StatsRegisterTopic();
+
+/**
+ * @brief Slow path of ndw_TopicStatsAdd. Attaches a shard to the calling thread and allocates the row chunk.
+ *
+ * @return Chunk holding the row of stats_index, else NULL.
+ */
+extern ndw_TopicStatsRow_T* ndw_StatsGetChunk(INT_T stats_index);
+
+/**
+ * @brief Current value of one Topic counter summed over all threads.
+ *
+ * @param[in] stats_index Topic stats_index.
+ * @param[in] counter One of NDW_TOPIC_STAT_*.
+ */
+extern LONG_T ndw_TopicStatsGet(INT_T stats_index, INT_T counter);
+
+/**
+ * @brief Current values of all counters of a Topic summed over all threads.
+ *
+ * @param[in] stats_index Topic stats_index.
+ * @param[out] stats Snapshot.
+ */
+extern void ndw_TopicStatsSnapshot(INT_T stats_index, ndw_TopicStats_T* stats);
+
+/**
+ * @brief Name of a counter, for example "received_msgs". Suitable as a metric name.
+ */
+extern const CHAR_T* ndw_TopicStatsName(INT_T counter);
+
+/**
+ * @brief Add to a Topic counter. Only touches the calling thread's shard.
+ *
+ * @param[in] stats_index Topic stats_index. Nothing is counted if it is -1 (Topic without counters).
+ * @param[in] counter One of NDW_TOPIC_STAT_*.
+ * @param[in] value Value to add.
+ */
+static inline void
+ndw_TopicStatsAdd(INT_T stats_index, INT_T counter, LONG_T value)
+{
+    if (__builtin_expect(((UINT_T) stats_index) >= NDW_STATS_MAX_TOPICS, 0))
+        return;
+
+    ndw_StatsShard_T* shard = (ndw_StatsShard_T*) pthread_getspecific(ndw_tls_stats_shard);
+    ndw_TopicStatsRow_T* chunk = (NULL == shard) ? NULL : shard->chunks[stats_index >> NDW_STATS_CHUNK_BITS];
+    if (__builtin_expect(NULL == chunk, 0)) {
+        if (NULL == (chunk = ndw_StatsGetChunk(stats_index)))
+            return;
+    }
+
+    // Only this thread writes the shard; readers load it relaxed.
+    LONG_T* c = &chunk[stats_index & (NDW_STATS_CHUNK_TOPICS - 1)].counters[counter];
+    __atomic_store_n(c, __atomic_load_n(c, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDW_STATS_H */
+
@@ -28,6 +28,10 @@
 #include <cjson/cJSON.h>
 
 #include "ndw_types.h"
+#include "NDW_Clock.h"
+#include "NDW_Histogram.h"
+#include "NDW_Stats.h"
+#include "NDW_Logger.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -360,6 +364,7 @@ extern uint64_t ndw_GetCurrentNanoSeconds();
  * @brief Get current UTC time in nanoseconds.
  *
  * @return Current UTC time in nanoseconds.
+ * @note Uses the TSC clock when it is calibrated. Hot paths should use the inline ndw_ClockNowNanos directly.
  */
 extern ULONG_T ndw_GetCurrentUTCNanoseconds();
 
@@ -570,40 +575,7 @@ extern bool ndw_CounterCheck(ndw_Counter_T* counter, LONG_T check_value, LONGLON
 
 
 // Statistics Utilities
-// Latency Buckets with underflow and overflow slots.
-
-
-/**
- * @struct ndw_LatencyBuckets_T
- * @brief Holds latency bucket information. A crude form of capturing percentile latency metrics.
- *
- * XXX: This needs to be implemented.
- */
-typedef struct ndw_LatencyBuckets
-{
-    LONG_T counter;                 // Number of items added.
-    LONG_T submicro_underflow;      // Underflow bucket.
-    LONG_T microseconds[1000];      // Counters for microseconds level.
-    LONG_T milliseconds[1000];      // Counters for milliseconds level.
-    LONG_T seconds[60];             // Counters for microseconds level.
-    LONG_T seconds_overflow;        // Overflow bucket.
-} ndw_LatencyBuckets_T;
-
-/**
- * @brief Update Latency Bucket structure with a nanoseconds (delta) latency value.
- *
- * @param[in] buckets Latency Bucket data structure Pointer.
- * @param[in] delta_ns Latency metric input in nanoseconds.
- *
- * XXX: This needs to be implemented.
- *
- * @return None.
- *
- * @see ndw_LatencyBuckets_T
- */
-
-void ndw_AddToLatencyTimeBucket(ndw_LatencyBuckets_T* buckets, ULONG_T delta_ns);
-
+// Latency histograms are in NDW_Histogram.h
 
 
 /**
@@ -620,7 +592,7 @@ void ndw_AddToLatencyTimeBucket(ndw_LatencyBuckets_T* buckets, ULONG_T delta_ns)
 
 /**
  * @brief Since message notifications arrive in background thread, it necessitates logging to be MT safe.
- * We use a mutex for each log operation.
+ * We use a mutex for each log operation, unless NDW_LOG_ASYNC selects the asynchronous backend (NDW_Logger.h).
  *
  * @return None.
      */
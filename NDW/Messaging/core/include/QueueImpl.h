@@ -6,9 +6,11 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <time.h>
+#include <stdbool.h>
 
 #include "ndw_types.h"
 #include "NDW_Utils.h"
+#include "QueueWait.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -36,6 +38,30 @@ typedef struct NDW_QData
 
 } NDW_QData_T;
 
+/*
+ * Overflow policy for a Topic asynchronous queue that is full.
+ * Configured with TopicOptions "QueueOverflowPolicy=<name>".
+ */
+#define NDW_QOVERFLOW_DROP_NEWEST 0     // Drop the incoming message (default).
+#define NDW_QOVERFLOW_DROP_OLDEST 1     // Evict the oldest pending message to make room, else drop the incoming one.
+#define NDW_QOVERFLOW_BLOCK 2           // Block the vendor callback thread up to QueueBlockTimeout_us, then drop.
+#define NDW_QOVERFLOW_SPILL 3           // Spill into a bounded local overflow list of QueueSpillSize items, then drop.
+
+#define NDW_QOVERFLOW_DROP_NEWEST_NAME "DropNewest"
+#define NDW_QOVERFLOW_DROP_OLDEST_NAME "DropOldest"
+#define NDW_QOVERFLOW_BLOCK_NAME "Block"
+#define NDW_QOVERFLOW_SPILL_NAME "Spill"
+
+#define NDW_QOVERFLOW_POLICY "QueueOverflowPolicy"
+#define NDW_QOVERFLOW_BLOCK_TIMEOUT_US "QueueBlockTimeout_us"
+#define NDW_QOVERFLOW_SPILL_SIZE "QueueSpillSize"
+
+#define NDW_QOVERFLOW_DEFAULT_BLOCK_TIMEOUT_US 1000
+
+// Returns policy for the name (case insensitive), or -1 if invalid.
+extern INT_T ndw_QOverflowPolicyFromName(const char* name);
+extern const char* ndw_QOverflowPolicyName(INT_T policy);
+
 extern NDW_Q_T* ndw_CreateInboundDataQueue(const char* queue_type, LONG_T max_items);
 extern void ndw_ReleaseInboundDataQueue(NDW_Q_T* Q);
 
@@ -46,11 +72,35 @@ INT_T   ndw_QInsert(NDW_Q_T* Q, void* data);
 INT_T   ndw_QGet(NDW_Q_T* Q, NDW_QData_T* data, LONG_T timeout_us);
 void    ndw_QDeleteCurrent(NDW_Q_T* Q);
 
+// Batch consumption: get up to max_items (returns count, 0 if none, < 0 on error), then delete them all at once.
+// A batch must be deleted with ndw_QDeleteBatch before the next ndw_QGetBatch.
+INT_T   ndw_QGetBatch(NDW_Q_T* Q, NDW_QData_T* data, INT_T max_items, LONG_T timeout_us);
+void    ndw_QDeleteBatch(NDW_Q_T* Q);
+
+// Producer side: drop the oldest item still pending on the producer side (cleanup operator is invoked).
+// Returns 1 if an item was evicted, 0 if queue type or state does not allow it.
+INT_T   ndw_QEvictOldest(NDW_Q_T* Q);
+
 typedef void (*ndw_QueueCleanupOperator)(void* data);
 
 void    ndw_QSetCleanupOperator(NDW_Q_T* Q, ndw_QueueCleanupOperator cleanup_operator);
+// Adaptive consumer wait: spin, then yield, then block (futex) until a producer signals. Negative counts keep defaults.
+void    ndw_QSetWaitStrategy(NDW_Q_T* Q, INT_T spins, INT_T yields, bool block);
 void    ndw_QCleanup(NDW_Q_T* Q);
 void    ndw_QPrintDebug(NDW_Q_T* Q);
+// Number of items inserted and not yet deleted. MT safe; approximate while producers and consumer are active.
+LONG_T  ndw_QSize(NDW_Q_T* Q);
+
+/*
+ * Bounded FIFO overflow (spill) list used when a queue is full. MT safe.
+ */
+typedef struct NDW_QSpill NDW_QSpill_T;
+
+NDW_QSpill_T* ndw_CreateQSpill(LONG_T max_items);
+INT_T   ndw_QSpillAppend(NDW_QSpill_T* spill, void* data);       // 0 on success, -1 if spill is full.
+INT_T   ndw_QSpillDrainInto(NDW_QSpill_T* spill, NDW_Q_T* Q);    // Moves items in order while Q accepts them. Returns count moved.
+LONG_T  ndw_QSpillCount(NDW_QSpill_T* spill);
+void    ndw_QSpillCleanup(NDW_QSpill_T* spill, ndw_QueueCleanupOperator cleanup_operator);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,110 @@
+#ifndef _NDWQUEUEWAIT_H
+#define _NDWQUEUEWAIT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "ndw_types.h"
+
+/**
+ * @file QueueWait.h
+ *
+ * @brief Adaptive consumer wait strategy for the inbound queues.
+ *
+ * When a queue is empty the consumer first spins, then yields the CPU, and finally parks on a futex.
+ * Producers only pay for a wakeup system call when the consumer is actually parked, so the
+ * common (busy) path is a single atomic load for the producer.
+ *
+ * @author Andrena team member
+ * @date 2025-07
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @def NDW_QWAIT_DEFAULT_SPINS
+ * @brief Default number of busy polls of the queue before yielding.
+ */
+#define NDW_QWAIT_DEFAULT_SPINS 128
+
+/**
+ * @def NDW_QWAIT_DEFAULT_YIELDS
+ * @brief Default number of sched_yield() calls before parking on the futex.
+ */
+#define NDW_QWAIT_DEFAULT_YIELDS 8
+
+/**
+ * @def NDW_QWAIT_SPINS
+ * @brief TopicOptions name to configure number of spins for the Topic asynchronous queue.
+ */
+#define NDW_QWAIT_SPINS "QueueWaitSpins"
+
+/**
+ * @def NDW_QWAIT_YIELDS
+ * @brief TopicOptions name to configure number of yields for the Topic asynchronous queue.
+ */
+#define NDW_QWAIT_YIELDS "QueueWaitYields"
+
+/**
+ * @def NDW_QWAIT_BLOCK
+ * @brief TopicOptions name; if "false" the consumer never parks and keeps yielding until the timeout expires.
+ */
+#define NDW_QWAIT_BLOCK "QueueWaitBlock"
+
+/**
+ * @struct ndw_QWait_T
+ * @brief Wait state shared between the producers and the (single) consumer of a queue.
+ */
+typedef struct ndw_QWait
+{
+    atomic_int futex_word;          // Bumped by producers to wake a parked consumer.
+    atomic_int consumer_parked;     // Non zero while consumer is (about to be) parked on futex_word.
+    INT_T spins;                    // Busy polls before yielding.
+    INT_T yields;                   // Yields before parking.
+    bool block;                     // Park on futex, else keep yielding.
+    LONG_T total_wakeups;           // Number of futex wakeups issued by producers.
+    LONG_T total_parks;             // Number of times consumer parked.
+} ndw_QWait_T;
+
+/**
+ * @brief Predicate the consumer uses to check if the queue has items.
+ */
+typedef bool (*ndw_QWaitReady_T)(void* q);
+
+/**
+ * @brief Initialize with default strategy.
+ */
+extern void ndw_QWaitInit(ndw_QWait_T* w);
+
+/**
+ * @brief Configure wait strategy. Negative values leave the current setting unchanged.
+ */
+extern void ndw_QWaitSetStrategy(ndw_QWait_T* w, INT_T spins, INT_T yields, bool block);
+
+/**
+ * @brief Producers invoke this after an item is made visible to the consumer.
+ */
+extern void ndw_QWaitSignal(ndw_QWait_T* w);
+
+/**
+ * @brief Wait until ready(q) is true or timeout_us elapses.
+ *
+ * @param[in] w Wait state.
+ * @param[in] timeout_us Maximum wait in microseconds. If <= 0 ready(q) is checked once.
+ * @param[in] ready Predicate to test if queue has items.
+ * @param[in] q Opaque queue pointer passed to the predicate.
+ *
+ * @return true if queue has items, false on timeout.
+ */
+extern bool ndw_QWaitForItems(ndw_QWait_T* w, LONG_T timeout_us, ndw_QWaitReady_T ready, void* q);
+
+#ifdef __cplusplus
+}
+#endif /* _cplusplus */
+
+#endif /* _NDWQUEUEWAIT_H */
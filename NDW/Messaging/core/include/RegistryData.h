@@ -42,83 +42,139 @@ extern "C"
 
 #include "uthash.h"
 
+/**
+ * @def NDW_HEADER_TEMPLATE_SIZE
+ * @brief Space kept per Topic for a precomputed outbound message header image.
+ */
+#define NDW_HEADER_TEMPLATE_SIZE 64
+
 typedef struct ndw_Connection ndw_Connection_T;
 typedef struct ndw_Topic ndw_Topic_T;
 typedef struct ndw_Domain ndw_Domain_T;
 typedef struct ndw_DomainHandle ndw_DomainHandle_T;
+struct ndw_PublishAck;
+
+/**
+ * @def NDW_TOPIC_CACHE_LINE_SIZE
+ * @brief Cache line size the hot groups of ndw_Topic_T are aligned to.
+ */
+#define NDW_TOPIC_CACHE_LINE_SIZE 64
+
+/**
+ * @def NDW_TOPIC_SLAB_SIZE
+ * @brief Number of Topics allocated together in one contiguous block by ndw_LoadDomains.
+ */
+#define NDW_TOPIC_SLAB_SIZE 64
+
+/**
+ * @struct ndw_TopicCold_T
+ * @brief Configuration of a Topic that is only read while loading the registry or subscribing.
+ * Allocated separately so it never shares cache lines with the hot part of ndw_Topic_T.
+ */
+typedef struct ndw_TopicCold
+{
+    CHAR_T* topic_description;              // Comments and description of this topic.
+    CHAR_T* q_async_name;                   // Asynchronous queue name, if any.
+
+    CHAR_T* topic_options;                  // List of Topic options.
+    NDW_NVPairs_T topic_options_nvpairs;    // Name value data structure to hold Topic options.
+
+    CHAR_T* vendor_topic_options;           // List of Topic options revelant for the Vendor implementation.
+    NDW_NVPairs_T vendor_topic_options_nvpairs; // Name value data structure to hold Topic options revelant to Vendor code.
+
+    // IPv4 (15 bytes), IPv6 (39 bytes), IPv6 with scope zone (46 bytes). So let use 60.
+    CHAR_T  last_received_ip_address[60];   // IP address for which the message arrived.
+} ndw_TopicCold_T;
 
 /**
  * @struct ndw_Topic_T
  * @brief Abstraction to enable encapsulate of a vendor pub-sub messaging Topic. Used for both pub and sub operations.
  * Topics are often referred to as Subjects as well on some messaging system.
  *
+ * Fields are grouped by when they are touched, each group starting on its own cache line:
+ * publish path, receive path, publish header template, per mode counters, and finally identification and
+ * hash table linkage. Rarely read configuration lives in the separately allocated ndw_TopicCold_T.
+ *
  * @note 
  * This is the primary data structure that application developer uses to interact with the abstract messaging layer.
  * Use this for both pub and sub operations.
  */
 typedef struct ndw_Topic
 {
+    // Publish path: read on every outbound message.
+    _Alignas(NDW_TOPIC_CACHE_LINE_SIZE)
+    ndw_Connection_T* connection;           // Back reference to ndw_Connecion_T
+    ndw_Domain_T* domain;                   // Back reference to ndw_Domain_T
+    void* vendor_opaque;                    // Vendor specific implementation data structure
+    CHAR_T* pub_key;                        // Publish Key to use: If not specified defeaults to topic_unique_name.
+    LONG_T sequence_number;                 // A sequencer number app can use to reset and increment.
+    INT_T stats_index;                      // Index of this Topic's message counters, -1 if none (not counted). See NDW_Stats.h.
+    INT_T topic_unique_id;                  // Unique identifier for this topic.
+    INT_T pub_header_template_id;           // Header type of pub_header_template, 0 if not built.
+    INT_T topic_handle;                     // Handle in the Topic table, -1 until it is built. Kept across reloads.
     bool disabled;                          // Is topic enabled or disabled?
     bool is_pub_enabled;                    // Is publish operation enabled on this topic?
     bool is_sub_enabled;                    // Is Subscribe operation enabled on this topic?
     bool durable_topic;                     // Is this topic for a durable subscription?
-    CHAR_T* topic_description;              // Comments and description of this topic.
-    INT_T topic_unique_id;                  // Unique identifier for this topic.
-    CHAR_T* topic_unique_name;              // Unique name for this topic.
-
-    CHAR_T* pub_key;                        // Publish Key to use: If not specified defeaults to topic_unique_name.
-    CHAR_T* sub_key;                        // Subscription key to use: If not specified defeaults to topic_unique_name.
-
     bool q_async_enabled;                   // Is Ansynchronous message queue enabled?
-    char* q_async_name;                     // Asynchronous queue name, if any.
-    int q_async_size;                       // Asynchronous queue size, if configured.
-    NDW_Q_T* q_async;                       // Queue where asynchronous data lands up
-    void* q_async_closure;                  // Queue Closure which holds a Queued Item.
-
-    UT_hash_handle hh_topic_id;             // hash handle for ID-based hash
-    UT_hash_handle hh_topic_name;           // hash handle for name-based hash
-
-    CHAR_T* debug_desc;                     // Holds all information to debug attributes of a Topic that can be logged.
-
-    ndw_Connection_T* connection;           // Back reference to ndw_Connecion_T
-    ndw_Domain_T* domain;                   // Back reference to ndw_Domain_T
-    ndw_DomainHandle_T* domain_handle;      // Back-back reference to ndw_DomainHandle_T
-
-    // XXX: Latency capture to be implemented.
-    ndw_LatencyBuckets_T latency_bucket;    // Latency bucket information for published and subscribed messages.
-    void* app_opaque;                       // Opaque data app can store per topic.
-    void* ndw_opaque;                       // Opaque data the NDW needs to store.
-    void* vendor_opaque;                    // Vendor specific implementation data structure
-
-    CHAR_T* topic_options;                  // List of Topic options.
-    NDW_NVPairs_T topic_options_nvpairs;    // Name value data structure to hold Topic options.
-
-    CHAR_T* vendor_topic_options;           // List of Topic options revelant for the Vendor implementation.
-    NDW_NVPairs_T vendor_topic_options_nvpairs; // Name value data structure to hold Topic options revelant to Vendor code.
-
-    LONG_T sequence_number;                 // A sequencer number app can use to reset and increment.
-    LONG_T total_published_msgs;            // Total published messages on this Topic while the application was running.
-    LONG_T total_received_msgs;             // Total received messages on this Topic while the application was running.
-    LONG_T total_bad_msgs_received;         // Total number of bad messages received on this Topic.
+    bool synchronous_subscription;          // Boolean indicator if this is a synchronous subject subscription.
 
+    // Receive path: written on every inbound message.
+    _Alignas(NDW_TOPIC_CACHE_LINE_SIZE)
     LONG_T last_msg_received_time;          // Last received message timestamp in UTC.
     UCHAR_T* last_msg_header_received;      // Last received message's message header Pointer.
     UCHAR_T* last_msg_received;             // Last received message's message body Pointer.
-    INT_T last_msg_received_size;           // Total number of bad messages received on this Topic.
     void* last_msg_closure;                 // For last message it is an opaque pointer.
     void* last_msg_vendor_closure;          // For last message it is a vendor opaque pointer.
-    
-    // IPv4 (15 bytes), IPv6 (39 bytes), IPv6 with scope zone (46 bytes). So let use 60.
-    CHAR_T  last_received_ip_address[60];               // IP address for which the message arrived.
+    NDW_Q_T* q_async;                       // Queue where asynchronous data lands up
+    void* app_opaque;                       // Opaque data app can store per topic.
+    INT_T last_msg_received_size;           // Size of the last received message body.
+
+    _Alignas(NDW_TOPIC_CACHE_LINE_SIZE)
+    ULONG_T pub_header_template[NDW_HEADER_TEMPLATE_SIZE / sizeof(ULONG_T)]; // LE header with the per Topic constant fields.
+
+    // Touched per message only when the matching feature is in use.
+    _Alignas(NDW_TOPIC_CACHE_LINE_SIZE)
+    // Allocated only when NDW_CAPTURE_LATENCY is set, else NULL.
+    ndw_Histogram_T* latency_histogram;     // Publish (header timestamp) to receive latency of subscribed messages.
+    ndw_Histogram_T* q_async_dwell_histogram; // Time received messages spent in q_async before being polled.
+    LONG_T latency_clock_skew;              // Messages whose header timestamp was ahead of our clock, so not captured.
+
+    int q_async_size;                       // Asynchronous queue size, if configured.
+    int q_async_overflow_policy;            // NDW_QOVERFLOW_* policy applied when q_async is full.
+    void* q_async_closure;                  // Queue Closure which holds a Queued Item.
+    void* q_async_batch_data;               // Scratch NDW_QData_T array used by ndw_PollAsyncQueueBatch.
+    int q_async_batch_capacity;             // Number of entries in q_async_batch_data.
+    LONG_T q_async_block_timeout_us;        // Max time to block vendor thread for NDW_QOVERFLOW_BLOCK.
+    NDW_QSpill_T* q_async_spill;            // Overflow list for NDW_QOVERFLOW_SPILL.
+    LONG_T q_async_dropped_newest;          // Incoming messages dropped as queue (and spill) was full.
+    LONG_T q_async_dropped_oldest;          // Queued messages evicted to make room (NDW_QOVERFLOW_DROP_OLDEST).
+    LONG_T q_async_evict_failures;          // NDW_QOVERFLOW_DROP_OLDEST could not evict, so the newest was dropped.
+    LONG_T q_async_blocked;                 // Inserts that had to block before succeeding (NDW_QOVERFLOW_BLOCK).
+    LONG_T q_async_block_timeouts;          // Blocked inserts that timed out and were dropped.
+    LONG_T q_async_spilled;                 // Messages placed in the spill list (NDW_QOVERFLOW_SPILL).
+
     ULONG_T last_received_durable_ack_sequence;         // For durable subjects the last ack sent by vendor messaging system.
     ULONG_T last_received_durable_ack_global_sequence;  // For durable subject the global ack sequencer number.
     ULONG_T last_received_durable_total_delivered;      // Total number of durable messages delivered to the application.
     ULONG_T last_received_durable_total_pending;        //  Total number of pending messages that should be delivered.
-    LONG_T msgs_commit_count;                          // Number of commits of messages received.
-    LONG_T msgs_ack_count;                             // Number of commits that resulted in acks.
-    LONG_T msgs_failed_ack_count;                      // Number of commits that resulted in failed acks.
 
-    bool synchronous_subscription;                      // Boolean indicator if this is a synchronous subject subscription.
+    void (*publish_ack_handler)(struct ndw_PublishAck* ack, void* closure); // Durable async publish completions.
+    void* publish_ack_closure;                         // Passed back to publish_ack_handler.
+    LONG_T publish_acks;                               // Durable async publishes acknowledged by the broker.
+    LONG_T publish_ack_failures;                       // Durable async publishes that failed or timed out.
+
+    // Identification and registry linkage: used for logging, lookups and setup.
+    _Alignas(NDW_TOPIC_CACHE_LINE_SIZE)
+    CHAR_T* topic_unique_name;              // Unique name for this topic.
+    CHAR_T* sub_key;                        // Subscription key to use: If not specified defeaults to topic_unique_name.
+    CHAR_T* debug_desc;                     // Holds all information to debug attributes of a Topic that can be logged.
+    ndw_DomainHandle_T* domain_handle;      // Back-back reference to ndw_DomainHandle_T
+    void* ndw_opaque;                       // Opaque data the NDW needs to store.
+    ndw_TopicCold_T* cold;                  // Configuration, allocated with the Topic.
+
+    UT_hash_handle hh_topic_id;             // hash handle for ID-based hash
+    UT_hash_handle hh_topic_name;           // hash handle for name-based hash
 
 } ndw_Topic_T;
 
@@ -198,6 +254,7 @@ typedef struct ndw_DomainHandle
     ndw_Domain_T *g_domains_by_name;        // List of domains by domain name.
     ndw_Domain_T *g_domains_by_id;          // List of domains by domain identifier.
     pthread_t creator_thread_id;            // Thread that created this data structure.
+    bool staging;                           // Parsed by ndw_ReloadRegistry for comparison only. See ndw_LoadStagingDomains.
 } ndw_DomainHandle_T;
 
 /**
@@ -254,6 +311,111 @@ extern ndw_DomainHandle_T* ndw_GetDomainHandle();
  */
 extern INT_T ndw_LoadDomains(const CHAR_T* jsonfilenamepath, CHAR_T** domain_names);
 
+/**
+ * @brief Create the global Domain handle. Used by ndw_LoadDomains and ndw_LoadDomainsFromImage.
+ *
+ * @return The new Domain handle, or NULL if it is already set.
+ * @note Application code should NOT call this.
+ */
+extern ndw_DomainHandle_T* ndw_CreateDomainHandle();
+
+/**
+ * @brief Allocate a zeroed Topic with its back references, statistics slot and (if enabled) latency histograms.
+ * Used by ndw_LoadDomains and ndw_LoadDomainsFromImage.
+ *
+ * @param[in] domain Domain of the Topic.
+ * @param[in] conn Connection of the Topic.
+ *
+ * @return The Topic. Exits on allocation failure.
+ * @note Application code should NOT call this.
+ */
+extern ndw_Topic_T* ndw_NewTopic(ndw_Domain_T* domain, ndw_Connection_T* conn);
+
+/**
+ * @brief Parse Domains of a JSON file into a staging registry, separate from the global one.
+ * Topics of a staging registry get no statistics slot, histograms or asynchronous queue.
+ * Used by ndw_ReloadRegistry to compare a changed JSON file with the running registry.
+ *
+ * @param[in] jsonfilenamepath JSON file path name.
+ * @param[in] domain_names NULL terminated list of Domains to parse.
+ * @param[out] ret 0 on success, else the (< 0) return code ndw_LoadDomains would have returned.
+ *
+ * @return The staging Domain handle, else NULL.
+ * @note Application code should NOT call this.
+ */
+extern ndw_DomainHandle_T* ndw_LoadStagingDomains(const CHAR_T* jsonfilenamepath, CHAR_T** domain_names, INT_T* ret);
+
+/**
+ * @brief Free a staging registry returned by ndw_LoadStagingDomains.
+ *
+ * @param[in] dh Staging Domain handle; ignored if NULL or not a staging handle.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_FreeStagingDomains(ndw_DomainHandle_T* dh);
+
+/**
+ * @brief Create a Topic of the running registry from a staged Topic, taking over its strings and configuration,
+ * and create its asynchronous queue if configured. The Topic is not linked into the Connection's hash tables.
+ *
+ * @param[in] domain Domain of the new Topic.
+ * @param[in] conn Connection of the new Topic.
+ * @param[in] staged Topic of a staging registry. Left with empty strings, to be freed with its registry.
+ *
+ * @return The Topic. Exits on allocation failure.
+ * @note Application code should NOT call this.
+ */
+extern ndw_Topic_T* ndw_AdoptStagedTopic(ndw_Domain_T* domain, ndw_Connection_T* conn, ndw_Topic_T* staged);
+
+/**
+ * @brief Move a Connection of a staging registry to a Domain of the running registry, replacing its Topics with
+ * ones created by ndw_AdoptStagedTopic. The Connection is not linked into the Domain's hash tables.
+ *
+ * @param[in] domain Domain of the running registry.
+ * @param[in] staged Connection of a staging registry; unlinked from it.
+ *
+ * @return The Connection.
+ * @note Application code should NOT call this.
+ */
+extern ndw_Connection_T* ndw_AdoptStagedConnection(ndw_Domain_T* domain, ndw_Connection_T* staged);
+
+/**
+ * @brief Exclusive access to the registry hash tables, to link new Domains, Connections and Topics.
+ * Lookups by name or identifier and the ndw_GetAll* functions take the same lock for reading.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_LockRegistryForUpdate();
+
+/**
+ * @brief Release the lock taken by ndw_LockRegistryForUpdate.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_UnlockRegistryForUpdate();
+
+/**
+ * @brief Create the asynchronous queue of a Topic from its q_async_name and q_async_size. Exits on failure.
+ *
+ * @param[in] topic Topic data structure.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_CreateTopicAsyncQueue(ndw_Topic_T* topic);
+
+/**
+ * @brief Set the wait strategy and overflow policy of a Topic's asynchronous queue from its Topic options.
+ * Exits on an invalid option.
+ *
+ * @param[in] topic Topic data structure, with q_async created and topic_options_nvpairs parsed.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_ConfigureTopicAsyncQueue(ndw_Topic_T* topic);
+
+/**
+ * @brief Cleanup operator of the Topic asynchronous queues (and their spill lists). Releases one queued item.
+ *
+ * @param[in] item Queued item.
+ * @note Application code should NOT call this.
+ */
+extern void ndw_QAsync_CleanupOperator(void* item);
+
 /**
  * @brief Given a Domain identifier return Domain data structure.
  *
@@ -475,6 +637,106 @@ extern INT_T ndw_GetConnectionDomain(const CHAR_T* method_name, bool force_exit,
 
 
 
+/**
+ * @def NDW_INVALID_TOPIC_HANDLE
+ * @brief Returned by ndw_GetTopicHandle for an unknown path.
+ */
+#define NDW_INVALID_TOPIC_HANDLE (-1)
+
+/**
+ * @struct ndw_TopicTableEntry_T
+ * @brief One Topic in the Topic table.
+ */
+typedef struct ndw_TopicTableEntry
+{
+    ndw_Topic_T* topic;
+    ULONG_T path_hash;                      // Hash of path, checked before comparing the path.
+    const CHAR_T* path;                     // Domain^Connection^Topic, stored in the table's paths block.
+    INT_T path_length;
+} ndw_TopicTableEntry_T;
+
+/**
+ * @struct ndw_TopicTable_T
+ * @brief Read-only index of all Topics, built at the end of ndw_LoadDomains and rebuilt by ndw_ReloadRegistry.
+ *
+ * Topics are numbered densely from 0 in the order of their full path. The handle indexes entries directly.
+ * A rebuild keeps the handle of every Topic that already had one and numbers new Topics after them,
+ * then publishes the new table atomically. Replaced tables are kept until ndw_CleanupTopicTable,
+ * so a thread still reading one is never left with freed memory.
+ * Full paths are resolved with a perfect hash (hash and displace): the bucket of a path hash gives a seed,
+ * and the seed with the path hash gives a slot holding the handle. A lookup therefore computes one hash, reads
+ * one seed and one slot, and compares one path, with no allocation or chaining.
+ */
+typedef struct ndw_TopicTable
+{
+    INT_T num_topics;
+    ndw_TopicTableEntry_T* entries;         // Indexed by handle.
+    UINT_T num_buckets;                     // Power of 2.
+    UINT_T* seeds;                          // Seed per bucket.
+    UINT_T num_slots;                       // Power of 2.
+    INT_T* slots;                           // Handle per slot, NDW_INVALID_TOPIC_HANDLE if unused.
+    CHAR_T* paths;                          // All full paths, NUL terminated, one after the other.
+    struct ndw_TopicTable* replaced;        // Table this one replaced, freed with it.
+} ndw_TopicTable_T;
+
+/**
+ * @var extern ndw_TopicTable_T* ndw_g_topic_table
+ * @brief Current Topic table, NULL before ndw_LoadDomains. Read with ndw_GetTopicTable.
+ */
+extern ndw_TopicTable_T* ndw_g_topic_table;
+
+/**
+ * @brief Build the Topic table from the registry and set the topic_handle of every Topic.
+ * Invoked by ndw_LoadDomains and ndw_ReloadRegistry.
+ *
+ * @return 0 on success, else < 0.
+ */
+extern INT_T ndw_BuildTopicTable();
+
+/**
+ * @brief Free the Topic table and the tables it replaced. Invoked by ndw_CleanupRegistry.
+ */
+extern void ndw_CleanupTopicTable();
+
+/**
+ * @brief Resolve a full path to a Topic handle. Does not allocate memory.
+ *
+ * @param[in] path full path of Topic hierarchy. Example: Domain^Connection^Topic.
+ *
+ * @return Topic handle, else NDW_INVALID_TOPIC_HANDLE.
+ *
+ * @note Resolve once, then use ndw_GetTopicByHandle on every publish.
+ */
+extern INT_T ndw_GetTopicHandle(const CHAR_T* path);
+
+/**
+ * @brief Total number of Topics in the Topic table. Valid handles are 0 to ndw_GetTopicCount() - 1.
+ */
+extern INT_T ndw_GetTopicCount();
+
+static inline ndw_TopicTable_T*
+ndw_GetTopicTable()
+{
+    return __atomic_load_n(&ndw_g_topic_table, __ATOMIC_ACQUIRE);
+} // end method ndw_GetTopicTable
+
+/**
+ * @brief Return the Topic for a handle returned by ndw_GetTopicHandle.
+ *
+ * @param[in] topic_handle Topic handle.
+ *
+ * @return Topic, else NULL if the handle is out of range.
+ */
+static inline ndw_Topic_T*
+ndw_GetTopicByHandle(INT_T topic_handle)
+{
+    ndw_TopicTable_T* table = ndw_GetTopicTable();
+    if ((NULL == table) || (((UINT_T) topic_handle) >= ((UINT_T) table->num_topics)))
+        return NULL;
+
+    return table->entries[topic_handle].topic;
+} // end method ndw_GetTopicByHandle
+
 /**
  * @brief Cleans up all data structures for Domains, Connections and frees them.
  *
@@ -26,6 +26,7 @@
 #include "NDW_Utils.h"
 #include "RegistryData.h"
 #include "MsgHeaders.h"
+#include "NDW_Metrics.h"
 
 /**
  * @file VendorImpl.h
@@ -158,6 +159,10 @@ typedef struct ndw_ImplAPI
 
     INT_T (*ProcessConfiguration)(ndw_Topic_T* topic);
 
+    // Optional (may be NULL): check the vendor configuration of a Topic staged by ndw_ReloadRegistry before it is
+    // added to connection. Returns 0 if ProcessConfiguration would accept it, else < 0. Must not change anything.
+    INT_T (*ValidateTopicConfiguration)(ndw_Topic_T* topic, ndw_Connection_T* connection);
+
     INT_T (*Connect)(ndw_Connection_T* connection);
     INT_T (*Disconnect)(ndw_Connection_T* connection);
     bool (*IsConnected)(ndw_Connection_T* connection);
@@ -165,6 +170,7 @@ typedef struct ndw_ImplAPI
     bool (*IsDraining)(ndw_Connection_T* connection);
 
     INT_T (*PublishMsg)();
+    INT_T (*PublishMsgBatch)(ndw_PublishBatchItem_T* items, INT_T count, INT_T vendor_id, LONG_T flush_timeout_ms);
 
     INT_T (*SubscribeAsync)(ndw_Topic_T* topic);
     INT_T (*Unsubscribe)(ndw_Topic_T* topic);
@@ -182,8 +188,19 @@ typedef struct ndw_ImplAPI
 
     INT_T (*CommitQueuedMsg)(ndw_Topic_T* topic, void* vendor_closure);
 
+    INT_T (*CommitQueuedMsgBatch)(ndw_Topic_T* topic, void** vendor_closures, INT_T count);
+
     INT_T (*CleanupQueuedMsg)(ndw_Topic_T* topic, void* vendor_closure);
 
+    // Optional (may be NULL): fill in the vendor_* fields of a statistics snapshot. Invoked from a monitoring thread.
+    void (*GetTopicMetrics)(ndw_Topic_T* topic, ndw_TopicMetrics_T* metrics);
+    void (*GetConnectionMetrics)(ndw_Connection_T* connection, ndw_ConnectionMetrics_T* metrics);
+
+    // Optional (may be NULL): invoked by ndw_ReloadRegistry for a Topic it added or whose TopicOptions changed,
+    // and for a Connection whose ConnectionOptions changed, to apply what can be applied without reconnecting.
+    INT_T (*ReloadTopic)(ndw_Topic_T* topic);
+    INT_T (*ReloadConnection)(ndw_Connection_T* connection);
+
 } ndw_ImplAPI_T;
 
 /**
@@ -198,6 +215,26 @@ typedef struct ndw_ImplAPI
  */
 extern ndw_ImplAPI_T* get_Implementation_API(INT_T vendor_id);
 
+/**
+ * @brief Let the vendor implementation process the configuration of a Topic, and set the cleanup operator of its
+ * asynchronous queue. Invoked by ndw_Init for every Topic and by ndw_ReloadRegistry for every Topic it adds.
+ *
+ * @param[in] topic Topic data structure.
+ *
+ * @return 0 on success, else < 0 if the vendor rejected the Topic configuration (the Topic is then disabled).
+ */
+extern INT_T ndw_ProcessTopicConfiguration(ndw_Topic_T* topic);
+
+/**
+ * @brief Check the vendor configuration of a Topic staged by ndw_ReloadRegistry, before it is added to connection.
+ *
+ * @param[in] staged Staged Topic data structure.
+ * @param[in] connection Connection the Topic would be added to.
+ *
+ * @return 0 if the vendor accepts the configuration (or has no check), else < 0.
+ */
+extern INT_T ndw_ValidateTopicConfiguration(ndw_Topic_T* staged, ndw_Connection_T* connection);
+
 /**
  * @var extern ndw_ImplAPI impl_api
  * @brief  Global variable that is the starting address of an array of ndw_ImplAPI_T.
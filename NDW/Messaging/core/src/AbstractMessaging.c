@@ -1,6 +1,8 @@
 
 #include "VendorImpl.h"
+#include "MsgHeader_1.h"
 #include "AbstractMessaging.h"
+#include "NDW_RegistryImage.h"
 
 
 // Setting this greater than zero will trigger verbose output.
@@ -81,6 +83,91 @@ ndw_QAsync_CleanupOperator(void* item)
     free(q_item);
 } // end method ndw_QAsync_CleanupOperator
 
+// Blocking deadlines use CLOCK_MONOTONIC: the messaging clock follows realtime, which can step or slew.
+static ULONG_T
+ndw_QAsync_MonotonicNanoseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((ULONG_T) ts.tv_sec * 1000000000UL) + (ULONG_T) ts.tv_nsec;
+} // end method ndw_QAsync_MonotonicNanoseconds
+
+/*
+ * Insert into Topic asynchronous queue, applying the Topic overflow policy if the queue is full.
+ * Invoked on vendor callback thread(s). Returns 0 if queued (or spilled), else < 0 if message was dropped.
+ */
+static INT_T
+ndw_QAsync_Insert(ndw_Topic_T* t, ndw_QAsync_Item_T* q_item)
+{
+    NDW_Q_T* Q = t->q_async;
+
+    // Keep order once we started spilling: new messages go behind the spilled ones.
+    if ((NULL != t->q_async_spill) && (ndw_QSpillCount(t->q_async_spill) > 0)) {
+        if (0 == ndw_QSpillAppend(t->q_async_spill, q_item)) {
+            __atomic_fetch_add(&t->q_async_spilled, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+        goto drop_newest;
+    }
+
+    if (0 == ndw_QInsert(Q, q_item))
+        return 0;
+
+    switch (t->q_async_overflow_policy)
+    {
+        case NDW_QOVERFLOW_DROP_OLDEST:
+            if (ndw_QEvictOldest(Q) > 0) {
+                __atomic_fetch_add(&t->q_async_dropped_oldest, 1, __ATOMIC_RELAXED);
+                if (0 == ndw_QInsert(Q, q_item))
+                    return 0;
+            }
+            else if (1 == __atomic_add_fetch(&t->q_async_evict_failures, 1, __ATOMIC_RELAXED)) {
+                // Queue type (or state) does not allow eviction; the message below is dropped instead.
+                NDW_LOGERR("*** WARNING: Cannot evict from asynchronous queue<%s>, %s drops the newest messages "
+                            "for %s\n", t->cold->q_async_name, ndw_QOverflowPolicyName(t->q_async_overflow_policy),
+                            t->debug_desc);
+            }
+            break;
+
+        case NDW_QOVERFLOW_BLOCK:
+        {
+            ULONG_T deadline = ndw_QAsync_MonotonicNanoseconds() + (ULONG_T) t->q_async_block_timeout_us * 1000UL;
+            LONG_T sleep_ns = 1000;
+            while (ndw_QAsync_MonotonicNanoseconds() < deadline) {
+                struct timespec delay = { .tv_sec = 0, .tv_nsec = sleep_ns };
+                nanosleep(&delay, NULL);
+                if (0 == ndw_QInsert(Q, q_item)) {
+                    __atomic_fetch_add(&t->q_async_blocked, 1, __ATOMIC_RELAXED);
+                    return 0;
+                }
+                if (sleep_ns < 100000)
+                    sleep_ns *= 2;
+            }
+            __atomic_fetch_add(&t->q_async_block_timeouts, 1, __ATOMIC_RELAXED);
+            break;
+        }
+
+        case NDW_QOVERFLOW_SPILL:
+            if ((NULL != t->q_async_spill) && (0 == ndw_QSpillAppend(t->q_async_spill, q_item))) {
+                __atomic_fetch_add(&t->q_async_spilled, 1, __ATOMIC_RELAXED);
+                return 0;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+drop_newest:
+    if (1 == __atomic_add_fetch(&t->q_async_dropped_newest, 1, __ATOMIC_RELAXED)) {
+        NDW_LOGERR("*** WARNING: Asynchronous queue is full, dropping messages (policy<%s>) for %s\n",
+                    ndw_QOverflowPolicyName(t->q_async_overflow_policy), t->debug_desc);
+    }
+
+    ndw_QAsync_CleanupOperator(q_item);
+    return -1;
+} // end method ndw_QAsync_Insert
+
 /*
  * We keep track of the last message received on a Synchronous poll.
  * And we free it on subsequent invocations to Synchronous poll.
@@ -224,6 +311,29 @@ ndw_initialize_API_Implementations()
 
 } // end method ndw_initialize_API_Implementations()
 
+INT_T
+ndw_ProcessTopicConfiguration(ndw_Topic_T* topic)
+{
+    ndw_ImplAPI_T* impl = &ndw_impl_api_structure[topic->connection->vendor_id];
+    INT_T ret_code = impl->ProcessConfiguration(topic);
+
+    if (topic->q_async_enabled) {
+        ndw_QSetCleanupOperator(topic->q_async, ndw_QAsync_CleanupOperator);
+    }
+
+    return ret_code;
+} // end method ndw_ProcessTopicConfiguration
+
+INT_T
+ndw_ValidateTopicConfiguration(ndw_Topic_T* staged, ndw_Connection_T* connection)
+{
+    ndw_ImplAPI_T* impl = &ndw_impl_api_structure[connection->vendor_id];
+    if (NULL == impl->ValidateTopicConfiguration)
+        return 0;
+
+    return impl->ValidateTopicConfiguration(staged, connection);
+} // end method ndw_ValidateTopicConfiguration
+
 static void
 ndw_ProcessVendorConfigurations()
 {
@@ -274,10 +384,9 @@ ndw_ProcessVendorConfigurations()
             {
                 ndw_Topic_T* t = topics[k];
                 NDW_LOG("\n\n> [%d] %s\n", k, t->debug_desc);
-                impl->ProcessConfiguration(t);
-
-                if (t->q_async_enabled) {
-                    ndw_QSetCleanupOperator(t->q_async, ndw_QAsync_CleanupOperator);
+                if (0 != ndw_ProcessTopicConfiguration(t)) {
+                    NDW_LOGERR("*** FATAL ERROR: Invalid vendor configuration for %s\n", t->debug_desc);
+                    ndw_exit(EXIT_FAILURE);
                 }
             } // Loop Topics
 
@@ -407,6 +516,9 @@ ndw_Init()
 
     NDW_LOGX("NDW_VERBOSE = %d\n", ndw_verbose);
 
+    ndw_ClockInit();
+    ndw_StatsInit();
+
     const CHAR_T* config_file_path = getenv(NDW_APP_CONFIG_FILE);
     if ((NULL == config_file_path) ||  ('\0' == *config_file_path)) {
         NDW_LOGERR( "Env Variable <%s> NOT set!\n", NDW_APP_CONFIG_FILE);
@@ -466,11 +578,29 @@ ndw_Init()
         return -4;
     }
 
-    ret = ndw_LoadDomains(config_file_path, domains);
+    // A precompiled registry image is used when set and consistent with the JSON file, else the JSON file is parsed.
+    const CHAR_T* config_image_path = getenv(NDW_APP_CONFIG_IMAGE);
+    ret = -1;
+    if ((NULL != config_image_path) && ('\0' != *config_image_path)) {
+        NDW_LOGX("%s = <%s>\n", NDW_APP_CONFIG_IMAGE, config_image_path);
+        ret = ndw_LoadDomainsFromImage(config_image_path, config_file_path, domains);
+        if ((0 != ret) && (ret >= -4)) {
+            NDW_LOGERR( "*** WARNING: Cannot use registry image <%s> (return code <%d>); parsing <%s>\n",
+                        config_image_path, ret, config_file_path);
+        } else if (0 != ret) {
+            NDW_LOGERR( "*** ERROR: FAILED to load registry image <%s> with return code <%d>\n",
+                        config_image_path, ret);
+            return -5;
+        }
+    }
+
     if (0 != ret) {
-        NDW_LOGERR( "*** ERROR: FAILED to load or parse <%s> with return code <%d>\n",
-                    config_file_path, ret);
-        return -5;
+        ret = ndw_LoadDomains(config_file_path, domains);
+        if (0 != ret) {
+            NDW_LOGERR( "*** ERROR: FAILED to load or parse <%s> with return code <%d>\n",
+                        config_file_path, ret);
+            return -5;
+        }
     }
 
     if (ndw_verbose) {
@@ -545,10 +675,47 @@ ndw_Init()
             ndw_bad_message_callback_ptr(&bad_msg);
     }
 
+    const CHAR_T* p_metrics_port = getenv(NDW_METRICS_PORT);
+    const CHAR_T* p_metrics_file = getenv(NDW_METRICS_FILE);
+    const CHAR_T* p_metrics_interval = getenv(NDW_METRICS_INTERVAL_MS);
+    INT_T metrics_port = ((NULL != p_metrics_port) && ('\0' != *p_metrics_port)) ? atoi(p_metrics_port) : 0;
+    LONG_T metrics_interval_ms = ((NULL != p_metrics_interval) && ('\0' != *p_metrics_interval)) ? atol(p_metrics_interval) : 0;
+    if (0 != ndw_MetricsExporterStart(metrics_port, p_metrics_file, metrics_interval_ms)) {
+        NDW_LOGERR( "*** WARNING: Metrics exporter NOT started for %s<%s> %s<%s>\n",
+                NDW_METRICS_PORT, (NULL == p_metrics_port) ? "" : p_metrics_port,
+                NDW_METRICS_FILE, (NULL == p_metrics_file) ? "" : p_metrics_file);
+    }
+
+    const CHAR_T* p_watch_ms = getenv(NDW_APP_CONFIG_WATCH_MS);
+    LONG_T watch_ms = ((NULL != p_watch_ms) && ('\0' != *p_watch_ms)) ? atol(p_watch_ms) : 0;
+    if ((watch_ms > 0) && (0 != ndw_StartRegistryWatch(config_file_path, watch_ms))) {
+        NDW_LOGERR( "*** WARNING: Registry watch NOT started for %s<%s>\n", NDW_APP_CONFIG_WATCH_MS, p_watch_ms);
+    }
+
     return 0;
 
 } // end method NDW_Init
 
+// Precompute the LE header image of every Topic on the Connection, so publishing only patches per message fields.
+static void
+ndw_BuildHeaderTemplates(ndw_Connection_T* connection)
+{
+    INT_T total_topics = 0;
+    ndw_Topic_T** topics = ndw_GetAllTopicsFromConnection(connection, &total_topics);
+    if ((NULL == topics) || (total_topics <= 0)) {
+        free(topics);
+        return;
+    }
+
+    for (INT_T i = 0; i < total_topics; i++) {
+        ndw_Topic_T* topic = topics[i];
+        if ((! topic->disabled) && topic->is_pub_enabled)
+            ndw_MsgHeader1_BuildTemplate(topic);
+    }
+
+    free(topics);
+} // end method ndw_BuildHeaderTemplates
+
 INT_T
 ndw_Connect(const CHAR_T* domain_name, const CHAR_T* connection_name)
 {
@@ -574,6 +741,9 @@ ndw_Connect(const CHAR_T* domain_name, const CHAR_T* connection_name)
     }
 
     INT_T ret_code = ndw_impl_api[impl_id].Connect(connection);
+    if (ret_code >= 0)
+        ndw_BuildHeaderTemplates(connection);
+
     return ret_code;
 } // end method ndw_Connect
 
@@ -862,6 +1032,10 @@ ndw_Shutdown()
         ndw_exit(EXIT_FAILURE);
     }
 
+    // Before tearing down queues and connections the exporter and a registry reload read.
+    ndw_StopRegistryWatch();
+    ndw_MetricsExporterStop();
+
     INT_T total_domains = 0;
     ndw_Domain_T** domains = ndw_GetAllDomains(&total_domains);
 
@@ -904,6 +1078,11 @@ ndw_Shutdown()
                             ndw_Topic_T* t = topics[k];
                             impl->Unsubscribe(t);
 
+                            if (NULL != t->q_async_spill) {
+                                ndw_QSpillCleanup(t->q_async_spill, ndw_QAsync_CleanupOperator);
+                                t->q_async_spill = NULL;
+                            }
+
                             if (NULL != t->q_async) {
                                 ndw_QCleanup(t->q_async);
                                 free(t->q_async);
@@ -943,6 +1122,8 @@ ndw_Shutdown()
 
     ndw_ThreadExit(); // Destroy all per thread data structures.
 
+    ndw_ClockShutdown();
+
     NDW_LOGX("\n\n===> END: ndw_Shutdown() ...\n\n");
 
     ndw_DestroyThreadSafeLogger();
@@ -953,13 +1134,13 @@ ndw_Shutdown()
 
 } // end method ndw_Shutdown
 
-// NOTE: msg can be NULL, and in that case set msg_size to zero too.
-ndw_OutMsgCxt_T*
-ndw_CreateOutMsgCxt(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format, UCHAR_T* msg, INT_T msg_size)
+// Validate the parameters of an outgoing message. Returns the header size, else < 0.
+static INT_T
+ndw_ValidateOutMsg(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format, UCHAR_T* msg, INT_T msg_size)
 {
     if (NULL == topic) {
         NDW_LOGERR( "*** ERROR: NULL ndw_Topic parameter!\n");
-        return NULL;
+        return -1;
     }
 
     ndw_Connection_T* conn = topic->connection;
@@ -976,28 +1157,24 @@ ndw_CreateOutMsgCxt(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_form
 
     if ((header_id <= 0) || (header_id > NDW_MAX_HEADER_TYPES))  {
         NDW_LOGERR( "*** ERROR: Invalid header_id <%d> specified and for %s!\n", header_id, topic->debug_desc);
-        return NULL;
+        return -2;
     }
 
     if (msg_size < 0) {
         NDW_LOGERR( "*** ERROR: Invalid msg_size<%d> with header_id<%d> and for %s\n", msg_size, header_id, topic->debug_desc);
-        return NULL;
+        return -3;
     }
 
     if ((0 == msg_size) && (NULL != msg)) {
         NDW_LOGERR( "*** ERROR: Invalid msg_size <%d> for NULL msg parameter with header_id <%d> and for %s\n",
             msg_size, header_id, topic->debug_desc);
-        return NULL;
-    }
-
-    if (0 == msg_size) {
-        msg = NULL;
+        return -4;
     }
 
     if (msg_size > NDW_MAX_MESSAGE_SIZE) {
         NDW_LOGERR( "*** ERROR: Too big a msg_size specified <%d> Max Possible<%d>. Request for header_id <%d> and for %s\n",
             msg_size, NDW_MAX_MESSAGE_SIZE, header_id, topic->debug_desc);
-        return NULL;
+        return -5;
     }
 
     if ((msg_encoding_format < 1) || (msg_encoding_format > NDW_MAX_ENCODING_FORMAT)) {
@@ -1013,26 +1190,51 @@ ndw_CreateOutMsgCxt(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_form
         ndw_exit(EXIT_FAILURE);
     }
 
-    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
-    if (NULL == cxt) {
-            NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt() return NULL for header_id <%d> with msg_size <%d> and for%s\n",
-                        header_id, msg_size, topic->debug_desc);
-            cxt = NULL;
-
-        ndw_exit(EXIT_FAILURE);
-    }
+    return header_size;
+} // end method ndw_ValidateOutMsg
 
+// Reset the per thread context for a new outgoing message. The header and body addresses are set by the caller.
+static void
+ndw_InitOutMsgCxt(ndw_OutMsgCxt_T* cxt, ndw_Topic_T* topic, INT_T header_id, INT_T header_size,
+                    INT_T msg_encoding_format, INT_T msg_size)
+{
     memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
 
     cxt->app_id = ndw_app_id;
     cxt->topic = topic;
-    cxt->connection = conn;
-    cxt->domain = domain;
+    cxt->connection = topic->connection;
+    cxt->domain = topic->domain;
     cxt->vendor_opaque = (ULONG_T*) NULL;
     cxt->header_id = header_id;
     cxt->header_size = header_size;
     cxt->message_size = msg_size;
     cxt->encoding_format = msg_encoding_format;
+} // end method ndw_InitOutMsgCxt
+
+// NOTE: msg can be NULL, and in that case set msg_size to zero too.
+// If msg is NULL and msg_size > 0 the body is left for the caller to fill in; it is zeroed unless zero_copy is set.
+static ndw_OutMsgCxt_T*
+ndw_CreateOutMsgCxt_Internal(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format,
+                                UCHAR_T* msg, INT_T msg_size, bool zero_copy)
+{
+    INT_T header_size = ndw_ValidateOutMsg(topic, header_id, msg_encoding_format, msg, msg_size);
+    if (header_size < 0)
+        return NULL;
+
+    if (0 == msg_size) {
+        msg = NULL;
+    }
+
+    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
+    if (NULL == cxt) {
+            NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt() return NULL for header_id <%d> with msg_size <%d> and for%s\n",
+                        header_id, msg_size, topic->debug_desc);
+            cxt = NULL;
+
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    ndw_InitOutMsgCxt(cxt, topic, header_id, header_size, msg_encoding_format, msg_size);
 
     INT_T ret_code = ndw_GetMsgHeaderAndBody(cxt);
     if (ret_code < 0) {
@@ -1089,13 +1291,65 @@ ndw_CreateOutMsgCxt(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_form
         ndw_exit(EXIT_FAILURE);
     }
 
-    if ((msg_size > 0) && (NULL != msg)) {
-        memcpy(cxt->message_address, msg, msg_size);
+    if (msg_size > 0) {
+        if (NULL != msg)
+            memcpy(cxt->message_address, msg, msg_size);
+        else if (! zero_copy)
+            memset(cxt->message_address, 0, msg_size);
     }
 
     return cxt;
+} // end method ndw_CreateOutMsgCxt_Internal
+
+ndw_OutMsgCxt_T*
+ndw_CreateOutMsgCxt(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format, UCHAR_T* msg, INT_T msg_size)
+{
+    return ndw_CreateOutMsgCxt_Internal(topic, header_id, msg_encoding_format, msg, msg_size, false);
 } // end method ndw_CreateOutMsgCxt
 
+UCHAR_T*
+ndw_ReserveOutMsg(ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format, INT_T max_msg_size)
+{
+    if (max_msg_size <= 0) {
+        NDW_LOGERR( "*** ERROR: Invalid max_msg_size<%d> to reserve for header_id<%d> and for %s\n",
+                    max_msg_size, header_id, (NULL == topic) ? "NULL Topic" : topic->debug_desc);
+        return NULL;
+    }
+
+    ndw_OutMsgCxt_T* cxt = ndw_CreateOutMsgCxt_Internal(topic, header_id, msg_encoding_format, NULL, max_msg_size, true);
+    if (NULL == cxt)
+        return NULL;
+
+    cxt->reserved_size = max_msg_size;
+    return cxt->message_address;
+} // end method ndw_ReserveOutMsg
+
+INT_T
+ndw_PublishReservedMsg(INT_T msg_size)
+{
+    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
+    if (NULL == cxt) {
+        NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt(): returned NULL!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (cxt->reserved_size <= 0) {
+        NDW_LOGERR( "*** ERROR: No message body was reserved. Invoke ndw_ReserveOutMsg(...) first!\n");
+        memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+        return -1;
+    }
+
+    if ((msg_size <= 0) || (msg_size > cxt->reserved_size)) {
+        NDW_LOGERR( "*** ERROR: msg_size<%d> must be > 0 and NOT more than reserved_size<%d> for %s\n",
+                    msg_size, cxt->reserved_size, (NULL == cxt->topic) ? "?" : cxt->topic->debug_desc);
+        memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+        return -2;
+    }
+
+    cxt->message_size = msg_size;
+    return ndw_PublishMsg();
+} // end method ndw_PublishReservedMsg
+
 INT_T
 ndw_ConvertHeaderToLE(ndw_OutMsgCxt_T* cxt)
 {
@@ -1150,6 +1404,9 @@ ndw_ConvertHeaderToLE(ndw_OutMsgCxt_T* cxt)
         ndw_exit(EXIT_FAILURE);
     }
 
+    if (cxt->header_is_le)
+        return 0; // Built from the per Topic LE template.
+
     INT_T ret_code = ndw_MsgHeaderImpl[header_id].ConvertToLE((UCHAR_T*) header_address);
 
     if (0 != ret_code) {
@@ -1165,18 +1422,11 @@ ndw_ConvertHeaderToLE(ndw_OutMsgCxt_T* cxt)
     return ret_code;
 } // end method ndw_ConvertHeaderToLE
 
-// Send message to a Topic (Subject).
-// It will use the ndw_OutMsgCxt_T* built by invoking ndw_CreateOutMsgCxt(...) method.
-// Returns 0 on success.
-INT_T
-ndw_PublishMsg()
+// Validate the context and build the header fields in LE wire format.
+// Returns 0 when the message is ready to be handed to the vendor, 1 if the Topic is disabled, else < 0.
+static INT_T
+ndw_StampOutMsg(ndw_OutMsgCxt_T* cxt)
 {
-    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
-    if (NULL == cxt) {
-        NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt(): returned NULL!\n");
-        ndw_exit(EXIT_FAILURE);
-    }
-
     ndw_Topic_T* t = cxt->topic;
     if (NULL == t) {
         NDW_LOGERR( "*** WARNING: Topic NOT set!");
@@ -1185,7 +1435,7 @@ ndw_PublishMsg()
     }
 
     if (t->disabled)
-        return 0;
+        return 1;
 
     if (! t->is_pub_enabled) {
         NDW_LOGERR("*** WARNING: Topic is not enabled for Publishing! %s\n", t->debug_desc);
@@ -1232,16 +1482,45 @@ ndw_PublishMsg()
         return -5;
     }
 
-    INT_T vendor_id = conn->vendor_id;
+    return 0;
+} // end method ndw_StampOutMsg
+
+// Send message to a Topic (Subject).
+// It will use the ndw_OutMsgCxt_T* built by invoking ndw_CreateOutMsgCxt(...) method.
+// Returns 0 on success.
+INT_T
+ndw_PublishMsg()
+{
+    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
+    if (NULL == cxt) {
+        NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt(): returned NULL!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    INT_T stamp_code = ndw_StampOutMsg(cxt);
+    if (stamp_code > 0)
+        return 0; // Topic is disabled.
+    if (stamp_code < 0)
+        return stamp_code;
+
+    ndw_Topic_T* t = cxt->topic;
+    INT_T vendor_id = t->connection->vendor_id;
     ndw_ImplAPI_T* impl = &ndw_impl_api_structure[vendor_id];
 
     INT_T ret_code = impl->PublishMsg();
+    if (NDW_PUBLISH_WOULD_BLOCK == ret_code) {
+        memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+        return ret_code; // Flow control, not an error. No logging on this path.
+    }
+
     if (ret_code < 0) {
         NDW_LOGERR( "*** ERROR: FAILED to publish message with ret_code<%d> For %s\n", ret_code, t->debug_desc);
         memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
         return -6;
     }
-        
+
+    ndw_TopicStatsAdd(t->stats_index, NDW_TOPIC_STAT_PUBLISHED_MSGS, 1);
+
     // NOTE: Make sure to zero out message cxt for next message processing!
     memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
 
@@ -1249,6 +1528,269 @@ ndw_PublishMsg()
 
 } // ndw_PublishMsg()
 
+INT_T
+ndw_PublishBatch(ndw_PublishBatchItem_T* items, INT_T count, LONG_T flush_timeout_ms)
+{
+    if ((NULL == items) || (count <= 0)) {
+        NDW_LOGERR("*** ERROR: Invalid parameters items<%p> count<%d>\n", (void*) items, count);
+        return -1;
+    }
+
+    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
+    if (NULL == cxt) {
+        NDW_LOGERR( "*** FATAL ERROR: ndw_GetOutMsgCxt(): returned NULL!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    bool vendor_used[NDW_MAX_API_IMPLEMENTATIONS + 1];
+    memset(vendor_used, 0, sizeof(vendor_used));
+
+    // Stamp every header and lay out all frames back to back in the per thread batch buffer.
+    UCHAR_T* base = NULL;
+    INT_T used = 0;
+    for (INT_T i = 0; i < count; i++)
+    {
+        ndw_PublishBatchItem_T* item = &items[i];
+        item->frame = NULL;
+        item->frame_size = 0;
+        item->ret_code = 0;
+
+        INT_T header_size = ndw_ValidateOutMsg(item->topic, item->header_id, item->msg_encoding_format,
+                                                item->msg, item->msg_size);
+        if (header_size < 0) {
+            item->ret_code = -1;
+            continue;
+        }
+
+        INT_T frame_size = header_size + item->msg_size;
+        INT_T offset = (used + (INT_T) sizeof(ULONG_T) - 1) & ~((INT_T) sizeof(ULONG_T) - 1); // Keep headers aligned.
+        UCHAR_T* new_base = ndw_GetPublishBatchBuffer(offset + frame_size, used);
+        if (NULL == new_base) {
+            NDW_LOGERR("*** ERROR: Failed to get <%d> bytes of publish batch buffer for %s\n",
+                        offset + frame_size, item->topic->debug_desc);
+            item->ret_code = -7;
+            continue;
+        }
+
+        if ((NULL != base) && (new_base != base)) {
+            // Buffer grew; rebase the frames laid out so far.
+            for (INT_T j = 0; j < i; j++) {
+                if (NULL != items[j].frame)
+                    items[j].frame = new_base + (items[j].frame - base);
+            }
+        }
+        base = new_base;
+
+        // Stamp the header in place in the batch buffer, then copy the body right behind it.
+        UCHAR_T* frame = base + offset;
+        ndw_InitOutMsgCxt(cxt, item->topic, item->header_id, header_size, item->msg_encoding_format, item->msg_size);
+        cxt->header_address = (ULONG_T*) frame;
+        cxt->message_address = frame + header_size;
+        cxt->current_allocation_size = frame_size;
+        memset(frame, 0, header_size);
+
+        INT_T stamp_code = ndw_StampOutMsg(cxt);
+        if (0 != stamp_code) {
+            item->ret_code = (stamp_code > 0) ? 0 : stamp_code; // Disabled Topics are silently skipped.
+            memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+            continue; // used is not advanced, so the next frame reuses the space.
+        }
+
+        if (item->msg_size > 0) {
+            if (NULL != item->msg)
+                memcpy(cxt->message_address, item->msg, item->msg_size);
+            else
+                memset(cxt->message_address, 0, item->msg_size);
+        }
+
+        // A variable size header (MsgHeader_2) is stamped at the end of its reservation, right in front of the body.
+        item->frame = (UCHAR_T*) cxt->header_address;
+        item->frame_size = cxt->header_size + item->msg_size;
+        used = offset + frame_size;
+
+        vendor_used[item->topic->connection->vendor_id] = true;
+        memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+    }
+
+    // Hand the frames to each vendor as one batch, with one flush per physical connection.
+    INT_T flush_failures = 0;
+    for (INT_T v = 0; v <= NDW_MAX_API_IMPLEMENTATIONS; v++)
+    {
+        if (! vendor_used[v])
+            continue;
+
+        ndw_ImplAPI_T* impl = &ndw_impl_api_structure[v];
+        if (NULL != impl->PublishMsgBatch) {
+            flush_failures += impl->PublishMsgBatch(items, count, v, flush_timeout_ms);
+            continue;
+        }
+
+        // Vendor has no batch support; publish frames one at a time through the context.
+        for (INT_T i = 0; i < count; i++)
+        {
+            ndw_PublishBatchItem_T* item = &items[i];
+            if ((NULL == item->frame) || (v != item->topic->connection->vendor_id))
+                continue;
+
+            cxt->topic = item->topic;
+            cxt->connection = item->topic->connection;
+            cxt->header_id = item->header_id;
+            cxt->header_size = item->frame_size - item->msg_size; // Size as stamped, not as reserved.
+            cxt->header_address = (ULONG_T*) item->frame;
+            cxt->message_size = item->msg_size;
+            cxt->message_address = item->frame + cxt->header_size;
+            cxt->current_allocation_size = item->frame_size;
+            cxt->loopback_test = item->loopback_test;
+            INT_T publish_code = impl->PublishMsg();
+            item->ret_code = (NDW_PUBLISH_WOULD_BLOCK == publish_code) ? publish_code : ((publish_code < 0) ? -6 : 0);
+            memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+        }
+    }
+
+    INT_T failures = flush_failures;
+    for (INT_T i = 0; i < count; i++) {
+        if ((0 == items[i].ret_code) && (NULL != items[i].frame))
+            ndw_TopicStatsAdd(items[i].topic->stats_index, NDW_TOPIC_STAT_PUBLISHED_MSGS, 1);
+
+        if (items[i].ret_code < 0) {
+            if (NDW_PUBLISH_WOULD_BLOCK != items[i].ret_code)
+                NDW_LOGERR("*** ERROR: Batch item[%d] FAILED with ret_code<%d> for %s\n", i, items[i].ret_code,
+                            (NULL == items[i].topic) ? "NULL Topic" : items[i].topic->debug_desc);
+            ++failures;
+        }
+    }
+
+    return failures;
+} // end method ndw_PublishBatch
+
+INT_T
+ndw_PreparePublisher(ndw_PreparedPublisher_T* pp, ndw_Topic_T* topic, INT_T header_id, INT_T msg_encoding_format)
+{
+    if (NULL == pp) {
+        NDW_LOGERR("*** ERROR: NULL ndw_PreparedPublisher_T parameter!\n");
+        return -1;
+    }
+
+    memset(pp, 0, sizeof(ndw_PreparedPublisher_T));
+
+    if (NULL == topic) {
+        NDW_LOGERR("*** ERROR: NULL ndw_Topic parameter!\n");
+        return -2;
+    }
+
+    if (! topic->is_pub_enabled) {
+        NDW_LOGERR("*** ERROR: Topic is not enabled for Publishing! %s\n", topic->debug_desc);
+        return -3;
+    }
+
+    if ((NULL == topic->connection) || (NULL == topic->domain)) {
+        NDW_LOGERR("*** ERROR: Connection or Domain NOT set for %s\n", topic->debug_desc);
+        return -4;
+    }
+
+    INT_T vendor_id = topic->connection->vendor_id;
+    if ((vendor_id < 1) || (vendor_id >= NDW_MAX_API_IMPLEMENTATIONS) ||
+        (NULL == ndw_impl_api_structure[vendor_id].PublishMsg)) {
+        NDW_LOGERR("*** ERROR: Invalid vendor_id<%d> or no PublishMsg implementation for %s\n", vendor_id, topic->debug_desc);
+        return -5;
+    }
+
+    if ((header_id <= 0) || (header_id > NDW_MAX_HEADER_TYPES) || (! ndw_MsgHeaderImpl[header_id].IsValid(header_id))) {
+        NDW_LOGERR("*** ERROR: Invalid header_id<%d> for %s\n", header_id, topic->debug_desc);
+        return -6;
+    }
+
+    INT_T header_size = ndw_MsgHeaderImpl[header_id].LE_MsgHeaderSize(header_id);
+    if ((header_size <= 0) || (header_size > NDW_MAX_HEADER_SIZE)) {
+        NDW_LOGERR("*** ERROR: Invalid header_size<%d> for header_id<%d> for %s\n", header_size, header_id, topic->debug_desc);
+        return -7;
+    }
+
+    if ((msg_encoding_format < 1) || (msg_encoding_format > NDW_MAX_ENCODING_FORMAT)) {
+        NDW_LOGERR("*** ERROR: Unsupported encoding_format<%d> for %s\n", msg_encoding_format, topic->debug_desc);
+        return -8;
+    }
+
+    pp->topic = topic;
+    pp->connection = topic->connection;
+    pp->domain = topic->domain;
+    pp->vendor_id = vendor_id;
+    pp->vendor_publish = ndw_impl_api_structure[vendor_id].PublishMsg;
+    pp->header_id = header_id;
+    pp->header_size = header_size;
+    pp->encoding_format = msg_encoding_format;
+    pp->prepared = true;
+
+    return 0;
+} // end method ndw_PreparePublisher
+
+INT_T
+ndw_PreparedPublish(ndw_PreparedPublisher_T* pp, UCHAR_T* msg, INT_T msg_size)
+{
+    if ((NULL == pp) || (! pp->prepared)) {
+        NDW_LOGERR("*** ERROR: ndw_PreparedPublisher_T is NULL or NOT prepared! Invoke ndw_PreparePublisher(...) first.\n");
+        return -1;
+    }
+
+#ifdef DEBUG
+    // Debug builds keep every check of the regular path.
+    if (NULL == ndw_CreateOutMsgCxt(pp->topic, pp->header_id, pp->encoding_format, msg, msg_size))
+        return -2;
+
+    return ndw_PublishMsg();
+#else
+    if ((msg_size < 0) || (msg_size > NDW_MAX_MESSAGE_SIZE) || ((msg_size > 0) && (NULL == msg)))
+        return -2;
+
+    ndw_Topic_T* t = pp->topic;
+    if (t->disabled)
+        return 0;
+
+    ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
+    *cxt = (ndw_OutMsgCxt_T) {
+        .app_id = ndw_app_id,
+        .topic = t,
+        .connection = pp->connection,
+        .domain = pp->domain,
+        .header_id = pp->header_id,
+        .header_size = pp->header_size,
+        .message_size = msg_size,
+        .encoding_format = pp->encoding_format
+    };
+
+    if (ndw_GetMsgHeaderAndBody(cxt) < 0) {
+        NDW_LOGERR("*** FATAL ERROR: ndw_GetMsgHeaderAndBody failed for msg_size<%d> for %s\n", msg_size, t->debug_desc);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (msg_size > 0)
+        memcpy(cxt->message_address, msg, msg_size);
+
+    INT_T ret_code = ndw_MsgHeaderImpl[pp->header_id].SetOutMsgFields(cxt);
+    if ((0 == ret_code) && (! cxt->header_is_le))
+        ret_code = ndw_MsgHeaderImpl[pp->header_id].ConvertToLE((UCHAR_T*) cxt->header_address);
+
+    if (0 != ret_code) {
+        NDW_LOGERR("*** ERROR: FAILED to build header_id<%d> with ret_code<%d> for %s\n", pp->header_id, ret_code, t->debug_desc);
+        memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+        return -4;
+    }
+
+    ret_code = pp->vendor_publish();
+    if ((ret_code < 0) && (NDW_PUBLISH_WOULD_BLOCK != ret_code)) {
+        NDW_LOGERR("*** ERROR: FAILED to publish message with ret_code<%d> For %s\n", ret_code, t->debug_desc);
+        ret_code = -6;
+    }
+    else if (ret_code >= 0) {
+        ndw_TopicStatsAdd(t->stats_index, NDW_TOPIC_STAT_PUBLISHED_MSGS, 1);
+    }
+
+    // NOTE: Make sure to zero out message cxt for next message processing!
+    memset(cxt, 0, sizeof(ndw_OutMsgCxt_T));
+    return ret_code;
+#endif
+} // end method ndw_PreparedPublish
+
 INT_T
 ndw_SubscribeAsyncToTopicNames(CHAR_T** topic_names)
 {
@@ -1405,6 +1947,37 @@ ndw_Publish_ResponseForRequestMsg(ndw_Topic_T* topic)
 
 } // end ndw_Publish_ResponseForRequestMsg()
 
+// Record publish to receive latency of a message from its header timestamp.
+// Bad messages and header types without a timestamp are skipped, as are timestamps ahead of our clock
+// (publisher clock skew) which are only counted.
+static inline void
+ndw_CaptureLatency(ndw_Topic_T* topic, ndw_InMsgCxt_T* msginfo, ULONG_T now)
+{
+    if ((NULL == topic->latency_histogram) || msginfo->is_bad || (NULL == msginfo->header_addr))
+        return;
+
+    ULONG_T published = ndw_MsgHeaderImpl[msginfo->header_id].GetTimestamp(msginfo->header_id, msginfo->header_addr);
+    if (0 == published)
+        return;
+
+    if (now < published) {
+        topic->latency_clock_skew += 1;
+        return;
+    }
+
+    ndw_HistogramRecord(topic->latency_histogram, now - published);
+} // end method ndw_CaptureLatency
+
+// Record how long a message waited in the Topic asynchronous queue.
+static inline void
+ndw_CaptureQueueDwell(ndw_Topic_T* topic, ULONG_T insert_time, ULONG_T now)
+{
+    if ((NULL == topic->q_async_dwell_histogram) || (0 == insert_time) || (now < insert_time))
+        return;
+
+    ndw_HistogramRecord(topic->q_async_dwell_histogram, now - insert_time);
+} // end method ndw_CaptureQueueDwell
+
 INT_T
 ndw_GetResponseForRequestMsg(ndw_Topic_T* topic, LONG_T timeout_ms)
 {
@@ -1526,11 +2099,12 @@ ndw_GetResponseForRequestMsg(ndw_Topic_T* topic, LONG_T timeout_ms)
     last_sync_poll_msg->msg_size = msg_length;
     last_sync_poll_msg->vendor_closure = vendor_closure;
 
-    topic->last_msg_received_time = ndw_GetCurrentUTCNanoseconds();
+    topic->last_msg_received_time = ndw_ClockNowNanos();
+    ndw_CaptureLatency(topic, msginfo, topic->last_msg_received_time);
     topic->last_msg_header_received = msginfo->header_addr;
     topic->last_msg_received = msginfo->msg_addr;
     topic->last_msg_received_size = msginfo->msg_size;
-    topic->total_received_msgs += 1;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS, 1);
     topic->last_msg_vendor_closure = vendor_closure;
 
     // NOTE: Make sure to zero out message cxt for next message processing!
@@ -1549,11 +2123,41 @@ ndw_PrintStatsForTopic(ndw_Topic_T* t)
     if (NULL == t)
         return;
 
+    ndw_TopicStats_T stats;
+    ndw_TopicStatsSnapshot(t->stats_index, &stats);
+
     const CHAR_T* spaces = "    ";
     NDW_LOG("%s--> BEGIN: Statistics for %s\n", spaces, t->debug_desc);
-    NDW_LOG("%s  * sequence_number<%ld> total_published_msgs<%ld> total_received_msgs<%ld> "
-                "total_bad_msgs_received <%ld>\n", spaces,
-                t->sequence_number, t->total_published_msgs, t->total_received_msgs, t->total_bad_msgs_received);
+    NDW_LOG("%s  * sequence_number<%ld> published_msgs<%ld> received_msgs<%ld> bad_msgs_received<%ld>\n", spaces,
+                t->sequence_number, stats.counters[NDW_TOPIC_STAT_PUBLISHED_MSGS],
+                stats.counters[NDW_TOPIC_STAT_RECEIVED_MSGS], stats.counters[NDW_TOPIC_STAT_BAD_MSGS_RECEIVED]);
+    if ((stats.counters[NDW_TOPIC_STAT_MSGS_COMMITS] > 0) || (stats.counters[NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS] > 0) ||
+        (stats.counters[NDW_TOPIC_STAT_VENDOR_REQUEST_REPLIES] > 0)) {
+        NDW_LOG("%s  * msgs_commits<%ld> msgs_acks<%ld> msgs_failed_acks<%ld> vendor_published_msgs<%ld> "
+                "vendor_request_replies<%ld>\n", spaces,
+                stats.counters[NDW_TOPIC_STAT_MSGS_COMMITS], stats.counters[NDW_TOPIC_STAT_MSGS_ACKS],
+                stats.counters[NDW_TOPIC_STAT_MSGS_FAILED_ACKS], stats.counters[NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS],
+                stats.counters[NDW_TOPIC_STAT_VENDOR_REQUEST_REPLIES]);
+    }
+    if (t->q_async_enabled) {
+        NDW_LOG("%s  * q_async<%s> overflow_policy<%s> dropped_newest<%ld> dropped_oldest<%ld> evict_failures<%ld> "
+                "blocked<%ld> block_timeouts<%ld> spilled<%ld> spill_pending<%ld>\n", spaces,
+                t->cold->q_async_name, ndw_QOverflowPolicyName(t->q_async_overflow_policy),
+                t->q_async_dropped_newest, t->q_async_dropped_oldest, t->q_async_evict_failures, t->q_async_blocked,
+                t->q_async_block_timeouts, t->q_async_spilled, ndw_QSpillCount(t->q_async_spill));
+    }
+    if ((t->publish_acks > 0) || (t->publish_ack_failures > 0)) {
+        NDW_LOG("%s  * publish_acks<%ld> publish_ack_failures<%ld>\n", spaces,
+                t->publish_acks, t->publish_ack_failures);
+    }
+    if (NULL != t->latency_histogram) {
+        NDW_LOG("%s  * Publish to receive latency: clock_skew<%ld> ", spaces, t->latency_clock_skew);
+        ndw_HistogramPrint(t->latency_histogram, "");
+    }
+    if ((NULL != t->q_async_dwell_histogram) && t->q_async_enabled) {
+        NDW_LOG("%s  * Asynchronous queue dwell time: ", spaces);
+        ndw_HistogramPrint(t->q_async_dwell_histogram, "");
+    }
     NDW_LOG("%s--> END: Statistics for %s\n", spaces, t->debug_desc);
 } // end method ndw_PrintStatsForTopic
 
@@ -1573,12 +2177,22 @@ ndw_PrintStatsForConnection(ndw_Connection_T* c)
         return;
     }
 
+    ndw_TopicStats_T totals;
+    memset(&totals, 0, sizeof(totals));
     for (INT_T k = 0; k < total_topics; k++) {
         ndw_PrintStatsForTopic(topics[k]);
+
+        ndw_TopicStats_T stats;
+        ndw_TopicStatsSnapshot(topics[k]->stats_index, &stats);
+        for (INT_T i = 0; i < NDW_TOPIC_STATS_COUNTERS; i++)
+            totals.counters[i] += stats.counters[i];
     }
 
     free(topics);
 
+    NDW_LOG("%s  * Connection totals: published_msgs<%ld> received_msgs<%ld> bad_msgs_received<%ld> msgs_commits<%ld>\n",
+            spaces, totals.counters[NDW_TOPIC_STAT_PUBLISHED_MSGS], totals.counters[NDW_TOPIC_STAT_RECEIVED_MSGS],
+            totals.counters[NDW_TOPIC_STAT_BAD_MSGS_RECEIVED], totals.counters[NDW_TOPIC_STAT_MSGS_COMMITS]);
     NDW_LOG("%s--> END: Statistics for %s\n", spaces, c->debug_desc);
 } // end method ndw_PrintStatsForConnection
 
@@ -1663,6 +2277,9 @@ ndw_PollAsyncQueue(ndw_Topic_T* topic, LONG_T timeout_us)
         ndw_exit(EXIT_FAILURE);
     }
 
+    if ((NULL != topic->q_async_spill) && (ndw_QSpillCount(topic->q_async_spill) > 0))
+        ndw_QSpillDrainInto(topic->q_async_spill, topic->q_async);
+
     NDW_QData_T q_data;
     memset(&q_data, 0, sizeof(NDW_QData_T));
 
@@ -1696,11 +2313,14 @@ ndw_PollAsyncQueue(ndw_Topic_T* topic, LONG_T timeout_us)
         ndw_exit(EXIT_FAILURE);
     }
 
-    topic->last_msg_received_time = ndw_GetCurrentUTCNanoseconds();
+    topic->last_msg_received_time = ndw_ClockNowNanos();
+    ndw_CaptureLatency(topic, msginfo, topic->last_msg_received_time);
     topic->last_msg_header_received = msginfo->header_addr;
     topic->last_msg_received = msginfo->msg_addr;
     topic->last_msg_received_size = msginfo->msg_size;
-    topic->total_received_msgs += 1;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS, 1);
+
+    ndw_CaptureQueueDwell(topic, q_data.consumption_insertion_time, topic->last_msg_received_time);
 
     topic->q_async_closure = q_item;
 
@@ -1760,10 +2380,210 @@ ndw_CommitAsyncQueuedMessge(ndw_Topic_T* topic)
     return 0;
 } // end method ndw_CommitAsyncQueuedMessge(ndw_Topic_T* topic)
 
+INT_T
+ndw_PollAsyncQueueBatch(ndw_Topic_T* topic, ndw_AsyncMsgView_T* views, INT_T max_msgs, LONG_T timeout_us)
+{
+    if (NULL == topic) {
+        NDW_LOGERR("NULL Topic!\n");
+        return -1;
+    }
+
+    if (! topic->q_async_enabled) {
+        NDW_LOGERR("Topic NOT enabled for asynchronous message queuing for %s\n", topic->debug_desc);
+        return -2;
+    }
+
+    if ((NULL == views) || (max_msgs <= 0)) {
+        NDW_LOGERR("Invalid views Pointer or max_msgs<%d> for %s\n", max_msgs, topic->debug_desc);
+        return -3;
+    }
+
+    if (NULL == topic->q_async) {
+        NDW_LOGERR("*** FATAL ERROR: q_async Pointer is NULL for %s\n", topic->debug_desc);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (max_msgs > topic->q_async_batch_capacity) {
+        free(topic->q_async_batch_data);
+        topic->q_async_batch_data = calloc(max_msgs, sizeof(NDW_QData_T));
+        if (NULL == topic->q_async_batch_data) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to allocate <%d> NDW_QData_T for %s\n", max_msgs, topic->debug_desc);
+            ndw_exit(EXIT_FAILURE);
+        }
+        topic->q_async_batch_capacity = max_msgs;
+    }
+
+    NDW_QData_T* q_data = (NDW_QData_T*) topic->q_async_batch_data;
+
+    if ((NULL != topic->q_async_spill) && (ndw_QSpillCount(topic->q_async_spill) > 0))
+        ndw_QSpillDrainInto(topic->q_async_spill, topic->q_async);
+
+    INT_T count = ndw_QGetBatch(topic->q_async, q_data, max_msgs, timeout_us);
+    if (count <= 0) {
+        if (count < 0) {
+            NDW_LOGERR("ndw_QGetBatch returned error code<%d> for %s\n", count, topic->debug_desc);
+        }
+        return count;
+    }
+
+    if (ndw_verbose > 3) {
+        NDW_LOGX("Received <%d> Messages from q_async for %s\n", count, topic->debug_desc);
+    }
+
+    LONG_T now = ndw_ClockNowNanos();
+
+    for (INT_T i = 0; i < count; i++)
+    {
+        ndw_QAsync_Item_T* q_item = (ndw_QAsync_Item_T*) q_data[i].data;
+        if (NULL == q_item) {
+            NDW_LOGERR("*** FATAL ERROR: ndw_QAsync_Item* is NULL for %s\n", topic->debug_desc);
+            ndw_exit(EXIT_FAILURE);
+        }
+
+        ndw_InMsgCxt_T* msginfo = ndw_LE_to_MsgHeader(q_item->msg, q_item->msg_size);
+        if (NULL == msginfo) {
+            NDW_LOGERR("*** FATAL ERROR:  ndw_MsgHeader_Info_T* returned is NULL! msg_size<%d>. For<%s>\n",
+                        q_item->msg_size, topic->debug_desc);
+            ndw_exit(EXIT_FAILURE);
+        }
+
+        // Header either points into the queued message (in place Little Endian view) which lives until commit,
+        // or it was decoded into a per thread buffer, in which case keep a copy per view.
+        ndw_AsyncMsgView_T* v = &views[i];
+        if ((msginfo->header_addr == q_item->msg) || (NULL == msginfo->header_addr)) {
+            v->header = msginfo->header_addr;
+        }
+        else {
+            memcpy(v->header_buffer, msginfo->header_addr, msginfo->header_native_size);
+            v->header = (UCHAR_T*) v->header_buffer;
+        }
+        v->header_size = msginfo->header_native_size;
+        v->msg = msginfo->msg_addr;
+        v->msg_size = msginfo->msg_size;
+        v->received_time = now;
+        v->sequence_number = q_data[i].consumption_sequence_number;
+        v->q_item = q_item;
+
+        ndw_CaptureLatency(topic, msginfo, now);
+        ndw_CaptureQueueDwell(topic, q_data[i].consumption_insertion_time, now);
+    }
+
+    topic->last_msg_received_time = now;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS, count);
+
+    return count;
+} // end method ndw_PollAsyncQueueBatch
+
+#define NDW_ASYNC_COMMIT_CHUNK 64
+
+INT_T
+ndw_CommitAsyncQueuedBatch(ndw_Topic_T* topic, ndw_AsyncMsgView_T* views, INT_T count)
+{
+    if (NULL == topic) {
+        NDW_LOGERR("NULL Topic!\n");
+        return -1;
+    }
+
+    if ((NULL == views) || (count <= 0)) {
+        NDW_LOGERR("Invalid views Pointer or count<%d> for %s\n", count, topic->debug_desc);
+        return -2;
+    }
+
+    if (NULL == topic->q_async) {
+        NDW_LOGERR("*** FATAL ERROR: q_async is NULL for %s\n", topic->debug_desc);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    INT_T impl_id = topic->connection->vendor_id;
+    if ((impl_id < 1) || (impl_id >= NDW_MAX_API_IMPLEMENTATIONS)) {
+        NDW_LOGERR( "*** FATAL ERROR: Invalid connection vendor_id <%d> for %s\n", impl_id, topic->debug_desc);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    ndw_ImplAPI_T *impl = &ndw_impl_api_structure[impl_id];
+
+    void* closures[NDW_ASYNC_COMMIT_CHUNK];
+    INT_T failed = 0;
+
+    for (INT_T start = 0; start < count; start += NDW_ASYNC_COMMIT_CHUNK)
+    {
+        INT_T n = ((count - start) < NDW_ASYNC_COMMIT_CHUNK) ? (count - start) : NDW_ASYNC_COMMIT_CHUNK;
+
+        for (INT_T i = 0; i < n; i++) {
+            ndw_QAsync_Item_T* q_item = (ndw_QAsync_Item_T*) views[start + i].q_item;
+            if ((NULL == q_item) || (q_item->topic != topic)) {
+                NDW_LOGERR("*** FATAL ERROR: ndw_AsyncMsgView_T at index<%d> does NOT belong to %s\n",
+                            start + i, topic->debug_desc);
+                ndw_exit(EXIT_FAILURE);
+            }
+            closures[i] = q_item->vendor_closure;
+        }
+
+        if (NULL != impl->CommitQueuedMsgBatch) {
+            INT_T vendor_ret_code = impl->CommitQueuedMsgBatch(topic, closures, n);
+            if (vendor_ret_code < 0)
+                failed += (-1 * vendor_ret_code);
+        }
+        else {
+            for (INT_T i = 0; i < n; i++) {
+                if (0 != impl->CommitQueuedMsg(topic, closures[i]))
+                    failed += 1;
+            }
+        }
+    }
+
+    if (0 != failed) {
+        NDW_LOGERR("*** ERROR: CommitQueuedMsgBatch reported failures for <%d> of <%d> messages for %s\n",
+                    failed, count, topic->debug_desc);
+    }
+
+    // Note: Queue items are deleted by the cleanup operator.
+    ndw_QDeleteBatch(topic->q_async);
+
+    for (INT_T i = 0; i < count; i++)
+        views[i].q_item = NULL;
+
+    return 0;
+} // end method ndw_CommitAsyncQueuedBatch
+
 
 //
 // Function Scope # 2: Vendor Implementations to invoke these following functions.
 //
+INT_T
+ndw_SetPublishAckHandler(ndw_Topic_T* topic, ndw_PublishAckHandler_T handler, void* closure)
+{
+    if (NULL == topic) {
+        NDW_LOGERR("*** ERROR: NULL ndw_Topic_T* parameter!\n");
+        return -1;
+    }
+
+    topic->publish_ack_closure = closure;
+    topic->publish_ack_handler = handler;
+    return 0;
+} // end method ndw_SetPublishAckHandler
+
+void
+ndw_HandleVendorPublishAck(ndw_PublishAck_T* ack)
+{
+    if ((NULL == ack) || (NULL == ack->topic)) {
+        NDW_LOGERR("*** ERROR: Publish ack or its Topic is NULL!\n");
+        return;
+    }
+
+    ndw_Topic_T* topic = ack->topic;
+    if (0 == ack->error_code) {
+        __atomic_fetch_add(&topic->publish_acks, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&topic->publish_ack_failures, 1, __ATOMIC_RELAXED);
+        NDW_LOGERR("*** ERROR: Asynchronous publish FAILED with error_code<%d> error_text<%s> for %s\n",
+                    ack->error_code, (NULL == ack->error_text) ? "?" : ack->error_text, topic->debug_desc);
+    }
+
+    if (NULL != topic->publish_ack_handler)
+        topic->publish_ack_handler(ack, topic->publish_ack_closure);
+} // end method ndw_HandleVendorPublishAck
+
 INT_T
 ndw_HandleVendorAsyncMessage(ndw_Topic_T* topic, UCHAR_T* msg, INT_T msg_size, void* vendor_closure)
 {
@@ -1795,12 +2615,7 @@ ndw_HandleVendorAsyncMessage(ndw_Topic_T* topic, UCHAR_T* msg, INT_T msg_size, v
         q_item->msg = msg;
         q_item->msg_size = msg_size;
 
-        if (0 != ndw_QInsert(topic->q_async, q_item)) {
-            NDW_LOGERR("*** FATAL ERROR: ndw_QInsert failed for %s\n", topic->debug_desc);
-            ndw_exit(EXIT_FAILURE);
-        }
-
-        return 0;
+        return ndw_QAsync_Insert(topic, q_item);
     }
 
     if (NULL != topic->last_msg_header_received) {
@@ -1831,15 +2646,16 @@ ndw_HandleVendorAsyncMessage(ndw_Topic_T* topic, UCHAR_T* msg, INT_T msg_size, v
         ndw_exit(EXIT_FAILURE);
     }
 
-    topic->last_msg_received_time = ndw_GetCurrentUTCNanoseconds();
+    topic->last_msg_received_time = ndw_ClockNowNanos();
+    ndw_CaptureLatency(topic, msginfo, topic->last_msg_received_time);
     topic->last_msg_header_received = msginfo->header_addr;
     topic->last_msg_received = msginfo->msg_addr;
     topic->last_msg_received_size = msginfo->msg_size;
-    topic->total_received_msgs += 1;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS, 1);
 
     INT_T ret_code = -1;
     if (msginfo->is_bad) {
-        topic->total_bad_msgs_received += 1;
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_BAD_MSGS_RECEIVED, 1);
 
         ndw_BadMessage_T bad_msg;
         bad_msg.received_time = topic->last_msg_received_time;
@@ -2032,15 +2848,16 @@ ndw_SynchronousPollForMsg(ndw_Topic_T* topic, LONG_T timeout_ms, LONG_T* dropped
     last_sync_poll_msg->msg_size = msg_length;
     last_sync_poll_msg->vendor_closure = vendor_closure;
 
-    topic->last_msg_received_time = ndw_GetCurrentUTCNanoseconds();
+    topic->last_msg_received_time = ndw_ClockNowNanos();
+    ndw_CaptureLatency(topic, msginfo, topic->last_msg_received_time);
     topic->last_msg_header_received = msginfo->header_addr;
     topic->last_msg_received = msginfo->msg_addr;
     topic->last_msg_received_size = msginfo->msg_size;
-    topic->total_received_msgs += 1;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS, 1);
     topic->last_msg_vendor_closure = vendor_closure;
 
     if (msginfo->is_bad) {
-        topic->total_bad_msgs_received += 1;
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_BAD_MSGS_RECEIVED, 1);
 
         ndw_BadMessage_T bad_msg;
         bad_msg.received_time = topic->last_msg_received_time;
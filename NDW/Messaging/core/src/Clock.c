@@ -0,0 +1,231 @@
+
+#include "NDW_Clock.h"
+#include "NDW_Utils.h"
+
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+ndw_Clock_T ndw_clock;
+
+static pthread_t ndw_clock_thread;
+static atomic_bool ndw_clock_thread_running;
+static pthread_mutex_t ndw_clock_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ndw_clock_cond;
+
+// Calibration origin against CLOCK_MONOTONIC_RAW. The frequency is measured over the whole interval since init,
+// so it keeps improving, and steps or NTP slewing of CLOCK_REALTIME do not skew it.
+static ULONG_T ndw_clock_origin_tsc = 0;
+static ULONG_T ndw_clock_origin_raw_ns = 0;
+
+static bool
+ndw_ClockHasInvariantTSC()
+{
+#if defined(__x86_64__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (0 == __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (0 != (edx & (1U << 8)));
+#else
+    return false;
+#endif
+} // end method ndw_ClockHasInvariantTSC
+
+static ULONG_T
+ndw_ClockRawNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (ULONG_T) ts.tv_sec * 1000000000UL + (ULONG_T) ts.tv_nsec;
+} // end method ndw_ClockRawNanos
+
+// Pair a TSC reading with CLOCK_MONOTONIC_RAW and CLOCK_REALTIME. Of a few tries keep the one with the tightest
+// TSC bracket.
+static void
+ndw_ClockSample(ULONG_T* tsc, ULONG_T* raw_ns, ULONG_T* ns)
+{
+    ULONG_T best_window = ~0UL;
+    for (INT_T i = 0; i < 5; i++) {
+        ULONG_T t0 = ndw_ClockReadTSC();
+        ULONG_T r = ndw_ClockRawNanos();
+        ULONG_T n = ndw_ClockSystemNanos();
+        ULONG_T t1 = ndw_ClockReadTSC();
+        if ((t1 - t0) < best_window) {
+            best_window = t1 - t0;
+            *tsc = t0 + ((t1 - t0) / 2);
+            *raw_ns = r;
+            *ns = n;
+        }
+    }
+} // end method ndw_ClockSample
+
+static void
+ndw_ClockPublish(ULONG_T tsc_base, ULONG_T ns_base, ULONG_T mult)
+{
+    // Single writer (init or the re-sync thread), so a plain increment to odd and back to even is enough.
+    UINT_T seq = atomic_load_explicit(&ndw_clock.seq, memory_order_relaxed);
+    atomic_store_explicit(&ndw_clock.seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    __atomic_store_n(&ndw_clock.tsc_base, tsc_base, __ATOMIC_RELAXED);
+    __atomic_store_n(&ndw_clock.ns_base, ns_base, __ATOMIC_RELAXED);
+    __atomic_store_n(&ndw_clock.mult, mult, __ATOMIC_RELAXED);
+
+    atomic_store_explicit(&ndw_clock.seq, seq + 2, memory_order_release);
+} // end method ndw_ClockPublish
+
+/*
+ * The TSC frequency comes from CLOCK_MONOTONIC_RAW; CLOCK_REALTIME only sets the offset.
+ * The first calibration takes CLOCK_REALTIME as is. Later ones keep the clock continuous at the sync point and
+ * slew towards CLOCK_REALTIME by adjusting the rate for the next interval, by at most NDW_CLOCK_MAX_SLEW_PPM,
+ * so the clock never goes backwards. Only an offset beyond NDW_CLOCK_STEP_NS (CLOCK_REALTIME was stepped) is
+ * stepped, as ntpd does.
+ */
+static bool
+ndw_ClockCalibrate(ULONG_T tsc, ULONG_T raw_ns, ULONG_T ns, bool initial)
+{
+    if ((tsc <= ndw_clock_origin_tsc) || (raw_ns <= ndw_clock_origin_raw_ns))
+        return false;
+
+    ULONG_T mult = (ULONG_T) ((((unsigned __int128) (raw_ns - ndw_clock_origin_raw_ns)) << 32) /
+                                (tsc - ndw_clock_origin_tsc));
+    if (0 == mult)
+        return false;
+
+    if (initial) {
+        ndw_ClockPublish(tsc, ns, mult);
+        return true;
+    }
+
+    // What readers get now, and how far that is from CLOCK_REALTIME.
+    ULONG_T delta = (tsc > ndw_clock.tsc_base) ? (tsc - ndw_clock.tsc_base) : 0;
+    ULONG_T now_ns = ndw_clock.ns_base + (ULONG_T) (((unsigned __int128) delta * ndw_clock.mult) >> 32);
+    LONG_T offset_ns = (LONG_T) (ns - now_ns);
+
+    if ((offset_ns > NDW_CLOCK_STEP_NS) || (offset_ns < -NDW_CLOCK_STEP_NS)) {
+        ndw_ClockPublish(tsc, ns, mult);
+        ndw_clock.total_steps += 1;
+        return true;
+    }
+
+    // Absorb the offset over the next re-sync interval.
+    const LONG_T interval_ns = NDW_CLOCK_RESYNC_MS * 1000000L;
+    const LONG_T max_slew_ns = (interval_ns / 1000000L) * NDW_CLOCK_MAX_SLEW_PPM;
+    if (offset_ns > max_slew_ns)
+        offset_ns = max_slew_ns;
+    else if (offset_ns < -max_slew_ns)
+        offset_ns = -max_slew_ns;
+
+    __int128 slewed_mult = (__int128) mult + (((__int128) mult * offset_ns) / interval_ns);
+    ndw_ClockPublish(tsc, now_ns, (ULONG_T) slewed_mult);
+    return true;
+} // end method ndw_ClockCalibrate
+
+static void*
+ndw_ClockResyncThread(void* arg)
+{
+    (void) arg;
+
+    while (atomic_load_explicit(&ndw_clock_thread_running, memory_order_acquire)) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += NDW_CLOCK_RESYNC_MS / 1000;
+        deadline.tv_nsec += (NDW_CLOCK_RESYNC_MS % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        // Sleep until the next re-sync, or until ndw_ClockShutdown wakes us up.
+        pthread_mutex_lock(&ndw_clock_mutex);
+        while (atomic_load_explicit(&ndw_clock_thread_running, memory_order_acquire)) {
+            if (ETIMEDOUT == pthread_cond_timedwait(&ndw_clock_cond, &ndw_clock_mutex, &deadline))
+                break;
+        }
+        pthread_mutex_unlock(&ndw_clock_mutex);
+
+        if (! atomic_load_explicit(&ndw_clock_thread_running, memory_order_acquire))
+            break;
+
+        ULONG_T tsc = 0, raw_ns = 0, ns = 0;
+        ULONG_T tsc_clock_ns = ndw_ClockNowNanos();
+        ndw_ClockSample(&tsc, &raw_ns, &ns);
+        ndw_clock.last_resync_error_ns = (LONG_T) (tsc_clock_ns - ns);
+
+        if (ndw_ClockCalibrate(tsc, raw_ns, ns, false))
+            ndw_clock.total_resyncs += 1;
+    }
+
+    return NULL;
+} // end method ndw_ClockResyncThread
+
+bool
+ndw_ClockInit()
+{
+    if (atomic_load(&ndw_clock.tsc_enabled))
+        return true;
+
+    const CHAR_T* use_tsc = getenv(NDW_CLOCK_TSC);
+    if ((NULL != use_tsc) && ('\0' != *use_tsc) && (0 == atoi(use_tsc))) {
+        NDW_LOGX("TSC clock disabled by %s; using clock_gettime\n", NDW_CLOCK_TSC);
+        return false;
+    }
+
+    if (! ndw_ClockHasInvariantTSC()) {
+        NDW_LOGX("No invariant TSC; using clock_gettime\n");
+        return false;
+    }
+
+    ULONG_T origin_ns = 0;
+    ndw_ClockSample(&ndw_clock_origin_tsc, &ndw_clock_origin_raw_ns, &origin_ns);
+
+    struct timespec ts = { 0, NDW_CLOCK_CALIBRATION_MS * 1000000L };
+    nanosleep(&ts, NULL);
+
+    ULONG_T tsc = 0, raw_ns = 0, ns = 0;
+    ndw_ClockSample(&tsc, &raw_ns, &ns);
+    if (! ndw_ClockCalibrate(tsc, raw_ns, ns, true)) {
+        NDW_LOGERR("*** WARNING: TSC calibration failed; using clock_gettime\n");
+        return false;
+    }
+
+    // The re-sync thread sleeps on CLOCK_MONOTONIC so a step of CLOCK_REALTIME does not stall it.
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ndw_clock_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    atomic_store(&ndw_clock_thread_running, true);
+    if (0 != pthread_create(&ndw_clock_thread, NULL, ndw_ClockResyncThread, NULL)) {
+        NDW_LOGERR("*** WARNING: Failed to create TSC clock re-sync thread; using clock_gettime\n");
+        atomic_store(&ndw_clock_thread_running, false);
+        pthread_cond_destroy(&ndw_clock_cond);
+        return false;
+    }
+
+    atomic_store(&ndw_clock.tsc_enabled, true);
+    NDW_LOGX("TSC clock enabled: %.4f ns per tick\n", ((double) ndw_clock.mult) / 4294967296.0);
+    return true;
+} // end method ndw_ClockInit
+
+void
+ndw_ClockShutdown()
+{
+    if (! atomic_load(&ndw_clock.tsc_enabled))
+        return;
+
+    atomic_store(&ndw_clock.tsc_enabled, false);
+
+    pthread_mutex_lock(&ndw_clock_mutex);
+    atomic_store(&ndw_clock_thread_running, false);
+    pthread_cond_signal(&ndw_clock_cond);
+    pthread_mutex_unlock(&ndw_clock_mutex);
+
+    pthread_join(ndw_clock_thread, NULL);
+    pthread_cond_destroy(&ndw_clock_cond);
+} // end method ndw_ClockShutdown
+
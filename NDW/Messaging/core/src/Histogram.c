@@ -0,0 +1,226 @@
+
+#include "NDW_Histogram.h"
+#include "NDW_Utils.h"
+
+#include <string.h>
+#include <inttypes.h>
+
+ndw_Histogram_T*
+ndw_HistogramCreate()
+{
+    ndw_Histogram_T* h = (ndw_Histogram_T*) calloc(1, sizeof(ndw_Histogram_T));
+    if (NULL == h) {
+        NDW_LOGERR("Failed to allocate memory for ndw_Histogram_T\n");
+        return NULL;
+    }
+
+    h->min_value = ~0UL;
+    return h;
+} // end method ndw_HistogramCreate
+
+void
+ndw_HistogramDestroy(ndw_Histogram_T* h)
+{
+    free(h);
+} // end method ndw_HistogramDestroy
+
+void
+ndw_HistogramReset(ndw_Histogram_T* h)
+{
+    if (NULL == h)
+        return;
+
+    for (INT_T i = 0; i < NDW_HISTOGRAM_BUCKETS; i++)
+        __atomic_store_n(&h->counts[i], 0, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&h->overflow_count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->total_sum, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->max_value, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->min_value, ~0UL, __ATOMIC_RELAXED);
+} // end method ndw_HistogramReset
+
+static void
+ndw_HistogramMergeMinMax(ndw_Histogram_T* dest, ULONG_T min_value, ULONG_T max_value)
+{
+    ULONG_T current = __atomic_load_n(&dest->min_value, __ATOMIC_RELAXED);
+    while ((min_value < current) &&
+           (! __atomic_compare_exchange_n(&dest->min_value, &current, min_value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        ;
+
+    current = __atomic_load_n(&dest->max_value, __ATOMIC_RELAXED);
+    while ((max_value > current) &&
+           (! __atomic_compare_exchange_n(&dest->max_value, &current, max_value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        ;
+} // end method ndw_HistogramMergeMinMax
+
+void
+ndw_HistogramMerge(ndw_Histogram_T* dest, const ndw_Histogram_T* src)
+{
+    if ((NULL == dest) || (NULL == src))
+        return;
+
+    for (INT_T i = 0; i < NDW_HISTOGRAM_BUCKETS; i++) {
+        ULONG_T count = __atomic_load_n(&src->counts[i], __ATOMIC_RELAXED);
+        if (0 != count)
+            __atomic_fetch_add(&dest->counts[i], count, __ATOMIC_RELAXED);
+    }
+
+    __atomic_fetch_add(&dest->overflow_count, __atomic_load_n(&src->overflow_count, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    __atomic_fetch_add(&dest->total_sum, __atomic_load_n(&src->total_sum, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    ndw_HistogramMergeMinMax(dest, __atomic_load_n(&src->min_value, __ATOMIC_RELAXED),
+                                    __atomic_load_n(&src->max_value, __ATOMIC_RELAXED));
+} // end method ndw_HistogramMerge
+
+ULONG_T
+ndw_HistogramCount(const ndw_Histogram_T* h)
+{
+    if (NULL == h)
+        return 0;
+
+    ULONG_T total = __atomic_load_n(&h->overflow_count, __ATOMIC_RELAXED);
+    for (INT_T i = 0; i < NDW_HISTOGRAM_BUCKETS; i++)
+        total += __atomic_load_n(&h->counts[i], __ATOMIC_RELAXED);
+
+    return total;
+} // end method ndw_HistogramCount
+
+ULONG_T
+ndw_HistogramValueAtPercentile(const ndw_Histogram_T* h, double percentile)
+{
+    ULONG_T total = ndw_HistogramCount(h);
+    if (0 == total)
+        return 0;
+
+    if (percentile < 0.0)
+        percentile = 0.0;
+    if (percentile > 100.0)
+        percentile = 100.0;
+
+    // Rank of the value we want (1 based), rounded up so p100 is the last value.
+    ULONG_T rank = (ULONG_T) ((percentile / 100.0) * (double) total);
+    if (((double) rank) < ((percentile / 100.0) * (double) total))
+        rank += 1;
+    if (0 == rank)
+        rank = 1;
+
+    ULONG_T min_value = __atomic_load_n(&h->min_value, __ATOMIC_RELAXED);
+    ULONG_T max_value = __atomic_load_n(&h->max_value, __ATOMIC_RELAXED);
+
+    ULONG_T cumulative = 0;
+    for (INT_T i = 0; i < NDW_HISTOGRAM_BUCKETS; i++) {
+        cumulative += __atomic_load_n(&h->counts[i], __ATOMIC_RELAXED);
+        if (cumulative >= rank) {
+            // Report the middle of the bucket, but never outside what was actually recorded.
+            ULONG_T value = ndw_HistogramBucketLowValue(i) + (ndw_HistogramBucketWidth(i) / 2);
+            if (value < min_value)
+                value = min_value;
+            if (value > max_value)
+                value = max_value;
+            return value;
+        }
+    }
+
+    return max_value; // Rank falls into the overflow count.
+} // end method ndw_HistogramValueAtPercentile
+
+void
+ndw_HistogramPrint(const ndw_Histogram_T* h, const CHAR_T* prefix)
+{
+    if (NULL == prefix)
+        prefix = "";
+
+    ULONG_T total = ndw_HistogramCount(h);
+    if (0 == total) {
+        NDW_LOG("%scount<0>\n", prefix);
+        return;
+    }
+
+    NDW_LOG("%scount<%" PRIu64 "> min<%" PRIu64 "> mean<%" PRIu64 "> p50<%" PRIu64 "> p90<%" PRIu64 "> p99<%" PRIu64
+            "> p99.9<%" PRIu64 "> p99.99<%" PRIu64 "> max<%" PRIu64 "> overflow<%" PRIu64 "> (nanoseconds)\n",
+            prefix, total,
+            __atomic_load_n(&h->min_value, __ATOMIC_RELAXED),
+            __atomic_load_n(&h->total_sum, __ATOMIC_RELAXED) / total,
+            ndw_HistogramValueAtPercentile(h, 50.0),
+            ndw_HistogramValueAtPercentile(h, 90.0),
+            ndw_HistogramValueAtPercentile(h, 99.0),
+            ndw_HistogramValueAtPercentile(h, 99.9),
+            ndw_HistogramValueAtPercentile(h, 99.99),
+            __atomic_load_n(&h->max_value, __ATOMIC_RELAXED),
+            __atomic_load_n(&h->overflow_count, __ATOMIC_RELAXED));
+} // end method ndw_HistogramPrint
+
+INT_T
+ndw_HistogramSerialize(const ndw_Histogram_T* h, CHAR_T* buffer, INT_T size)
+{
+    if ((NULL == h) || (NULL == buffer) || (size <= 0))
+        return -1;
+
+    INT_T length = snprintf(buffer, size, "NDWH1 %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64,
+                            __atomic_load_n(&h->total_sum, __ATOMIC_RELAXED),
+                            __atomic_load_n(&h->min_value, __ATOMIC_RELAXED),
+                            __atomic_load_n(&h->max_value, __ATOMIC_RELAXED),
+                            __atomic_load_n(&h->overflow_count, __ATOMIC_RELAXED));
+    if ((length < 0) || (length >= size))
+        return -1;
+
+    for (INT_T i = 0; i < NDW_HISTOGRAM_BUCKETS; i++) {
+        ULONG_T count = __atomic_load_n(&h->counts[i], __ATOMIC_RELAXED);
+        if (0 == count)
+            continue;
+
+        INT_T n = snprintf(buffer + length, size - length, " %d:%" PRIu64, i, count);
+        if ((n < 0) || (n >= (size - length)))
+            return -1;
+        length += n;
+    }
+
+    return length;
+} // end method ndw_HistogramSerialize
+
+INT_T
+ndw_HistogramDeserialize(ndw_Histogram_T* h, const CHAR_T* text)
+{
+    if ((NULL == h) || (NULL == text))
+        return -1;
+
+    ULONG_T sum = 0, min_value = 0, max_value = 0, overflow = 0;
+    INT_T consumed = 0;
+    if (4 != sscanf(text, "NDWH1 %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 "%n",
+                    &sum, &min_value, &max_value, &overflow, &consumed))
+        return -2;
+
+    // Validate everything before touching h, so a malformed text adds nothing.
+    const CHAR_T* p = text + consumed;
+    for (;;) {
+        INT_T index = 0;
+        ULONG_T count = 0;
+        INT_T n = 0;
+        if (2 != sscanf(p, " %d:%" SCNu64 "%n", &index, &count, &n))
+            break;
+        if ((index < 0) || (index >= NDW_HISTOGRAM_BUCKETS))
+            return -3;
+        p += n;
+    }
+    while (' ' == *p)
+        ++p;
+    if ('\0' != *p)
+        return -4;
+
+    p = text + consumed;
+    for (;;) {
+        INT_T index = 0;
+        ULONG_T count = 0;
+        INT_T n = 0;
+        if (2 != sscanf(p, " %d:%" SCNu64 "%n", &index, &count, &n))
+            break;
+        __atomic_fetch_add(&h->counts[index], count, __ATOMIC_RELAXED);
+        p += n;
+    }
+
+    __atomic_fetch_add(&h->overflow_count, overflow, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->total_sum, sum, __ATOMIC_RELAXED);
+    ndw_HistogramMergeMinMax(h, min_value, max_value);
+
+    return 0;
+} // end method ndw_HistogramDeserialize
+
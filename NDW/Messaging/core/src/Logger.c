@@ -0,0 +1,385 @@
+
+#include "NDW_Logger.h"
+#include "NDW_Utils.h"
+
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+
+INT_T ndw_log_mode = NDW_LOG_SYNC;
+
+#define NDW_LOG_RECORD_WRAP 0xFFFFFFFFU     // Rest of the ring is unused; the next record is at offset 0.
+
+typedef struct ndw_LogRecord
+{
+    UINT_T length;                  // Bytes of text after the record, or NDW_LOG_RECORD_WRAP.
+    UINT_T reserved;
+    ULONG_T timestamp;              // ndw_ClockNowNanos when the line was logged.
+    FILE* stream;
+} ndw_LogRecord_T;
+
+// Single producer (the owning thread), single consumer (whoever holds ndw_log_rings_mutex).
+typedef struct ndw_LogRing
+{
+    _Alignas(64) ULONG_T head;      // Bytes produced. Written by the owning thread only.
+    ULONG_T cached_tail;            // Owning thread's last view of tail.
+    ULONG_T dropped;                // Lines dropped as the ring was full. Written by the owning thread only.
+
+    _Alignas(64) ULONG_T tail;      // Bytes consumed.
+    ULONG_T drain_head;             // head as seen at the start of the current drain.
+    ULONG_T reported_dropped;       // Drops already reported.
+    bool closed;                    // Owning thread has exited; freed once drained.
+    pthread_t thread_id;
+    ULONG_T capacity;               // Power of two.
+    UCHAR_T* buffer;
+    struct ndw_LogRing* next;
+} ndw_LogRing_T;
+
+static pthread_key_t ndw_tls_log_ring;
+static pthread_once_t ndw_tls_log_ring_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t ndw_log_rings_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ndw_LogRing_T* ndw_log_rings = NULL;         // Protected by ndw_log_rings_mutex.
+static ULONG_T ndw_log_freed_rings_dropped = 0;     // Protected by ndw_log_rings_mutex.
+static ULONG_T ndw_log_ring_capacity = NDW_LOG_ASYNC_DEFAULT_BUFFER_KB * 1024UL;
+
+static pthread_t ndw_log_writer_thread;
+static bool ndw_log_writer_running = false;
+static bool ndw_log_writer_stop = false;
+static bool ndw_log_atexit_registered = false;
+
+static void
+ndw_TLSDestructor_LogRing(void* ptr)
+{
+    ndw_LogRing_T* ring = (ndw_LogRing_T*) ptr;
+    if (NULL != ring)
+        __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+} // end method ndw_TLSDestructor_LogRing
+
+static void
+ndw_tls_log_ring_Init()
+{
+    if (0 != pthread_key_create(&ndw_tls_log_ring, ndw_TLSDestructor_LogRing))
+    {
+        fprintf(stderr, "*** FATAL ERROR: Failed to create ndw_tls_log_ring!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+}
+
+static ndw_LogRing_T*
+ndw_LogRingAttach()
+{
+    void* memptr = NULL;
+    if ((0 != posix_memalign(&memptr, 64, sizeof(ndw_LogRing_T))) || (NULL == memptr))
+        return NULL;
+
+    ndw_LogRing_T* ring = (ndw_LogRing_T*) memptr;
+    memset(ring, 0, sizeof(ndw_LogRing_T));
+    ring->capacity = ndw_log_ring_capacity;
+    ring->buffer = (UCHAR_T*) malloc(ring->capacity);
+    if (NULL == ring->buffer) {
+        free(ring);
+        return NULL;
+    }
+    ring->thread_id = pthread_self();
+
+    pthread_mutex_lock(&ndw_log_rings_mutex);
+    ring->next = ndw_log_rings;
+    ndw_log_rings = ring;
+    pthread_mutex_unlock(&ndw_log_rings_mutex);
+
+    pthread_setspecific(ndw_tls_log_ring, ring);
+    return ring;
+} // end method ndw_LogRingAttach
+
+static inline ULONG_T
+ndw_LogRecordSize(UINT_T length)
+{
+    return (sizeof(ndw_LogRecord_T) + length + 7) & ~7UL;
+}
+
+static void
+ndw_LogRingPut(ndw_LogRing_T* ring, FILE* stream, const CHAR_T* text, UINT_T length)
+{
+    ULONG_T size = ndw_LogRecordSize(length);
+    ULONG_T head = ring->head;
+    ULONG_T pos = head & (ring->capacity - 1);
+    ULONG_T contiguous = ring->capacity - pos;
+    ULONG_T needed = (contiguous < size) ? (contiguous + size) : size;
+
+    while ((head + needed - ring->cached_tail) > ring->capacity) {
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if ((head + needed - ring->cached_tail) <= ring->capacity)
+            break;
+
+        if ((NDW_LOG_ASYNC_WAIT != __atomic_load_n(&ndw_log_mode, __ATOMIC_RELAXED)) ||
+            (! __atomic_load_n(&ndw_log_writer_running, __ATOMIC_ACQUIRE))) {
+            __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+            return;
+        }
+
+        sched_yield();
+    }
+
+    if (contiguous < size) {
+        *((UINT_T*) (ring->buffer + pos)) = NDW_LOG_RECORD_WRAP;
+        head += contiguous;
+        pos = 0;
+    }
+
+    ndw_LogRecord_T* record = (ndw_LogRecord_T*) (ring->buffer + pos);
+    record->length = length;
+    record->timestamp = ndw_ClockNowNanos();
+    record->stream = stream;
+    memcpy(record + 1, text, length);
+
+    __atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+} // end method ndw_LogRingPut
+
+void
+ndw_LogAsyncV(FILE* stream, const CHAR_T* filename, INT_T line_number,
+                const CHAR_T* function_name, const CHAR_T* format, va_list args)
+{
+    if (NULL == stream)
+        stream = stdout;
+
+    pthread_once(&ndw_tls_log_ring_once, ndw_tls_log_ring_Init);
+
+    ndw_LogRing_T* ring = (ndw_LogRing_T*) pthread_getspecific(ndw_tls_log_ring);
+    if ((NULL == ring) && (NULL == (ring = ndw_LogRingAttach()))) {
+        vfprintf(stream, format, args);
+        return;
+    }
+
+    CHAR_T line[NDW_LOG_ASYNC_MAX_LINE];
+    INT_T prefix = 0;
+    if (NULL != filename) {
+        prefix = snprintf(line, sizeof(line), "[(tid: %lu) %s:%d:%s()] ", pthread_self(), filename, line_number, function_name);
+        if (prefix < 0)
+            prefix = 0;
+        else if (prefix >= (INT_T) sizeof(line))
+            prefix = sizeof(line) - 1;
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    INT_T n = vsnprintf(line + prefix, sizeof(line) - prefix, format, args);
+    if (n < 0) {
+        va_end(args_copy);
+        return;
+    }
+
+    CHAR_T* text = line;
+    if ((size_t) (prefix + n) >= sizeof(line)) {
+        CHAR_T* long_line = (CHAR_T*) malloc(prefix + n + 1);
+        if (NULL != long_line) {
+            memcpy(long_line, line, prefix);
+            vsnprintf(long_line + prefix, n + 1, format, args_copy);
+            text = long_line;
+        }
+        else {
+            n = sizeof(line) - 1 - prefix;
+        }
+    }
+    va_end(args_copy);
+
+    // A record may take at most half the ring.
+    ULONG_T length = prefix + n;
+    ULONG_T max_length = (ring->capacity / 2) - sizeof(ndw_LogRecord_T);
+    if (length > max_length)
+        length = max_length;
+
+    ndw_LogRingPut(ring, stream, text, (UINT_T) length);
+
+    if (text != line)
+        free(text);
+} // end method ndw_LogAsyncV
+
+// Next record of the ring below drain_head, skipping wrap markers. Caller holds ndw_log_rings_mutex.
+static ndw_LogRecord_T*
+ndw_LogRingPeek(ndw_LogRing_T* ring)
+{
+    while (ring->tail < ring->drain_head) {
+        ULONG_T pos = ring->tail & (ring->capacity - 1);
+        ndw_LogRecord_T* record = (ndw_LogRecord_T*) (ring->buffer + pos);
+        if (NDW_LOG_RECORD_WRAP != record->length)
+            return record;
+
+        __atomic_store_n(&ring->tail, ring->tail + (ring->capacity - pos), __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+} // end method ndw_LogRingPeek
+
+// Write out all queued lines, oldest first across threads. Caller holds ndw_log_rings_mutex.
+// Returns number of lines written.
+static ULONG_T
+ndw_LogDrain()
+{
+    FILE* err_stream = (NULL == ndw_err_file) ? stdout : ndw_err_file;
+    FILE* streams[8];
+    INT_T num_streams = 0;
+    bool flush_all = false;
+
+    for (ndw_LogRing_T* ring = ndw_log_rings; NULL != ring; ring = ring->next) {
+        ring->drain_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        ULONG_T dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if (dropped != ring->reported_dropped) {
+            fprintf(err_stream, "*** WARNING: %lu log lines dropped by thread<%lu> as its log buffer was full\n",
+                    dropped - ring->reported_dropped, ring->thread_id);
+            ring->reported_dropped = dropped;
+            if (0 == num_streams)
+                streams[num_streams++] = err_stream;
+        }
+    }
+
+    ULONG_T lines = 0;
+    for (;;) {
+        ndw_LogRing_T* oldest_ring = NULL;
+        ndw_LogRecord_T* oldest = NULL;
+        for (ndw_LogRing_T* ring = ndw_log_rings; NULL != ring; ring = ring->next) {
+            ndw_LogRecord_T* record = ndw_LogRingPeek(ring);
+            if ((NULL != record) && ((NULL == oldest) || (record->timestamp < oldest->timestamp))) {
+                oldest = record;
+                oldest_ring = ring;
+            }
+        }
+
+        if (NULL == oldest)
+            break;
+
+        fwrite(oldest + 1, 1, oldest->length, oldest->stream);
+        lines++;
+
+        if (! flush_all) {
+            INT_T i = 0;
+            while ((i < num_streams) && (streams[i] != oldest->stream))
+                i++;
+            if (i == num_streams) {
+                if (num_streams < (INT_T) (sizeof(streams) / sizeof(streams[0])))
+                    streams[num_streams++] = oldest->stream;
+                else
+                    flush_all = true;
+            }
+        }
+
+        __atomic_store_n(&oldest_ring->tail, oldest_ring->tail + ndw_LogRecordSize(oldest->length), __ATOMIC_RELEASE);
+    }
+
+    if (flush_all) {
+        fflush(NULL);
+    }
+    else {
+        for (INT_T i = 0; i < num_streams; i++)
+            fflush(streams[i]);
+    }
+
+    // Free the rings of exited threads once empty.
+    ndw_LogRing_T** link = &ndw_log_rings;
+    while (NULL != *link) {
+        ndw_LogRing_T* ring = *link;
+        if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE) &&
+            (ring->tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE))) {
+            *link = ring->next;
+            ndw_log_freed_rings_dropped += ring->dropped;
+            free(ring->buffer);
+            free(ring);
+        }
+        else {
+            link = &ring->next;
+        }
+    }
+
+    return lines;
+} // end method ndw_LogDrain
+
+static void*
+ndw_LogWriterThread(void* arg)
+{
+    (void) arg;
+
+    struct timespec ts = { 0, NDW_LOG_ASYNC_DRAIN_INTERVAL_MS * 1000000L };
+    while (! __atomic_load_n(&ndw_log_writer_stop, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&ndw_log_rings_mutex);
+        ULONG_T lines = ndw_LogDrain();
+        pthread_mutex_unlock(&ndw_log_rings_mutex);
+
+        if (0 == lines)
+            nanosleep(&ts, NULL);
+    }
+
+    pthread_mutex_lock(&ndw_log_rings_mutex);
+    ndw_LogDrain();
+    pthread_mutex_unlock(&ndw_log_rings_mutex);
+
+    return NULL;
+} // end method ndw_LogWriterThread
+
+void
+ndw_LogAsyncFlush()
+{
+    pthread_mutex_lock(&ndw_log_rings_mutex);
+    ndw_LogDrain();
+    pthread_mutex_unlock(&ndw_log_rings_mutex);
+} // end method ndw_LogAsyncFlush
+
+INT_T
+ndw_LogAsyncStart(INT_T mode, INT_T buffer_kb)
+{
+    if ((NDW_LOG_ASYNC_DROP != mode) && (NDW_LOG_ASYNC_WAIT != mode))
+        return -1;
+
+    pthread_once(&ndw_tls_log_ring_once, ndw_tls_log_ring_Init);
+
+    if (! ndw_log_writer_running) {
+        // Applies to rings created from now on.
+        ULONG_T capacity = 4096;
+        ULONG_T wanted = ((buffer_kb > 0) ? (ULONG_T) buffer_kb : NDW_LOG_ASYNC_DEFAULT_BUFFER_KB) * 1024UL;
+        while (capacity < wanted)
+            capacity <<= 1;
+        ndw_log_ring_capacity = capacity;
+
+        __atomic_store_n(&ndw_log_writer_stop, false, __ATOMIC_RELEASE);
+        if (0 != pthread_create(&ndw_log_writer_thread, NULL, ndw_LogWriterThread, NULL)) {
+            fprintf(stderr, "*** ERROR: Failed to create log writer thread; logging stays synchronous\n");
+            return -2;
+        }
+        __atomic_store_n(&ndw_log_writer_running, true, __ATOMIC_RELEASE);
+
+        // Lines still queued when the application calls exit().
+        if (! ndw_log_atexit_registered) {
+            ndw_log_atexit_registered = true;
+            atexit(ndw_LogAsyncFlush);
+        }
+    }
+
+    __atomic_store_n(&ndw_log_mode, mode, __ATOMIC_RELEASE);
+    return 0;
+} // end method ndw_LogAsyncStart
+
+void
+ndw_LogAsyncStop()
+{
+    __atomic_store_n(&ndw_log_mode, NDW_LOG_SYNC, __ATOMIC_RELEASE);
+
+    if (! ndw_log_writer_running)
+        return;
+
+    __atomic_store_n(&ndw_log_writer_stop, true, __ATOMIC_RELEASE);
+    pthread_join(ndw_log_writer_thread, NULL);
+    __atomic_store_n(&ndw_log_writer_running, false, __ATOMIC_RELEASE);
+} // end method ndw_LogAsyncStop
+
+ULONG_T
+ndw_LogAsyncDropped()
+{
+    pthread_mutex_lock(&ndw_log_rings_mutex);
+    ULONG_T total = ndw_log_freed_rings_dropped;
+    for (ndw_LogRing_T* ring = ndw_log_rings; NULL != ring; ring = ring->next)
+        total += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ndw_log_rings_mutex);
+
+    return total;
+} // end method ndw_LogAsyncDropped
+
@@ -1,137 +1,146 @@
 
-#include "MPSCQ.h"
 
 
+#include "MPSCQ.h"
+
 ndw_MPSCQ_T*
 ndw_CreateMPSCQueue(LONG_T max_items)
 {
-    ndw_MPSCQ_T* queue = calloc(1, sizeof(ndw_MPSCQ_T));
-    if (NULL == queue) {
+    if (max_items <= 0)
+        max_items = NDW_MPSCQ_DEFAULT_ITEMS;
+
+    // At least two slots: with one, "filled" (position + 1) and "free for the next lap" (position + capacity) coincide.
+    ULONG_T capacity = 2;
+    while (capacity < (ULONG_T) max_items)
+        capacity <<= 1;
+
+    void* memptr = NULL;
+    if ((0 != posix_memalign(&memptr, NDW_MPSCQ_CACHE_LINE_SIZE, sizeof(ndw_MPSCQ_T))) || (NULL == memptr)) {
         fprintf(stderr, "Failed to allocate memory for MPSC queue.\n");
         return NULL;
     }
 
-    if (0 != pthread_mutex_init(&queue->producer_lock, NULL)) {
-        fprintf(stderr, "Failed to initialize producer mutex.\n");
+    ndw_MPSCQ_T* queue = (ndw_MPSCQ_T*) memptr;
+    memset(queue, 0, sizeof(ndw_MPSCQ_T));
+
+    memptr = NULL;
+    if ((0 != posix_memalign(&memptr, NDW_MPSCQ_CACHE_LINE_SIZE, capacity * sizeof(ndw_MPSCQSlot_T))) ||
+        (NULL == memptr)) {
+        fprintf(stderr, "Failed to allocate memory for <%lu> MPSC queue slots.\n", capacity);
         free(queue);
         return NULL;
     }
 
+    queue->slots = (ndw_MPSCQSlot_T*) memptr;
+    for (ULONG_T i = 0; i < capacity; i++) {
+        atomic_init(&queue->slots[i].sequence, i);
+        queue->slots[i].data = NULL;
+    }
+
     queue->max_queue_items = max_items;
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    atomic_init(&queue->producer_tail, 0);
+    atomic_init(&queue->producer_full_count, 0);
+    atomic_init(&queue->consumer_head, 0);
+    queue->consumer_pull_count = 0;
+    ndw_QWaitInit(&queue->wait);
+
     return queue;
 }
 
-// Insert into queue (returns 0 or -1 on error)
+// Insert into queue (returns NDW_MPSCQ_OK, NDW_MPSCQ_FULL or NDW_MPSCQ_INVALID)
 INT_T
 ndw_mpscq_insert(ndw_MPSCQ_T* queue, void* data)
 {
-    ndw_MPSCQNode_T* node = calloc(1, sizeof(ndw_MPSCQNode_T));
-    if (NULL == node) {
-        fprintf(stderr, "Failed to allocate memory for new node.\n");
-        return -1;
+    if ((NULL == queue) || (NULL == data))
+        return NDW_MPSCQ_INVALID;
+
+    // Vyukov style claim: a position is taken only once its slot has been released by the consumer,
+    // so a full queue is reported instead of producers overrunning the tail and waiting on the slot.
+    ndw_MPSCQSlot_T* slot = NULL;
+    ULONG_T pos = atomic_load_explicit(&queue->producer_tail, memory_order_relaxed);
+    for (;;) {
+        slot = &queue->slots[pos & queue->mask];
+        ULONG_T sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        LONG_T diff = (LONG_T) (sequence - pos);
+        if (0 == diff) {
+            // Slot is free for this lap. On failure pos is reloaded with the current tail.
+            if (atomic_compare_exchange_weak_explicit(&queue->producer_tail, &pos, pos + 1,
+                                                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // Slot still holds the item of the previous lap.
+            atomic_fetch_add_explicit(&queue->producer_full_count, 1, memory_order_relaxed);
+            return NDW_MPSCQ_FULL;
+        } else {
+            // Another producer claimed this position.
+            pos = atomic_load_explicit(&queue->producer_tail, memory_order_relaxed);
+        }
     }
-    node->data = data;
 
-    pthread_mutex_lock(&queue->producer_lock);
+    slot->data = data;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
 
-    node->sequence = queue->producer_push_count + 1;
-
-    if (0 == queue->producer_push_count) {
-        queue->consumer_cached_head = node;
-        queue->producer_queue_tail = node;
-        atomic_store(&queue->consumer_limit, node);
-    } else {
-        queue->producer_queue_tail->next = node;
-        queue->producer_queue_tail = node;
-        atomic_store(&queue->consumer_limit, node);
-    }
-
-    atomic_fetch_add(&queue->producer_push_count, 1);
+    ndw_QWaitSignal(&queue->wait);
+    return NDW_MPSCQ_OK;
+}
 
-    pthread_mutex_unlock(&queue->producer_lock);
-    return 0;
-} 
+static bool
+ndw_mpscq_ready(void* q)
+{
+    ndw_MPSCQ_T* queue = (ndw_MPSCQ_T*) q;
+    ULONG_T pos = atomic_load_explicit(&queue->consumer_head, memory_order_relaxed);
+    ndw_MPSCQSlot_T* slot = &queue->slots[pos & queue->mask];
+    return (atomic_load_explicit(&slot->sequence, memory_order_acquire) == (pos + 1));
+}
 
 void*
 ndw_mpscq_get(ndw_MPSCQ_T* queue, LONG_T timeout_in_milliseconds)
 {
-    // free previously accessed node
-    if (queue->consumer_last_accessed_node) {
-        free(queue->consumer_last_accessed_node);
-        queue->consumer_last_accessed_node = NULL;
-    }
-
-    // First pull: initialize cache limit
-    if (0 == atomic_load(&queue->consumer_pull_count)) {
-        ndw_MPSCQNode_T* limit = (ndw_MPSCQNode_T*)(intptr_t)atomic_load(&queue->consumer_limit);
-        if (!limit) {
-        struct timespec req = {
-            .tv_sec  = timeout_in_milliseconds / 1000,
-            .tv_nsec = (timeout_in_milliseconds % 1000) * 1000000
-        };
-        nanosleep(&req, NULL);
-
-            limit = (ndw_MPSCQNode_T*)(intptr_t)atomic_load(&queue->consumer_limit);
-            if (!limit) return NULL;
-        }
+    ULONG_T pos = atomic_load_explicit(&queue->consumer_head, memory_order_relaxed);
+    ndw_MPSCQSlot_T* slot = &queue->slots[pos & queue->mask];
 
-        queue->consumer_cached_limit = limit;
-        ndw_MPSCQNode_T* node = queue->consumer_cached_head;
-        atomic_fetch_add(&queue->consumer_pull_count, 1);
-        return node;
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != (pos + 1)) {
+        if (!ndw_QWaitForItems(&queue->wait, timeout_in_milliseconds * 1000, ndw_mpscq_ready, queue))
+            return NULL;
     }
 
-// Fetching subsequent nodes
-fetch_next:
-    if (queue->consumer_cached_head != queue->consumer_cached_limit) {
-        ndw_MPSCQNode_T* next = queue->consumer_cached_head->next;
-        queue->consumer_last_accessed_node = queue->consumer_cached_head;
-        queue->consumer_cached_head = next;
-        atomic_fetch_add(&queue->consumer_pull_count, 1);
-        return next;
-    }
+    void* data = slot->data;
+    slot->data = NULL;
 
-    // Refresh limit and try again
-    ndw_MPSCQNode_T* new_limit = (ndw_MPSCQNode_T*)(intptr_t)atomic_load(&queue->consumer_limit);
-    if (new_limit == queue->consumer_cached_limit) {
-        struct timespec req = {
-            .tv_sec  = timeout_in_milliseconds / 1000,
-            .tv_nsec = (timeout_in_milliseconds % 1000) * 1000000
-        };
-        nanosleep(&req, NULL);
-
-        new_limit = (ndw_MPSCQNode_T*)(intptr_t)atomic_load(&queue->consumer_limit);
-        if (new_limit == queue->consumer_cached_limit) return NULL;
-    }
+    // Hand the slot back to producers for the next lap.
+    atomic_store_explicit(&slot->sequence, pos + queue->capacity, memory_order_release);
+    atomic_store_explicit(&queue->consumer_head, pos + 1, memory_order_release);
+    queue->consumer_pull_count += 1;
 
-    queue->consumer_cached_limit = new_limit;
-    goto fetch_next;
+    return data;
 }
 
 void
-ndw_mpscq_release(ndw_MPSCQNode_T* node)
+ndw_mpscq_set_wait_strategy(ndw_MPSCQ_T* queue, INT_T spins, INT_T yields, bool block)
+{
+    ndw_QWaitSetStrategy(&queue->wait, spins, yields, block);
+}
+
+LONG_T
+ndw_mpscq_size(ndw_MPSCQ_T* queue)
 {
-    (void) node;
+    ULONG_T head = atomic_load_explicit(&queue->consumer_head, memory_order_acquire);
+    ULONG_T tail = atomic_load_explicit(&queue->producer_tail, memory_order_acquire);
+    return (tail > head) ? (LONG_T) (tail - head) : 0;
 }
 
 void
 ndw_mpscq_cleanup(ndw_MPSCQ_T* queue)
 {
-    pthread_mutex_lock(&queue->producer_lock);
-
-    ndw_MPSCQNode_T* node = queue->consumer_cached_head;
-    while (node) {
-        ndw_MPSCQNode_T* next = node->next;
-        free(node);
-        node = next;
-    }
-
-    queue->consumer_cached_head = NULL;
-    queue->consumer_last_accessed_node = NULL;
-    queue->consumer_cached_limit = NULL;
-    queue->producer_queue_tail = NULL;
-    atomic_store(&queue->consumer_limit, NULL);
-
-    pthread_mutex_unlock(&queue->producer_lock);
+    if (NULL == queue)
+        return;
+
+    free(queue->slots);
+    queue->slots = NULL;
+    queue->capacity = 0;
+    queue->mask = 0;
+    atomic_store(&queue->producer_tail, 0);
+    atomic_store(&queue->consumer_head, 0);
 }
-
@@ -0,0 +1,931 @@
+
+#include "VendorImpl.h"
+#include "AbstractMessaging.h"
+#include "QueueImpl.h"
+#include "NDW_Metrics.h"
+
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define NDW_METRICS_POLL_MS 100     // How often the exporter thread checks for stop.
+
+/*
+ * BEGIN: Snapshot.
+ */
+
+static CHAR_T*
+ndw_MetricsStrdup(const CHAR_T* s)
+{
+    return strdup((NULL == s) ? "" : s);
+} // end method ndw_MetricsStrdup
+
+static void
+ndw_MetricsAddStats(ndw_TopicStats_T* dest, const ndw_TopicStats_T* src)
+{
+    for (INT_T i = 0; i < NDW_TOPIC_STATS_COUNTERS; i++)
+        dest->counters[i] += src->counters[i];
+} // end method ndw_MetricsAddStats
+
+static void
+ndw_MetricsFillLatency(const ndw_Histogram_T* h, ndw_LatencyMetrics_T* m)
+{
+    if (NULL == h)
+        return;
+
+    m->captured = true;
+    m->count = ndw_HistogramCount(h);
+    if (0 == m->count)
+        return;
+
+    m->sum = __atomic_load_n(&h->total_sum, __ATOMIC_RELAXED);
+    m->min = __atomic_load_n(&h->min_value, __ATOMIC_RELAXED);
+    m->max = __atomic_load_n(&h->max_value, __ATOMIC_RELAXED);
+    m->p50 = ndw_HistogramValueAtPercentile(h, 50.0);
+    m->p90 = ndw_HistogramValueAtPercentile(h, 90.0);
+    m->p99 = ndw_HistogramValueAtPercentile(h, 99.0);
+    m->p999 = ndw_HistogramValueAtPercentile(h, 99.9);
+} // end method ndw_MetricsFillLatency
+
+static void
+ndw_MetricsFillTopic(ndw_Topic_T* t, ndw_ImplAPI_T* impl, ndw_TopicMetrics_T* m)
+{
+    m->topic_id = t->topic_unique_id;
+    m->topic_name = ndw_MetricsStrdup(t->topic_unique_name);
+    m->connection_id = t->connection->connection_unique_id;
+    m->domain_id = t->domain->domain_id;
+    m->disabled = t->disabled;
+
+    ndw_TopicStatsSnapshot(t->stats_index, &m->stats);
+
+    m->sequence_number = __atomic_load_n(&t->sequence_number, __ATOMIC_RELAXED);
+    if (NULL != t->q_async)
+        m->q_async_depth = ndw_QSize(t->q_async);
+    m->q_async_spill_depth = ndw_QSpillCount(t->q_async_spill);
+    m->q_async_dropped_newest = __atomic_load_n(&t->q_async_dropped_newest, __ATOMIC_RELAXED);
+    m->q_async_dropped_oldest = __atomic_load_n(&t->q_async_dropped_oldest, __ATOMIC_RELAXED);
+    m->q_async_evict_failures = __atomic_load_n(&t->q_async_evict_failures, __ATOMIC_RELAXED);
+    m->q_async_blocked = __atomic_load_n(&t->q_async_blocked, __ATOMIC_RELAXED);
+    m->q_async_block_timeouts = __atomic_load_n(&t->q_async_block_timeouts, __ATOMIC_RELAXED);
+    m->q_async_spilled = __atomic_load_n(&t->q_async_spilled, __ATOMIC_RELAXED);
+    m->publish_acks = __atomic_load_n(&t->publish_acks, __ATOMIC_RELAXED);
+    m->publish_ack_failures = __atomic_load_n(&t->publish_ack_failures, __ATOMIC_RELAXED);
+    m->latency_clock_skew = __atomic_load_n(&t->latency_clock_skew, __ATOMIC_RELAXED);
+
+    ndw_MetricsFillLatency(t->latency_histogram, &m->latency);
+    ndw_MetricsFillLatency(t->q_async_dwell_histogram, &m->q_async_dwell);
+
+    if ((! t->disabled) && (NULL != impl) && (NULL != impl->GetTopicMetrics))
+        impl->GetTopicMetrics(t, m);
+} // end method ndw_MetricsFillTopic
+
+static ndw_ImplAPI_T*
+ndw_MetricsGetImpl(ndw_Connection_T* c)
+{
+    if ((c->vendor_id < 1) || (c->vendor_id >= NDW_MAX_API_IMPLEMENTATIONS))
+        return NULL;
+
+    return get_Implementation_API(c->vendor_id);
+} // end method ndw_MetricsGetImpl
+
+// Appends the Connection and its Topics to the snapshot. Returns 0 on success, else < 0.
+static INT_T
+ndw_MetricsAddConnection(ndw_StatsSnapshot_T* s, ndw_Connection_T* c, ndw_DomainMetrics_T* dm)
+{
+    INT_T total_topics = 0;
+    ndw_Topic_T** topics = ndw_GetAllTopicsFromConnection(c, &total_topics);
+    if (NULL == topics)
+        total_topics = 0;
+
+    if (total_topics > 0) {
+        ndw_TopicMetrics_T* grown = (ndw_TopicMetrics_T*)
+            realloc(s->topics, (s->num_topics + total_topics) * sizeof(ndw_TopicMetrics_T));
+        if (NULL == grown) {
+            free(topics);
+            return -1;
+        }
+        s->topics = grown;
+        memset(&s->topics[s->num_topics], 0, total_topics * sizeof(ndw_TopicMetrics_T));
+    }
+
+    ndw_ConnectionMetrics_T* cm = &s->connections[s->num_connections++];
+    cm->connection_id = c->connection_unique_id;
+    cm->connection_name = ndw_MetricsStrdup(c->connection_unique_name);
+    cm->vendor_name = ndw_MetricsStrdup(c->vendor_name);
+    cm->domain_id = dm->domain_id;
+    cm->disabled = c->disabled;
+    cm->num_topics = total_topics;
+
+    ndw_ImplAPI_T* impl = ndw_MetricsGetImpl(c);
+
+    for (INT_T k = 0; k < total_topics; k++) {
+        ndw_TopicMetrics_T* tm = &s->topics[s->num_topics++];
+        ndw_MetricsFillTopic(topics[k], impl, tm);
+
+        ndw_MetricsAddStats(&cm->stats, &tm->stats);
+        cm->q_async_depth += tm->q_async_depth;
+        cm->vendor_pending_msgs += tm->vendor_pending_msgs;
+        cm->vendor_dropped_msgs += tm->vendor_dropped_msgs;
+    }
+
+    free(topics);
+
+    if ((! c->disabled) && (NULL != impl)) {
+        if (NULL != impl->IsConnected)
+            cm->connected = impl->IsConnected(c);
+        if (NULL != impl->GetConnectionMetrics)
+            impl->GetConnectionMetrics(c, cm);
+    }
+
+    dm->num_topics += total_topics;
+    ndw_MetricsAddStats(&dm->stats, &cm->stats);
+    dm->q_async_depth += cm->q_async_depth;
+    dm->vendor_pending_msgs += cm->vendor_pending_msgs;
+    dm->vendor_dropped_msgs += cm->vendor_dropped_msgs;
+
+    return 0;
+} // end method ndw_MetricsAddConnection
+
+ndw_StatsSnapshot_T*
+ndw_GetStatsSnapshot()
+{
+    if (NULL == ndw_GetDomainHandle())
+        return NULL;
+
+    INT_T total_domains = 0;
+    ndw_Domain_T** domains = ndw_GetAllDomains(&total_domains);
+    if ((NULL == domains) || (total_domains <= 0)) {
+        free(domains);
+        return NULL;
+    }
+
+    ndw_StatsSnapshot_T* s = (ndw_StatsSnapshot_T*) calloc(1, sizeof(ndw_StatsSnapshot_T));
+    if (NULL == s) {
+        NDW_LOGERR("Failed to allocate memory for ndw_StatsSnapshot_T\n");
+        free(domains);
+        return NULL;
+    }
+
+    s->snapshot_time = ndw_GetCurrentUTCNanoseconds();
+    s->app_id = ndw_GetAppId();
+    s->domains = (ndw_DomainMetrics_T*) calloc(total_domains, sizeof(ndw_DomainMetrics_T));
+    if (NULL == s->domains)
+        goto error;
+
+    for (INT_T i = 0; i < total_domains; i++) {
+        ndw_Domain_T* d = domains[i];
+        ndw_DomainMetrics_T* dm = &s->domains[s->num_domains++];
+        dm->domain_id = d->domain_id;
+        dm->domain_name = ndw_MetricsStrdup(d->domain_name);
+
+        INT_T total_connections = 0;
+        ndw_Connection_T** connections = ndw_GetAllConnectionsFromDomain(d, &total_connections);
+        if ((NULL == connections) || (total_connections <= 0)) {
+            free(connections);
+            continue;
+        }
+
+        ndw_ConnectionMetrics_T* grown = (ndw_ConnectionMetrics_T*)
+            realloc(s->connections, (s->num_connections + total_connections) * sizeof(ndw_ConnectionMetrics_T));
+        if (NULL == grown) {
+            free(connections);
+            goto error;
+        }
+        s->connections = grown;
+        memset(&s->connections[s->num_connections], 0, total_connections * sizeof(ndw_ConnectionMetrics_T));
+
+        for (INT_T j = 0; j < total_connections; j++) {
+            if (0 != ndw_MetricsAddConnection(s, connections[j], dm)) {
+                free(connections);
+                goto error;
+            }
+            dm->num_connections += 1;
+        }
+
+        free(connections);
+    }
+
+    free(domains);
+    return s;
+
+error:
+    NDW_LOGERR("Failed to allocate memory for statistics snapshot\n");
+    free(domains);
+    ndw_FreeStatsSnapshot(s);
+    return NULL;
+} // end method ndw_GetStatsSnapshot
+
+void
+ndw_FreeStatsSnapshot(ndw_StatsSnapshot_T* s)
+{
+    if (NULL == s)
+        return;
+
+    for (INT_T i = 0; i < s->num_domains; i++)
+        free(s->domains[i].domain_name);
+
+    for (INT_T i = 0; i < s->num_connections; i++) {
+        free(s->connections[i].connection_name);
+        free(s->connections[i].vendor_name);
+    }
+
+    for (INT_T i = 0; i < s->num_topics; i++)
+        free(s->topics[i].topic_name);
+
+    free(s->domains);
+    free(s->connections);
+    free(s->topics);
+    free(s);
+} // end method ndw_FreeStatsSnapshot
+
+/*
+ * END: Snapshot.
+ */
+
+/*
+ * BEGIN: Formatting.
+ */
+
+// LONG_T fields of the metrics structures, by offset, so both formats list the same fields under the same names.
+typedef struct ndw_MetricField
+{
+    const CHAR_T* name;
+    bool counter;           // Else gauge.
+    size_t offset;
+    const CHAR_T* help;
+} ndw_MetricField_T;
+
+#define NDW_METRIC_FIELD(type, name, counter, help) { #name, counter, offsetof(type, name), help }
+#define NDW_METRIC_FIELDS(fields) ((INT_T) (sizeof(fields) / sizeof(fields[0])))
+#define NDW_METRIC_VALUE(ptr, field) (*(const LONG_T*) (((const CHAR_T*) (ptr)) + (field)->offset))
+
+static const ndw_MetricField_T ndw_topic_fields[] = {
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, sequence_number, false, "Application sequence number of the Topic."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_depth, false, "Messages in the asynchronous queue not yet polled."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_spill_depth, false, "Messages waiting in the asynchronous queue spill list."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_dropped_newest, true, "Incoming messages dropped as the asynchronous queue was full."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_dropped_oldest, true, "Queued messages evicted to make room."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_evict_failures, true, "DropOldest evictions that failed, so the newest was dropped."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_blocked, true, "Inserts that blocked on a full asynchronous queue."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_block_timeouts, true, "Blocked inserts that timed out and were dropped."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, q_async_spilled, true, "Messages placed in the spill list."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, publish_acks, true, "Durable asynchronous publishes acknowledged."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, publish_ack_failures, true, "Durable asynchronous publishes that failed."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, latency_clock_skew, true, "Messages not captured as the sender clock was ahead."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, vendor_pending_msgs, false, "Messages held by the vendor library not yet delivered."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, vendor_pending_bytes, false, "Bytes held by the vendor library not yet delivered."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, vendor_delivered_msgs, true, "Messages delivered by the vendor library."),
+    NDW_METRIC_FIELD(ndw_TopicMetrics_T, vendor_dropped_msgs, true, "Messages dropped by the vendor library.")
+};
+
+static const ndw_MetricField_T ndw_connection_fields[] = {
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, q_async_depth, false, "Messages in asynchronous queues not yet polled."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_pending_msgs, false, "Messages held by the vendor library not yet delivered."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_dropped_msgs, true, "Messages dropped by the vendor library."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, backoff_attempts, true, "Publish retries after the vendor refused a message."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, would_block, true, "Publishes refused as the outbound buffer was full."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, throttle_waits, true, "Publishes that waited for the outbound buffer to drain."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, async_publish_pending, false, "Durable asynchronous publishes not yet acknowledged."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_connections, false, "Physical vendor connections open."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_buffered_bytes, false, "Bytes in the vendor outbound buffer."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_reconnects, true, "Reconnects to the vendor messaging system."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_in_msgs, true, "Messages received by the vendor library."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_in_bytes, true, "Bytes received by the vendor library."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_out_msgs, true, "Messages sent by the vendor library."),
+    NDW_METRIC_FIELD(ndw_ConnectionMetrics_T, vendor_out_bytes, true, "Bytes sent by the vendor library.")
+};
+
+static const ndw_MetricField_T ndw_domain_fields[] = {
+    NDW_METRIC_FIELD(ndw_DomainMetrics_T, q_async_depth, false, "Messages in asynchronous queues not yet polled."),
+    NDW_METRIC_FIELD(ndw_DomainMetrics_T, vendor_pending_msgs, false, "Messages held by the vendor library not yet delivered."),
+    NDW_METRIC_FIELD(ndw_DomainMetrics_T, vendor_dropped_msgs, true, "Messages dropped by the vendor library.")
+};
+
+// Growable text buffer. On allocation failure it stops growing and marks itself failed.
+typedef struct ndw_MetricsText
+{
+    CHAR_T* data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} ndw_MetricsText_T;
+
+static void ndw_MetricsAppend(ndw_MetricsText_T* text, const CHAR_T* format, ...) __attribute__((format(printf, 2, 3)));
+
+static void
+ndw_MetricsAppend(ndw_MetricsText_T* text, const CHAR_T* format, ...)
+{
+    if (text->failed)
+        return;
+
+    for (;;) {
+        size_t available = text->capacity - text->length;
+        va_list args;
+        va_start(args, format);
+        INT_T n = vsnprintf((NULL == text->data) ? NULL : text->data + text->length, available, format, args);
+        va_end(args);
+
+        if (n < 0) {
+            text->failed = true;
+            return;
+        }
+
+        if (((size_t) n) < available) {
+            text->length += n;
+            return;
+        }
+
+        size_t capacity = (0 == text->capacity) ? 16384 : text->capacity;
+        while (capacity <= (text->length + n))
+            capacity *= 2;
+
+        CHAR_T* data = (CHAR_T*) realloc(text->data, capacity);
+        if (NULL == data) {
+            text->failed = true;
+            return;
+        }
+
+        text->data = data;
+        text->capacity = capacity;
+    }
+} // end method ndw_MetricsAppend
+
+// Prometheus label value escaping: backslash, double quote and newline.
+static void
+ndw_MetricsAppendLabel(ndw_MetricsText_T* text, const CHAR_T* name, const CHAR_T* value, bool first)
+{
+    ndw_MetricsAppend(text, "%s%s=\"", first ? "" : ",", name);
+    for (const CHAR_T* p = (NULL == value) ? "" : value; '\0' != *p; p++) {
+        if (('\\' == *p) || ('"' == *p))
+            ndw_MetricsAppend(text, "\\%c", *p);
+        else if ('\n' == *p)
+            ndw_MetricsAppend(text, "\\n");
+        else
+            ndw_MetricsAppend(text, "%c", *p);
+    }
+    ndw_MetricsAppend(text, "\"");
+} // end method ndw_MetricsAppendLabel
+
+static void
+ndw_MetricsAppendFamily(ndw_MetricsText_T* text, const CHAR_T* scope, const CHAR_T* name, bool counter, const CHAR_T* help)
+{
+    const CHAR_T* suffix = counter ? "_total" : "";
+    ndw_MetricsAppend(text, "# HELP ndw_%s_%s%s %s\n", scope, name, suffix, help);
+    ndw_MetricsAppend(text, "# TYPE ndw_%s_%s%s %s\n", scope, name, suffix, counter ? "counter" : "gauge");
+} // end method ndw_MetricsAppendFamily
+
+static void
+ndw_MetricsAppendSummary(ndw_MetricsText_T* text, const ndw_StatsSnapshot_T* s, CHAR_T** topic_labels,
+                         const CHAR_T* name, const CHAR_T* help, size_t offset)
+{
+    bool any = false;
+    for (INT_T k = 0; k < s->num_topics; k++)
+        any |= ((const ndw_LatencyMetrics_T*) (((const CHAR_T*) &s->topics[k]) + offset))->captured;
+    if (! any)
+        return;
+
+    ndw_MetricsAppend(text, "# HELP ndw_topic_%s %s\n# TYPE ndw_topic_%s summary\n", name, help, name);
+    for (INT_T k = 0; k < s->num_topics; k++) {
+        const ndw_LatencyMetrics_T* m = (const ndw_LatencyMetrics_T*) (((const CHAR_T*) &s->topics[k]) + offset);
+        if (! m->captured)
+            continue;
+
+        const CHAR_T* labels = topic_labels[k];
+        ndw_MetricsAppend(text, "ndw_topic_%s{%s,quantile=\"0.5\"} %" PRIu64 "\n", name, labels, m->p50);
+        ndw_MetricsAppend(text, "ndw_topic_%s{%s,quantile=\"0.9\"} %" PRIu64 "\n", name, labels, m->p90);
+        ndw_MetricsAppend(text, "ndw_topic_%s{%s,quantile=\"0.99\"} %" PRIu64 "\n", name, labels, m->p99);
+        ndw_MetricsAppend(text, "ndw_topic_%s{%s,quantile=\"0.999\"} %" PRIu64 "\n", name, labels, m->p999);
+        ndw_MetricsAppend(text, "ndw_topic_%s_sum{%s} %" PRIu64 "\n", name, labels, m->sum);
+        ndw_MetricsAppend(text, "ndw_topic_%s_count{%s} %" PRIu64 "\n", name, labels, m->count);
+    }
+} // end method ndw_MetricsAppendSummary
+
+static void
+ndw_MetricsFreeLabels(CHAR_T** labels, INT_T count)
+{
+    if (NULL == labels)
+        return;
+
+    for (INT_T i = 0; i < count; i++)
+        free(labels[i]);
+    free(labels);
+} // end method ndw_MetricsFreeLabels
+
+// Builds the label set of every Domain, Connection and Topic, relying on the grouping order of the snapshot.
+static bool
+ndw_MetricsBuildLabels(const ndw_StatsSnapshot_T* s, CHAR_T*** domain_labels, CHAR_T*** connection_labels, CHAR_T*** topic_labels)
+{
+    *domain_labels = (CHAR_T**) calloc(s->num_domains + 1, sizeof(CHAR_T*));
+    *connection_labels = (CHAR_T**) calloc(s->num_connections + 1, sizeof(CHAR_T*));
+    *topic_labels = (CHAR_T**) calloc(s->num_topics + 1, sizeof(CHAR_T*));
+    if ((NULL == *domain_labels) || (NULL == *connection_labels) || (NULL == *topic_labels))
+        return false;
+
+    INT_T c = 0, t = 0;
+    for (INT_T d = 0; d < s->num_domains; d++) {
+        const ndw_DomainMetrics_T* dm = &s->domains[d];
+        ndw_MetricsText_T text = { 0 };
+        ndw_MetricsAppendLabel(&text, "domain", dm->domain_name, true);
+        if (text.failed)
+            return false;
+        (*domain_labels)[d] = text.data;
+
+        for (INT_T j = 0; (j < dm->num_connections) && (c < s->num_connections); j++, c++) {
+            const ndw_ConnectionMetrics_T* cm = &s->connections[c];
+            ndw_MetricsText_T ctext = { 0 };
+            ndw_MetricsAppend(&ctext, "%s", (*domain_labels)[d]);
+            ndw_MetricsAppendLabel(&ctext, "connection", cm->connection_name, false);
+            ndw_MetricsAppendLabel(&ctext, "vendor", cm->vendor_name, false);
+            if (ctext.failed)
+                return false;
+            (*connection_labels)[c] = ctext.data;
+
+            for (INT_T k = 0; (k < cm->num_topics) && (t < s->num_topics); k++, t++) {
+                const ndw_TopicMetrics_T* tm = &s->topics[t];
+                ndw_MetricsText_T ttext = { 0 };
+                ndw_MetricsAppendLabel(&ttext, "domain", dm->domain_name, true);
+                ndw_MetricsAppendLabel(&ttext, "connection", cm->connection_name, false);
+                ndw_MetricsAppendLabel(&ttext, "topic", tm->topic_name, false);
+                ndw_MetricsAppend(&ttext, ",topic_id=\"%d\"", tm->topic_id);
+                if (ttext.failed)
+                    return false;
+                (*topic_labels)[t] = ttext.data;
+            }
+        }
+    }
+
+    return true;
+} // end method ndw_MetricsBuildLabels
+
+CHAR_T*
+ndw_StatsSnapshotToPrometheus(const ndw_StatsSnapshot_T* s)
+{
+    if (NULL == s)
+        return NULL;
+
+    CHAR_T** domain_labels = NULL;
+    CHAR_T** connection_labels = NULL;
+    CHAR_T** topic_labels = NULL;
+    ndw_MetricsText_T text = { 0 };
+
+    if (! ndw_MetricsBuildLabels(s, &domain_labels, &connection_labels, &topic_labels)) {
+        text.failed = true;
+        goto done;
+    }
+
+    // Domains.
+    ndw_MetricsAppendFamily(&text, "domain", "connections", false, "Connections of the Domain.");
+    for (INT_T d = 0; d < s->num_domains; d++)
+        ndw_MetricsAppend(&text, "ndw_domain_connections{%s} %d\n", domain_labels[d], s->domains[d].num_connections);
+
+    ndw_MetricsAppendFamily(&text, "domain", "topics", false, "Topics of the Domain.");
+    for (INT_T d = 0; d < s->num_domains; d++)
+        ndw_MetricsAppend(&text, "ndw_domain_topics{%s} %d\n", domain_labels[d], s->domains[d].num_topics);
+
+    for (INT_T f = 0; f < NDW_METRIC_FIELDS(ndw_domain_fields); f++) {
+        const ndw_MetricField_T* field = &ndw_domain_fields[f];
+        ndw_MetricsAppendFamily(&text, "domain", field->name, field->counter, field->help);
+        for (INT_T d = 0; d < s->num_domains; d++)
+            ndw_MetricsAppend(&text, "ndw_domain_%s%s{%s} %ld\n", field->name, field->counter ? "_total" : "",
+                                domain_labels[d], NDW_METRIC_VALUE(&s->domains[d], field));
+    }
+
+    // Connections.
+    ndw_MetricsAppendFamily(&text, "connection", "connected", false, "1 if the Connection is connected.");
+    for (INT_T c = 0; c < s->num_connections; c++)
+        ndw_MetricsAppend(&text, "ndw_connection_connected{%s} %d\n", connection_labels[c], s->connections[c].connected ? 1 : 0);
+
+    for (INT_T f = 0; f < NDW_METRIC_FIELDS(ndw_connection_fields); f++) {
+        const ndw_MetricField_T* field = &ndw_connection_fields[f];
+        ndw_MetricsAppendFamily(&text, "connection", field->name, field->counter, field->help);
+        for (INT_T c = 0; c < s->num_connections; c++)
+            ndw_MetricsAppend(&text, "ndw_connection_%s%s{%s} %ld\n", field->name, field->counter ? "_total" : "",
+                                connection_labels[c], NDW_METRIC_VALUE(&s->connections[c], field));
+    }
+
+    // Topics.
+    for (INT_T i = 0; i < NDW_TOPIC_STATS_COUNTERS; i++) {
+        const CHAR_T* name = ndw_TopicStatsName(i);
+        ndw_MetricsAppendFamily(&text, "topic", name, true, "Topic message counter.");
+        for (INT_T k = 0; k < s->num_topics; k++)
+            ndw_MetricsAppend(&text, "ndw_topic_%s_total{%s} %ld\n", name, topic_labels[k], s->topics[k].stats.counters[i]);
+    }
+
+    for (INT_T f = 0; f < NDW_METRIC_FIELDS(ndw_topic_fields); f++) {
+        const ndw_MetricField_T* field = &ndw_topic_fields[f];
+        ndw_MetricsAppendFamily(&text, "topic", field->name, field->counter, field->help);
+        for (INT_T k = 0; k < s->num_topics; k++)
+            ndw_MetricsAppend(&text, "ndw_topic_%s%s{%s} %ld\n", field->name, field->counter ? "_total" : "",
+                                topic_labels[k], NDW_METRIC_VALUE(&s->topics[k], field));
+    }
+
+    ndw_MetricsAppendSummary(&text, s, topic_labels, "latency_nanoseconds",
+                            "Publish to receive latency.", offsetof(ndw_TopicMetrics_T, latency));
+    ndw_MetricsAppendSummary(&text, s, topic_labels, "q_async_dwell_nanoseconds",
+                            "Time received messages spent in the asynchronous queue.", offsetof(ndw_TopicMetrics_T, q_async_dwell));
+
+done:
+    ndw_MetricsFreeLabels(domain_labels, s->num_domains);
+    ndw_MetricsFreeLabels(connection_labels, s->num_connections);
+    ndw_MetricsFreeLabels(topic_labels, s->num_topics);
+
+    if (text.failed) {
+        NDW_LOGERR("Failed to allocate memory for Prometheus metrics text\n");
+        free(text.data);
+        return NULL;
+    }
+
+    return text.data;
+} // end method ndw_StatsSnapshotToPrometheus
+
+static void
+ndw_MetricsAddFieldsToJSON(cJSON* object, const void* metrics, const ndw_MetricField_T* fields, INT_T num_fields)
+{
+    for (INT_T f = 0; f < num_fields; f++)
+        cJSON_AddNumberToObject(object, fields[f].name, (double) NDW_METRIC_VALUE(metrics, &fields[f]));
+} // end method ndw_MetricsAddFieldsToJSON
+
+static void
+ndw_MetricsAddStatsToJSON(cJSON* object, const ndw_TopicStats_T* stats)
+{
+    for (INT_T i = 0; i < NDW_TOPIC_STATS_COUNTERS; i++)
+        cJSON_AddNumberToObject(object, ndw_TopicStatsName(i), (double) stats->counters[i]);
+} // end method ndw_MetricsAddStatsToJSON
+
+static void
+ndw_MetricsAddLatencyToJSON(cJSON* object, const CHAR_T* name, const ndw_LatencyMetrics_T* m)
+{
+    if (! m->captured)
+        return;
+
+    cJSON* latency = cJSON_AddObjectToObject(object, name);
+    if (NULL == latency)
+        return;
+
+    cJSON_AddNumberToObject(latency, "count", (double) m->count);
+    cJSON_AddNumberToObject(latency, "sum", (double) m->sum);
+    cJSON_AddNumberToObject(latency, "min", (double) ((0 == m->count) ? 0 : m->min));
+    cJSON_AddNumberToObject(latency, "p50", (double) m->p50);
+    cJSON_AddNumberToObject(latency, "p90", (double) m->p90);
+    cJSON_AddNumberToObject(latency, "p99", (double) m->p99);
+    cJSON_AddNumberToObject(latency, "p999", (double) m->p999);
+    cJSON_AddNumberToObject(latency, "max", (double) m->max);
+} // end method ndw_MetricsAddLatencyToJSON
+
+CHAR_T*
+ndw_StatsSnapshotToJSON(const ndw_StatsSnapshot_T* s)
+{
+    if (NULL == s)
+        return NULL;
+
+    cJSON* root = cJSON_CreateObject();
+    if (NULL == root)
+        return NULL;
+
+    cJSON_AddNumberToObject(root, "snapshot_time", (double) s->snapshot_time);
+    cJSON_AddNumberToObject(root, "app_id", s->app_id);
+    cJSON* domains = cJSON_AddArrayToObject(root, "domains");
+
+    INT_T c = 0, t = 0;
+    for (INT_T d = 0; (NULL != domains) && (d < s->num_domains); d++) {
+        const ndw_DomainMetrics_T* dm = &s->domains[d];
+        cJSON* domain = cJSON_CreateObject();
+        if (NULL == domain)
+            break;
+        cJSON_AddItemToArray(domains, domain);
+
+        cJSON_AddNumberToObject(domain, "domain_id", dm->domain_id);
+        cJSON_AddStringToObject(domain, "domain_name", dm->domain_name);
+        cJSON_AddNumberToObject(domain, "num_connections", dm->num_connections);
+        cJSON_AddNumberToObject(domain, "num_topics", dm->num_topics);
+        ndw_MetricsAddStatsToJSON(domain, &dm->stats);
+        ndw_MetricsAddFieldsToJSON(domain, dm, ndw_domain_fields, NDW_METRIC_FIELDS(ndw_domain_fields));
+        cJSON* connections = cJSON_AddArrayToObject(domain, "connections");
+
+        for (INT_T j = 0; (NULL != connections) && (j < dm->num_connections) && (c < s->num_connections); j++, c++) {
+            const ndw_ConnectionMetrics_T* cm = &s->connections[c];
+            cJSON* connection = cJSON_CreateObject();
+            if (NULL == connection)
+                break;
+            cJSON_AddItemToArray(connections, connection);
+
+            cJSON_AddNumberToObject(connection, "connection_id", cm->connection_id);
+            cJSON_AddStringToObject(connection, "connection_name", cm->connection_name);
+            cJSON_AddStringToObject(connection, "vendor_name", cm->vendor_name);
+            cJSON_AddBoolToObject(connection, "disabled", cm->disabled);
+            cJSON_AddBoolToObject(connection, "connected", cm->connected);
+            cJSON_AddNumberToObject(connection, "num_topics", cm->num_topics);
+            ndw_MetricsAddStatsToJSON(connection, &cm->stats);
+            ndw_MetricsAddFieldsToJSON(connection, cm, ndw_connection_fields, NDW_METRIC_FIELDS(ndw_connection_fields));
+            cJSON* topics = cJSON_AddArrayToObject(connection, "topics");
+
+            for (INT_T k = 0; (NULL != topics) && (k < cm->num_topics) && (t < s->num_topics); k++, t++) {
+                const ndw_TopicMetrics_T* tm = &s->topics[t];
+                cJSON* topic = cJSON_CreateObject();
+                if (NULL == topic)
+                    break;
+                cJSON_AddItemToArray(topics, topic);
+
+                cJSON_AddNumberToObject(topic, "topic_id", tm->topic_id);
+                cJSON_AddStringToObject(topic, "topic_name", tm->topic_name);
+                cJSON_AddBoolToObject(topic, "disabled", tm->disabled);
+                ndw_MetricsAddStatsToJSON(topic, &tm->stats);
+                ndw_MetricsAddFieldsToJSON(topic, tm, ndw_topic_fields, NDW_METRIC_FIELDS(ndw_topic_fields));
+                ndw_MetricsAddLatencyToJSON(topic, "latency", &tm->latency);
+                ndw_MetricsAddLatencyToJSON(topic, "q_async_dwell", &tm->q_async_dwell);
+            }
+        }
+    }
+
+    CHAR_T* json = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return json;
+} // end method ndw_StatsSnapshotToJSON
+
+/*
+ * END: Formatting.
+ */
+
+/*
+ * BEGIN: Exporter thread.
+ */
+
+static pthread_t ndw_metrics_thread;
+static bool ndw_metrics_running = false;
+static bool ndw_metrics_stop = false;
+static INT_T ndw_metrics_listen_fd = -1;
+static CHAR_T* ndw_metrics_file_path = NULL;
+static LONG_T ndw_metrics_interval_ms = NDW_METRICS_DEFAULT_INTERVAL_MS;
+
+static CHAR_T*
+ndw_MetricsRender(bool json)
+{
+    ndw_StatsSnapshot_T* s = ndw_GetStatsSnapshot();
+    if (NULL == s)
+        return NULL;
+
+    CHAR_T* text = json ? ndw_StatsSnapshotToJSON(s) : ndw_StatsSnapshotToPrometheus(s);
+    ndw_FreeStatsSnapshot(s);
+    return text;
+} // end method ndw_MetricsRender
+
+// Write to a temporary file and rename it, so readers never see a partial file.
+static void
+ndw_MetricsWriteFile()
+{
+    const CHAR_T* path = ndw_metrics_file_path;
+    size_t length = strlen(path);
+    bool json = (length >= 5) && (0 == strcasecmp(path + length - 5, ".json"));
+
+    CHAR_T* text = ndw_MetricsRender(json);
+    if (NULL == text)
+        return;
+
+    CHAR_T* tmp_path = (CHAR_T*) malloc(length + 5);
+    if (NULL == tmp_path) {
+        free(text);
+        return;
+    }
+    snprintf(tmp_path, length + 5, "%s.tmp", path);
+
+    FILE* fp = fopen(tmp_path, "w");
+    if (NULL == fp) {
+        NDW_LOGERR("*** ERROR: Cannot open metrics file <%s>: %s\n", tmp_path, strerror(errno));
+    }
+    else {
+        bool ok = (EOF != fputs(text, fp));
+        ok = (0 == fclose(fp)) && ok;
+        if (! ok || (0 != rename(tmp_path, path))) {
+            NDW_LOGERR("*** ERROR: Failed to write metrics file <%s>: %s\n", path, strerror(errno));
+            unlink(tmp_path);
+        }
+    }
+
+    free(tmp_path);
+    free(text);
+} // end method ndw_MetricsWriteFile
+
+static void
+ndw_MetricsSendAll(INT_T fd, const CHAR_T* data, size_t length)
+{
+    while (length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if ((n < 0) && (EINTR == errno))
+                continue;
+            return;
+        }
+        data += n;
+        length -= n;
+    }
+} // end method ndw_MetricsSendAll
+
+// Minimal HTTP/1.1: one GET per connection, then close.
+static void
+ndw_MetricsServeClient(INT_T fd)
+{
+    struct timeval tv = { 1, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    CHAR_T request[2048];
+    size_t length = 0;
+    while (length < (sizeof(request) - 1)) {
+        ssize_t n = recv(fd, request + length, sizeof(request) - 1 - length, 0);
+        if (n <= 0)
+            break;
+        length += n;
+        request[length] = '\0';
+        if (NULL != strstr(request, "\r\n\r\n"))
+            break;
+    }
+    request[length] = '\0';
+
+    CHAR_T method[16], path[256];
+    if (2 != sscanf(request, "%15s %255s", method, path))
+        return;
+
+    CHAR_T* query = strchr(path, '?');
+    if (NULL != query)
+        *query = '\0';
+
+    const CHAR_T* status = "200 OK";
+    const CHAR_T* content_type = "text/plain; charset=utf-8";
+    CHAR_T* body = NULL;
+
+    if (0 != strcmp(method, "GET")) {
+        status = "405 Method Not Allowed";
+    }
+    else if ((0 == strcmp(path, "/metrics")) || (0 == strcmp(path, "/"))) {
+        content_type = "text/plain; version=0.0.4; charset=utf-8";
+        if (NULL == (body = ndw_MetricsRender(false)))
+            status = "503 Service Unavailable";
+    }
+    else if (0 == strcmp(path, "/metrics.json")) {
+        content_type = "application/json";
+        if (NULL == (body = ndw_MetricsRender(true)))
+            status = "503 Service Unavailable";
+    }
+    else {
+        status = "404 Not Found";
+    }
+
+    size_t body_length = (NULL == body) ? 0 : strlen(body);
+    CHAR_T header[256];
+    INT_T header_length = snprintf(header, sizeof(header),
+            "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+            status, content_type, body_length);
+
+    ndw_MetricsSendAll(fd, header, header_length);
+    if (NULL != body)
+        ndw_MetricsSendAll(fd, body, body_length);
+
+    free(body);
+} // end method ndw_MetricsServeClient
+
+static LONG_T
+ndw_MetricsMonotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000L) + (ts.tv_nsec / 1000000L);
+} // end method ndw_MetricsMonotonicMs
+
+static void*
+ndw_MetricsExporterThread(void* arg)
+{
+    (void) arg;
+
+    LONG_T next_write = 0;
+    while (! __atomic_load_n(&ndw_metrics_stop, __ATOMIC_ACQUIRE)) {
+        LONG_T wait_ms = NDW_METRICS_POLL_MS;
+
+        if (NULL != ndw_metrics_file_path) {
+            LONG_T now = ndw_MetricsMonotonicMs();
+            if (now >= next_write) {
+                ndw_MetricsWriteFile();
+                next_write = now + ndw_metrics_interval_ms;
+            }
+            if ((next_write - now) < wait_ms)
+                wait_ms = (next_write > now) ? (next_write - now) : 0;
+        }
+
+        if (ndw_metrics_listen_fd >= 0) {
+            struct pollfd pfd = { .fd = ndw_metrics_listen_fd, .events = POLLIN, .revents = 0 };
+            if ((poll(&pfd, 1, (INT_T) wait_ms) > 0) && (pfd.revents & POLLIN)) {
+                INT_T client = accept(ndw_metrics_listen_fd, NULL, NULL);
+                if (client >= 0) {
+                    ndw_MetricsServeClient(client);
+                    close(client);
+                }
+            }
+        }
+        else {
+            struct timespec ts = { wait_ms / 1000, (wait_ms % 1000) * 1000000L };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    // Leave the file with the final counts.
+    if (NULL != ndw_metrics_file_path)
+        ndw_MetricsWriteFile();
+
+    return NULL;
+} // end method ndw_MetricsExporterThread
+
+static INT_T
+ndw_MetricsListen(INT_T port)
+{
+    INT_T fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        NDW_LOGERR("*** ERROR: Metrics socket() failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    INT_T on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t) port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((0 != bind(fd, (struct sockaddr*) &addr, sizeof(addr))) || (0 != listen(fd, 8))) {
+        NDW_LOGERR("*** ERROR: Cannot listen for metrics on 127.0.0.1:%d: %s\n", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+} // end method ndw_MetricsListen
+
+INT_T
+ndw_MetricsExporterStart(INT_T port, const CHAR_T* file_path, LONG_T interval_ms)
+{
+    if (ndw_metrics_running) {
+        NDW_LOGERR("*** WARNING: Metrics exporter is already running\n");
+        return -1;
+    }
+
+    bool has_file = (NULL != file_path) && ('\0' != *file_path);
+    if ((port <= 0) && (! has_file))
+        return 0;
+
+    if (port > 65535) {
+        NDW_LOGERR("*** ERROR: Invalid metrics port<%d>\n", port);
+        return -2;
+    }
+
+    if ((port > 0) && ((ndw_metrics_listen_fd = ndw_MetricsListen(port)) < 0))
+        return -3;
+
+    ndw_metrics_file_path = has_file ? strdup(file_path) : NULL;
+    ndw_metrics_interval_ms = (interval_ms > 0) ? interval_ms : NDW_METRICS_DEFAULT_INTERVAL_MS;
+    __atomic_store_n(&ndw_metrics_stop, false, __ATOMIC_RELEASE);
+
+    if (0 != pthread_create(&ndw_metrics_thread, NULL, ndw_MetricsExporterThread, NULL)) {
+        NDW_LOGERR("*** ERROR: Failed to create metrics exporter thread\n");
+        if (ndw_metrics_listen_fd >= 0)
+            close(ndw_metrics_listen_fd);
+        ndw_metrics_listen_fd = -1;
+        free(ndw_metrics_file_path);
+        ndw_metrics_file_path = NULL;
+        return -4;
+    }
+
+    ndw_metrics_running = true;
+    NDW_LOGX("Metrics exporter started: port<%d> file<%s> interval_ms<%ld>\n",
+                port, has_file ? file_path : "", ndw_metrics_interval_ms);
+    return 0;
+} // end method ndw_MetricsExporterStart
+
+void
+ndw_MetricsExporterStop()
+{
+    if (! ndw_metrics_running)
+        return;
+
+    __atomic_store_n(&ndw_metrics_stop, true, __ATOMIC_RELEASE);
+    pthread_join(ndw_metrics_thread, NULL);
+
+    if (ndw_metrics_listen_fd >= 0)
+        close(ndw_metrics_listen_fd);
+    ndw_metrics_listen_fd = -1;
+
+    free(ndw_metrics_file_path);
+    ndw_metrics_file_path = NULL;
+    ndw_metrics_running = false;
+} // end method ndw_MetricsExporterStop
+
+/*
+ * END: Exporter thread.
+ */
+
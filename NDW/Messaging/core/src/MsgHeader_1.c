@@ -2,6 +2,7 @@
 #include "MsgHeader_1.h"
 
 extern int ndw_verbose;
+extern INT_T ndw_app_id;
 
 void
 ndw_MsgHeader1_Init()
@@ -22,6 +23,7 @@ ndw_MsgHeader1_Init()
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].Print = ndw_MsgHeader1_Print;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].Compare = ndw_MsgHeader1_Compare;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].LE_MsgHeaderSize = ndw_MsgHeader1_LE_MsgHeaderSize;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_1].GetTimestamp = ndw_MsgHeader1_GetTimestamp;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].SetOutMsgFields = ndw_MsgHeader1_SetOutMsgFields;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].ConvertToLE = ndw_MsgHeader1_ConvertToLE;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].ConvertFromLE = ndw_MsgHeader1_ConvertFromLE;
@@ -224,6 +226,15 @@ ndw_MsgHeader1_LE_MsgHeaderSize(int header_id)
 
 } // end method ndw_MsgHeader1_LE_MsgHeaderSize
 
+ULONG_T
+ndw_MsgHeader1_GetTimestamp(int header_id, UCHAR_T* pHeader)
+{
+    if ((NDW_MSGHEADER_1 != header_id) || (NULL == pHeader))
+        return 0;
+
+    return ((ndw_MsgHeader1_T*) pHeader)->timestamp;
+} // end method ndw_MsgHeader1_GetTimestamp
+
 int
 ndw_MsgHeader1_SetOutMsgFields(ndw_OutMsgCxt_T* cxt)
 {
@@ -257,6 +268,22 @@ ndw_MsgHeader1_SetOutMsgFields(ndw_OutMsgCxt_T* cxt)
         ndw_exit(EXIT_FAILURE);
     }
 
+    ndw_Topic_T* topic = cxt->topic;
+    if (NDW_MSGHEADER_1 == topic->pub_header_template_id) {
+        // Constant fields come from the per Topic LE template; patch the per message ones in LE.
+        memcpy(ph, topic->pub_header_template, NDW_MSGHEADER1_V1_LE_MSG_SIZE);
+        ph->encoding_format = (UCHAR_T) cxt->encoding_format;
+        ph->priority = (UCHAR_T) cxt->priority;
+        ph->flags = (UCHAR_T) cxt->flags;
+        ph->correlation_id = htole64(cxt->correlation_id);
+        ph->tenant_id = (SHORT_T) htole16((USHORT_T) cxt->tenant_id);
+        ph->payload_size = (INT_T) htole32((UINT_T) cxt->message_size);
+        ph->message_id = (SHORT_T) htole16((USHORT_T) cxt->message_id);
+        ph->timestamp = htole64(ndw_ClockNowNanos());
+        cxt->header_is_le = true;
+        return 0;
+    }
+
     ph->header_number = (UCHAR_T) NDW_MSGHEADER_1;
     ph->header_size = (UCHAR_T) NDW_MSGHEADER1_V1_LE_MSG_SIZE;
     ph->vendor_id = (UCHAR_T) cxt->topic->connection->vendor_id;
@@ -271,12 +298,44 @@ ndw_MsgHeader1_SetOutMsgFields(ndw_OutMsgCxt_T* cxt)
     ph->tenant_id = (SHORT_T) cxt->tenant_id;
     ph->payload_size = cxt->message_size;
     ph->message_id = (SHORT_T) cxt->message_id;
-    ph->timestamp = ndw_GetCurrentUTCNanoseconds();
+    ph->timestamp = ndw_ClockNowNanos();
 
     return 0;
     
 } // end method ndw_MsgHeader1_SetOutMsgFields
 
+int
+ndw_MsgHeader1_BuildTemplate(ndw_Topic_T* topic)
+{
+    if ((NULL == topic) || (NULL == topic->connection) || (NULL == topic->domain)) {
+        NDW_LOGERR("Invalid Topic or Topic without Connection or Domain for BuildTemplate!\n");
+        return -1;
+    }
+
+    _Static_assert(NDW_MSGHEADER1_V1_LE_MSG_SIZE <= NDW_HEADER_TEMPLATE_SIZE, "Header template space too small");
+
+    ndw_MsgHeader1_T* ph = (ndw_MsgHeader1_T*) topic->pub_header_template;
+    memset(ph, 0, NDW_MSGHEADER1_V1_LE_MSG_SIZE);
+
+    ph->header_number = (UCHAR_T) NDW_MSGHEADER_1;
+    ph->header_size = (UCHAR_T) NDW_MSGHEADER1_V1_LE_MSG_SIZE;
+    ph->vendor_id = (UCHAR_T) topic->connection->vendor_id;
+    ph->vendor_version = (UCHAR_T) topic->connection->vendor_logical_version;
+    ph->domain = (UCHAR_T) topic->domain->domain_id;
+    ph->source_id = (SHORT_T) ndw_app_id;
+    ph->topic_id = (SHORT_T) topic->topic_unique_id;
+
+    INT_T ret_code = ndw_MsgHeader1_ConvertToLE((UCHAR_T*) ph);
+    if (0 != ret_code) {
+        NDW_LOGERR("FAILED to convert header template to LE for %s\n", topic->debug_desc);
+        topic->pub_header_template_id = 0;
+        return -2;
+    }
+
+    topic->pub_header_template_id = NDW_MSGHEADER_1;
+    return 0;
+} // end method ndw_MsgHeader1_BuildTemplate
+
 int
 ndw_MsgHeader1_ConvertToLE(UCHAR_T *header_address)
 {
@@ -0,0 +1,359 @@
+
+#include "MsgHeader_2.h"
+
+extern int ndw_verbose;
+
+// Unsigned LEB128: 7 bits per byte, high bit set on all but the last byte.
+static inline INT_T
+ndw_MsgHeader2_PutVarint(UCHAR_T* p, ULONG_T value)
+{
+    INT_T n = 0;
+    while (value >= 0x80) {
+        p[n++] = (UCHAR_T) (value | 0x80);
+        value >>= 7;
+    }
+    p[n++] = (UCHAR_T) value;
+    return n;
+} // end method ndw_MsgHeader2_PutVarint
+
+// Returns bytes consumed, or -1 if the varint runs past end or is longer than 10 bytes.
+static inline INT_T
+ndw_MsgHeader2_GetVarint(const UCHAR_T* p, const UCHAR_T* end, ULONG_T* value)
+{
+    ULONG_T v = 0;
+    INT_T shift = 0;
+    INT_T n = 0;
+    while ((p + n) < end) {
+        UCHAR_T b = p[n++];
+        v |= ((ULONG_T) (b & 0x7F)) << shift;
+        if (0 == (b & 0x80)) {
+            *value = v;
+            return n;
+        }
+        shift += 7;
+        if (shift > 63)
+            return -1;
+    }
+    return -1;
+} // end method ndw_MsgHeader2_GetVarint
+
+void
+ndw_MsgHeader2_Init()
+{
+    if (NULL == ndw_MsgHeaderImpl) {
+        NDW_LOGERR("*** FATAL ERROR: ndw_msgHeaderImpl global POINTER NOT set!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].IsValid = ndw_MsgHeader2_IsValid;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].IsVariableSize = ndw_MsgHeader2_IsVariableSize;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].Print = ndw_MsgHeader2_Print;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].Compare = ndw_MsgHeader2_Compare;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].LE_MsgHeaderSize = ndw_MsgHeader2_LE_MsgHeaderSize;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].GetTimestamp = ndw_MsgHeader2_GetTimestamp;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].SetOutMsgFields = ndw_MsgHeader2_SetOutMsgFields;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].ConvertToLE = ndw_MsgHeader2_ConvertToLE;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].ConvertFromLE = ndw_MsgHeader2_ConvertFromLE;
+
+    if (ndw_verbose > 1) {
+        // Debug Sample Message Header: encode and decode a header with a few fields present.
+        UCHAR_T le[NDW_MSGHEADER2_MAX_LE_MSG_SIZE];
+        ndw_MsgHeader2_T h2;
+        memset(le, 0, sizeof(le));
+        le[0] = NDW_MSGHEADER_2;
+        le[2] = 3;
+        le[3] = 4;
+        le[4] = 5;
+        USHORT_T presence = htole16(NDW_MSGHEADER2_HAS_DOMAIN | NDW_MSGHEADER2_HAS_TOPIC_ID);
+        memcpy(le + 5, &presence, sizeof(presence));
+        INT_T size = NDW_MSGHEADER2_MIN_LE_MSG_SIZE;
+        size += ndw_MsgHeader2_PutVarint(le + size, 6);
+        size += ndw_MsgHeader2_PutVarint(le + size, 300);
+        le[1] = (UCHAR_T) size;
+
+        if (0 == ndw_MsgHeader2_ConvertFromLE(le, (UCHAR_T*) &h2))
+            ndw_MsgHeaderImpl[NDW_MSGHEADER_2].Print(NDW_MSGHEADER_2, (ULONG_T*) &h2);
+    }
+
+} // end method ndw_MsgHeader2_Init
+
+bool
+ndw_MsgHeader2_IsValid(int header_id)
+{
+    return (NDW_MSGHEADER_2 == header_id);
+} // end method ndw_MsgHeader2_IsValid
+
+bool
+ndw_MsgHeader2_IsVariableSize(int header_id)
+{
+    return (NDW_MSGHEADER_2 == header_id);
+} // end method ndw_MsgHeader2_IsVariableSize
+
+void
+ndw_MsgHeader2_Print(int header_id, ULONG_T* pHeader)
+{
+    if (! ndw_MsgHeader2_IsValid(header_id)) {
+        NDW_LOGERR("Invalid Print request for header_id<%d>\n", header_id);
+        return;
+    }
+
+    if (NULL == pHeader) {
+        NDW_LOGERR("NULL header POINTER as argument! " "header_id<%d>\n", header_id);
+        return;
+    }
+
+    ndw_MsgHeader2_T* ph = (ndw_MsgHeader2_T*) pHeader;
+
+    NDW_LOG("\nMessage_Header_2:\n");
+    NDW_LOG("  header_number: %d\n", ph->header_number);
+    NDW_LOG("  header_size: %d (wire_size: %d)\n", ph->header_size, ph->wire_size);
+    NDW_LOG("  vendor_id: %d\n", ph->vendor_id);
+    NDW_LOG("  vendor_version: %d\n", ph->vendor_version);
+    NDW_LOG("  encoding_format: %d\n", ph->encoding_format);
+    NDW_LOG("  presence: 0x%04X\n", ph->presence);
+    NDW_LOG("  domain: %d\n", ph->domain);
+    NDW_LOG("  priority: %d\n", ph->priority);
+    NDW_LOG("  flags: %d\n", ph->flags);
+    NDW_LOG("  message_id: %d\n", ph->message_id);
+    NDW_LOG("  message_sub_id: %d\n", ph->message_sub_id);
+    NDW_LOG("  payload_size: %d\n", ph->payload_size);
+    NDW_LOG("  correlation_id: %lu\n", ph->correlation_id);
+    NDW_LOG("  timestamp: %lu\n", ph->timestamp);
+    NDW_LOG("  source_id: %d\n", ph->source_id);
+    NDW_LOG("  tenant_id: %d\n", ph->tenant_id);
+    NDW_LOG("  topic_id: %d\n", ph->topic_id);
+    NDW_LOG("\n");
+
+} // end method ndw_MsgHeader2_Print
+
+int
+ndw_MsgHeader2_Compare(int header_id, ULONG_T* pHeader1, ULONG_T* pHeader2)
+{
+    if (! ndw_MsgHeader2_IsValid(header_id)) {
+        NDW_LOGERR("Invalid Compare request for header_id<%d>\n", header_id);
+        return -100;
+    }
+
+    ndw_MsgHeader2_T* ph1 = (ndw_MsgHeader2_T*) pHeader1;
+    ndw_MsgHeader2_T* ph2 = (ndw_MsgHeader2_T*) pHeader2;
+
+    if (NULL == ph1) {
+        NDW_LOGERR("NULL pHeader1 POINTER as argument! " "header_id<%d>\n", header_id);
+        return -101;
+    }
+
+    if (NULL == ph2) {
+        NDW_LOGERR("NULL pHeader2 POINTER as argument! " "header_id<%d>\n", header_id);
+        return -102;
+    }
+
+    if (ph1->header_number != ph2->header_number) return -1;
+    if (ph1->header_size != ph2->header_size) return -2;
+    if (ph1->vendor_id != ph2->vendor_id) return -3;
+    if (ph1->vendor_version != ph2->vendor_version) return -4;
+    if (ph1->encoding_format != ph2->encoding_format) return -5;
+    if (ph1->domain != ph2->domain) return -6;
+    if (ph1->priority != ph2->priority) return -7;
+    if (ph1->flags != ph2->flags) return -8;
+    if (ph1->source_id != ph2->source_id) return -9;
+    if (ph1->topic_id != ph2->topic_id) return -10;
+    if (ph1->correlation_id != ph2->correlation_id) return -11;
+    if (ph1->tenant_id != ph2->tenant_id) return -12;
+    if (ph1->payload_size != ph2->payload_size) return -13;
+    if (ph1->message_id != ph2->message_id) return -14;
+    if (ph1->message_sub_id != ph2->message_sub_id) return -15;
+    if (ph1->timestamp != ph2->timestamp) return -16;
+    if (ph1->presence != ph2->presence) return -17;
+
+    // If all fields match, return 0
+    return 0;
+} // end method ndw_MsgHeader2_Compare
+
+int
+ndw_MsgHeader2_LE_MsgHeaderSize(int header_id)
+{
+    if (NDW_MSGHEADER_2 == header_id)
+        return NDW_MSGHEADER2_MAX_LE_MSG_SIZE;
+
+    return -1;
+} // end method ndw_MsgHeader2_LE_MsgHeaderSize
+
+ULONG_T
+ndw_MsgHeader2_GetTimestamp(int header_id, UCHAR_T* pHeader)
+{
+    if ((NDW_MSGHEADER_2 != header_id) || (NULL == pHeader))
+        return 0;
+
+    return ((ndw_MsgHeader2_T*) pHeader)->timestamp;
+} // end method ndw_MsgHeader2_GetTimestamp
+
+#define NDW_MSGHEADER2_PUT(bit, value) \
+    if (0 != (value)) { \
+        presence |= (bit); \
+        p += ndw_MsgHeader2_PutVarint(p, (ULONG_T) (value)); \
+    }
+
+int
+ndw_MsgHeader2_SetOutMsgFields(ndw_OutMsgCxt_T* cxt)
+{
+    if (NULL == cxt) {
+        NDW_LOGERR("Invalid ndw_OutMsgCxtT_* parameter is NULL\n");
+        return -1;
+    }
+
+    if (! ndw_MsgHeader2_IsValid(cxt->header_id)) {
+        NDW_LOGERR("Invalid SetOutMsgFields request for header_id<%d> header_size<%d>\n", cxt->header_id, cxt->header_size);
+        return -2;
+    }
+
+    if (NDW_MSGHEADER2_MAX_LE_MSG_SIZE != cxt->header_size) {
+        NDW_LOGERR("Invalid SetOutMsgFields set for header_id<%d> with INVALID header_size<%d>\n",
+            cxt->header_id, cxt->header_size);
+        return -3;
+    }
+
+    if ((NULL == cxt->header_address) || (NULL == cxt->message_address)) {
+        NDW_LOGERR("Header cxt->header_address or cxt->message_address is NULL for header_id<%d> header_size<%d>\n",
+                    cxt->header_id, cxt->header_size);
+        return -4;
+    }
+
+    UCHAR_T le[NDW_MSGHEADER2_MAX_LE_MSG_SIZE];
+    UCHAR_T* p = le + NDW_MSGHEADER2_MIN_LE_MSG_SIZE;
+    USHORT_T presence = 0;
+
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_DOMAIN, (UCHAR_T) cxt->domain->domain_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_PRIORITY, (UCHAR_T) cxt->priority);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_FLAGS, (UCHAR_T) cxt->flags);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_MESSAGE_ID, (USHORT_T) cxt->message_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_MESSAGE_SUB_ID, (USHORT_T) cxt->message_sub_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_PAYLOAD_SIZE, (UINT_T) cxt->message_size);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_CORRELATION_ID, cxt->correlation_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_TIMESTAMP, ndw_ClockNowNanos());
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_SOURCE_ID, (USHORT_T) cxt->app_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_TENANT_ID, (USHORT_T) cxt->tenant_id);
+    NDW_MSGHEADER2_PUT(NDW_MSGHEADER2_HAS_TOPIC_ID, (USHORT_T) cxt->topic->topic_unique_id);
+
+    INT_T size = (INT_T) (p - le);
+    le[0] = (UCHAR_T) NDW_MSGHEADER_2;
+    le[1] = (UCHAR_T) size;
+    le[2] = (UCHAR_T) cxt->topic->connection->vendor_id;
+    le[3] = (UCHAR_T) cxt->topic->connection->vendor_logical_version;
+    le[4] = (UCHAR_T) cxt->encoding_format;
+    USHORT_T presence_le = htole16(presence);
+    memcpy(le + 5, &presence_le, sizeof(presence_le));
+
+    // Place the encoded header right in front of the body so the frame is contiguous and as short as possible.
+    UCHAR_T* header_address = cxt->message_address - size;
+    memcpy(header_address, le, size);
+    cxt->header_address = (ULONG_T*) header_address;
+    cxt->header_size = size;
+
+    return 0;
+
+} // end method ndw_MsgHeader2_SetOutMsgFields
+
+int
+ndw_MsgHeader2_ConvertToLE(UCHAR_T *header_address)
+{
+    if (NULL == header_address) {
+        NDW_LOGERR("*** FATAL ERROR: NULL header_address parameter!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (NDW_MSGHEADER_2 != header_address[0]) {
+        NDW_LOGERR("Unsupported conversion specified for header_id<%d>\n", header_address[0]);
+        return -1;
+    }
+
+    INT_T header_size = (INT_T) header_address[1];
+    if ((header_size < NDW_MSGHEADER2_MIN_LE_MSG_SIZE) || (header_size > NDW_MSGHEADER2_MAX_LE_MSG_SIZE)) {
+        NDW_LOGERR("Invalid encoded header_size<%d> for header_id<%d>\n", header_size, NDW_MSGHEADER_2);
+        return -2;
+    }
+
+    return 0;
+} // end method ndw_MsgHeader2_ConvertToLE
+
+int
+ndw_MsgHeader2_ConvertFromLE(UCHAR_T *src, UCHAR_T* dest)
+{
+    if (NULL == src) {
+        NDW_LOGERR("*** FATAL ERROR: NULL src parameter!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (NULL == dest) {
+        NDW_LOGERR("*** FATAL ERROR: NULL dest parameter!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    INT_T header_id = (INT_T) src[0];
+    INT_T header_size = (INT_T) src[1];
+    if (NDW_MSGHEADER_2 != header_id) {
+        NDW_LOGERR("Unsupported conversion specified for header_id<%d>\n", header_id);
+        return -1;
+    }
+
+    if ((header_size < NDW_MSGHEADER2_MIN_LE_MSG_SIZE) || (header_size > NDW_MSGHEADER2_MAX_LE_MSG_SIZE)) {
+        NDW_LOGERR("Invalid encoded header_size<%d> for header_id<%d>\n", header_size, header_id);
+        return -2;
+    }
+
+    ndw_MsgHeader2_T* h = (ndw_MsgHeader2_T*) dest;
+    memset(h, 0, sizeof(ndw_MsgHeader2_T));
+
+    h->header_number = src[0];
+    h->header_size = (UCHAR_T) sizeof(ndw_MsgHeader2_T);
+    h->vendor_id = src[2];
+    h->vendor_version = src[3];
+    h->encoding_format = src[4];
+    h->wire_size = (UCHAR_T) header_size;
+
+    USHORT_T presence_le;
+    memcpy(&presence_le, src + 5, sizeof(presence_le));
+    h->presence = le16toh(presence_le);
+    if (0 != (h->presence & ~NDW_MSGHEADER2_ALL_FIELDS)) {
+        NDW_LOGERR("Unknown presence bits <0x%04X> for header_id<%d>\n", h->presence, header_id);
+        return -3;
+    }
+
+    const UCHAR_T* p = src + NDW_MSGHEADER2_MIN_LE_MSG_SIZE;
+    const UCHAR_T* end = src + header_size;
+    ULONG_T values[16];
+    for (INT_T bit = 0; bit < 16; bit++)
+    {
+        values[bit] = 0;
+        if (0 == (h->presence & (1 << bit)))
+            continue;
+
+        INT_T n = ndw_MsgHeader2_GetVarint(p, end, &values[bit]);
+        if (n < 0) {
+            NDW_LOGERR("Truncated or malformed varint for field bit<%d> header_size<%d> header_id<%d>\n",
+                        bit, header_size, header_id);
+            return -4;
+        }
+        p += n;
+    }
+
+    if (p != end) {
+        NDW_LOGERR("Encoded header_size<%d> does not match the <%ld> bytes of fields decoded for header_id<%d>\n",
+                    header_size, (LONG_T) (p - src), header_id);
+        return -5;
+    }
+
+    h->domain = (UCHAR_T) values[0];
+    h->priority = (UCHAR_T) values[1];
+    h->flags = (UCHAR_T) values[2];
+    h->message_id = (SHORT_T) (USHORT_T) values[3];
+    h->message_sub_id = (SHORT_T) (USHORT_T) values[4];
+    h->payload_size = (INT_T) (UINT_T) values[5];
+    h->correlation_id = values[6];
+    h->timestamp = values[7];
+    h->source_id = (SHORT_T) (USHORT_T) values[8];
+    h->tenant_id = (SHORT_T) (USHORT_T) values[9];
+    h->topic_id = (SHORT_T) (USHORT_T) values[10];
+
+    return 0;
+} // end method ndw_MsgHeader2_ConvertFromLE
+
@@ -1,6 +1,7 @@
 
 #include "MsgHeaders.h"
 #include "MsgHeader_1.h"
+#include "MsgHeader_2.h"
 
 size_t ndw_max_message_size = NDW_MAX_MESSAGE_SIZE;
 
@@ -61,6 +62,17 @@ static void ndw_tls_header_and_message_Init()
     }
 }
 
+pthread_key_t ndw_tls_publish_batch; // Per thread memory for frames of a publish batch.
+pthread_once_t ndw_tls_publish_batch_once = PTHREAD_ONCE_INIT;
+static void ndw_tls_publish_batch_Init()
+{
+    if (0 != pthread_key_create(&ndw_tls_publish_batch, ndw_TLSDestructor_header_and_message))
+    {
+        NDW_LOGERR("*** FATAL ERROR: Failed to create ndw_tls_publish_batch!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+}
+
 pthread_key_t ndw_tls_OutMsgCxt; // Per thread memory for Out Message Context
 pthread_once_t ndw_tls_OutMsgCx_once = PTHREAD_ONCE_INIT; 
 static void ndw_tls_OutMsgCxt_Init()
@@ -116,6 +128,17 @@ static INT_T ndw_ImplMsgHeader_Compare(INT_T header_id, ULONG_T* pHeader1, ULONG
     return -1;
 }
 
+static bool ndw_ImplMsgHeader_IsVariableSize(INT_T header_id) {
+    (void) header_id;
+    return false; // Headers are fixed size unless the header type says otherwise.
+}
+
+static ULONG_T ndw_ImplMsgHeader_GetTimestamp(INT_T header_id, UCHAR_T* pHeader) {
+    (void) header_id;
+    (void) pHeader;
+    return 0; // Header type does not carry a timestamp.
+}
+
 static INT_T ndw_ImplMsgHeader_LE_MsgHeaderSize(INT_T header_id) {
     NDW_LOGERR("Invalid LE MsgHeaderSize Function Request with header_id<%d>\n", header_id);
     return -1;
@@ -221,25 +244,18 @@ ndw_LE_to_MsgHeader(UCHAR_T* le_msg, INT_T le_msg_size)
         }
     }
 
-    memset(msginfo, 0, sizeof(ndw_InMsgCxt_T));
-
+    // Every field is assigned here instead of clearing the whole structure on each received message.
     msginfo->is_bad = true;
     msginfo->error_msg = "";
     msginfo->data_addr = le_msg;
     msginfo->data_size = le_msg_size;
-    msginfo->header_addr = pthread_getspecific(ndw_tls_received_msg_header);
-    if (NULL == msginfo->header_addr) {
-        CHAR_T* ptr_aligned = ndw_alloc_align(NDW_MAX_HEADER_SIZE * 2);
-        pthread_setspecific(ndw_tls_received_msg_header, ptr_aligned);
-        msginfo->header_addr = pthread_getspecific(ndw_tls_received_msg_header);
-        if (NULL == msginfo->header_addr) {
-            NDW_LOGERR( "*** FATAL ERROR: (ndw_tls_received_msg_header) returned NULL even after allocating it and settig it into TLS!\n");
-            ndw_exit(EXIT_FAILURE);
-        }
-    }
+    msginfo->header_id = 0;
+    msginfo->header_size = 0;
+    msginfo->header_addr = NULL;
+    msginfo->header_native_size = 0;
+    msginfo->msg_addr = NULL;
+    msginfo->msg_size = 0;
 
-    memset(msginfo->header_addr, 0, NDW_MAX_HEADER_SIZE);
-    
     if (NULL == le_msg) {
         msginfo->error_msg = "Input parameter le_msg is NULL";
         return msginfo;
@@ -266,7 +282,17 @@ ndw_LE_to_MsgHeader(UCHAR_T* le_msg, INT_T le_msg_size)
     }
 
     INT_T expected_header_size = ndw_MsgHeaderImpl[msginfo->header_id].LE_MsgHeaderSize( msginfo->header_id);
-    if (expected_header_size != msginfo->header_size) {
+    bool is_variable_size = ndw_MsgHeaderImpl[msginfo->header_id].IsVariableSize(msginfo->header_id);
+    if (is_variable_size) {
+        // Encoded size varies per message; expected_header_size is the maximum.
+        if ((msginfo->header_size < NDW_MIN_HEADER_SIZE) || (msginfo->header_size > expected_header_size)) {
+            NDW_LOGERR("*** ERROR: header_size out of range! Got <%d> Max<%d> for header_id<%d>\n",
+                        msginfo->header_size, expected_header_size, msginfo->header_id);
+            msginfo->error_msg = "Variable header_size out of range\n";
+            return msginfo;
+        }
+    }
+    else if (expected_header_size != msginfo->header_size) {
         NDW_LOGERR("*** ERROR: header_size mismatch! Got <%d> Expected<%d> for header_id<%d>\n",
                     msginfo->header_size, expected_header_size, msginfo->header_id);
         msginfo->error_msg = "Mismatched header_size\n";
@@ -290,12 +316,40 @@ ndw_LE_to_MsgHeader(UCHAR_T* le_msg, INT_T le_msg_size)
        return msginfo;
     }
 
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+    // Wire format is Little Endian which is the native format here, so if the header is suitably aligned
+    // hand out a view straight into the received buffer. No copy and no conversion are needed.
+    if ((! is_variable_size) && (0 == (((ULONG_T) le_msg) % sizeof(ULONG_T)))) {
+        msginfo->header_addr = le_msg;
+        msginfo->header_native_size = msginfo->header_size;
+        msginfo->is_bad = false;
+        return msginfo;
+    }
+#endif
+
+    // Big Endian host, misaligned received buffer or variable length header: decode into the per thread header buffer.
+    msginfo->header_addr = pthread_getspecific(ndw_tls_received_msg_header);
+    if (NULL == msginfo->header_addr) {
+        CHAR_T* ptr_aligned = ndw_alloc_align(NDW_MAX_HEADER_SIZE * 2);
+        pthread_setspecific(ndw_tls_received_msg_header, ptr_aligned);
+        msginfo->header_addr = pthread_getspecific(ndw_tls_received_msg_header);
+        if (NULL == msginfo->header_addr) {
+            NDW_LOGERR( "*** FATAL ERROR: (ndw_tls_received_msg_header) returned NULL even after allocating it and settig it into TLS!\n");
+            ndw_exit(EXIT_FAILURE);
+        }
+    }
+
+    memset(msginfo->header_addr, 0, expected_header_size);
+
     INT_T ret_code = ndw_MsgHeaderImpl[msginfo->header_id].ConvertFromLE(le_msg, msginfo->header_addr);
     if (0 != ret_code) {
         NDW_LOGERR("FAILED convert Message Header contents from LE to native format for " "header_id<%d>\n", msginfo->header_id);
         return msginfo;
     }
 
+    // Native header carries its own size in the second byte, as every header type does.
+    msginfo->header_native_size = (INT_T) msginfo->header_addr[1];
+
     msginfo->is_bad = false;
 
     return msginfo;
@@ -375,6 +429,9 @@ ndw_InitThreadSpecificMsgHeaders()
     pthread_once(&ndw_tls_header_and_message_once, ndw_tls_header_and_message_Init);
     pthread_setspecific(ndw_tls_header_and_message, NULL);
 
+    pthread_once(&ndw_tls_publish_batch_once, ndw_tls_publish_batch_Init);
+    pthread_setspecific(ndw_tls_publish_batch, NULL);
+
     pthread_once(&ndw_tls_OutMsgCx_once, ndw_tls_OutMsgCxt_Init);
     ndw_OutMsgCxt_T* out_msg_cxt = calloc(1, sizeof(ndw_OutMsgCxt_T));
     NDW_LOGX("TLS: ALLOCATE: ThreadID<%lu> out_msg_cxt<%p>\n", pthread_self(), out_msg_cxt);
@@ -438,6 +495,21 @@ ndw_DestroyThreadSpecificMsgHeaders()
 #endif
     ndw_safe_PTHREAD_KEY_DELETE("ndw_tls_header_and_message", ndw_tls_header_and_message);
 
+#if 1
+    if (NDW_IS_NDW_INIT_THREAD(this_thread)) {
+    ndw_HeaderAndMsg_T* batch = pthread_getspecific(ndw_tls_publish_batch);
+    if (NULL != batch) {
+        if (NULL != batch->aligned_address) {
+            free(batch->aligned_address);
+            batch->aligned_address = NULL;
+            batch->allocated_size = 0;
+        }
+        free(batch);
+    }
+    }
+#endif
+    ndw_safe_PTHREAD_KEY_DELETE("ndw_tls_publish_batch", ndw_tls_publish_batch);
+
 #if 1
     if (NDW_IS_NDW_INIT_THREAD(this_thread)) {
     ndw_OutMsgCxt_T* mha = pthread_getspecific(ndw_tls_OutMsgCxt);
@@ -482,7 +554,9 @@ ndw_InitMsgHeaders()
         pHeader->IsValid = ndw_ImplMsgHeader_IsValid;
         pHeader->Print = ndw_ImplMsgHeader_Print;
         pHeader->Compare = ndw_ImplMsgHeader_Compare;
+        pHeader->IsVariableSize = ndw_ImplMsgHeader_IsVariableSize;
         pHeader->LE_MsgHeaderSize = ndw_ImplMsgHeader_LE_MsgHeaderSize;
+        pHeader->GetTimestamp = ndw_ImplMsgHeader_GetTimestamp;
         pHeader->SetOutMsgFields = ndw_ImplMsgHeader_SetOutMsgFields;
         pHeader->ConvertToLE = ndw_ImplMsgHeader_ConvertToLE;
         pHeader->ConvertFromLE = ndw_ImplMsgHeader_ConvertFromLE;
@@ -494,6 +568,9 @@ ndw_InitMsgHeaders()
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].Init = ndw_MsgHeader1_Init;
     ndw_MsgHeaderImpl[NDW_MSGHEADER_1].Init();
 
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].Init = ndw_MsgHeader2_Init;
+    ndw_MsgHeaderImpl[NDW_MSGHEADER_2].Init();
+
 #if 0
     // XXX: Not needed!
     ndw_InitThreadSpecificMsgHeaders();
@@ -549,7 +626,8 @@ ndw_GetMsgHeaderAndBody(ndw_OutMsgCxt_T *mha)
         mha->header_address = (ULONG_T*) hm->aligned_address;
         mha->message_address = (UCHAR_T*) (((UCHAR_T*) hm->aligned_address) + mha->header_size);
         mha->current_allocation_size = hm->allocated_size;
-        memset(mha->header_address, 0, sz);
+        // Only the header is cleared. Message body is written by the caller (copy or in place).
+        memset(mha->header_address, 0, mha->header_size);
         return 0;
     }
 
@@ -571,6 +649,44 @@ ndw_GetMsgHeaderAndBody(ndw_OutMsgCxt_T *mha)
 
 } // end method ndw_GetMsgHeaderAndBody
 
+UCHAR_T*
+ndw_GetPublishBatchBuffer(INT_T size, INT_T preserve_size)
+{
+    if ((size <= 0) || (preserve_size < 0) || (preserve_size > size))
+        return NULL;
+
+    ndw_HeaderAndMsg_T* batch = pthread_getspecific(ndw_tls_publish_batch);
+    if (NULL == batch)
+    {
+        batch = calloc(1, sizeof(ndw_HeaderAndMsg_T));
+        if (NULL == batch)
+            return NULL;
+
+        pthread_setspecific(ndw_tls_publish_batch, batch);
+    }
+
+    if (batch->allocated_size >= size)
+        return batch->aligned_address;
+
+    // Grow geometrically so a burst of appends does not reallocate on every message.
+    INT_T new_size = (batch->allocated_size > 0) ? batch->allocated_size : 4096;
+    while (new_size < size)
+        new_size *= 2;
+
+    UCHAR_T* ptr_aligned = (UCHAR_T*) ndw_alloc_align(new_size);
+    if (NULL == ptr_aligned)
+        return NULL;
+
+    if ((preserve_size > 0) && (NULL != batch->aligned_address))
+        memcpy(ptr_aligned, batch->aligned_address, preserve_size);
+
+    free(batch->aligned_address);
+    batch->aligned_address = ptr_aligned;
+    batch->allocated_size = new_size;
+
+    return ptr_aligned;
+} // end method ndw_GetPublishBatchBuffer
+
 ndw_OutMsgCxt_T*
 ndw_GetOutMsgCxt()
 {
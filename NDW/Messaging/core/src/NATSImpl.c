@@ -1,5 +1,6 @@
 
 #include "NATSImpl.h"
+#include "NDW_RegistryImage.h"
 
 extern INT_T ndw_verbose; // Defined in NDW_Init.h, but we do not include that file.
 
@@ -8,10 +9,18 @@ pthread_mutex_t ndw_NATS_ConnectionLock = PTHREAD_MUTEX_INITIALIZER;
 // And same for JetStream
 pthread_mutex_t ndw_NATS_JS_ConnectionLock = PTHREAD_MUTEX_INITIALIZER;
 
+// Guards js_pub_topics of all connections: read on the JetStream ack thread, updated by a registry reload.
+static pthread_rwlock_t ndw_NATS_JSPubTopicsLock = PTHREAD_RWLOCK_INITIALIZER;
+
 // JetStream methods (externs as they were written at the bottom of the source code file.)
 extern INT_T ndw_NATS_ProcessConfiguration(ndw_Topic_T*);
+extern INT_T ndw_NATS_ValidateTopicConfiguration(ndw_Topic_T*, ndw_Connection_T*);
 extern INT_T ndw_NATS_JSConnect(ndw_NATS_Connection_T*);
 extern INT_T ndw_NATS_JSPublish(ndw_Topic_T*);
+extern INT_T ndw_NATS_JSPublishFrame(ndw_Topic_T*, UCHAR_T* start_address, INT_T total_size, bool in_batch,
+                                        LONG_T max_wait_ms);
+extern INT_T ndw_NATS_JSWaitForPublishAcks(ndw_NATS_Connection_T*);
+extern void ndw_NATS_JSFreeFetchList(ndw_Topic_T*, ndw_NATS_JS_Attr_T*);
 extern INT_T ndw_NATS_JSSubscribe(ndw_Topic_T*, bool push_mode);
 extern bool ndw_NATS_IsJSPubSub(ndw_Topic_T*);
 extern INT_T ndw_NATS_JSPollForMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T* msg_length, LONG_T timeout_ms, void** vendor_closure);
@@ -21,6 +30,77 @@ extern INT_T ndw_NATS_Publish_ResponseForRequestMsg(ndw_Topic_T* topic);
 extern INT_T ndw_NATS_GetResponseForRequestMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T* msg_length,
                                 LONG_T timeout_ms, void** vendor_closure);
 
+/*
+ * Subscriptions, JetStream contexts and connections closed while publishing, polling or exporter threads may still
+ * hold them. They are closed at once but destroyed only by ndw_NATS_Shutdown, as a topic or connection flag check
+ * cannot stop another thread that has already loaded the handle.
+ */
+typedef struct ndw_NATS_RetiredHandle
+{
+    natsSubscription* subscription;
+    jsCtx* js_context;
+    natsConnection* conn;
+} ndw_NATS_RetiredHandle_T;
+
+static pthread_mutex_t ndw_NATS_RetireLock = PTHREAD_MUTEX_INITIALIZER;
+static ndw_NATS_RetiredHandle_T* ndw_NATS_retired = NULL;
+static INT_T ndw_NATS_num_retired = 0;
+static INT_T ndw_NATS_retired_capacity = 0;
+
+// Keep a closed handle until ndw_NATS_Shutdown. If there is no memory to remember it, it is leaked, which is safe.
+static void
+ndw_NATS_Retire(natsSubscription* subscription, jsCtx* js_context, natsConnection* conn)
+{
+    if ((NULL == subscription) && (NULL == js_context) && (NULL == conn))
+        return;
+
+    pthread_mutex_lock(&ndw_NATS_RetireLock);
+    if (ndw_NATS_num_retired == ndw_NATS_retired_capacity) {
+        INT_T capacity = (0 == ndw_NATS_retired_capacity) ? 16 : (ndw_NATS_retired_capacity * 2);
+        ndw_NATS_RetiredHandle_T* more = realloc(ndw_NATS_retired, capacity * sizeof(ndw_NATS_RetiredHandle_T));
+        if (NULL == more) {
+            pthread_mutex_unlock(&ndw_NATS_RetireLock);
+            NDW_LOGERR("*** WARNING: Memory allocation failed to retire NATS handles; leaking them\n");
+            return;
+        }
+        ndw_NATS_retired = more;
+        ndw_NATS_retired_capacity = capacity;
+    }
+
+    ndw_NATS_RetiredHandle_T* entry = &ndw_NATS_retired[ndw_NATS_num_retired++];
+    entry->subscription = subscription;
+    entry->js_context = js_context;
+    entry->conn = conn;
+    pthread_mutex_unlock(&ndw_NATS_RetireLock);
+} // end method ndw_NATS_Retire
+
+// Subscriptions and JetStream contexts first, as they refer to their connection.
+static void
+ndw_NATS_DestroyRetiredHandles()
+{
+    pthread_mutex_lock(&ndw_NATS_RetireLock);
+    for (INT_T i = 0; i < ndw_NATS_num_retired; i++) {
+        if (NULL != ndw_NATS_retired[i].subscription)
+            natsSubscription_Destroy(ndw_NATS_retired[i].subscription);
+    }
+
+    for (INT_T i = 0; i < ndw_NATS_num_retired; i++) {
+        if (NULL != ndw_NATS_retired[i].js_context)
+            jsCtx_Destroy(ndw_NATS_retired[i].js_context);
+    }
+
+    for (INT_T i = 0; i < ndw_NATS_num_retired; i++) {
+        if (NULL != ndw_NATS_retired[i].conn)
+            natsConnection_Destroy(ndw_NATS_retired[i].conn);
+    }
+
+    free(ndw_NATS_retired);
+    ndw_NATS_retired = NULL;
+    ndw_NATS_num_retired = 0;
+    ndw_NATS_retired_capacity = 0;
+    pthread_mutex_unlock(&ndw_NATS_RetireLock);
+} // end method ndw_NATS_DestroyRetiredHandles
+
 typedef struct ndw_NATS_Closure
 {
     LONG_T counter;                         // Incremental counter.
@@ -434,6 +514,67 @@ ndw_NATS_ParseConnectionOptions(ndw_Connection_T* connection, const CHAR_T* opti
     return value;
 } // end method ndw_NATS_ParseConnectionOptions
 
+// Open the rest of the Connection pool (entry 0 is the connection already made) with the same options.
+// A pool connection is only stored once connected; publishers load it without a lock.
+static INT_T
+ndw_NATS_ConnectPool(ndw_Connection_T* connection, ndw_NATS_Connection_T* conn, natsOptions* nats_options)
+{
+    for (INT_T i = 1; i < conn->pool_size; i++) {
+        natsConnection* closed = conn->pool[i].conn;
+        if (NULL != closed) {
+            // Closed for good; reconnecting. Publishers may still hold it.
+            __atomic_store_n(&(conn->pool[i].conn), NULL, __ATOMIC_RELEASE);
+            natsConnection_Close(closed);
+            ndw_NATS_Retire(NULL, NULL, closed);
+        }
+
+        natsConnection* nc = NULL;
+        conn->status = natsConnection_Connect(&nc, nats_options);
+        if (NATS_OK != conn->status) {
+            NDW_LOGERR("*** WARNING: FAILED to Connect pool connection<%d of %d> with NATS with URL<%s> "
+                        "Error Status %s for %s\n", i + 1, conn->pool_size, connection->connection_url,
+                        natsStatus_GetText(conn->status), connection->debug_desc);
+            natsConnection_Destroy(nc); // Never stored, so no other thread has it.
+            return -1;
+        }
+
+        __atomic_store_n(&(conn->pool[i].publication_throttled), false, __ATOMIC_RELAXED);
+        __atomic_store_n(&(conn->pool[i].conn), nc, __ATOMIC_RELEASE);
+    }
+
+    if (conn->pool_size > 1)
+        NDW_LOGX("NOTE: Connected <%d> pooled NATS connections for %s\n", conn->pool_size, connection->debug_desc);
+
+    return 0;
+} // end method ndw_NATS_ConnectPool
+
+// Flush and close the pool connections other than entry 0, which is closed with ndw_NATS_Connection_T conn.
+// As with conn, publishers may still hold a pool connection, so it is closed now and destroyed on shutdown.
+static void
+ndw_NATS_DisconnectPool(ndw_Connection_T* connection, ndw_NATS_Connection_T* conn)
+{
+    for (INT_T i = 1; i < conn->pool_size; i++) {
+        natsConnection* nc = conn->pool[i].conn;
+        if (NULL == nc)
+            continue;
+
+        if (conn->flush_timeout_ms > 0) {
+            natsStatus flush_code = natsConnection_FlushTimeout(nc, (LONG_T) conn->flush_timeout_ms);
+            if (NATS_OK != flush_code) {
+                NDW_LOGERR("*** ERROR: natsConnection_FlushTimeout(<%ld> milliseconds) FAILED with natsStatus<%d> "
+                            "for pool connection<%d> of %s!\n", conn->flush_timeout_ms, flush_code, i + 1,
+                            connection->debug_desc);
+            }
+        }
+
+        __atomic_store_n(&(conn->pool[i].conn), NULL, __ATOMIC_RELEASE);
+        natsConnection_Close(nc);
+        ndw_NATS_Retire(NULL, NULL, nc);
+    }
+
+    __atomic_store_n(&(conn->pool[0].conn), NULL, __ATOMIC_RELEASE);
+} // end method ndw_NATS_DisconnectPool
+
 INT_T
 ndw_NATS_ConnectWithLock(ndw_Connection_T* connection)
 {
@@ -587,19 +728,37 @@ ndw_NATS_ConnectWithLock(ndw_Connection_T* connection)
         NDW_LOGX("---> NATS: Initiating NATS Connection: %s\n", connection->debug_desc);
     }
 
+    if (NULL != conn->conn) {
+        // Closed for good; other threads may still hold it.
+        natsConnection* closed = conn->conn;
+        __atomic_store_n(&conn->conn, NULL, __ATOMIC_RELEASE);
+        ndw_NATS_Retire(NULL, NULL, closed);
+    }
+
     //natsSockCtx* socket_ctx = &(conn->conn->sockCtx);
-    conn->status = natsConnection_Connect(&conn->conn, nats_options);
+    natsConnection* nc = NULL;
+    conn->status = natsConnection_Connect(&nc, nats_options);
 
     if (NATS_OK != conn->status) {
         NDW_LOGERR("*** WARNING: FAILED to Connect with NATS with URL<%s> Error Status %s for %s\n",
                     url, natsStatus_GetText(conn->status), connection->debug_desc);
 
-        natsConnection_Destroy(conn->conn); // Assumption is that NATS is delete that memory!
-        conn->conn = NULL;
+        natsConnection_Destroy(nc); // Assumption is that NATS is delete that memory!
         natsOptions_Destroy(nats_options);
         return -4;
     }
     else {
+        __atomic_store_n(&conn->pool[0].conn, nc, __ATOMIC_RELEASE);
+        __atomic_store_n(&conn->conn, nc, __ATOMIC_RELEASE);
+        if (0 != ndw_NATS_ConnectPool(connection, conn, nats_options)) {
+            ndw_NATS_DisconnectPool(connection, conn);
+            __atomic_store_n(&conn->conn, NULL, __ATOMIC_RELEASE);
+            natsConnection_Close(nc);
+            ndw_NATS_Retire(NULL, NULL, nc);
+            natsOptions_Destroy(nats_options);
+            return -5;
+        }
+
         // Also initialize JetStream if configured.
         if (conn->js_enabled_count > 0) {
             INT_T js_ret_code = ndw_NATS_JSConnect(conn);
@@ -678,6 +837,9 @@ ndw_NATS_DisconnectWithLock(ndw_Connection_T* connection)
 
         free(topics);
 
+        // Durable messages published asynchronously must be acked before we go away.
+        ndw_NATS_JSWaitForPublishAcks(conn);
+
         // Flush out connection.
         if (conn->flush_timeout_ms > 0) {
             natsStatus flush_code = natsConnection_FlushTimeout(conn->conn, (LONG_T) conn->flush_timeout_ms);
@@ -694,8 +856,13 @@ ndw_NATS_DisconnectWithLock(ndw_Connection_T* connection)
             NDW_LOGX("---> NATS: Disconnecting from %s\n", connection->debug_desc);
         }
 
-        natsConnection_Destroy(conn->conn); // Assumption is that NATS is delete that memory!
-        conn->conn = NULL;
+        ndw_NATS_DisconnectPool(connection, conn);
+
+        // Publishers may still hold the connection: close it now, destroy it on shutdown.
+        natsConnection* closed = conn->conn;
+        __atomic_store_n(&conn->conn, NULL, __ATOMIC_RELEASE);
+        natsConnection_Close(closed);
+        ndw_NATS_Retire(NULL, NULL, closed);
         conn->disconnect_time = ndw_GetCurrentUTCNanoseconds();
 
         if (ndw_verbose) {
@@ -710,12 +877,11 @@ ndw_NATS_DisconnectWithLock(ndw_Connection_T* connection)
     }
 
     if (NULL != conn->js_context) {
-        jsCtx_Destroy(conn->js_context);
-        conn->js_context = NULL;
+        jsCtx* js_context = conn->js_context;
+        __atomic_store_n(&conn->js_context, NULL, __ATOMIC_RELEASE);
+        ndw_NATS_Retire(NULL, js_context, NULL);
     }
 
-    conn->conn = NULL;
-
     return 0;
 } // end method ndw_NATS_DisconnectWithLock
 
@@ -751,11 +917,13 @@ ndw_NATS_IsConnected(ndw_Connection_T* connection)
         return false;
     }
 
-    if (NULL == nats_connection->conn) {
+    // Read once: Disconnect may clear it meanwhile, but keeps the closed connection until shutdown.
+    natsConnection* conn = __atomic_load_n(&nats_connection->conn, __ATOMIC_ACQUIRE);
+    if (NULL == conn) {
         return false;
     }
 
-    bool b = natsConnection_IsClosed(nats_connection->conn);
+    bool b = natsConnection_IsClosed(conn);
 
     return (!b);
 } // end method ndw_NATS_IsConnected
@@ -782,11 +950,12 @@ ndw_NATS_IsClosed(ndw_Connection_T* connection)
         return false;
     }
 
-    if (NULL == nats_connection->conn) {
+    natsConnection* conn = __atomic_load_n(&nats_connection->conn, __ATOMIC_ACQUIRE);
+    if (NULL == conn) {
         return false;
     }
 
-    bool b = natsConnection_IsClosed(nats_connection->conn);
+    bool b = natsConnection_IsClosed(conn);
 
     return b;
 } // end method ndw_NATS_IsClosed
@@ -813,11 +982,12 @@ ndw_NATS_IsDraining(ndw_Connection_T* connection)
         return false;
     }
 
-    if (NULL == nats_connection->conn) {
+    natsConnection* conn = __atomic_load_n(&nats_connection->conn, __ATOMIC_ACQUIRE);
+    if (NULL == conn) {
         return false;
     }
 
-    bool b = natsConnection_IsDraining(nats_connection->conn);
+    bool b = natsConnection_IsDraining(conn);
 
     return b;
 } // end method 
@@ -910,6 +1080,7 @@ ndw_NATS_Init(ndw_ImplAPI_T* impl, INT_T vendor_id)
 #endif
 
     impl->ProcessConfiguration = ndw_NATS_ProcessConfiguration;
+    impl->ValidateTopicConfiguration = ndw_NATS_ValidateTopicConfiguration;
     impl->Connect = ndw_NATS_Connect;
     impl->Disconnect = ndw_NATS_Disconnect;
     impl->ShutdownConnection = ndw_NATS_ShutdownConnection;
@@ -917,6 +1088,7 @@ ndw_NATS_Init(ndw_ImplAPI_T* impl, INT_T vendor_id)
     impl->IsClosed = ndw_NATS_IsClosed;
     impl->IsDraining = ndw_NATS_IsDraining;
     impl->PublishMsg = ndw_NATS_PublishMsg;
+    impl->PublishMsgBatch = ndw_NATS_PublishMsgBatch;
     impl->SubscribeAsync = ndw_NATS_SubscribeAsync;
     impl->Unsubscribe = ndw_NATS_Unsubscribe;
     impl->GetQueuedMsgCount = ndw_NATS_GetQueuedMsgCount;
@@ -926,7 +1098,12 @@ ndw_NATS_Init(ndw_ImplAPI_T* impl, INT_T vendor_id)
     impl->GetResponseForRequestMsg = ndw_NATS_GetResponseForRequestMsg;
     impl->CommitLastMsg = ndw_NATS_CommitLastMsg;
     impl->CommitQueuedMsg = ndw_NATS_CommitQueuedMsg;
+    impl->CommitQueuedMsgBatch = ndw_NATS_CommitQueuedMsgBatch;
     impl->CleanupQueuedMsg = ndw_NATS_CleanupQueuedMsg;
+    impl->GetTopicMetrics = ndw_NATS_GetTopicMetrics;
+    impl->GetConnectionMetrics = ndw_NATS_GetConnectionMetrics;
+    impl->ReloadTopic = ndw_NATS_ReloadTopic;
+    impl->ReloadConnection = ndw_NATS_ReloadConnection;
 
     if (ndw_verbose) {
         NDW_LOGX("===> NATS.io Init Derivation complete for id<%d> name<%s> logical_version<%d>\n",
@@ -941,6 +1118,19 @@ ndw_NATS_Init(ndw_ImplAPI_T* impl, INT_T vendor_id)
     return 0;
 } // end method ndw_NATS_Init
 
+static void
+ndw_NATS_FreePubKeyTopics(ndw_NATS_Connection_T* nats_connection)
+{
+    ndw_NATS_PubKeyTopic_T* entry = NULL;
+    ndw_NATS_PubKeyTopic_T* tmp = NULL;
+    pthread_rwlock_wrlock(&ndw_NATS_JSPubTopicsLock);
+    HASH_ITER(hh, nats_connection->js_pub_topics, entry, tmp) {
+        HASH_DEL(nats_connection->js_pub_topics, entry);
+        free(entry);
+    }
+    pthread_rwlock_unlock(&ndw_NATS_JSPubTopicsLock);
+} // end method ndw_NATS_FreePubKeyTopics
+
 void
 ndw_NATS_ShutdownConnection(ndw_Connection_T* connection)
 {
@@ -958,7 +1148,9 @@ ndw_NATS_ShutdownConnection(ndw_Connection_T* connection)
     ndw_Topic_T** topics = ndw_GetAllTopicsFromConnection(connection, &total_topics);
 
     if ((NULL == topics) || (total_topics <= 0)) {
+        ndw_NATS_FreePubKeyTopics(nats_connection);
         nats_connection->ndw_connection = NULL;
+        free(nats_connection->pool);
         free(nats_connection);
         return;
     }
@@ -980,7 +1172,9 @@ ndw_NATS_ShutdownConnection(ndw_Connection_T* connection)
 
     free(topics);
 
+    ndw_NATS_FreePubKeyTopics(nats_connection);
     connection->vendor_opaque = NULL;
+    free(nats_connection->pool);
     free(nats_connection);
 } // ndw_NATS_ShutdownConnection
 
@@ -989,6 +1183,8 @@ ndw_NATS_Shutdown()
 {
     NDW_LOGX("===> ndw_NATS_Shutdown() ...\n");
 
+    ndw_NATS_DestroyRetiredHandles(); // All connections are disconnected; no thread uses them now.
+
     NDW_LOGX("First invoking nats_CloseAndWait...\n");
     nats_CloseAndWait(5000);
 
@@ -1035,6 +1231,8 @@ ndw_Build_JSAttributes_String(ndw_Topic_T* topic)
     }
 
     ndw_NATS_JS_Attr_T* attr = &(nats_topic->nats_js_attr);
+    CHAR_T fetch_batch[16];
+    snprintf(fetch_batch, sizeof(fetch_batch), "%d", attr->fetch_batch);
     attr->debug_desc = ndw_ConcatStrings(" <-- JetStream Attributes: Initialized<",
         attr->is_initialized ? "TRUE" : "false",
          "> Enabled<", attr->is_enabled ? "TRUE" : "false",
@@ -1047,12 +1245,14 @@ ndw_Build_JSAttributes_String(ndw_Topic_T* topic)
          "> StreamSubjectName<", NDW_ISNULLCHARPTR(attr->stream_subject_name) ? "???" : attr->stream_subject_name,
          "> DurableName<", NDW_ISNULLCHARPTR(attr->durable_name) ? "???" : attr->durable_name,
          "> Filter<\"", NDW_ISNULLCHARPTR(attr->filter) ? "???" : attr->filter,
-         "\">", NULL);
+         "\"> FetchBatch<", fetch_batch,
+         "> FetchAckAll<", attr->fetch_ack_all ? "TRUE" : "false",
+         ">", NULL);
 
     if (attr->is_initialized && (! attr->is_config_error) && (attr->is_enabled)) {
         CHAR_T* prev_debug_desc = topic->debug_desc;
         topic->debug_desc = ndw_ConcatStrings(prev_debug_desc, attr->debug_desc, NULL);
-        free(prev_debug_desc);
+        ndw_RegistryFree(prev_debug_desc); // May point into the registry image.
     }
 
 } // end method ndw_Build_JSAttributes_String
@@ -1096,61 +1296,90 @@ ndw_NATS_PrintJSAttr(ndw_Topic_T* topic)
     
 } // end method ndw_NATS_PrintJSAttr
 
-static INT_T
-ndw_NATS_PublicationBackoff(ndw_NATS_Connection_T* conn)
+// Deadlines of publication waits must not move with NTP or settimeofday steps.
+static ULONG_T
+ndw_NATS_MonotonicNanoseconds()
 {
-    if (NULL == conn) {
-        NDW_LOGERR("*** ERROR FATAL: ndw_NATS_Connection* conn parameter is NULL!\n");
-        ndw_exit(EXIT_FAILURE);
-    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((ULONG_T) ts.tv_sec * 1000000000UL) + (ULONG_T) ts.tv_nsec;
+} // end method ndw_NATS_MonotonicNanoseconds
+
+// Wait up to wait_us for the bytes buffered on the physical connection nc to drain to the low watermark.
+// No locks, no flush and no logging: the NATS flusher thread drains the buffer on its own.
+// Returns true if the connection is below the low watermark.
+static bool
+ndw_NATS_PublicationWaitForRoom(ndw_NATS_Connection_T* conn, natsConnection* nc, LONG_T wait_us)
+{
+    LONG_T low = conn->publication_low_watermark_bytes;
+    if (natsConnection_Buffered(nc) <= low)
+        return true;
 
-    ndw_Connection_T* connection = conn->ndw_connection;
-    if (NULL == connection) {
-        NDW_LOGERR("*** ERROR FATAL: ndw_Connection* POINTER is NULL inside of ndw_NATS_Connection_T*\n");
-        ndw_exit(EXIT_FAILURE);
-    }
+    if (wait_us <= 0)
+        return false;
 
-    NDW_LOGX("Trying backoff on %s flush_timeout_ms<%ld> publication_backoff_bytes<%ld> "
-                "backoff_sleep_us<%ld> backoff_attempts<%ld> ...... for %s\n",
-                conn->ndw_connection->debug_desc, conn->flush_timeout_ms, conn->publication_backoff_bytes,
-                conn->backoff_sleep_us, conn->backoff_attempts, connection->debug_desc);
+    struct timespec slice = { .tv_sec = 0, .tv_nsec = NDW_NATS_PUBLICATION_WAIT_SLICE_US * 1000L };
+    ULONG_T deadline = ndw_NATS_MonotonicNanoseconds() + ((ULONG_T) wait_us * 1000UL);
+    do {
+        nanosleep(&slice, NULL);
+        if (natsConnection_Buffered(nc) <= low)
+            return true;
+    } while (ndw_NATS_MonotonicNanoseconds() < deadline);
+
+    return false;
+} // end method ndw_NATS_PublicationWaitForRoom
+
+// Admission check before a core NATS publish on nc, the physical connection loaded from pc of the pool.
+// Once buffered bytes reach the high watermark (PublicationBackoffBytes) the connection is throttled until they
+// drain to the low watermark. A throttled publisher waits up to publication_max_wait_us. Then, by default, the
+// message is sent anyway, as before flow control; with PublicationWouldBlock it is refused instead.
+// Returns 0 if the message may be sent, else NDW_PUBLISH_WOULD_BLOCK.
+static INT_T
+ndw_NATS_PublicationAdmit(ndw_NATS_Connection_T* conn, ndw_NATS_PoolConnection_T* pc, natsConnection* nc)
+{
+    if (conn->publication_backoff_bytes <= 0)
+        return 0; // Flow control disabled.
 
-    INT_T buffered = 0;
-    LONG_T attempts = 0;
-    natsStatus flush_code;
-    INT_T sleep_us = (INT_T) conn->backoff_sleep_us;
-    while (attempts < conn->backoff_attempts)
-    {
-        buffered = natsConnection_Buffered(conn->conn);
+    LONG_T buffered = natsConnection_Buffered(nc);
+    bool throttled = __atomic_load_n(&pc->publication_throttled, __ATOMIC_RELAXED);
 
-        if (buffered < ((INT_T) conn->publication_backoff_bytes)) {
-            NDW_LOGX("Attempt[%ld] ==> buffered<%d> backoff at<%ld> diff<%ld> for %s\n",
-                attempts, buffered, conn->publication_backoff_bytes, (conn->publication_backoff_bytes - buffered), connection->debug_desc);
-            break;
-        }
+    if (! throttled) {
+        if (buffered < conn->publication_backoff_bytes)
+            return 0;
+        __atomic_store_n(&pc->publication_throttled, true, __ATOMIC_RELAXED);
+    }
+    else if (buffered <= conn->publication_low_watermark_bytes) {
+        __atomic_store_n(&pc->publication_throttled, false, __ATOMIC_RELAXED);
+        return 0;
+    }
 
-        usleep((sleep_us <= 0) ? 100 : sleep_us);
+    if (ndw_NATS_PublicationWaitForRoom(conn, nc, conn->publication_max_wait_us)) {
+        __atomic_store_n(&pc->publication_throttled, false, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&conn->total_throttle_waits, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
 
-        if (conn->flush_timeout_ms > 0)
-        {
-            flush_code = natsConnection_FlushTimeout(conn->conn, (LONG_T) conn->flush_timeout_ms);
-            if (NATS_OK == flush_code) {
-                NDW_LOGX("Attempt[%ld] => natsConnection_FlushTimeoutMs(<%ld> milliseconds) Okay! For %s\n",
-                            attempts, conn->flush_timeout_ms, connection->debug_desc);
-            } else {
-                NDW_LOGERR("**** ERROR: Attempt[%ld] natsConnection_FlushTimeoutMs(<%ld> milliseconds) FAILED with natsStatus<%d>!\n For %s",
-                    attempts, conn->flush_timeout_ms, flush_code, connection->debug_desc);
-            }
-        }
+    if (! conn->publication_would_block) {
+        __atomic_fetch_add(&conn->total_throttle_waits, 1, __ATOMIC_RELAXED);
+        return 0; // NATS buffers it; the throttle stays on until the low watermark.
+    }
 
-        ++attempts;
-        conn->total_backoff_attempts += 1;
-    } // end while attempts ...
+    __atomic_fetch_add(&conn->total_would_block, 1, __ATOMIC_RELAXED);
+    return NDW_PUBLISH_WOULD_BLOCK;
+} // end method ndw_NATS_PublicationAdmit
+
+// Invoked after a failed publish on nc: give the connection a bounded chance to drain before the retry.
+static INT_T
+ndw_NATS_PublicationBackoff(ndw_NATS_Connection_T* conn, natsConnection* nc)
+{
+    if (NULL == conn) {
+        NDW_LOGERR("*** ERROR FATAL: ndw_NATS_Connection* conn parameter is NULL!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
 
-    NDW_LOGX("Completed Attempts<%ld> backoff with flush_timeout_ms<%ld> publication_backoff_bytes<%ld> "
-                "backoff_sleep_us<%ld> backoff_attempts<%ld> for %s......\n", attempts,
-                conn->flush_timeout_ms, conn->publication_backoff_bytes,
-                conn->backoff_sleep_us, conn->backoff_attempts, connection->debug_desc);
+    __atomic_fetch_add(&conn->total_backoff_attempts, 1, __ATOMIC_RELAXED);
+    LONG_T wait_us = (conn->publication_max_wait_us > 0) ? conn->publication_max_wait_us : conn->backoff_sleep_us;
+    ndw_NATS_PublicationWaitForRoom(conn, nc, (wait_us <= 0) ? 100 : wait_us);
 
     return 0;
 } // end method ndw_NATS_PublicationBackoff
@@ -1220,23 +1449,34 @@ ndw_NATS_Publish_Internal(const char* subject)
         return ret_code;
     }
 
+    // Loaded once: Disconnect clears the pool entry while publishers run, and keeps the handle until shutdown.
+    ndw_NATS_PoolConnection_T* pc = &(nats_connection->pool[nats_topic->pool_index]);
+    natsConnection* nc = __atomic_load_n(&pc->conn, __ATOMIC_ACQUIRE);
+    if (NULL == nc) {
+        NDW_LOGTOPICERRMSG("Connection was NOT established (before)!", t);
+        return -3;
+    }
+
+    if (0 != ndw_NATS_PublicationAdmit(nats_connection, pc, nc))
+        return NDW_PUBLISH_WOULD_BLOCK;
+
     INT_T max_tries = 2;
     INT_T ret_code = -9;
     for (INT_T i = 0; i < max_tries; i++)
     {
-        natsStatus status = natsConnection_Publish( nats_connection->conn, subject,
+        natsStatus status = natsConnection_Publish( nc, subject,
                                                 (const void*) start_address, (INT_T) total_size);
         if (NATS_OK == status) {
-            nats_topic->total_messages_published += 1;
+            ndw_TopicStatsAdd(t->stats_index, NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS, 1);
             ret_code = 0;
             break; // Successful Publish!
         }
 
-        const CHAR_T* connection_status = ndw_GetNATSConnectionStatus(nats_connection->conn);
+        const CHAR_T* connection_status = ndw_GetNATSConnectionStatus(nc);
         NDW_LOGERR( "*** WARNING: Publish FAILED with status<%d> and ConnectionStatus<%s> for TopicSequenceNumber<%ld> for %s\n",
                      status, connection_status, t->sequence_number, t->debug_desc);
 
-        ndw_NATS_PublicationBackoff(nats_connection);
+        ndw_NATS_PublicationBackoff(nats_connection, nc);
     }
 
     return ret_code;
@@ -1261,6 +1501,115 @@ ndw_NATS_PublishMsg()
     return ndw_NATS_Publish_Internal(t->pub_key);
 } // end method ndw_NATS_PublishMsg()
 
+INT_T
+ndw_NATS_PublishMsgBatch(ndw_PublishBatchItem_T* items, INT_T count, INT_T vendor_id, LONG_T flush_timeout_ms)
+{
+    natsConnection* flush_list[NDW_NATS_BATCH_MAX_FLUSH_CONNECTIONS];
+    ndw_NATS_Connection_T* flush_owner[NDW_NATS_BATCH_MAX_FLUSH_CONNECTIONS];
+    INT_T flush_count = 0;
+    INT_T flush_failures = 0;
+
+    for (INT_T i = 0; i < count; i++)
+    {
+        ndw_PublishBatchItem_T* item = &items[i];
+        if (NULL == item->frame)
+            continue; // Failed or skipped while stamping.
+
+        ndw_Topic_T* t = item->topic;
+        ndw_Connection_T* c = t->connection;
+        if (vendor_id != c->vendor_id)
+            continue;
+
+        if (t->disabled || c->disabled) {
+            item->ret_code = 0;
+            continue;
+        }
+
+        if (! ndw_NATS_IsConnected(c)) {
+            NDW_LOGTOPICERRMSG("Connection was NOT established (before)!", t);
+            item->ret_code = -3;
+            continue;
+        }
+
+        ndw_NATS_Connection_T* nats_connection = (ndw_NATS_Connection_T*) c->vendor_opaque;
+        if (NULL == nats_connection) {
+            NDW_LOGERR("*** WARNING: ndw_NATS_Connection_T* not yet allocated for %s\n", t->debug_desc);
+            item->ret_code = -4;
+            continue;
+        }
+
+        if (item->loopback_test) {
+            // Loopback testing, as in ndw_NATS_Publish_Internal.
+            item->ret_code = ndw_HandleVendorAsyncMessage(t, item->frame, item->frame_size, NULL);
+            continue;
+        }
+
+        ndw_NATS_Topic_T* nats_topic = (ndw_NATS_Topic_T*) t->vendor_opaque;
+        ndw_NATS_JS_Attr_T* js_attr = &(nats_topic->nats_js_attr);
+        if (js_attr->is_initialized && js_attr->is_enabled) {
+            // JetStream publish is acknowledged per message; no flush needed.
+            item->ret_code = ndw_NATS_JSPublishFrame(t, item->frame, item->frame_size, true, flush_timeout_ms);
+            continue;
+        }
+
+        ndw_NATS_PoolConnection_T* pc = &(nats_connection->pool[nats_topic->pool_index]);
+        natsConnection* nc = __atomic_load_n(&pc->conn, __ATOMIC_ACQUIRE);
+        if (NULL == nc) {
+            NDW_LOGTOPICERRMSG("Connection was NOT established (before)!", t);
+            item->ret_code = -3;
+            continue;
+        }
+
+        if (0 != ndw_NATS_PublicationAdmit(nats_connection, pc, nc)) {
+            item->ret_code = NDW_PUBLISH_WOULD_BLOCK;
+            continue;
+        }
+
+        // One attempt: a failed item is reported and the batch moves on rather than backing off per item.
+        natsStatus status = natsConnection_Publish(nc, t->pub_key, (const void*) item->frame, item->frame_size);
+        if (NATS_OK == status) {
+            ndw_TopicStatsAdd(t->stats_index, NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS, 1);
+            item->ret_code = 0;
+        } else {
+            const CHAR_T* connection_status = ndw_GetNATSConnectionStatus(nc);
+            NDW_LOGERR( "*** WARNING: Batch Publish FAILED with status<%d> and ConnectionStatus<%s> for %s\n",
+                         status, connection_status, t->debug_desc);
+            item->ret_code = -9;
+        }
+
+        if ((0 != item->ret_code) || (flush_timeout_ms <= 0))
+            continue;
+
+        INT_T f = 0;
+        while ((f < flush_count) && (flush_list[f] != nc))
+            ++f;
+
+        if (f < flush_count)
+            continue; // Already scheduled for flush.
+
+        if (flush_count < NDW_NATS_BATCH_MAX_FLUSH_CONNECTIONS) {
+            flush_owner[flush_count] = nats_connection;
+            flush_list[flush_count++] = nc;
+        } else {
+            // Too many distinct connections in one batch; flush this one now.
+            if (NATS_OK != natsConnection_FlushTimeout(nc, flush_timeout_ms))
+                ++flush_failures;
+        }
+    }
+
+    for (INT_T f = 0; f < flush_count; f++)
+    {
+        natsStatus flush_code = natsConnection_FlushTimeout(flush_list[f], flush_timeout_ms);
+        if (NATS_OK != flush_code) {
+            NDW_LOGERR("*** ERROR: Batch natsConnection_FlushTimeout(<%ld> milliseconds) FAILED with natsStatus<%d> for %s\n",
+                        flush_timeout_ms, flush_code, flush_owner[f]->ndw_connection->debug_desc);
+            ++flush_failures;
+        }
+    }
+
+    return flush_failures;
+} // end method ndw_NATS_PublishMsgBatch
+
 static INT_T
 ndw_NATS_SetSubscriptionOptions(ndw_Topic_T* topic)
 {
@@ -1275,11 +1624,11 @@ ndw_NATS_SetSubscriptionOptions(ndw_Topic_T* topic)
     //ndw_Connection_T* conn = topic->connection;
     //ndw_Domain_T* domain = conn->domain;
 
-    const CHAR_T* pendingMsgsLimit = ndw_GetNVPairValue(NDW_NATS_TOPIC_MSGLIMIT_OPTION, &(topic->topic_options_nvpairs));
+    const CHAR_T* pendingMsgsLimit = ndw_GetNVPairValue(NDW_NATS_TOPIC_MSGLIMIT_OPTION, &(topic->cold->topic_options_nvpairs));
     INT_T n_PendingMsgsLimit = 0;
     if (NULL != pendingMsgsLimit) {
         if (ndw_atoi(pendingMsgsLimit, &n_PendingMsgsLimit) && (n_PendingMsgsLimit > 0)) {
-            const CHAR_T* pendingBytesLimit = ndw_GetNVPairValue(NDW_NATS_TOPIC_BYTESLIMIT_OPTION, &(topic->topic_options_nvpairs));
+            const CHAR_T* pendingBytesLimit = ndw_GetNVPairValue(NDW_NATS_TOPIC_BYTESLIMIT_OPTION, &(topic->cold->topic_options_nvpairs));
             INT_T n_PendingBytesLimit = 0;
             if (ndw_atoi(pendingBytesLimit, &n_PendingBytesLimit) && (n_PendingBytesLimit > 0)) {
                 nats_topic->subscription_PendingLimitsMsgs = n_PendingMsgsLimit;
@@ -1409,22 +1758,28 @@ ndw_NATS_Unsubscribe(ndw_Topic_T* topic)
     if (NULL == topic)
         return 0;
 
-    if (topic->disabled || topic->connection->disabled)
-        return 0;
-
     ndw_NATS_Topic_T* nats_topic = (ndw_NATS_Topic_T*) topic->vendor_opaque;
     if (NULL == nats_topic)
         return 0;
 
+    // A Topic disabled by a registry reload is still unsubscribed.
+    if ((topic->disabled || topic->connection->disabled) && (NULL == nats_topic->nats_subscription))
+        return 0;
+
     if (topic->durable_topic) {
         // Nothing to do at this Point. We can use natsSubscription_Unsubscribe
     }
 
+    if (NULL != nats_topic->nats_js_attr.fetch_list.Msgs)
+        ndw_NATS_JSFreeFetchList(topic, &(nats_topic->nats_js_attr)); // Unacked; server redelivers them.
+
     if (NULL != nats_topic->nats_subscription) {
         NDW_LOGTOPICMSG("NOTE: Unsubscribing from Topic:", topic);
-        natsSubscription_Unsubscribe(nats_topic->nats_subscription);
-        natsSubscription_Destroy(nats_topic->nats_subscription);
-        nats_topic->nats_subscription = NULL;
+        // A poller or the metrics exporter may still hold the subscription: unsubscribe now, destroy on shutdown.
+        natsSubscription* subscription = nats_topic->nats_subscription;
+        __atomic_store_n(&nats_topic->nats_subscription, NULL, __ATOMIC_RELEASE);
+        natsSubscription_Unsubscribe(subscription);
+        ndw_NATS_Retire(subscription, NULL, NULL);
         topic->synchronous_subscription = false;
         return 0;
     }
@@ -1463,6 +1818,175 @@ ndw_NATS_GetQueuedMsgCount(ndw_Topic_T* topic, ULONG_T* count)
     }
 } // end method ndw_NATS_GetQueuedMsgCount
 
+void
+ndw_NATS_GetTopicMetrics(ndw_Topic_T* topic, ndw_TopicMetrics_T* metrics)
+{
+    if ((NULL == topic) || (NULL == metrics))
+        return;
+
+    ndw_NATS_Topic_T* nats_topic = (ndw_NATS_Topic_T*) topic->vendor_opaque;
+    if (NULL == nats_topic)
+        return;
+
+    // Serialized with Disconnect; a subscription closed by Unsubscribe is kept until ndw_NATS_Shutdown.
+    pthread_mutex_lock(&ndw_NATS_ConnectionLock);
+    natsSubscription* subscription = __atomic_load_n(&nats_topic->nats_subscription, __ATOMIC_ACQUIRE);
+    int pending_msgs = 0, pending_bytes = 0, max_pending_msgs = 0, max_pending_bytes = 0;
+    int64_t delivered_msgs = 0, dropped_msgs = 0;
+    natsStatus status = NATS_ERR;
+    if (NULL != subscription)
+        status = natsSubscription_GetStats(subscription, &pending_msgs, &pending_bytes,
+                                    &max_pending_msgs, &max_pending_bytes, &delivered_msgs, &dropped_msgs);
+    pthread_mutex_unlock(&ndw_NATS_ConnectionLock);
+
+    if (NATS_OK != status)
+        return; // Not subscribed, or the subscription is closing.
+
+    metrics->vendor_pending_msgs = pending_msgs;
+    metrics->vendor_pending_bytes = pending_bytes;
+    metrics->vendor_delivered_msgs = delivered_msgs;
+    metrics->vendor_dropped_msgs = dropped_msgs;
+} // end method ndw_NATS_GetTopicMetrics
+
+void
+ndw_NATS_GetConnectionMetrics(ndw_Connection_T* connection, ndw_ConnectionMetrics_T* metrics)
+{
+    if ((NULL == connection) || (NULL == metrics))
+        return;
+
+    ndw_NATS_Connection_T* nats_connection = (ndw_NATS_Connection_T*) connection->vendor_opaque;
+    if (NULL == nats_connection)
+        return;
+
+    metrics->backoff_attempts = __atomic_load_n(&nats_connection->total_backoff_attempts, __ATOMIC_RELAXED);
+    metrics->would_block = __atomic_load_n(&nats_connection->total_would_block, __ATOMIC_RELAXED);
+    metrics->throttle_waits = __atomic_load_n(&nats_connection->total_throttle_waits, __ATOMIC_RELAXED);
+    metrics->async_publish_pending = __atomic_load_n(&nats_connection->js_async_published, __ATOMIC_RELAXED) -
+                                        __atomic_load_n(&nats_connection->js_async_completed, __ATOMIC_RELAXED);
+
+    natsStatistics* stats = NULL;
+    if (NATS_OK != natsStatistics_Create(&stats))
+        return;
+
+    // Summed over the physical connections of the pool. Connect and Disconnect change the pool under this lock.
+    pthread_mutex_lock(&ndw_NATS_ConnectionLock);
+    for (INT_T i = 0; (NULL != nats_connection->conn) && (i < nats_connection->pool_size); i++) {
+        natsConnection* conn = nats_connection->pool[i].conn;
+        if (NULL == conn)
+            continue;
+
+        metrics->vendor_connections += 1;
+
+        int buffered = natsConnection_Buffered(conn);
+        metrics->vendor_buffered_bytes += (buffered > 0) ? buffered : 0;
+
+        uint64_t in_msgs = 0, in_bytes = 0, out_msgs = 0, out_bytes = 0, reconnects = 0;
+        if ((NATS_OK == natsConnection_GetStats(conn, stats)) &&
+            (NATS_OK == natsStatistics_GetCounts(stats, &in_msgs, &in_bytes, &out_msgs, &out_bytes, &reconnects))) {
+            metrics->vendor_in_msgs += in_msgs;
+            metrics->vendor_in_bytes += in_bytes;
+            metrics->vendor_out_msgs += out_msgs;
+            metrics->vendor_out_bytes += out_bytes;
+            metrics->vendor_reconnects += reconnects;
+        }
+    }
+    pthread_mutex_unlock(&ndw_NATS_ConnectionLock);
+
+    natsStatistics_Destroy(stats);
+} // end method ndw_NATS_GetConnectionMetrics
+
+// Publication flow control options of a Connection. Publishing threads read these while they may be reloaded,
+// so each is stored with a single atomic store.
+static void
+ndw_NATS_SetPublicationBackoffOptions(ndw_Connection_T* connection, ndw_NATS_Connection_T* conn)
+{
+    LONG_T backoff_bytes = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_BYTES;
+    LONG_T backoff_sleep_us = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_SLEEP_US;
+    LONG_T backoff_attempts = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_ATTEMPTS;
+    bool exists = false;
+    LONG_T value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_BYTES, &exists);
+    if (exists && (value > 0))
+        backoff_bytes = value;
+    NDW_LOGX("Connection Option: # of publication_backoff_bytes <%ld> for %s\n", backoff_bytes, connection->debug_desc);
+
+    exists = false;
+    value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_SLEEP_US, &exists);
+    if (exists && (value > 0))
+        backoff_sleep_us = value;
+    NDW_LOGX("Connection Option: # of backoff_sleep_us <%ld> for %s\n", backoff_sleep_us, connection->debug_desc);
+
+    exists = false;
+    value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_ATTEMPTS, &exists);
+    if (exists && (value > 0))
+        backoff_attempts = value;
+    NDW_LOGX("Connection Option: Number of backoff_attempts <%ld> for %s\n", backoff_attempts, connection->debug_desc);
+
+    LONG_T low_watermark_bytes = backoff_bytes / 2;
+    exists = false;
+    value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_LOW_WATERMARK_BYTES, &exists);
+    if (exists && (value >= 0) && (value < backoff_bytes))
+        low_watermark_bytes = value;
+    NDW_LOGX("Connection Option: publication_low_watermark_bytes <%ld> for %s\n",
+                low_watermark_bytes, connection->debug_desc);
+
+    exists = false;
+    value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_WOULD_BLOCK, &exists);
+    bool would_block = (exists && (value > 0));
+    NDW_LOGX("Connection Option: publication_would_block <%s> for %s\n", (would_block ? "True" : "false"),
+                connection->debug_desc);
+
+    // Admit without waiting unless a wait is configured: BackoffSleep_us is sized for retrying a failed publish.
+    LONG_T max_wait_us = 0;
+    exists = false;
+    value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_MAX_WAIT_US, &exists);
+    if (exists && (value >= 0))
+        max_wait_us = value;
+    NDW_LOGX("Connection Option: publication_max_wait_us <%ld> for %s\n", max_wait_us, connection->debug_desc);
+
+    // Low watermark first, so a reader never sees it at or above a lowered high watermark for long.
+    __atomic_store_n(&conn->publication_low_watermark_bytes, low_watermark_bytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&conn->publication_backoff_bytes, backoff_bytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&conn->backoff_sleep_us, backoff_sleep_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&conn->backoff_attempts, backoff_attempts, __ATOMIC_RELAXED);
+    __atomic_store_n(&conn->publication_max_wait_us, max_wait_us, __ATOMIC_RELAXED);
+    __atomic_store_n(&conn->publication_would_block, would_block, __ATOMIC_RELAXED);
+} // end method ndw_NATS_SetPublicationBackoffOptions
+
+INT_T
+ndw_NATS_ReloadTopic(ndw_Topic_T* topic)
+{
+    if (NULL == topic)
+        return -1;
+
+    ndw_NATS_Topic_T* nats_topic = (ndw_NATS_Topic_T*) topic->vendor_opaque;
+    if (NULL == nats_topic)
+        return -2;
+
+    // A durable Topic added to a Connection that was connected without any: JetStream is set up on Connect.
+    ndw_NATS_Connection_T* nats_connection = nats_topic->nats_connection;
+    if (topic->durable_topic && (NULL != nats_connection->conn) && (NULL == nats_connection->js_context)) {
+        if (0 != ndw_NATS_JSConnect(nats_connection)) {
+            NDW_LOGERR("*** ERROR: FAILED to Connect with JetStream for %s\n", topic->debug_desc);
+            return -3;
+        }
+    }
+
+    if (NULL != nats_topic->nats_subscription)
+        return ndw_NATS_SetSubscriptionOptions(topic);
+
+    return 0;
+} // end method ndw_NATS_ReloadTopic
+
+INT_T
+ndw_NATS_ReloadConnection(ndw_Connection_T* connection)
+{
+    if ((NULL == connection) || (NULL == connection->vendor_opaque))
+        return -1;
+
+    ndw_NATS_SetPublicationBackoffOptions(connection, (ndw_NATS_Connection_T*) connection->vendor_opaque);
+    return 0;
+} // end method ndw_NATS_ReloadConnection
+
 INT_T
 ndw_NATS_SubscribeSynchronously(ndw_Topic_T* topic)
 {
@@ -1730,8 +2254,6 @@ ndw_NATS_GetResponseForRequestMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T*
         ndw_exit(EXIT_FAILURE);
     }
 
-    ndw_NATS_Topic_T* nats_topic = cxt_topic->nats_topic;
-
     *vendor_closure = NULL;
     *msg_length = 0;
 
@@ -1762,7 +2284,7 @@ ndw_NATS_GetResponseForRequestMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T*
         *msg = user_msg;
         *msg_length = reply_msg_size;
         *vendor_closure = closure;
-        nats_topic->total_messages_get_requestmsg += 1;
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_VENDOR_REQUEST_REPLIES, 1);
 
         return 1;
     } else if (NATS_TIMEOUT != status) {
@@ -1791,7 +2313,7 @@ ndw_NATS_IsJSPubSub(ndw_Topic_T* topic)
     js_attr->is_initialized = true;
     js_attr->is_enabled = false;
 
-    NDW_NVPairs_T* vendor_nvpairs = &(topic->vendor_topic_options_nvpairs);
+    NDW_NVPairs_T* vendor_nvpairs = &(topic->cold->vendor_topic_options_nvpairs);
     const CHAR_T* js_enabled = ndw_GetNVPairValue(NDW_NATS_JS_ATTR_JETSTREAM_NAME, vendor_nvpairs);
     if (NDW_ISNULLCHARPTR(js_enabled) || (0 != strcasecmp("true", js_enabled))) {
         return false;
@@ -1882,6 +2404,22 @@ ndw_NATS_IsJSPubSub(ndw_Topic_T* topic)
         const CHAR_T* queue_browse = ndw_GetNVPairValue(NDW_NATS_JS_ATTR_BROWSE_MODE, vendor_nvpairs);
         js_attr->is_sub_browse_mode = (! NDW_ISNULLCHARPTR(queue_browse)) &&
                                     (0 == strcasecmp("true", queue_browse));
+
+        js_attr->fetch_batch = 1;
+        const CHAR_T* fetch_batch = ndw_GetNVPairValue(NDW_NATS_JS_ATTR_FETCH_BATCH, vendor_nvpairs);
+        if (! NDW_ISNULLCHARPTR(fetch_batch)) {
+            INT_T n = atoi(fetch_batch);
+            if ((n < 1) || (n > NDW_NATS_JS_MAX_FETCH_BATCH)) {
+                NDW_LOGERR("*** WARNING: %s<%s> must be between 1 and %d, using 1 for %s\n",
+                            NDW_NATS_JS_ATTR_FETCH_BATCH, fetch_batch, NDW_NATS_JS_MAX_FETCH_BATCH, topic->debug_desc);
+                n = 1;
+            }
+            js_attr->fetch_batch = n;
+        }
+
+        const CHAR_T* fetch_ack_all = ndw_GetNVPairValue(NDW_NATS_JS_ATTR_FETCH_ACK_ALL, vendor_nvpairs);
+        js_attr->fetch_ack_all = (! NDW_ISNULLCHARPTR(fetch_ack_all)) && (0 == strcasecmp("true", fetch_ack_all))
+                                    && (! js_attr->is_sub_browse_mode);
     }
 
     // Yikes: That was a lot of twisted logic just to set vendor attributes!
@@ -1899,6 +2437,82 @@ ndw_NATS_IsJSPubSub(ndw_Topic_T* topic)
     return true;
 } // end method ndw_NATS_ISJSPubSub
 
+// Invoked by NATS for every asynchronous JetStream publish once it is acked or has failed.
+// NATS owns msg, pa and pae.
+static void
+ndw_NATS_JSPubAckHandler(jsCtx* js, natsMsg* msg, jsPubAck* pa, jsPubAckErr* pae, void* closure)
+{
+    (void) js;
+    ndw_NATS_Connection_T* nats_connection = (ndw_NATS_Connection_T*) closure;
+    if (NULL == nats_connection) {
+        NDW_LOGERR("*** ERROR: NULL ndw_NATS_Connection_T* closure in JetStream publish ack!\n");
+        return;
+    }
+
+    __atomic_fetch_add(&nats_connection->js_async_completed, 1, __ATOMIC_RELAXED);
+
+    const CHAR_T* subject = (NULL == msg) ? NULL : natsMsg_GetSubject(msg);
+    ndw_NATS_PubKeyTopic_T* entry = NULL;
+    ndw_Topic_T* topic = NULL;
+    pthread_rwlock_rdlock(&ndw_NATS_JSPubTopicsLock);
+    if (NULL != subject)
+        HASH_FIND_STR(nats_connection->js_pub_topics, subject, entry);
+    if (NULL != entry)
+        topic = entry->topic; // Topics live until shutdown, so it can be used after unlocking.
+    pthread_rwlock_unlock(&ndw_NATS_JSPubTopicsLock);
+
+    if (NULL == topic) {
+        NDW_LOGERR("*** ERROR: JetStream publish ack for unknown subject<%s> on %s\n",
+                    (NULL == subject) ? "?" : subject, nats_connection->ndw_connection->debug_desc);
+        return;
+    }
+
+    ndw_PublishAck_T ack;
+    memset(&ack, 0, sizeof(ack));
+    ack.topic = topic;
+    if (NULL != pae) {
+        ack.error_code = (0 != pae->ErrCode) ? (INT_T) pae->ErrCode : (INT_T) pae->Err;
+        ack.error_text = (NULL != pae->ErrText) ? pae->ErrText : natsStatus_GetText(pae->Err);
+    } else if (NULL != pa) {
+        ack.stream_sequence = pa->Sequence;
+        ack.duplicate = pa->Duplicate;
+    }
+
+    ndw_HandleVendorPublishAck(&ack);
+} // end method ndw_NATS_JSPubAckHandler
+
+// Wait for outstanding asynchronous JetStream publishes to be acked. Returns number still pending.
+INT_T
+ndw_NATS_JSWaitForPublishAcks(ndw_NATS_Connection_T* nats_connection)
+{
+    if ((NULL == nats_connection->js_context) || (nats_connection->js_async_max_pending <= 0))
+        return 0;
+
+    jsPubOptions po;
+    jsPubOptions_Init(&po);
+    po.MaxWait = nats_connection->js_async_complete_wait_ms;
+
+    natsStatus s = js_PublishAsyncComplete(nats_connection->js_context, &po);
+    if (NATS_OK == s)
+        return 0;
+
+    natsMsgList pending;
+    memset(&pending, 0, sizeof(pending));
+    INT_T pending_count = 0;
+    if (NATS_OK == js_PublishAsyncGetPendingList(&pending, nats_connection->js_context)) {
+        pending_count = pending.Count;
+        natsMsgList_Destroy(&pending);
+    }
+
+    NDW_LOGERR("*** ERROR: js_PublishAsyncComplete(<%ld> milliseconds) returned <%d, %s> with <%d> "
+                "messages still waiting for acks (published<%ld> completed<%ld>) for %s\n",
+                nats_connection->js_async_complete_wait_ms, s, natsStatus_GetText(s), pending_count,
+                nats_connection->js_async_published, nats_connection->js_async_completed,
+                nats_connection->ndw_connection->debug_desc);
+
+    return (pending_count > 0) ? pending_count : 1;
+} // end method ndw_NATS_JSWaitForPublishAcks
+
 INT_T
 ndw_NATS_JSInitWithLock(ndw_NATS_Connection_T* nats_connection)
 {
@@ -1913,7 +2527,17 @@ ndw_NATS_JSInitWithLock(ndw_NATS_Connection_T* nats_connection)
         return 0;
     }
 
-    natsStatus s = natsConnection_JetStream(&(nats_connection->js_context), nats_connection->conn, NULL);
+    jsOptions js_options;
+    jsOptions* p_js_options = NULL;
+    if (nats_connection->js_async_max_pending > 0) {
+        jsOptions_Init(&js_options);
+        js_options.PublishAsync.MaxPending = nats_connection->js_async_max_pending;
+        js_options.PublishAsync.AckHandler = ndw_NATS_JSPubAckHandler;
+        js_options.PublishAsync.AckHandlerClosure = nats_connection;
+        p_js_options = &js_options;
+    }
+
+    natsStatus s = natsConnection_JetStream(&(nats_connection->js_context), nats_connection->conn, p_js_options);
     if (NATS_OK != s) {
         NDW_LOGERR("Failed to connection JetStream. Status code<%d, %s>. For %s\n",
                             s, natsStatus_GetText(s), nats_connection->ndw_connection->debug_desc);
@@ -1960,13 +2584,13 @@ ndw_NATS_JS_AsyncMsgHandler(natsConnection *nc, natsSubscription *sub, natsMsg *
     CHAR_T* ip_address = NULL;
     natsConnection_GetClientIP(nc, &ip_address);
     if (NULL != ip_address) {
-        if (ndw_CopyMaxBytes(t->last_received_ip_address,
-                                sizeof(t->last_received_ip_address), ip_address) < 0) {
+        if (ndw_CopyMaxBytes(t->cold->last_received_ip_address,
+                                sizeof(t->cold->last_received_ip_address), ip_address) < 0) {
             NDW_LOGERR( "*** FATAL ERROR: invalid ip_address\n");
             ndw_exit(EXIT_FAILURE);
         }
     } else {
-        t->last_received_ip_address[0] = '\0';
+        t->cold->last_received_ip_address[0] = '\0';
     }
 
     jsMsgMetaData *meta = NULL;
@@ -2049,7 +2673,7 @@ ndw_NATS_JSSubscribe(ndw_Topic_T* topic, bool push_mode)
     {
         jsErrCode errCode = 0;
         jsSubOptions subOpts;
-        memset(&subOpts, 0,sizeof(subOpts));
+        jsSubOptions_Init(&subOpts);
         subOpts.Stream = js_attr->stream_name;
         subOpts.Consumer = js_attr->durable_name; // You need this for Ack to work, else queue will keep growng!
         subOpts.Config.AckPolicy = js_AckExplicit;
@@ -2086,12 +2710,20 @@ ndw_NATS_JSSubscribe(ndw_Topic_T* topic, bool push_mode)
     {
         jsErrCode errCode = 0;
 
+        jsSubOptions subOpts;
+        jsSubOptions* p_subOpts = NULL;
+        if (js_attr->fetch_ack_all) {
+            jsSubOptions_Init(&subOpts);
+            subOpts.Config.AckPolicy = js_AckAll; // One ack per fetched batch.
+            p_subOpts = &subOpts;
+        }
+
         natsStatus s = js_PullSubscribe(&(nats_topic->nats_subscription),
                                         nats_connection->js_context,
                                         js_attr->filter,
                                         js_attr->durable_name,
                                         NULL,
-                                        NULL,
+                                        p_subOpts,
                                         &errCode);
         if (NATS_OK != s) {
             NDW_LOGERR("*** ERROR: JetStream Durable PULL Subscription Failed. natsStats<%d, %s> errCode<%d> for %s\n",
@@ -2129,8 +2761,6 @@ ndw_NATS_JSPublish(ndw_Topic_T* topic)
         return -2;
     }
 
-    ndw_NATS_Connection_T* nats_connection = nats_topic->nats_connection;
-
     ndw_OutMsgCxt_T* cxt = ndw_GetOutMsgCxt();
     if (NULL == cxt) {
         NDW_LOGERR("*** FATAL ERROR: ndw_GetOutMsg() returned NULL!\n");
@@ -2143,7 +2773,53 @@ ndw_NATS_JSPublish(ndw_Topic_T* topic)
     INT_T msg_size = cxt->message_size;
     INT_T total_size = header_size + msg_size;
 
-    INT_T max_tries = 2;
+    return ndw_NATS_JSPublishFrame(topic, start_address, total_size, false, 0);
+} // end method ndw_NATS_JSPublish
+
+// Publish one frame on JetStream. A batch item (in_batch) gets a single attempt with no backoff, so one slow stream
+// cannot hold up the rest of the batch: an asynchronous publish is refused with NDW_PUBLISH_WOULD_BLOCK while the
+// ack window is full, and a synchronous one waits at most max_wait_ms (if > 0) for its ack.
+INT_T
+ndw_NATS_JSPublishFrame(ndw_Topic_T* topic, UCHAR_T* start_address, INT_T total_size, bool in_batch,
+                        LONG_T max_wait_ms)
+{
+    ndw_NATS_Topic_T* nats_topic = (ndw_NATS_Topic_T*) topic->vendor_opaque;
+    ndw_NATS_Connection_T* nats_connection = nats_topic->nats_connection;
+    INT_T max_tries = in_batch ? 1 : 2;
+
+    if (nats_connection->js_async_max_pending > 0) {
+        if (in_batch) {
+            LONG_T pending = __atomic_load_n(&nats_connection->js_async_published, __ATOMIC_RELAXED) -
+                                __atomic_load_n(&nats_connection->js_async_completed, __ATOMIC_RELAXED);
+            if (pending >= nats_connection->js_async_max_pending) {
+                __atomic_fetch_add(&nats_connection->total_would_block, 1, __ATOMIC_RELAXED);
+                return NDW_PUBLISH_WOULD_BLOCK;
+            }
+        }
+
+        // Ack arrives later in ndw_NATS_JSPubAckHandler. NATS stalls us while the ack window is full.
+        for (INT_T i = 0; i < max_tries; i++)
+        {
+            natsStatus s = js_PublishAsync(nats_connection->js_context, topic->pub_key, start_address, total_size, NULL);
+            if (NATS_OK == s) {
+                ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS, 1);
+                __atomic_fetch_add(&nats_connection->js_async_published, 1, __ATOMIC_RELAXED);
+                return 0;
+            }
+
+            NDW_LOGERR("*** ERROR: js_PublishAsync FAILED with <%d, %s> on %s\n", s, natsStatus_GetText(s), topic->debug_desc);
+            if (! in_batch)
+                ndw_NATS_PublicationBackoff(nats_connection, nats_connection->conn);
+        }
+
+        return -3;
+    }
+
+    jsPubOptions pub_options;
+    jsPubOptions_Init(&pub_options);
+    if (in_batch && (max_wait_ms > 0))
+        pub_options.MaxWait = max_wait_ms;
+
     INT_T ret_code = -3;
     jsPubAck* ack = NULL;
     for (INT_T i = 0; i < max_tries; i++ )
@@ -2157,16 +2833,17 @@ ndw_NATS_JSPublish(ndw_Topic_T* topic)
                isprint((UCHAR_T)topic->pub_key[i]) ? topic->pub_key[i] : '.');
 #endif
         natsStatus s = js_Publish(&ack, nats_connection->js_context, topic->pub_key,
-                                    start_address, total_size, NULL, NULL);
+                                    start_address, total_size, &pub_options, NULL);
 
         if (NATS_OK == s) {
-            nats_topic->total_messages_published += 1;
+            ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_VENDOR_PUBLISHED_MSGS, 1);
             ret_code = 0;
             break; // Successful Publish!
         }
 
         NDW_LOGERR("*** ERROR: Failed to publish to JetStream on %s\n", topic->debug_desc);
-        ndw_NATS_PublicationBackoff(nats_connection);
+        if (! in_batch)
+            ndw_NATS_PublicationBackoff(nats_connection, nats_connection->conn);
     }
 
     if (NULL != ack) {
@@ -2174,7 +2851,47 @@ ndw_NATS_JSPublish(ndw_Topic_T* topic)
     }
 
     return ret_code;
-} // end method ndw_NATS_JSPublish
+} // end method ndw_NATS_JSPublishFrame
+
+// AckAll consumer: ack the last committed message whose ack was deferred to a later message of its batch.
+static void
+ndw_NATS_JSAckFetchPending(ndw_Topic_T* topic, ndw_NATS_JS_Attr_T* js_attr)
+{
+    natsMsg* nats_msg = js_attr->fetch_ack_pending;
+    if (NULL == nats_msg)
+        return;
+
+    js_attr->fetch_ack_pending = NULL;
+    natsStatus ack_status = natsMsg_Ack(nats_msg, NULL);
+    if (NATS_OK != ack_status) {
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_FAILED_ACKS, 1);
+        NDW_LOGERR("*** ERROR: natsMsg_Ack(...) of a partially consumed fetch failed with status<%d> status_text<%s> "
+                    "for %s\n", ack_status, natsStatus_GetText(ack_status), topic->debug_desc);
+    }
+    else {
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_ACKS, 1);
+    }
+
+    natsMsg_Destroy(nats_msg);
+} // end method ndw_NATS_JSAckFetchPending
+
+// Destroy fetched messages not yet handed out to the application.
+// Messages already committed are acked, so only the ones never handed out are redelivered.
+void
+ndw_NATS_JSFreeFetchList(ndw_Topic_T* topic, ndw_NATS_JS_Attr_T* js_attr)
+{
+    ndw_NATS_JSAckFetchPending(topic, js_attr);
+
+    natsMsgList* fetch_list = &(js_attr->fetch_list);
+    for (INT_T i = js_attr->fetch_next; i < fetch_list->Count; i++) {
+        if (NULL != fetch_list->Msgs[i])
+            natsMsg_Destroy(fetch_list->Msgs[i]);
+    }
+
+    free(fetch_list->Msgs);
+    memset(fetch_list, 0, sizeof(natsMsgList));
+    js_attr->fetch_next = 0;
+} // end method ndw_NATS_JSFreeFetchList
 
 INT_T
 ndw_NATS_JSPollForMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T* msg_length, LONG_T timeout_ms, void** vendor_closure)
@@ -2219,78 +2936,221 @@ ndw_NATS_JSPollForMsg(ndw_Topic_T* topic, const CHAR_T** msg, INT_T* msg_length,
                     topic->sub_key, timeout_ms, topic->debug_desc);
     }
 
-    natsMsgList msgList;
-    memset(&msgList, 0, sizeof(msgList));
+    natsMsgList* fetch_list = &(js_attr->fetch_list);
+
+    if (js_attr->fetch_next >= fetch_list->Count)
+    {
+        // Local buffer is drained. One server round trip for up to fetch_batch messages.
+        // A committed message still waiting on the ack of the last one of its batch is acked now.
+        ndw_NATS_JSAckFetchPending(topic, js_attr);
+        free(fetch_list->Msgs); // Important: NATS leaves the array to us, the messages are destroyed on commit.
+        memset(fetch_list, 0, sizeof(natsMsgList));
+        js_attr->fetch_next = 0;
+
+        INT_T num_messages = (js_attr->fetch_batch > 0) ? js_attr->fetch_batch : 1;
+
+        natsStatus s = natsSubscription_Fetch(fetch_list, nats_topic->nats_subscription, num_messages, timeout_ms, NULL);
+        if (NATS_TIMEOUT == s) {
+            if (ndw_verbose > 4) {
+                NDW_LOGX("NOTE: natsSubscription_Fetch() returned with NATS_TIMEOUT for %s\n", topic->debug_desc);
+            }
+
+            memset(fetch_list, 0, sizeof(natsMsgList));
+            return 0;   // No message.
+        }
 
-    INT_T num_messages = 1; // XXX: Need to support batch mode fetching!
+        if (NATS_OK != s) {
+            NDW_LOGERR("*** ERROR: natsSubscrption_Fetch (PULL poll mode) failed with code<%d, %s> for %s\n",
+                        s, natsStatus_GetText(s), topic->debug_desc);
+            memset(fetch_list, 0, sizeof(natsMsgList));
+            return -4;
+        }
 
-    natsStatus s = natsSubscription_Fetch(&msgList, nats_topic->nats_subscription, num_messages, timeout_ms, NULL);
-    if (NATS_TIMEOUT == s) {
-        if (ndw_verbose > 4) {
-            NDW_LOGX("NOTE: natsSubscription_Fetch() returned with NATS_TIMEOUT for %s\n", topic->debug_desc);
+        if ((0 == fetch_list->Count) || (fetch_list->Count > num_messages)) {
+            NDW_LOGERR("*** ERROR: natsSubscrption_Fetch Return <%d> messages when Expected NOT more than <%d> for %s\n",
+                        fetch_list->Count, num_messages, topic->debug_desc);
+            ndw_NATS_JSFreeFetchList(topic, js_attr);
+            return -5;
         }
 
-        return 0;   // No message.
+        js_attr->fetch_round_trips += 1;
     }
 
-    if (NATS_OK != s) {
-        NDW_LOGERR("*** ERROR: natsSubscrption_Fetch (PULL poll mode) failed with code<%d, %s> for %s\n",
-                    s, natsStatus_GetText(s), topic->debug_desc);
+    natsMsg* nats_msg = fetch_list->Msgs[js_attr->fetch_next];
+    fetch_list->Msgs[js_attr->fetch_next] = NULL; // Ownership passes to the closure until commit.
+    js_attr->fetch_next += 1;
+
+    jsMsgMetaData *meta = NULL;
+    natsMsg_GetMetaData(&meta, nats_msg);
+    if (NULL == meta) {
+        NDW_LOGERR("*** ERROR: natsMsg_GetMetaData returned NULL POINTER for %s\n", topic->debug_desc);
+    }
+    else {
+        js_attr->durable_ack_sequence = meta->Sequence.Consumer;
+        js_attr->durable_ack_global_sequence = meta->Sequence.Stream;
+        topic->last_received_durable_ack_sequence =  meta->Sequence.Consumer;
+        topic->last_received_durable_ack_global_sequence = meta->Sequence.Stream;
+        topic->last_received_durable_total_delivered += 1;
+        topic->last_received_durable_total_pending = (ULONG_T) (fetch_list->Count - js_attr->fetch_next);
+
+        jsMsgMetaData_Destroy(meta);
+    }
+
+    ndw_NATS_Closure_T* closure = NDW_NATS_GET_EMPTY_CLOSURE(topic);
+    LONG_T dropped = 0;
+    natsSubscription_GetDropped(nats_topic->nats_subscription, &dropped);
+    nats_topic->subscription_DroppedMsgs = (LONG_T) dropped;
+
+    const CHAR_T* user_msg = natsMsg_GetData(nats_msg);
+    INT_T nats_msg_size = natsMsg_GetDataLength(nats_msg);
+    closure->is_js = true;
+    closure->nats_msg = nats_msg;
+    closure->user_msg = user_msg;
+    closure->msg_size = nats_msg_size;
+    closure->counter += 1;
+
+    *msg = user_msg;
+    *msg_length = nats_msg_size;
+
+    *vendor_closure = closure;
+
+    return 1;
+} // end method ndw_NATS_JSPollForMsg
+
+// JetStream configuration checks of a Topic, on attributes already parsed by ndw_NATS_IsJSPubSub.
+// Returns 0 if the Topic can be configured, else < 0. Never exits, as a registry reload checks Topics it may add.
+static INT_T
+ndw_NATS_CheckJSConfiguration(ndw_Topic_T* topic, ndw_NATS_JS_Attr_T* attr)
+{
+    if (! attr->is_initialized) {
+        NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T is NOT initialized for %s\n", topic->debug_desc);
+        return -1;
+    }
+
+    if (! attr->is_enabled)
+        return 0; // No Durability feature. JetStream NOT needed.
+
+    // Durability is expected. JetStream needed.
+    if (attr->is_config_error) {
+        NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T initialized has CONFIG error for %s\n", topic->debug_desc);
+        return -2;
+    }
+
+    if (! topic->is_pub_enabled)
+        attr->is_pub_enabled = false;
+
+    if (! topic->is_sub_enabled)
+        attr->is_sub_enabled = false;
+
+    if ((!attr->is_pub_enabled) && (!attr->is_sub_enabled)) {
+        NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T has neither pub NOR sub enabled for %s\n",
+                    topic->debug_desc);
+        return -3;
+    }
+
+    if (attr->is_push_mode && attr->is_pull_mode) {
+        NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T BOTH PUSH and PULL mode enabled for %s\n",
+                    topic->debug_desc);
         return -4;
     }
 
-    if ((0 == msgList.Count) || (msgList.Count > num_messages)) {
-        NDW_LOGERR("*** ERROR: natsSubscrption_Fetch Return <%d> messages when Expected NOT more than <%d> for %s\n",
-                    msgList.Count, num_messages, topic->debug_desc);
-        return -5;
+    // Check sub. Cannot be both PUSH and PULL mode.
+    if (attr->is_sub_enabled) {
+        bool atleast_one_mode = attr->is_push_mode || attr->is_pull_mode;
+        if (! atleast_one_mode) {
+            NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T Neither PUSH NOR PULL mode enabled for %s\n",
+                    topic->debug_desc);
+            return -5;
+        }
     }
 
-    // XXX: ToDo: Handle batched polled messages.
-    for (INT_T i = 0; i < msgList.Count; i++)
-    {
-        natsMsg* nats_msg = msgList.Msgs[i];
+    bool no_stream_name = NDW_ISNULLCHARPTR(attr->stream_name);
+    bool no_stream_subject_name = NDW_ISNULLCHARPTR(attr->stream_subject_name);
+    bool no_durable_name = NDW_ISNULLCHARPTR(attr->durable_name);
+    bool no_filter = NDW_ISNULLCHARPTR(attr->filter);
+
+    //  Pub: Needs stream_subject_name.
+    if (attr->is_pub_enabled && no_stream_subject_name) {
+        NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T: Publish need stream_subject_name for %s\n",
+                    topic->debug_desc);
+        return -6;
+    }
 
-        jsMsgMetaData *meta = NULL;
-        natsMsg_GetMetaData(&meta, nats_msg);
-        if (NULL == meta) {
-            NDW_LOGERR("*** ERROR: natsMsg_GetMetaData returned NULL POINTER for %s\n", topic->debug_desc);
+    // Check Sub attributes for PUSH and PULL.
+    if (attr->is_sub_enabled) {
+        if (attr->is_push_mode) {
+            // Sub: PUSH Mode: Needs stream_name, durable_name and filter.
+            if (no_stream_name || no_durable_name || no_filter) {
+                NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T: PUSH mode needs stream_name and durable_name "
+                            "and filter for %s\n", topic->debug_desc);
+                return -7;
+            }
+        }
+        else if (attr->is_pull_mode) {
+            // Sub: PULL Mode: durable_name and filter.
+            if (no_durable_name || no_filter) {
+                NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T: PULL mode needs durable_name and filter for %s\n",
+                                topic->debug_desc);
+                return -8;
+            }
         }
         else {
-            js_attr->durable_ack_sequence = meta->Sequence.Consumer;
-            js_attr->durable_ack_global_sequence = meta->Sequence.Stream;
-            topic->last_received_durable_ack_sequence =  meta->Sequence.Consumer;
-            topic->last_received_durable_ack_global_sequence = meta->Sequence.Stream;
-            topic->last_received_durable_total_delivered += 1;
-            topic->last_received_durable_total_pending = 0;
-
-            jsMsgMetaData_Destroy(meta);
+            NDW_LOGERR("*** ERROR: ndw_NATS_JS_Attr_T Neither PUSH or PULL mode enabled for %s\n", topic->debug_desc);
+            return -9;
         }
 
-        ndw_NATS_Closure_T* closure = NDW_NATS_GET_EMPTY_CLOSURE(topic);
-        LONG_T dropped = 0;
-        natsSubscription_GetDropped(nats_topic->nats_subscription, &dropped);
-        nats_topic->subscription_DroppedMsgs = (LONG_T) dropped;
+    } // end if sub is enabled
 
-        // XXX: Note that this point we polling for ONLY 1 message, else this code will have to maintain a list.
-        const CHAR_T* user_msg = natsMsg_GetData(nats_msg);
-        INT_T nats_msg_size = natsMsg_GetDataLength(nats_msg);
-        closure->is_js = true;
-        closure->nats_msg = nats_msg;
-        closure->user_msg = user_msg;
-        closure->msg_size = nats_msg_size;
-        closure->counter += 1;
+    return 0;
+} // end method ndw_NATS_CheckJSConfiguration
 
-        *msg = user_msg;
-        *msg_length = nats_msg_size;
+// Asynchronous JetStream acks only carry the subject, so with js_async_max_pending a PubKey may be published on by
+// one Topic per connection. Returns the Topic other than topic that already publishes on its PubKey, else NULL.
+static ndw_Topic_T*
+ndw_NATS_JSPubKeyOwner(ndw_NATS_Connection_T* nats_connection, ndw_Topic_T* topic)
+{
+    ndw_NATS_PubKeyTopic_T* entry = NULL;
+    pthread_rwlock_rdlock(&ndw_NATS_JSPubTopicsLock);
+    HASH_FIND_STR(nats_connection->js_pub_topics, topic->pub_key, entry);
+    ndw_Topic_T* owner = ((NULL == entry) || (entry->topic == topic)) ? NULL : entry->topic;
+    pthread_rwlock_unlock(&ndw_NATS_JSPubTopicsLock);
+    return owner;
+} // end method ndw_NATS_JSPubKeyOwner
+
+// Check a Topic staged by a registry reload before it is added to connection. Nothing is changed on failure.
+INT_T
+ndw_NATS_ValidateTopicConfiguration(ndw_Topic_T* topic, ndw_Connection_T* connection)
+{
+    if ((NULL == topic) || (! ndw_is_really_NATS_connection(connection)))
+        return -1;
 
-        *vendor_closure = closure;
-    } // for each message
+    // The staged Topic is not shared yet, so parse its VendorTopicOptions into a scratch vendor record.
+    ndw_NATS_Topic_T scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    scratch.ndw_topic = topic;
+    topic->vendor_opaque = &scratch;
+    ndw_NATS_IsJSPubSub(topic);
+    topic->vendor_opaque = NULL;
+    topic->durable_topic = false;
 
+    ndw_NATS_JS_Attr_T* attr = &(scratch.nats_js_attr);
+    INT_T ret_code = ndw_NATS_CheckJSConfiguration(topic, attr);
+    if (0 != ret_code)
+        return ret_code;
 
-    free(msgList.Msgs); // Important
+    ndw_NATS_Connection_T* nats_connection = (ndw_NATS_Connection_T*) connection->vendor_opaque;
+    if ((NULL != nats_connection) && attr->is_enabled && attr->is_pub_enabled && (! NDW_ISNULLCHARPTR(topic->pub_key)) &&
+        (nats_connection->js_async_max_pending > 0)) {
+        ndw_Topic_T* owner = ndw_NATS_JSPubKeyOwner(nats_connection, topic);
+        if (NULL != owner) {
+            NDW_LOGERR("*** ERROR: PubKey<%s> is already published on by %s; asynchronous JetStream acks "
+                        "could not be attributed to %s\n", topic->pub_key, owner->debug_desc, topic->debug_desc);
+            return -10;
+        }
+    }
 
-    return 1;
-} // end method ndw_NATS_JSPollForMsg
+    return 0;
+} // end method ndw_NATS_ValidateTopicConfiguration
 
 INT_T
 ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
@@ -2316,9 +3176,6 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
         conn->tcp_nodelay = false;
         conn->number_of_callback_threads = 0;
         conn->flush_timeout_ms = NDW_NATS_CONNECTION_FLUSH_TIMEOUT_MS;
-        conn->publication_backoff_bytes = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_BYTES;
-        conn->backoff_sleep_us = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_SLEEP_US;
-        conn->backoff_attempts = NDW_NATS_CONNECTION_PUBLICATION_DEFAULT_BACKOFF_ATTEMPTS;
         conn->iobuf_size = NDW_NATS_CONNECTION_DEFAULT_IO_BUFSIZE_KB;
 
         bool exists = false;
@@ -2339,23 +3196,7 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
             conn->flush_timeout_ms = value;
         NDW_LOGX("Connection Option: flush_timeout_ms <%ld> for %s\n", conn->flush_timeout_ms, connection->debug_desc);
             
-        exists = false;
-        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_BYTES, &exists);
-        if (exists && (value > 0))
-            conn->publication_backoff_bytes = value;
-        NDW_LOGX("Connection Option: # of publication_backoff_bytes <%ld> for %s\n", conn->publication_backoff_bytes, connection->debug_desc);
-
-        exists = false;
-        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_SLEEP_US, &exists);
-        if (exists && (value > 0))
-            conn->backoff_sleep_us = value;
-        NDW_LOGX("Connection Option: # of backoff_sleep_us <%ld> for %s\n", conn->backoff_sleep_us, connection->debug_desc);
-
-        exists = false;
-        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_PUBLICATION_BACKOFF_ATTEMPTS, &exists);
-        if (exists && (value > 0))
-            conn->backoff_attempts = value;
-        NDW_LOGX("Connection Option: Number of backoff_attempts <%ld> for %s\n", conn->backoff_attempts, connection->debug_desc);
+        ndw_NATS_SetPublicationBackoffOptions(connection, conn);
 
         exists = false;
         value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_IO_BUFSIZE_KB, &exists);
@@ -2387,6 +3228,35 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
             conn->connection_no_echo = true;
         NDW_LOGX("Connection Option: connection_no_echo input<%d> for %s\n", value, connection->debug_desc);
 
+        conn->js_async_complete_wait_ms = NDW_NATS_JS_ASYNC_DEFAULT_COMPLETE_WAIT_MS;
+
+        exists = false;
+        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_JS_ASYNC_MAX_PENDING, &exists);
+        if (exists && (value > 0))
+            conn->js_async_max_pending = value;
+        NDW_LOGX("Connection Option: js_async_max_pending <%ld> for %s\n", conn->js_async_max_pending, connection->debug_desc);
+
+        exists = false;
+        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_JS_ASYNC_COMPLETE_WAIT_MS, &exists);
+        if (exists && (value > 0))
+            conn->js_async_complete_wait_ms = value;
+        NDW_LOGX("Connection Option: js_async_complete_wait_ms <%ld> for %s\n", conn->js_async_complete_wait_ms, connection->debug_desc);
+
+        conn->pool_size = 1;
+
+        exists = false;
+        value = ndw_NATS_ParseConnectionOptions(connection, NDW_NATS_CONNECTION_POOL_SIZE, &exists);
+        if (exists && (value > 0))
+            conn->pool_size = (value > NDW_NATS_MAX_CONNECTION_POOL_SIZE) ? NDW_NATS_MAX_CONNECTION_POOL_SIZE : value;
+        NDW_LOGX("Connection Option: pool_size <%d> for %s\n", conn->pool_size, connection->debug_desc);
+
+        conn->pool = calloc(conn->pool_size, sizeof(ndw_NATS_PoolConnection_T));
+        if (NULL == conn->pool) {
+            NDW_LOGERR("*** FATAL ERROR: Memory allocation failed for <%d> pool connections for %s\n",
+                        conn->pool_size, connection->debug_desc);
+            ndw_exit(EXIT_FAILURE);
+        }
+
     } // end if NULL connection Pointer
 
 
@@ -2401,6 +3271,13 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
     nats_topic->nats_connection = nats_connection;
     nats_topic->initiation_time = ndw_GetCurrentUTCNanoseconds();
 
+    // Same PubKey, same socket: messages of a Topic (and of Topics sharing its subject) stay in order.
+    if ((nats_connection->pool_size > 1) && (! NDW_ISNULLCHARPTR(topic->pub_key))) {
+        unsigned pub_key_hash = 0;
+        HASH_FNV(topic->pub_key, strlen(topic->pub_key), pub_key_hash);
+        nats_topic->pool_index = (INT_T) (pub_key_hash % (unsigned) nats_connection->pool_size);
+    }
+
     if (! ndw_is_really_NATS_connection(connection)) {
         NDW_LOGERR("*** FATAL ERROR: Cannot process Connection Configuration for %s\n", topic->debug_desc);
         ndw_exit(EXIT_FAILURE);
@@ -2409,9 +3286,11 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
     ndw_NATS_IsJSPubSub(topic);
 
     ndw_NATS_JS_Attr_T* attr = &(nats_topic->nats_js_attr);
-    if (! attr->is_initialized) {
-        NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T is NOT initialized for %s\n", topic->debug_desc);
-        ndw_exit(EXIT_FAILURE);
+    if (0 != ndw_NATS_CheckJSConfiguration(topic, attr)) {
+        // Rejected: ndw_Init fails on it, a registry reload does not add it.
+        NDW_LOGERR("*** ERROR: Invalid JetStream configuration, rejecting %s\n", topic->debug_desc);
+        __atomic_store_n(&topic->disabled, true, __ATOMIC_RELEASE);
+        return -2;
     }
 
     if (! attr->is_enabled) {
@@ -2421,76 +3300,29 @@ ndw_NATS_ProcessConfiguration(ndw_Topic_T* topic)
         return 0;
     }
 
-    // Durability is expected. JetStream needed.
-    if (attr->is_config_error) {
-        NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T initialized has CONFIG error for %s\n", topic->debug_desc);
-        ndw_exit(EXIT_FAILURE);
-    }
-
-    if (! topic->is_pub_enabled)
-        attr->is_pub_enabled = false;
-
-    if (! topic->is_sub_enabled)
-        attr->is_sub_enabled = false;
-
-    if ((!attr->is_pub_enabled) && (!attr->is_sub_enabled)) {
-        NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T has neither pub NOR sub enabled for %s\n",
-                    topic->debug_desc);
-        ndw_exit(EXIT_FAILURE);
-    }
-
-    if (attr->is_push_mode && attr->is_pull_mode) {
-        NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T BOTH PUSH and PULL mode enabled for %s\n",
-                    topic->debug_desc);
-        ndw_exit(EXIT_FAILURE);
-    }
-
-    // Check sub. Cannot be both PUSH and PULL mode.
-    if (attr->is_sub_enabled) {
-        bool atleast_one_mode = attr->is_push_mode || attr->is_pull_mode;
-        if (! atleast_one_mode) {
-            NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T Neither PUSH NOR PULL mode enabled for %s\n",
-                    topic->debug_desc);
-            ndw_exit(EXIT_FAILURE);
+    if (attr->is_pub_enabled && (! NDW_ISNULLCHARPTR(topic->pub_key)) && (nats_connection->js_async_max_pending > 0)) {
+        // Asynchronous acks only carry the subject, so remember which Topic publishes on it.
+        // Two Topics publishing on one subject could not be told apart, so the second one is rejected.
+        ndw_Topic_T* owner = ndw_NATS_JSPubKeyOwner(nats_connection, topic);
+        if (NULL != owner) {
+            NDW_LOGERR("*** ERROR: PubKey<%s> is already published on by %s; asynchronous JetStream acks "
+                        "could not be attributed to %s, rejecting it\n", topic->pub_key, owner->debug_desc,
+                        topic->debug_desc);
+            __atomic_store_n(&topic->disabled, true, __ATOMIC_RELEASE);
+            return -3;
         }
-    }
-
-    bool no_stream_name = NDW_ISNULLCHARPTR(attr->stream_name);
-    bool no_stream_subject_name = NDW_ISNULLCHARPTR(attr->stream_subject_name);
-    bool no_durable_name = NDW_ISNULLCHARPTR(attr->durable_name);
-    bool no_filter = NDW_ISNULLCHARPTR(attr->filter);
-
-    //  Pub: Needs stream_subject_name.
-    if (attr->is_pub_enabled && no_stream_subject_name) {
-        NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T: Publish need stream_subject_name for %s\n",
-                    topic->debug_desc);
-        ndw_exit(EXIT_FAILURE);
-    }
 
-    // Check Sub attributes for PUSH and PULL.
-    if (attr->is_sub_enabled) {
-        if (attr->is_push_mode) {
-            // Sub: PUSH Mode: Needs stream_name, durable_name and filter.
-            if (no_stream_name || no_durable_name || no_filter) {
-                NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T: PUSH mode needs stream_name and durable_name "
-                            "and filter for %s\n", topic->debug_desc);
-                ndw_exit(EXIT_FAILURE);
-            }
-        }
-        else if (attr->is_pull_mode) {
-            // Sub: PULL Mode: durable_name and filter.
-            if (no_durable_name || no_filter) {
-                NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T: PULL mode needs durable_name and filter for %s\n",
-                                topic->debug_desc);
-                ndw_exit(EXIT_FAILURE);
-            }
-        }
-        else {
-            NDW_LOGERR("*** FATAL ERROR: ndw_NATS_JS_Attr_T Neither PUSH or PULL mode enabled for %s\n", topic->debug_desc);
-            ndw_exit(EXIT_FAILURE);
+        ndw_NATS_PubKeyTopic_T* entry = NULL;
+        pthread_rwlock_wrlock(&ndw_NATS_JSPubTopicsLock);
+        HASH_FIND_STR(nats_connection->js_pub_topics, topic->pub_key, entry);
+        if (NULL == entry) {
+            entry = calloc(1, sizeof(ndw_NATS_PubKeyTopic_T));
+            entry->pub_key = topic->pub_key;
+            entry->topic = topic;
+            HASH_ADD_KEYPTR(hh, nats_connection->js_pub_topics, entry->pub_key, strlen(entry->pub_key), entry);
         }
-
-    } // end if sub is enabled
+        pthread_rwlock_unlock(&ndw_NATS_JSPubTopicsLock);
+    }
 
     nats_topic->durable_topic = true;
     topic->durable_topic = true;
@@ -2551,6 +3383,51 @@ ndw_NATS_CommitQueuedMsg(ndw_Topic_T* topic, void* vendor_closure)
 
 } // end method ndw_NATS_CommitQueuedMsg
 
+INT_T
+ndw_NATS_CommitQueuedMsgBatch(ndw_Topic_T* topic, void** vendor_closures, INT_T count)
+{
+    if ((NULL == vendor_closures) || (count <= 0)) {
+        NDW_LOGERR("*** FATAL ERROR: vendor_closures is NULL or count<%d> is invalid for %s\n", count, topic->debug_desc);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if (ndw_verbose > 3) {
+        NDW_LOGX("Committing <%d> queued messages on topic<%s>\n", count, topic->debug_desc);
+    }
+
+    // JetStream consumers are configured with js_AckExplicit, hence each message still gets its own ack.
+    // What we save is the per message round trip through the abstraction layer and vendor dispatch.
+    INT_T failed = 0;
+    for (INT_T i = 0; i < count; i++)
+    {
+        ndw_NATS_Closure_T* c = (ndw_NATS_Closure_T*) vendor_closures[i];
+        if ((NULL == c) || (NULL == c->nats_msg)) {
+            NDW_LOGERR("*** FATAL ERROR: vendor_closure or its nats_msg Pointer is NULL at index<%d> for %s\n",
+                        i, topic->debug_desc);
+            ndw_exit(EXIT_FAILURE);
+        }
+
+        if (c->is_js) {
+            natsStatus ack_status = natsMsg_Ack(c->nats_msg, NULL);
+            if (NATS_OK != ack_status) {
+                NDW_LOGERR("*** ERROR: natsMsg_Ack(...) failed with status<%d> status_text<%s> for %s\n",
+                              ack_status, natsStatus_GetText(ack_status), topic->debug_desc);
+                failed += 1;
+            }
+        }
+
+        natsMsg_Destroy(c->nats_msg);
+
+        c->nats_topic = NULL;
+        c->nats_connection = NULL;
+        c->nats_msg = NULL;
+        c->msg_size = 0;
+    }
+
+    return -1 * failed;
+
+} // end method ndw_NATS_CommitQueuedMsgBatch
+
 INT_T
 ndw_NATS_CleanupQueuedMsg(ndw_Topic_T* topic, void* vendor_closure)
 {
@@ -2666,22 +3543,41 @@ ndw_NATS_CommitLastMsg(ndw_Topic_T* topic, void* vendor_closure)
         ndw_exit(EXIT_FAILURE);
     }
 
-    if (closure->is_js) {
+    ndw_NATS_JS_Attr_T* js_attr = &(nats_topic->nats_js_attr);
+    if (closure->is_js && js_attr->fetch_ack_all && (js_attr->fetch_next < js_attr->fetch_list.Count)) {
+        // AckAll consumer: the ack of the last message of this fetched batch covers this one.
+        // It is kept, and acked if the rest of the batch is dropped or never committed.
+        if (NULL != js_attr->fetch_ack_pending)
+            natsMsg_Destroy(js_attr->fetch_ack_pending);
+        js_attr->fetch_ack_pending = nats_msg;
+        js_attr->fetch_acks_coalesced += 1;
+
+        ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_COMMITS, 1);
+        NDW_CLEAR_CLOSURE(topic);
+        return 0;
+    }
+    else if (closure->is_js) {
+        if (NULL != js_attr->fetch_ack_pending) {
+            // Covered by the AckAll ack below.
+            natsMsg_Destroy(js_attr->fetch_ack_pending);
+            js_attr->fetch_ack_pending = NULL;
+        }
+
         natsStatus ack_status = natsMsg_Ack(nats_msg, NULL);
         if (NATS_OK != ack_status) {
-            topic->msgs_failed_ack_count += 1;
+            ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_FAILED_ACKS, 1);
             NDW_LOGERR("*** ERROR: natsMsg_Ack(...) failed with status<%d> status_text<%s> for %s\n",
                           ack_status, natsStatus_GetText(ack_status), topic->debug_desc);
         }
         else {
-            topic->msgs_ack_count += 1;
+            ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_ACKS, 1);
             if (ndw_verbose > 4) {
                 NDW_LOGX("natsMsg_Ack(...) OKAY!\n");
             }
         }
     }
 
-    topic->msgs_commit_count += 1;
+    ndw_TopicStatsAdd(topic->stats_index, NDW_TOPIC_STAT_MSGS_COMMITS, 1);
 
     natsMsg_Destroy(nats_msg);
 
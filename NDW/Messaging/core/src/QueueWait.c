@@ -0,0 +1,126 @@
+
+#include "QueueWait.h"
+
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+static inline void
+ndw_QWaitCpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    atomic_signal_fence(memory_order_seq_cst);
+#endif
+}
+
+static inline ULONG_T
+ndw_QWaitNowNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ULONG_T) ts.tv_sec * 1000000000UL + (ULONG_T) ts.tv_nsec;
+}
+
+void
+ndw_QWaitInit(ndw_QWait_T* w)
+{
+    atomic_init(&w->futex_word, 0);
+    atomic_init(&w->consumer_parked, 0);
+    w->spins = NDW_QWAIT_DEFAULT_SPINS;
+    w->yields = NDW_QWAIT_DEFAULT_YIELDS;
+    w->block = true;
+    w->total_wakeups = 0;
+    w->total_parks = 0;
+} // end method ndw_QWaitInit
+
+void
+ndw_QWaitSetStrategy(ndw_QWait_T* w, INT_T spins, INT_T yields, bool block)
+{
+    if (spins >= 0)
+        w->spins = spins;
+    if (yields >= 0)
+        w->yields = yields;
+    w->block = block;
+} // end method ndw_QWaitSetStrategy
+
+void
+ndw_QWaitSignal(ndw_QWait_T* w)
+{
+    // Pairs with the seq_cst store of consumer_parked in ndw_QWaitForItems: either we see the
+    // consumer parked, or the consumer sees our item before it goes to sleep.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (0 == atomic_load_explicit(&w->consumer_parked, memory_order_relaxed))
+        return;
+
+    atomic_fetch_add_explicit(&w->futex_word, 1, memory_order_release);
+    __atomic_fetch_add(&w->total_wakeups, 1, __ATOMIC_RELAXED);
+    syscall(SYS_futex, (int*) &w->futex_word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+} // end method ndw_QWaitSignal
+
+bool
+ndw_QWaitForItems(ndw_QWait_T* w, LONG_T timeout_us, ndw_QWaitReady_T ready, void* q)
+{
+    if (ready(q))
+        return true;
+
+    if (timeout_us <= 0)
+        return false;
+
+    for (INT_T i = 0; i < w->spins; i++) {
+        ndw_QWaitCpuRelax();
+        if (ready(q))
+            return true;
+    }
+
+    ULONG_T deadline = ndw_QWaitNowNanos() + ((ULONG_T) timeout_us * 1000UL);
+
+    for (INT_T i = 0; i < w->yields; i++) {
+        sched_yield();
+        if (ready(q))
+            return true;
+        if (ndw_QWaitNowNanos() >= deadline)
+            return false;
+    }
+
+    for (;;)
+    {
+        ULONG_T now = ndw_QWaitNowNanos();
+        if (now >= deadline)
+            return ready(q);
+
+        if (! w->block) {
+            sched_yield();
+            if (ready(q))
+                return true;
+            continue;
+        }
+
+        INT_T seq = atomic_load_explicit(&w->futex_word, memory_order_acquire);
+        atomic_store_explicit(&w->consumer_parked, 1, memory_order_seq_cst);
+
+        if (ready(q)) {
+            atomic_store_explicit(&w->consumer_parked, 0, memory_order_relaxed);
+            return true;
+        }
+
+        ULONG_T remaining = deadline - now;
+        struct timespec ts = {
+            .tv_sec = remaining / 1000000000UL,
+            .tv_nsec = remaining % 1000000000UL
+        };
+
+        w->total_parks += 1;
+        syscall(SYS_futex, (int*) &w->futex_word, FUTEX_WAIT_PRIVATE, seq, &ts, NULL, 0);
+        atomic_store_explicit(&w->consumer_parked, 0, memory_order_relaxed);
+
+        if (ready(q))
+            return true;
+    }
+} // end method ndw_QWaitForItems
@@ -1,6 +1,8 @@
 
 #include "QueueImpl.h"
 
+#include <stdatomic.h>
+
 #define NDW_Q_BATCH_ID 1
 #define NDW_Q_SWEEP_ID 2
 
@@ -18,9 +20,14 @@ typedef struct NDW_QImpl
     INT_T   (*insert)(NDW_QImpl_T* impl, void* data);
     INT_T   (*get)(NDW_QImpl_T* impl, NDW_QData_T* data, LONG_T timeout_ms);
     void    (*delete_current)(NDW_QImpl_T* impl);
+    INT_T   (*get_batch)(NDW_QImpl_T* impl, NDW_QData_T* data, INT_T max_items, LONG_T timeout_us);
+    void    (*delete_batch)(NDW_QImpl_T* impl);
+    INT_T   (*evict_oldest)(NDW_QImpl_T* impl);
     void    (*set_cleanup_operator)(NDW_QImpl_T* impl, ndw_QueueCleanupOperator); 
+    void    (*set_wait_strategy)(NDW_QImpl_T* impl, INT_T spins, INT_T yields, bool block);
     void    (*cleanup)(NDW_QImpl_T* impl);
     void    (*print_debug)(NDW_QImpl_T* impl);
+    LONG_T  (*size)(NDW_QImpl_T* impl);
 
 } NDW_QImpl_T;
 
@@ -37,6 +44,27 @@ typedef struct ndw_QNode
 
 } ndw_QNode_T;
 
+// Invoke cleanup operator on and free a chain of consumed nodes.
+static void ndw_q_free_node_chain(ndw_QNode_T* node, ndw_QueueCleanupOperator cleanup_operator)
+{
+    while (node) {
+        ndw_QNode_T* next = node->next;
+        if ((NULL != node->data) && (NULL != cleanup_operator))
+            cleanup_operator(node->data);
+        free(node);
+        node = next;
+    }
+}
+
+static inline void ndw_q_fill_data(NDW_QData_T* data, ndw_QNode_T* node, LONG_T pending, LONG_T total_consumed)
+{
+    data->data = node->data;
+    data->consumption_sequence_number = node->sequence_number;
+    data->consumption_insertion_time = node->insert_time;
+    data->consumer_pending_items = pending;
+    data->total_consumed_items = total_consumed;
+}
+
 /*
  * BEGIN: NDW_QBatch Implementation.
  */
@@ -58,9 +86,13 @@ typedef struct NDW_QBatch
     LONG_T q_consumer_items;
     LONG_T q_consumer_total_consumed;
     ndw_QNode_T* consumer_last_node_consumed;
+    ndw_QNode_T* consumer_batch_consumed;   // Chain of nodes handed out by the last get_batch.
+    LONG_T consumer_batch_items;
 
     ndw_QueueCleanupOperator cleanup_operator;
 
+    ndw_QWait_T q_wait;
+
 } NDW_QBatch_T;
 
 NDW_QBatch_T* ndw_qBatch_GetImpl(NDW_QImpl_T* impl)
@@ -103,6 +135,8 @@ NDW_QBatch_T* ndw_CreateQBatchQueue(LONG_T max_items)
         return NULL;
     }
 
+    ndw_QWaitInit(&q->q_wait);
+
     // All other fields are zeroed out by calloc
     return q;
 }
@@ -129,7 +163,7 @@ INT_T ndw_qBatch_insert(NDW_QImpl_T* impl, void* data)
     }
 
     node->sequence_number = ++q->q_producer_sequence_number;
-    node->insert_time = ndw_GetCurrentNanoSeconds();
+    node->insert_time = ndw_ClockNowNanos();
 
     if (q->q_producer_tail) {
         q->q_producer_tail->next = node;
@@ -138,15 +172,24 @@ INT_T ndw_qBatch_insert(NDW_QImpl_T* impl, void* data)
     }
 
     q->q_producer_tail = node;
-    q->q_producer_items++;
+    __atomic_store_n(&q->q_producer_items, q->q_producer_items + 1, __ATOMIC_RELEASE);
 
     pthread_mutex_unlock(&q->producer_lock);
 
+    ndw_QWaitSignal(&q->q_wait);
+
     return 0;
 }
 
 // Hybrid implementation of transfer logic for qBatch queue
 
+// Consumer side check, without the producer lock, for pending producer items.
+static bool ndw_qBatch_ready(void* queue)
+{
+    NDW_QBatch_T* q = (NDW_QBatch_T*) queue;
+    return (__atomic_load_n(&q->q_producer_items, __ATOMIC_ACQUIRE) > 0);
+}
+
 static inline void ndw_qBatch_transfer_producer_locked(NDW_QBatch_T* q)
 {
     if (q->q_producer_head) {
@@ -156,7 +199,7 @@ static inline void ndw_qBatch_transfer_producer_locked(NDW_QBatch_T* q)
 
         q->q_producer_head = NULL;
         q->q_producer_tail = NULL;
-        q->q_producer_items = 0;
+        __atomic_store_n(&q->q_producer_items, 0, __ATOMIC_RELAXED);
     }
 }
 
@@ -183,15 +226,10 @@ INT_T ndw_qBatch_get(NDW_QImpl_T* impl, NDW_QData_T* data, LONG_T timeout_us)
     ndw_qBatch_transfer_producer(q);  // First attempt
 
     if (!q->q_consumer_head) {
-        if (timeout_us > 0) {
-            struct timespec delay = {
-                .tv_sec = timeout_us / 1000000,
-                .tv_nsec = (timeout_us % 1000000) * 1000
-            };
-            nanosleep(&delay, NULL);
-        }
+        if (!ndw_QWaitForItems(&q->q_wait, timeout_us, ndw_qBatch_ready, q))
+            return 0;
 
-        ndw_qBatch_transfer_producer(q);  // Retry after sleep
+        ndw_qBatch_transfer_producer(q);  // Retry after wait
 
         if (!q->q_consumer_head)
             return 0;
@@ -219,6 +257,81 @@ out:
 }
 
 
+INT_T ndw_qBatch_get_batch(NDW_QImpl_T* impl, NDW_QData_T* data, INT_T max_items, LONG_T timeout_us)
+{
+    NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
+    if ((NULL == data) || (max_items <= 0))
+        return -1;
+
+    if (NULL != q->consumer_batch_consumed) {
+        NDW_LOGERR("*** ERROR: QBatch<%s> previous batch of <%ld> items has NOT been deleted!\n",
+                    q->q_name, q->consumer_batch_items);
+        return -2;
+    }
+
+    if (timeout_us < 0)
+        timeout_us = 1;
+
+    if (!q->q_consumer_head) {
+        ndw_qBatch_transfer_producer(q);  // First attempt
+
+        if (!q->q_consumer_head) {
+            if (!ndw_QWaitForItems(&q->q_wait, timeout_us, ndw_qBatch_ready, q))
+                return 0;
+
+            ndw_qBatch_transfer_producer(q);  // Retry after wait
+
+            if (!q->q_consumer_head)
+                return 0;
+        }
+    }
+
+    ndw_QNode_T* batch_head = NULL;
+    ndw_QNode_T* batch_tail = NULL;
+    INT_T count = 0;
+    bool transferred = false;
+
+    while (count < max_items) {
+        ndw_QNode_T* node = q->q_consumer_head;
+        if (NULL == node) {
+            if (transferred)
+                break;
+            ndw_qBatch_transfer_producer(q);  // Top up the batch once from producers without waiting.
+            transferred = true;
+            continue;
+        }
+
+        q->q_consumer_head = node->next;
+        q->q_consumer_items--;
+        q->q_consumer_total_consumed++;
+        node->next = NULL;
+        if (batch_tail)
+            batch_tail->next = node;
+        else
+            batch_head = node;
+        batch_tail = node;
+
+        ndw_q_fill_data(&data[count], node, q->q_consumer_items, q->q_consumer_total_consumed);
+        count++;
+    }
+
+    if (!q->q_consumer_head)
+        q->q_consumer_tail = NULL;
+
+    q->consumer_batch_consumed = batch_head;
+    q->consumer_batch_items = count;
+
+    return count;
+}
+
+void ndw_qBatch_delete_batch(NDW_QImpl_T* impl)
+{
+    NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
+    ndw_q_free_node_chain(q->consumer_batch_consumed, q->cleanup_operator);
+    q->consumer_batch_consumed = NULL;
+    q->consumer_batch_items = 0;
+}
+
 void ndw_qBatch_delete_current(NDW_QImpl_T* impl)
 {
     NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
@@ -239,12 +352,40 @@ void ndw_qBatch_delete_current(NDW_QImpl_T* impl)
     q->consumer_last_node_consumed = NULL;
 }
 
+INT_T ndw_qBatch_evict_oldest(NDW_QImpl_T* impl)
+{
+    NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
+
+    pthread_mutex_lock(&q->producer_lock);
+    ndw_QNode_T* node = q->q_producer_head;
+    if (NULL != node) {
+        q->q_producer_head = node->next;
+        if (NULL == q->q_producer_head)
+            q->q_producer_tail = NULL;
+        __atomic_store_n(&q->q_producer_items, q->q_producer_items - 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&q->producer_lock);
+
+    if (NULL == node)
+        return 0; // Everything pending is already owned by the consumer.
+
+    node->next = NULL;
+    ndw_q_free_node_chain(node, q->cleanup_operator);
+    return 1;
+}
+
 void ndw_qBatch_set_cleanup_operator(NDW_QImpl_T* impl, ndw_QueueCleanupOperator cleanup_operator)
 {
     NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
     q->cleanup_operator = cleanup_operator;
 }
 
+void ndw_qBatch_set_wait_strategy(NDW_QImpl_T* impl, INT_T spins, INT_T yields, bool block)
+{
+    NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
+    ndw_QWaitSetStrategy(&q->q_wait, spins, yields, block);
+}
+
 void ndw_qBatch_cleanup(NDW_QImpl_T* impl)
 {
     NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
@@ -281,18 +422,29 @@ void ndw_qBatch_cleanup(NDW_QImpl_T* impl)
         q->consumer_last_node_consumed = NULL;
     }
 
+    ndw_q_free_node_chain(q->consumer_batch_consumed, q->cleanup_operator);
+    q->consumer_batch_consumed = NULL;
+
     pthread_mutex_destroy(&q->producer_lock);
     free(q);
 }
 
+// Approximate when called from a thread other than the consumer.
+LONG_T ndw_qBatch_size(NDW_QImpl_T* impl)
+{
+    NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
+    return __atomic_load_n(&q->q_producer_items, __ATOMIC_ACQUIRE) +
+            __atomic_load_n(&q->q_consumer_items, __ATOMIC_RELAXED);
+}
+
 void ndw_qBatch_print_debug(NDW_QImpl_T* impl)
 {
     NDW_QBatch_T* q = ndw_qBatch_GetImpl(impl);
     pthread_mutex_lock(&q->producer_lock);
     NDW_LOG("QBatch<%d, %s>: max_queue_items<%ld> producer_items<%ld> producer_sequence_number<%ld> "
-            "consumer_items<%ld> consumer_total_consumed<%ld>\n",
+            "consumer_items<%ld> consumer_total_consumed<%ld> consumer_parks<%ld> producer_wakeups<%ld>\n",
             q->q_id, q->q_name, q->max_queue_items, q->q_producer_items, q->q_producer_sequence_number,
-            q->q_consumer_items, q->q_consumer_total_consumed);
+            q->q_consumer_items, q->q_consumer_total_consumed, q->q_wait.total_parks, q->q_wait.total_wakeups);
     pthread_mutex_unlock(&q->producer_lock);
 }
 
@@ -305,6 +457,352 @@ void ndw_qBatch_print_debug(NDW_QImpl_T* impl)
  * BEGIN: ndw_QSweep Implementation.
  */
 
+/*
+ * Producers push nodes onto a lock-free LIFO list with a CAS on q_producer_head.
+ * The consumer detaches everything pending with a single atomic exchange (no mutex),
+ * reverses the detached chain into FIFO order and then walks it locally.
+ */
+typedef struct NDW_QSweep
+{
+    const char* q_name;
+    INT_T q_id;
+    LONG_T max_queue_items;
+
+    ndw_QNode_T* _Atomic q_producer_head;  // LIFO stack of pending producer nodes.
+    atomic_long q_producer_items;           // Items inserted but not yet consumed (includes consumer batch).
+    atomic_long q_producer_sequence_number;
+
+    ndw_QNode_T* q_consumer_head;           // Detached FIFO batch owned by the consumer.
+    LONG_T q_consumer_items;
+    LONG_T q_consumer_total_consumed;
+    ndw_QNode_T* consumer_last_node_consumed;
+    ndw_QNode_T* consumer_batch_consumed;   // Chain of nodes handed out by the last get_batch.
+    LONG_T consumer_batch_items;
+
+    ndw_QueueCleanupOperator cleanup_operator;
+
+    ndw_QWait_T q_wait;
+
+} NDW_QSweep_T;
+
+NDW_QSweep_T* ndw_qSweep_GetImpl(NDW_QImpl_T* impl)
+{
+    if (NULL ==  impl) {
+        NDW_LOGERR("NULL implementation Pointer!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    NDW_QSweep_T* q = (NDW_QSweep_T*) impl->q;
+    if (NULL == q) {
+        NDW_LOGERR("NULL implementation Pointer insdie NDW_QImpl_T*!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (NDW_Q_SWEEP_ID != impl->q_id) {
+        NDW_LOGERR("QSweep does not match Implementation Pointer. Q_ID<%d> Expected %d\n",
+            impl->q_id, NDW_Q_SWEEP_ID);
+        exit(EXIT_FAILURE);
+    }
+
+    return q;
+}
+
+// Implementation: ndw_CreateQSweepQueue
+NDW_QSweep_T* ndw_CreateQSweepQueue(LONG_T max_items)
+{
+    NDW_QSweep_T* q = (NDW_QSweep_T*) calloc(1, sizeof(NDW_QSweep_T));
+    if (!q) {
+        fprintf(stderr, "Failed to allocate QSweep queue.\n");
+        return NULL;
+    }
+
+    q->max_queue_items = max_items;
+    atomic_init(&q->q_producer_head, NULL);
+    atomic_init(&q->q_producer_items, 0);
+    atomic_init(&q->q_producer_sequence_number, 0);
+    ndw_QWaitInit(&q->q_wait);
+
+    // All other fields are zeroed out by calloc
+    return q;
+}
+
+INT_T ndw_qSweep_insert(NDW_QImpl_T* impl, void* data)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    if (q == NULL || data == NULL)
+        return -1;
+
+    if (q->max_queue_items > 0) {
+        LONG_T items = atomic_fetch_add_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+        if (items >= q->max_queue_items) {
+            atomic_fetch_sub_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+            return -1; // Queue full
+        }
+    }
+    else {
+        atomic_fetch_add_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+    }
+
+    ndw_QNode_T* node = (ndw_QNode_T*) malloc(sizeof(ndw_QNode_T));
+    if (!node) {
+        atomic_fetch_sub_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    node->data = data;
+    node->pData = NULL;
+    node->sequence_number = atomic_fetch_add_explicit(&q->q_producer_sequence_number, 1, memory_order_relaxed) + 1;
+    node->insert_time = ndw_ClockNowNanos();
+
+    ndw_QNode_T* head = atomic_load_explicit(&q->q_producer_head, memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (! atomic_compare_exchange_weak_explicit(&q->q_producer_head, &head, node,
+                                                    memory_order_release, memory_order_relaxed));
+
+    ndw_QWaitSignal(&q->q_wait);
+
+    return 0;
+}
+
+static bool ndw_qSweep_ready(void* queue)
+{
+    NDW_QSweep_T* q = (NDW_QSweep_T*) queue;
+    return (NULL != atomic_load_explicit(&q->q_producer_head, memory_order_acquire));
+}
+
+// Detach all pending producer nodes in one exchange and reverse them into insertion order.
+static inline void ndw_qSweep_transfer_producer(NDW_QSweep_T* q)
+{
+    ndw_QNode_T* node = atomic_exchange_explicit(&q->q_producer_head, NULL, memory_order_acquire);
+    if (NULL == node)
+        return;
+
+    ndw_QNode_T* fifo = NULL;
+    LONG_T count = 0;
+    while (node) {
+        ndw_QNode_T* next = node->next;
+        node->next = fifo;
+        fifo = node;
+        node = next;
+        count++;
+    }
+
+    q->q_consumer_head = fifo;
+    q->q_consumer_items = count;
+}
+
+INT_T ndw_qSweep_get(NDW_QImpl_T* impl, NDW_QData_T* data, LONG_T timeout_us)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    memset(data, 0, sizeof(NDW_QData_T));
+
+    if (timeout_us < 0)
+        timeout_us = 1;
+
+    ndw_QNode_T* node = NULL;
+
+    if (q->q_consumer_head)
+        goto out;
+
+    ndw_qSweep_transfer_producer(q);  // First attempt
+
+    if (!q->q_consumer_head) {
+        if (!ndw_QWaitForItems(&q->q_wait, timeout_us, ndw_qSweep_ready, q))
+            return 0;
+
+        ndw_qSweep_transfer_producer(q);  // Retry after wait
+
+        if (!q->q_consumer_head)
+            return 0;
+    }
+
+out:
+    node = q->q_consumer_head;
+    q->q_consumer_head = node->next;
+
+    q->q_consumer_items--;
+    q->q_consumer_total_consumed++;
+    q->consumer_last_node_consumed = node;
+    atomic_fetch_sub_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+
+    node->next = NULL;
+
+    data->data = node->data;
+    data->consumption_sequence_number = node->sequence_number;
+    data->consumption_insertion_time = node->insert_time;
+    data->consumer_pending_items = q->q_consumer_items;
+    data->total_consumed_items = q->q_consumer_total_consumed;
+
+    return 1;
+}
+
+INT_T ndw_qSweep_get_batch(NDW_QImpl_T* impl, NDW_QData_T* data, INT_T max_items, LONG_T timeout_us)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    if ((NULL == data) || (max_items <= 0))
+        return -1;
+
+    if (NULL != q->consumer_batch_consumed) {
+        NDW_LOGERR("*** ERROR: QSweep<%s> previous batch of <%ld> items has NOT been deleted!\n",
+                    q->q_name, q->consumer_batch_items);
+        return -2;
+    }
+
+    if (timeout_us < 0)
+        timeout_us = 1;
+
+    if (!q->q_consumer_head) {
+        ndw_qSweep_transfer_producer(q);  // First attempt
+
+        if (!q->q_consumer_head) {
+            if (!ndw_QWaitForItems(&q->q_wait, timeout_us, ndw_qSweep_ready, q))
+                return 0;
+
+            ndw_qSweep_transfer_producer(q);  // Retry after wait
+
+            if (!q->q_consumer_head)
+                return 0;
+        }
+    }
+
+    ndw_QNode_T* batch_head = NULL;
+    ndw_QNode_T* batch_tail = NULL;
+    INT_T count = 0;
+    bool transferred = false;
+
+    while (count < max_items) {
+        ndw_QNode_T* node = q->q_consumer_head;
+        if (NULL == node) {
+            if (transferred)
+                break;
+            ndw_qSweep_transfer_producer(q);  // Top up the batch once from producers without waiting.
+            transferred = true;
+            continue;
+        }
+
+        q->q_consumer_head = node->next;
+        q->q_consumer_items--;
+        q->q_consumer_total_consumed++;
+        atomic_fetch_sub_explicit(&q->q_producer_items, 1, memory_order_relaxed);
+        node->next = NULL;
+        if (batch_tail)
+            batch_tail->next = node;
+        else
+            batch_head = node;
+        batch_tail = node;
+
+        ndw_q_fill_data(&data[count], node, q->q_consumer_items, q->q_consumer_total_consumed);
+        count++;
+    }
+    q->consumer_batch_consumed = batch_head;
+    q->consumer_batch_items = count;
+
+    return count;
+}
+
+void ndw_qSweep_delete_batch(NDW_QImpl_T* impl)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    ndw_q_free_node_chain(q->consumer_batch_consumed, q->cleanup_operator);
+    q->consumer_batch_consumed = NULL;
+    q->consumer_batch_items = 0;
+}
+
+void ndw_qSweep_delete_current(NDW_QImpl_T* impl)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    ndw_QNode_T* node = q->consumer_last_node_consumed;
+    if (NULL == node) {
+        fprintf(stderr, "*** FATAL ERROR: Attempted to delete NULL node. "
+                "There is no q->consumer_last_node_consumed!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    if ((NULL != node->data) && (NULL != q->cleanup_operator)) {
+        q->cleanup_operator(node->data);
+    }
+
+    memset(node, 0, sizeof(ndw_QNode_T));
+    free(node);
+    q->consumer_last_node_consumed = NULL;
+}
+
+INT_T ndw_qSweep_evict_oldest(NDW_QImpl_T* impl)
+{
+    (void) ndw_qSweep_GetImpl(impl);
+    return 0; // Oldest node is at the bottom of the lock-free producer stack, so it cannot be evicted.
+}
+
+void ndw_qSweep_set_cleanup_operator(NDW_QImpl_T* impl, ndw_QueueCleanupOperator cleanup_operator)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    q->cleanup_operator = cleanup_operator;
+}
+
+void ndw_qSweep_set_wait_strategy(NDW_QImpl_T* impl, INT_T spins, INT_T yields, bool block)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    ndw_QWaitSetStrategy(&q->q_wait, spins, yields, block);
+}
+
+void ndw_qSweep_cleanup(NDW_QImpl_T* impl)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    if (!q)
+        return;
+
+    // Clean up any remaining producer nodes
+    ndw_QNode_T* node = atomic_exchange(&q->q_producer_head, NULL);
+    while (node) {
+        ndw_QNode_T* next = node->next;
+        if (NULL != q->cleanup_operator)
+            q->cleanup_operator(node->data);
+        free(node);
+        node = next;
+    }
+
+    // Clean up any remaining consumer nodes
+    node = q->q_consumer_head;
+    while (node) {
+        ndw_QNode_T* next = node->next;
+        if (NULL != q->cleanup_operator)
+            q->cleanup_operator(node->data);
+        free(node);
+        node = next;
+    }
+
+    // Also free last node if consumer forgot to
+    if (q->consumer_last_node_consumed) {
+        if (NULL != q->cleanup_operator)
+            q->cleanup_operator(q->consumer_last_node_consumed->data);
+        free(q->consumer_last_node_consumed);
+        q->consumer_last_node_consumed = NULL;
+    }
+
+    ndw_q_free_node_chain(q->consumer_batch_consumed, q->cleanup_operator);
+    q->consumer_batch_consumed = NULL;
+
+    free(q);
+}
+
+LONG_T ndw_qSweep_size(NDW_QImpl_T* impl)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    return (LONG_T) atomic_load_explicit(&q->q_producer_items, memory_order_relaxed);
+}
+
+void ndw_qSweep_print_debug(NDW_QImpl_T* impl)
+{
+    NDW_QSweep_T* q = ndw_qSweep_GetImpl(impl);
+    NDW_LOG("QSweep<%d, %s>: max_queue_items<%ld> pending_items<%ld> producer_sequence_number<%ld> "
+            "consumer_items<%ld> consumer_total_consumed<%ld> consumer_parks<%ld> producer_wakeups<%ld>\n",
+            q->q_id, q->q_name, q->max_queue_items, (LONG_T) atomic_load(&q->q_producer_items),
+            (LONG_T) atomic_load(&q->q_producer_sequence_number),
+            q->q_consumer_items, q->q_consumer_total_consumed, q->q_wait.total_parks, q->q_wait.total_wakeups);
+}
+
+
 /*
  * END: ndw_QSweep Implementation.
  */
@@ -313,6 +811,32 @@ void ndw_qBatch_print_debug(NDW_QImpl_T* impl)
  * BEGIN: Queue Implementation Factory.
  */
 
+INT_T ndw_QOverflowPolicyFromName(const char* name)
+{
+    if (NDW_ISNULLCHARPTR(name))
+        return -1;
+    if (0 == strcasecmp(NDW_QOVERFLOW_DROP_NEWEST_NAME, name))
+        return NDW_QOVERFLOW_DROP_NEWEST;
+    if (0 == strcasecmp(NDW_QOVERFLOW_DROP_OLDEST_NAME, name))
+        return NDW_QOVERFLOW_DROP_OLDEST;
+    if (0 == strcasecmp(NDW_QOVERFLOW_BLOCK_NAME, name))
+        return NDW_QOVERFLOW_BLOCK;
+    if (0 == strcasecmp(NDW_QOVERFLOW_SPILL_NAME, name))
+        return NDW_QOVERFLOW_SPILL;
+    return -1;
+}
+
+const char* ndw_QOverflowPolicyName(INT_T policy)
+{
+    switch (policy) {
+        case NDW_QOVERFLOW_DROP_NEWEST: return NDW_QOVERFLOW_DROP_NEWEST_NAME;
+        case NDW_QOVERFLOW_DROP_OLDEST: return NDW_QOVERFLOW_DROP_OLDEST_NAME;
+        case NDW_QOVERFLOW_BLOCK: return NDW_QOVERFLOW_BLOCK_NAME;
+        case NDW_QOVERFLOW_SPILL: return NDW_QOVERFLOW_SPILL_NAME;
+        default: return "?";
+    }
+}
+
 NDW_QData_T* ndw_CreateQData()
 {
     NDW_QData_T* data = calloc(1, sizeof(NDW_QData_T));
@@ -349,9 +873,35 @@ ndw_CreateInboundDataQueue(const char* queue_type, LONG_T max_items)
         impl->insert = ndw_qBatch_insert;
         impl->get = ndw_qBatch_get;
         impl->delete_current = ndw_qBatch_delete_current;
+        impl->get_batch = ndw_qBatch_get_batch;
+        impl->delete_batch = ndw_qBatch_delete_batch;
+        impl->evict_oldest = ndw_qBatch_evict_oldest;
         impl->set_cleanup_operator = ndw_qBatch_set_cleanup_operator;
+        impl->set_wait_strategy = ndw_qBatch_set_wait_strategy;
         impl->cleanup = ndw_qBatch_cleanup;
         impl->print_debug = ndw_qBatch_print_debug;
+        impl->size = ndw_qBatch_size;
+    }
+    else if (0 == strcasecmp(NDW_Q_SWEEP_NAME, queue_type))
+    {
+        NDW_QSweep_T* q = ndw_CreateQSweepQueue(max_items);
+        impl->q = q;
+        impl->q_name = queue_type;
+        impl->q_id = NDW_Q_SWEEP_ID;
+        q->q_id = NDW_Q_SWEEP_ID;
+        q->q_name = NDW_Q_SWEEP_NAME;
+
+        impl->insert = ndw_qSweep_insert;
+        impl->get = ndw_qSweep_get;
+        impl->delete_current = ndw_qSweep_delete_current;
+        impl->get_batch = ndw_qSweep_get_batch;
+        impl->delete_batch = ndw_qSweep_delete_batch;
+        impl->evict_oldest = ndw_qSweep_evict_oldest;
+        impl->set_cleanup_operator = ndw_qSweep_set_cleanup_operator;
+        impl->set_wait_strategy = ndw_qSweep_set_wait_strategy;
+        impl->cleanup = ndw_qSweep_cleanup;
+        impl->print_debug = ndw_qSweep_print_debug;
+        impl->size = ndw_qSweep_size;
     }
     else
     {
@@ -397,6 +947,27 @@ ndw_QDeleteCurrent(NDW_Q_T* Q)
     impl->delete_current(impl);
 }
 
+INT_T
+ndw_QGetBatch(NDW_Q_T* Q, NDW_QData_T* data, INT_T max_items, LONG_T timeout_us)
+{
+    NDW_QImpl_T* impl = (NDW_QImpl_T*) Q->impl;
+    return impl->get_batch(impl, data, max_items, timeout_us);
+}
+
+void
+ndw_QDeleteBatch(NDW_Q_T* Q)
+{
+    NDW_QImpl_T* impl = (NDW_QImpl_T*) Q->impl;
+    impl->delete_batch(impl);
+}
+
+INT_T
+ndw_QEvictOldest(NDW_Q_T* Q)
+{
+    NDW_QImpl_T* impl = (NDW_QImpl_T*) Q->impl;
+    return impl->evict_oldest(impl);
+}
+
 void
 ndw_QSetCleanupOperator(NDW_Q_T* Q, ndw_QueueCleanupOperator cleanup_operator)
 {
@@ -404,6 +975,13 @@ ndw_QSetCleanupOperator(NDW_Q_T* Q, ndw_QueueCleanupOperator cleanup_operator)
     impl->set_cleanup_operator(impl, cleanup_operator);
 }
 
+void
+ndw_QSetWaitStrategy(NDW_Q_T* Q, INT_T spins, INT_T yields, bool block)
+{
+    NDW_QImpl_T* impl = (NDW_QImpl_T*) Q->impl;
+    impl->set_wait_strategy(impl, spins, yields, block);
+}
+
 void
 ndw_QCleanup(NDW_Q_T* Q)
 {
@@ -419,8 +997,122 @@ ndw_QPrintDebug(NDW_Q_T* Q)
     impl->print_debug(impl);
 }
 
+LONG_T
+ndw_QSize(NDW_Q_T* Q)
+{
+    if ((NULL == Q) || (NULL == Q->impl))
+        return 0;
+
+    NDW_QImpl_T* impl = (NDW_QImpl_T*) Q->impl;
+    return impl->size(impl);
+}
+
 
 /*
  * END: Queue Implementation Factory.
  */
 
+/*
+ * BEGIN: NDW_QSpill Implementation.
+ */
+
+typedef struct NDW_QSpill
+{
+    LONG_T max_items;
+    pthread_mutex_t lock;
+    ndw_QNode_T* head;
+    ndw_QNode_T* tail;
+    atomic_long items;
+} NDW_QSpill_T;
+
+NDW_QSpill_T* ndw_CreateQSpill(LONG_T max_items)
+{
+    NDW_QSpill_T* spill = (NDW_QSpill_T*) calloc(1, sizeof(NDW_QSpill_T));
+    if (!spill) {
+        fprintf(stderr, "Failed to allocate QSpill.\n");
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&spill->lock, NULL) != 0) {
+        fprintf(stderr, "Failed to initialize QSpill mutex.\n");
+        free(spill);
+        return NULL;
+    }
+
+    spill->max_items = max_items;
+    atomic_init(&spill->items, 0);
+    return spill;
+}
+
+INT_T ndw_QSpillAppend(NDW_QSpill_T* spill, void* data)
+{
+    ndw_QNode_T* node = (ndw_QNode_T*) calloc(1, sizeof(ndw_QNode_T));
+    if (!node)
+        return -1;
+
+    node->data = data;
+
+    pthread_mutex_lock(&spill->lock);
+    if ((spill->max_items > 0) && (atomic_load_explicit(&spill->items, memory_order_relaxed) >= spill->max_items)) {
+        pthread_mutex_unlock(&spill->lock);
+        free(node);
+        return -1; // Spill full
+    }
+
+    if (spill->tail)
+        spill->tail->next = node;
+    else
+        spill->head = node;
+    spill->tail = node;
+    atomic_fetch_add_explicit(&spill->items, 1, memory_order_release);
+    pthread_mutex_unlock(&spill->lock);
+
+    return 0;
+}
+
+INT_T ndw_QSpillDrainInto(NDW_QSpill_T* spill, NDW_Q_T* Q)
+{
+    INT_T moved = 0;
+
+    pthread_mutex_lock(&spill->lock);
+    while (spill->head) {
+        if (0 != ndw_QInsert(Q, spill->head->data))
+            break; // Queue is full again.
+
+        ndw_QNode_T* node = spill->head;
+        spill->head = node->next;
+        if (!spill->head)
+            spill->tail = NULL;
+        free(node);
+        atomic_fetch_sub_explicit(&spill->items, 1, memory_order_release);
+        moved++;
+    }
+    pthread_mutex_unlock(&spill->lock);
+
+    return moved;
+}
+
+LONG_T ndw_QSpillCount(NDW_QSpill_T* spill)
+{
+    return (NULL == spill) ? 0 : atomic_load_explicit(&spill->items, memory_order_acquire);
+}
+
+void ndw_QSpillCleanup(NDW_QSpill_T* spill, ndw_QueueCleanupOperator cleanup_operator)
+{
+    if (!spill)
+        return;
+
+    pthread_mutex_lock(&spill->lock);
+    ndw_q_free_node_chain(spill->head, cleanup_operator);
+    spill->head = NULL;
+    spill->tail = NULL;
+    pthread_mutex_unlock(&spill->lock);
+
+    pthread_mutex_destroy(&spill->lock);
+    free(spill);
+}
+
+/*
+ * END: NDW_QSpill Implementation.
+ */
+
@@ -0,0 +1,794 @@
+#include "RegistryData.h"
+#include "NDW_RegistryImage.h"
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define NDW_REGISTRY_IMAGE_ALIGN 8
+
+extern INT_T ndw_verbose;
+
+static const UCHAR_T* ndw_registry_image = NULL;   // Mapped image, kept until ndw_CleanupRegistry.
+static size_t ndw_registry_image_size = 0;
+
+_Static_assert(sizeof(NDW_REGISTRY_IMAGE_MAGIC) == 8, "Registry image magic must be 8 bytes");
+_Static_assert((sizeof(ndw_RegistryImageHeader_T) % NDW_REGISTRY_IMAGE_ALIGN) == 0, "Registry image header must be 8 byte aligned");
+
+// Eight bytes at a time FNV-1a style, folded with the murmur3 finalizer.
+// Detects a truncated, corrupted or changed file; it is not a cryptographic check.
+static ULONG_T
+ndw_RegistryImageHash(const UCHAR_T* data, size_t size)
+{
+    ULONG_T h = 0xcbf29ce484222325UL ^ size;
+    size_t i = 0;
+    for (; (i + sizeof(ULONG_T)) <= size; i += sizeof(ULONG_T)) {
+        ULONG_T word;
+        memcpy(&word, data + i, sizeof(word));
+        h ^= word;
+        h *= 0x100000001b3UL;
+        h ^= h >> 32;
+    }
+
+    for (; i < size; ++i) {
+        h ^= data[i];
+        h *= 0x100000001b3UL;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return h;
+} // end method ndw_RegistryImageHash
+
+// Whole file, NUL terminated. NULL on failure (logged).
+static CHAR_T*
+ndw_ReadRegistrySource(const CHAR_T* path, size_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (NULL == file) {
+        NDW_LOGERR("Error opening file: %s (%s)\n", path, strerror(errno));
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    CHAR_T* data = (length < 0) ? NULL : malloc(length + 1);
+    if ((NULL == data) || (fread(data, 1, length, file) != (size_t) length)) {
+        NDW_LOGERR("Error reading file: %s\n", path);
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+    data[length] = '\0';
+    *size = length;
+    return data;
+} // end method ndw_ReadRegistrySource
+
+//
+// Compiler.
+//
+
+typedef struct ndw_ImageBuffer
+{
+    UCHAR_T* data;
+    size_t size;
+    size_t capacity;
+} ndw_ImageBuffer_T;
+
+typedef struct ndw_ImageWriter
+{
+    ndw_ImageBuffer_T domains;
+    ndw_ImageBuffer_T connections;
+    ndw_ImageBuffer_T topics;
+    ndw_ImageBuffer_T nvpairs;
+    ndw_ImageBuffer_T strings;
+} ndw_ImageWriter_T;
+
+// Returns the offset of the appended bytes. Exits on allocation failure.
+static size_t
+ndw_ImageAppend(ndw_ImageBuffer_T* buffer, const void* data, size_t size)
+{
+    if ((buffer->size + size) > buffer->capacity) {
+        size_t capacity = (0 == buffer->capacity) ? 4096 : buffer->capacity;
+        while ((buffer->size + size) > capacity)
+            capacity *= 2;
+
+        UCHAR_T* grown = realloc(buffer->data, capacity);
+        if (NULL == grown) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to allocate <%zu> bytes for the registry image\n", capacity);
+            ndw_exit(EXIT_FAILURE);
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    size_t offset = buffer->size;
+    memcpy(buffer->data + offset, data, size);
+    buffer->size += size;
+    return offset;
+} // end method ndw_ImageAppend
+
+static UINT_T
+ndw_ImageAddString(ndw_ImageWriter_T* w, const CHAR_T* str)
+{
+    if (NULL == str)
+        return NDW_REGISTRY_IMAGE_NULL_STRING;
+
+    return (UINT_T) ndw_ImageAppend(&w->strings, str, strlen(str) + 1);
+} // end method ndw_ImageAddString
+
+// ndw_ParseNVPairs splits an options string in place and its names and values point into it.
+// The whole split string is copied, so that the name value pairs of the image point into the copy.
+static UINT_T
+ndw_ImageAddOptions(ndw_ImageWriter_T* w, const CHAR_T* options, NDW_NVPairs_T* nvpairs, UINT_T* first, UINT_T* num)
+{
+    *first = (UINT_T) (w->nvpairs.size / sizeof(ndw_RegistryImageNVPair_T));
+    *num = 0;
+
+    if (NULL == options)
+        return NDW_REGISTRY_IMAGE_NULL_STRING;
+
+    const CHAR_T* end = options + strlen(options) + 1;
+    for (INT_T i = 0; i < nvpairs->count; ++i) {
+        const CHAR_T* name_end = nvpairs->names[i] + strlen(nvpairs->names[i]) + 1;
+        const CHAR_T* value_end = nvpairs->values[i] + strlen(nvpairs->values[i]) + 1;
+        if (name_end > end)
+            end = name_end;
+        if (value_end > end)
+            end = value_end;
+    }
+
+    UINT_T offset = (UINT_T) ndw_ImageAppend(&w->strings, options, end - options);
+
+    for (INT_T i = 0; i < nvpairs->count; ++i) {
+        ndw_RegistryImageNVPair_T pair;
+        pair.name = offset + (UINT_T) (nvpairs->names[i] - options);
+        pair.value = offset + (UINT_T) (nvpairs->values[i] - options);
+        ndw_ImageAppend(&w->nvpairs, &pair, sizeof(pair));
+        ++(*num);
+    }
+
+    return offset;
+} // end method ndw_ImageAddOptions
+
+static void
+ndw_ImageAddTopic(ndw_ImageWriter_T* w, ndw_Topic_T* topic)
+{
+    ndw_RegistryImageTopic_T t;
+    memset(&t, 0, sizeof(t));
+
+    t.topic_unique_name = ndw_ImageAddString(w, topic->topic_unique_name);
+    t.topic_description = ndw_ImageAddString(w, topic->cold->topic_description);
+    t.pub_key = ndw_ImageAddString(w, topic->pub_key);
+    t.sub_key = ndw_ImageAddString(w, topic->sub_key);
+    t.q_async_name = ndw_ImageAddString(w, topic->cold->q_async_name);
+    t.debug_desc = ndw_ImageAddString(w, topic->debug_desc);
+    t.topic_options = ndw_ImageAddOptions(w, topic->cold->topic_options, &(topic->cold->topic_options_nvpairs),
+                                        &t.first_nvpair, &t.num_nvpairs);
+    t.vendor_topic_options = ndw_ImageAddOptions(w, topic->cold->vendor_topic_options,
+                                        &(topic->cold->vendor_topic_options_nvpairs),
+                                        &t.first_vendor_nvpair, &t.num_vendor_nvpairs);
+    t.topic_unique_id = topic->topic_unique_id;
+    t.q_async_size = topic->q_async_size;
+    t.flags = (topic->disabled ? NDW_REGISTRY_IMAGE_TOPIC_DISABLED : 0) |
+                (topic->is_pub_enabled ? NDW_REGISTRY_IMAGE_TOPIC_PUB_ENABLED : 0) |
+                (topic->is_sub_enabled ? NDW_REGISTRY_IMAGE_TOPIC_SUB_ENABLED : 0);
+
+    ndw_ImageAppend(&w->topics, &t, sizeof(t));
+} // end method ndw_ImageAddTopic
+
+static void
+ndw_ImageAddConnection(ndw_ImageWriter_T* w, ndw_Connection_T* conn)
+{
+    ndw_RegistryImageConnection_T c;
+    memset(&c, 0, sizeof(c));
+
+    c.connection_unique_name = ndw_ImageAddString(w, conn->connection_unique_name);
+    c.vendor_name = ndw_ImageAddString(w, conn->vendor_name);
+    c.vendor_real_version = ndw_ImageAddString(w, conn->vendor_real_version);
+    c.connection_url = ndw_ImageAddString(w, conn->connection_url);
+    c.connection_comments = ndw_ImageAddString(w, conn->connection_comments);
+    c.debug_desc = ndw_ImageAddString(w, conn->debug_desc);
+    c.vendor_connection_options = ndw_ImageAddOptions(w, conn->vendor_connection_options,
+                                        &(conn->vendor_connection_options_nvpairs), &c.first_nvpair, &c.num_nvpairs);
+    c.connection_unique_id = conn->connection_unique_id;
+    c.vendor_id = conn->vendor_id;
+    c.vendor_logical_version = conn->vendor_logical_version;
+    c.tenant_id = conn->tenant_id;
+    c.disabled = conn->disabled ? 1 : 0;
+
+    c.first_topic = (UINT_T) (w->topics.size / sizeof(ndw_RegistryImageTopic_T));
+    ndw_Topic_T *topic, *tmp;
+    HASH_ITER(hh_topic_id, conn->topics_by_id, topic, tmp) {
+        ndw_ImageAddTopic(w, topic);
+        ++c.num_topics;
+    }
+
+    ndw_ImageAppend(&w->connections, &c, sizeof(c));
+} // end method ndw_ImageAddConnection
+
+static void
+ndw_ImageAddDomain(ndw_ImageWriter_T* w, ndw_Domain_T* domain)
+{
+    ndw_RegistryImageDomain_T d;
+    memset(&d, 0, sizeof(d));
+
+    d.domain_name = ndw_ImageAddString(w, domain->domain_name);
+    d.domain_description = ndw_ImageAddString(w, domain->domain_description);
+    d.debug_desc = ndw_ImageAddString(w, domain->debug_desc);
+    d.domain_id = domain->domain_id;
+
+    d.first_connection = (UINT_T) (w->connections.size / sizeof(ndw_RegistryImageConnection_T));
+    ndw_Connection_T *conn, *tmp;
+    HASH_ITER(hh_connection_id, domain->connections_by_id, conn, tmp) {
+        ndw_ImageAddConnection(w, conn);
+        ++d.num_connections;
+    }
+
+    ndw_ImageAppend(&w->domains, &d, sizeof(d));
+} // end method ndw_ImageAddDomain
+
+static ULONG_T
+ndw_ImageAlign(ULONG_T offset)
+{
+    return (offset + (NDW_REGISTRY_IMAGE_ALIGN - 1)) & ~((ULONG_T) (NDW_REGISTRY_IMAGE_ALIGN - 1));
+} // end method ndw_ImageAlign
+
+// Lays out the sections behind the header. Returns the image (caller frees) or NULL.
+static UCHAR_T*
+ndw_ImageAssemble(ndw_ImageWriter_T* w, ndw_RegistryImageHeader_T* h)
+{
+    if (w->strings.size >= NDW_REGISTRY_IMAGE_NULL_STRING) {
+        NDW_LOGERR("*** ERROR: Registry strings of <%zu> bytes do not fit a registry image\n", w->strings.size);
+        return NULL;
+    }
+
+    memcpy(h->magic, NDW_REGISTRY_IMAGE_MAGIC, sizeof(h->magic));
+    h->version = NDW_REGISTRY_IMAGE_VERSION;
+    h->header_size = sizeof(ndw_RegistryImageHeader_T);
+    h->byte_order = NDW_REGISTRY_IMAGE_BYTE_ORDER;
+    h->domain_record_size = sizeof(ndw_RegistryImageDomain_T);
+    h->connection_record_size = sizeof(ndw_RegistryImageConnection_T);
+    h->topic_record_size = sizeof(ndw_RegistryImageTopic_T);
+    h->nvpair_record_size = sizeof(ndw_RegistryImageNVPair_T);
+    h->num_domains = (UINT_T) (w->domains.size / sizeof(ndw_RegistryImageDomain_T));
+    h->num_connections = (UINT_T) (w->connections.size / sizeof(ndw_RegistryImageConnection_T));
+    h->num_topics = (UINT_T) (w->topics.size / sizeof(ndw_RegistryImageTopic_T));
+    h->num_nvpairs = (UINT_T) (w->nvpairs.size / sizeof(ndw_RegistryImageNVPair_T));
+
+    h->domains_offset = ndw_ImageAlign(sizeof(ndw_RegistryImageHeader_T));
+    h->connections_offset = ndw_ImageAlign(h->domains_offset + w->domains.size);
+    h->topics_offset = ndw_ImageAlign(h->connections_offset + w->connections.size);
+    h->nvpairs_offset = ndw_ImageAlign(h->topics_offset + w->topics.size);
+    h->strings_offset = ndw_ImageAlign(h->nvpairs_offset + w->nvpairs.size);
+    h->strings_size = w->strings.size + 1;  // Trailing NUL, so any offset into the table reads a terminated string.
+    h->image_size = h->strings_offset + h->strings_size;
+
+    UCHAR_T* image = calloc(1, h->image_size);
+    if (NULL == image) {
+        NDW_LOGERR("*** ERROR: Failed to allocate <%lu> bytes for the registry image\n", h->image_size);
+        return NULL;
+    }
+
+    if (w->domains.size > 0)
+        memcpy(image + h->domains_offset, w->domains.data, w->domains.size);
+    if (w->connections.size > 0)
+        memcpy(image + h->connections_offset, w->connections.data, w->connections.size);
+    if (w->topics.size > 0)
+        memcpy(image + h->topics_offset, w->topics.data, w->topics.size);
+    if (w->nvpairs.size > 0)
+        memcpy(image + h->nvpairs_offset, w->nvpairs.data, w->nvpairs.size);
+    if (w->strings.size > 0)
+        memcpy(image + h->strings_offset, w->strings.data, w->strings.size);
+
+    h->image_hash = ndw_RegistryImageHash(image + sizeof(ndw_RegistryImageHeader_T),
+                                        h->image_size - sizeof(ndw_RegistryImageHeader_T));
+    memcpy(image, h, sizeof(ndw_RegistryImageHeader_T));
+    return image;
+} // end method ndw_ImageAssemble
+
+// Written next to the image and renamed over it, so that the image is replaced atomically.
+static INT_T
+ndw_ImageWrite(const CHAR_T* image_path, const UCHAR_T* image, size_t size)
+{
+    CHAR_T* tmp_path = ndw_ConcatStrings((CHAR_T*) image_path, ".tmp", NULL);
+    FILE* file = fopen(tmp_path, "wb");
+    if (NULL == file) {
+        NDW_LOGERR("*** ERROR: Failed to create <%s> (%s)\n", tmp_path, strerror(errno));
+        free(tmp_path);
+        return -1;
+    }
+
+    bool written = (fwrite(image, 1, size, file) == size);
+    written = (0 == fclose(file)) && written;
+    if ((! written) || (0 != rename(tmp_path, image_path))) {
+        NDW_LOGERR("*** ERROR: Failed to write registry image <%s> (%s)\n", image_path, strerror(errno));
+        unlink(tmp_path);
+        free(tmp_path);
+        return -1;
+    }
+
+    free(tmp_path);
+    return 0;
+} // end method ndw_ImageWrite
+
+static void
+ndw_ImageWriterFree(ndw_ImageWriter_T* w)
+{
+    free(w->domains.data);
+    free(w->connections.data);
+    free(w->topics.data);
+    free(w->nvpairs.data);
+    free(w->strings.data);
+} // end method ndw_ImageWriterFree
+
+// NULL terminated list of all distinct DomainName values in the JSON registry.
+static CHAR_T**
+ndw_GetJsonDomainNames(const CHAR_T* json_data)
+{
+    cJSON* root = cJSON_Parse(json_data);
+    if (NULL == root) {
+        NDW_LOGERR("Error parsing JSON\n");
+        return NULL;
+    }
+
+    cJSON* domains = cJSON_GetObjectItem(root, "Domains");
+    if ((NULL == domains) || (! cJSON_IsArray(domains))) {
+        NDW_LOGERR("'Domains' array not found\n");
+        cJSON_Delete(root);
+        return NULL;
+    }
+
+    CHAR_T** names = calloc(cJSON_GetArraySize(domains) + 1, sizeof(CHAR_T*));
+    INT_T num_names = 0;
+    cJSON* domain_obj = NULL;
+    cJSON_ArrayForEach(domain_obj, domains)
+    {
+        cJSON* name_item = cJSON_GetObjectItem(domain_obj, "DomainName");
+        if ((NULL == name_item) || NDW_ISNULLCHARPTR(name_item->valuestring))
+            continue;
+
+        bool duplicate = false;
+        for (INT_T i = 0; (i < num_names) && (! duplicate); ++i)
+            duplicate = (0 == strcmp(names[i], name_item->valuestring));
+        if (! duplicate)
+            names[num_names++] = strdup(name_item->valuestring);
+    }
+
+    cJSON_Delete(root);
+    return names;
+} // end method ndw_GetJsonDomainNames
+
+INT_T
+ndw_CompileRegistry(const CHAR_T* json_path, const CHAR_T* image_path)
+{
+    if (NDW_ISNULLCHARPTR(json_path) || NDW_ISNULLCHARPTR(image_path)) {
+        NDW_LOGERR("*** ERROR: NULL JSON registry or registry image path\n");
+        return -1;
+    }
+
+    struct stat st;
+    size_t source_size = 0;
+    CHAR_T* json_data = NULL;
+    if ((0 != stat(json_path, &st)) || (NULL == (json_data = ndw_ReadRegistrySource(json_path, &source_size)))) {
+        NDW_LOGERR("*** ERROR: Cannot read JSON registry <%s>\n", json_path);
+        return -2;
+    }
+
+    ndw_RegistryImageHeader_T h;
+    memset(&h, 0, sizeof(h));
+    h.source_size = source_size;
+    h.source_mtime_sec = st.st_mtim.tv_sec;
+    h.source_mtime_nsec = st.st_mtim.tv_nsec;
+    h.source_hash = ndw_RegistryImageHash((const UCHAR_T*) json_data, source_size);
+
+    CHAR_T** domain_names = ndw_GetJsonDomainNames(json_data);
+    free(json_data);
+    if (NULL == domain_names)
+        return -3;
+
+    // Load through the JSON path, so that the image holds exactly what ndw_LoadDomains builds.
+    INT_T ret = ndw_LoadDomains(json_path, domain_names);
+    for (INT_T i = 0; NULL != domain_names[i]; ++i)
+        free(domain_names[i]);
+    free(domain_names);
+
+    if (0 != ret) {
+        NDW_LOGERR("*** ERROR: FAILED to load or parse <%s> with return code <%d>\n", json_path, ret);
+        if (-1 != ret)
+            ndw_CleanupRegistry();
+        return -3;
+    }
+
+    ndw_ImageWriter_T w;
+    memset(&w, 0, sizeof(w));
+    ndw_Domain_T *domain, *tmp;
+    HASH_ITER(hh_domain_id, ndw_GetDomainHandle()->g_domains_by_id, domain, tmp) {
+        ndw_ImageAddDomain(&w, domain);
+    }
+
+    ndw_CleanupRegistry();
+
+    UCHAR_T* image = ndw_ImageAssemble(&w, &h);
+    ndw_ImageWriterFree(&w);
+    if (NULL == image)
+        return -4;
+
+    ret = ndw_ImageWrite(image_path, image, h.image_size);
+    free(image);
+    if (0 != ret)
+        return -5;
+
+    NDW_LOG("Compiled <%s> into registry image <%s>: Domains<%u> Connections<%u> Topics<%u> Bytes<%lu>\n",
+            json_path, image_path, h.num_domains, h.num_connections, h.num_topics, h.image_size);
+    return 0;
+} // end method ndw_CompileRegistry
+
+//
+// Loader.
+//
+
+static bool
+ndw_ImageSectionValid(const ndw_RegistryImageHeader_T* h, ULONG_T offset, ULONG_T count, ULONG_T record_size)
+{
+    return (0 == (offset % NDW_REGISTRY_IMAGE_ALIGN)) && (offset >= h->header_size) && (offset <= h->image_size) &&
+            ((count * record_size) <= (h->image_size - offset));
+} // end method ndw_ImageSectionValid
+
+static bool
+ndw_ImageStringValid(const ndw_RegistryImageHeader_T* h, UINT_T offset, bool mandatory)
+{
+    return (NDW_REGISTRY_IMAGE_NULL_STRING == offset) ? (! mandatory) : (offset < h->strings_size);
+} // end method ndw_ImageStringValid
+
+static bool
+ndw_ImageRangeValid(UINT_T first, UINT_T num, UINT_T total)
+{
+    return (((ULONG_T) first) + num) <= total;
+} // end method ndw_ImageRangeValid
+
+// Everything the loader dereferences is checked here, so that a damaged image is rejected before any registry
+// data structure is created.
+static INT_T
+ndw_ValidateRegistryImage(const CHAR_T* image_path, const UCHAR_T* image, size_t size)
+{
+    const CHAR_T* error = NULL;
+    const ndw_RegistryImageHeader_T* h = (const ndw_RegistryImageHeader_T*) image;
+
+    if (size < sizeof(ndw_RegistryImageHeader_T))
+        error = "too small";
+    else if (0 != memcmp(h->magic, NDW_REGISTRY_IMAGE_MAGIC, sizeof(h->magic)))
+        error = "not a registry image";
+    else if (NDW_REGISTRY_IMAGE_VERSION != h->version)
+        error = "unsupported version";
+    else if (NDW_REGISTRY_IMAGE_BYTE_ORDER != h->byte_order)
+        error = "different byte order";
+    else if ((sizeof(ndw_RegistryImageHeader_T) != h->header_size) ||
+            (sizeof(ndw_RegistryImageDomain_T) != h->domain_record_size) ||
+            (sizeof(ndw_RegistryImageConnection_T) != h->connection_record_size) ||
+            (sizeof(ndw_RegistryImageTopic_T) != h->topic_record_size) ||
+            (sizeof(ndw_RegistryImageNVPair_T) != h->nvpair_record_size))
+        error = "different record layout";
+    else if (h->image_size != size)
+        error = "size does not match the file (truncated?)";
+    else if ((! ndw_ImageSectionValid(h, h->domains_offset, h->num_domains, sizeof(ndw_RegistryImageDomain_T))) ||
+            (! ndw_ImageSectionValid(h, h->connections_offset, h->num_connections, sizeof(ndw_RegistryImageConnection_T))) ||
+            (! ndw_ImageSectionValid(h, h->topics_offset, h->num_topics, sizeof(ndw_RegistryImageTopic_T))) ||
+            (! ndw_ImageSectionValid(h, h->nvpairs_offset, h->num_nvpairs, sizeof(ndw_RegistryImageNVPair_T))) ||
+            (! ndw_ImageSectionValid(h, h->strings_offset, h->strings_size, 1)) ||
+            (0 == h->strings_size) || (h->strings_size > NDW_REGISTRY_IMAGE_NULL_STRING) ||
+            ('\0' != image[h->strings_offset + h->strings_size - 1]))
+        error = "invalid section";
+    else if (ndw_RegistryImageHash(image + sizeof(ndw_RegistryImageHeader_T), size - sizeof(ndw_RegistryImageHeader_T))
+                != h->image_hash)
+        error = "hash mismatch (corrupted?)";
+
+    const ndw_RegistryImageDomain_T* domains = (const ndw_RegistryImageDomain_T*) (image + h->domains_offset);
+    for (UINT_T i = 0; (NULL == error) && (i < h->num_domains); ++i) {
+        const ndw_RegistryImageDomain_T* d = &domains[i];
+        if ((! ndw_ImageStringValid(h, d->domain_name, true)) || (! ndw_ImageStringValid(h, d->domain_description, false)) ||
+            (! ndw_ImageStringValid(h, d->debug_desc, false)) ||
+            (! ndw_ImageRangeValid(d->first_connection, d->num_connections, h->num_connections)))
+            error = "invalid Domain record";
+    }
+
+    const ndw_RegistryImageConnection_T* connections = (const ndw_RegistryImageConnection_T*) (image + h->connections_offset);
+    for (UINT_T i = 0; (NULL == error) && (i < h->num_connections); ++i) {
+        const ndw_RegistryImageConnection_T* c = &connections[i];
+        if ((! ndw_ImageStringValid(h, c->connection_unique_name, true)) ||
+            (! ndw_ImageStringValid(h, c->vendor_name, false)) ||
+            (! ndw_ImageStringValid(h, c->vendor_real_version, false)) ||
+            (! ndw_ImageStringValid(h, c->connection_url, false)) ||
+            (! ndw_ImageStringValid(h, c->connection_comments, false)) ||
+            (! ndw_ImageStringValid(h, c->debug_desc, false)) ||
+            (! ndw_ImageStringValid(h, c->vendor_connection_options, false)) ||
+            (! ndw_ImageRangeValid(c->first_nvpair, c->num_nvpairs, h->num_nvpairs)) ||
+            (! ndw_ImageRangeValid(c->first_topic, c->num_topics, h->num_topics)))
+            error = "invalid Connection record";
+    }
+
+    const ndw_RegistryImageTopic_T* topics = (const ndw_RegistryImageTopic_T*) (image + h->topics_offset);
+    for (UINT_T i = 0; (NULL == error) && (i < h->num_topics); ++i) {
+        const ndw_RegistryImageTopic_T* t = &topics[i];
+        if ((! ndw_ImageStringValid(h, t->topic_unique_name, true)) ||
+            (! ndw_ImageStringValid(h, t->topic_description, false)) ||
+            (! ndw_ImageStringValid(h, t->pub_key, false)) ||
+            (! ndw_ImageStringValid(h, t->sub_key, false)) ||
+            (! ndw_ImageStringValid(h, t->q_async_name, false)) ||
+            (! ndw_ImageStringValid(h, t->debug_desc, false)) ||
+            (! ndw_ImageStringValid(h, t->topic_options, false)) ||
+            (! ndw_ImageStringValid(h, t->vendor_topic_options, false)) ||
+            (! ndw_ImageRangeValid(t->first_nvpair, t->num_nvpairs, h->num_nvpairs)) ||
+            (! ndw_ImageRangeValid(t->first_vendor_nvpair, t->num_vendor_nvpairs, h->num_nvpairs)))
+            error = "invalid Topic record";
+    }
+
+    const ndw_RegistryImageNVPair_T* nvpairs = (const ndw_RegistryImageNVPair_T*) (image + h->nvpairs_offset);
+    for (UINT_T i = 0; (NULL == error) && (i < h->num_nvpairs); ++i) {
+        if ((! ndw_ImageStringValid(h, nvpairs[i].name, true)) || (! ndw_ImageStringValid(h, nvpairs[i].value, true)))
+            error = "invalid name value pair record";
+    }
+
+    if (NULL != error) {
+        NDW_LOGERR("*** ERROR: Registry image <%s>: %s\n", image_path, error);
+        return -3;
+    }
+
+    return 0;
+} // end method ndw_ValidateRegistryImage
+
+// Rejects the image if the JSON registry changed since it was compiled. Size and modification time are checked
+// first; if they differ the contents are compared by hash, so that a copied or touched but unchanged file is accepted.
+static INT_T
+ndw_CheckRegistryImageSource(const ndw_RegistryImageHeader_T* h, const CHAR_T* image_path, const CHAR_T* json_path)
+{
+    struct stat st;
+    if (0 != stat(json_path, &st)) {
+        NDW_LOGERR("*** WARNING: Cannot check registry image <%s> against JSON registry <%s> (%s); using the image\n",
+                    image_path, json_path, strerror(errno));
+        return 0;
+    }
+
+    if ((h->source_size == (ULONG_T) st.st_size) && (h->source_mtime_sec == st.st_mtim.tv_sec) &&
+        (h->source_mtime_nsec == st.st_mtim.tv_nsec)) {
+        return 0;
+    }
+
+    size_t size = 0;
+    CHAR_T* json_data = ndw_ReadRegistrySource(json_path, &size);
+    if (NULL == json_data) {
+        NDW_LOGERR("*** WARNING: Cannot check registry image <%s> against JSON registry <%s>; using the image\n",
+                    image_path, json_path);
+        return 0;
+    }
+
+    bool unchanged = (h->source_size == size) && (h->source_hash == ndw_RegistryImageHash((const UCHAR_T*) json_data, size));
+    free(json_data);
+    if (! unchanged) {
+        NDW_LOGERR("*** ERROR: Registry image <%s> is stale: JSON registry <%s> changed since it was compiled. "
+                    "Recompile it with compile_registry.out\n", image_path, json_path);
+        return -4;
+    }
+
+    NDW_LOGX("Registry image <%s>: JSON registry <%s> was touched but its contents are unchanged\n", image_path, json_path);
+    return 0;
+} // end method ndw_CheckRegistryImageSource
+
+static inline CHAR_T*
+ndw_ImageString(const ndw_RegistryImageHeader_T* h, UINT_T offset)
+{
+    return (NDW_REGISTRY_IMAGE_NULL_STRING == offset) ? NULL : (CHAR_T*) (ndw_registry_image + h->strings_offset + offset);
+} // end method ndw_ImageString
+
+// Only the pointer arrays are allocated; names and values point into the image.
+static void
+ndw_ImageNVPairs(const ndw_RegistryImageHeader_T* h, UINT_T first, UINT_T num, NDW_NVPairs_T* nvpairs)
+{
+    if (0 == num)
+        return;
+
+    nvpairs->names = malloc((num + 1) * sizeof(CHAR_T*));
+    nvpairs->values = malloc((num + 1) * sizeof(CHAR_T*));
+    if ((NULL == nvpairs->names) || (NULL == nvpairs->values)) {
+        NDW_LOGERR("*** FATAL ERROR: Failed to allocate memory for <%u> name value pairs\n", num);
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    const ndw_RegistryImageNVPair_T* pairs = (const ndw_RegistryImageNVPair_T*) (ndw_registry_image + h->nvpairs_offset);
+    for (UINT_T i = 0; i < num; ++i) {
+        nvpairs->names[i] = ndw_ImageString(h, pairs[first + i].name);
+        nvpairs->values[i] = ndw_ImageString(h, pairs[first + i].value);
+    }
+
+    nvpairs->names[num] = NULL;
+    nvpairs->values[num] = NULL;
+    nvpairs->count = num;
+} // end method ndw_ImageNVPairs
+
+static void
+ndw_ImageLoadTopic(const ndw_RegistryImageHeader_T* h, const ndw_RegistryImageTopic_T* t,
+                    ndw_Domain_T* domain, ndw_Connection_T* conn)
+{
+    ndw_Topic_T* topic = ndw_NewTopic(domain, conn);
+    topic->topic_unique_name = ndw_ImageString(h, t->topic_unique_name);
+    topic->topic_unique_id = t->topic_unique_id;
+    topic->pub_key = ndw_ImageString(h, t->pub_key);
+    topic->sub_key = ndw_ImageString(h, t->sub_key);
+    topic->debug_desc = ndw_ImageString(h, t->debug_desc);
+    topic->disabled = (0 != (t->flags & NDW_REGISTRY_IMAGE_TOPIC_DISABLED));
+    topic->is_pub_enabled = (0 != (t->flags & NDW_REGISTRY_IMAGE_TOPIC_PUB_ENABLED));
+    topic->is_sub_enabled = (0 != (t->flags & NDW_REGISTRY_IMAGE_TOPIC_SUB_ENABLED));
+    topic->q_async_size = t->q_async_size;
+    topic->cold->topic_description = ndw_ImageString(h, t->topic_description);
+    topic->cold->q_async_name = ndw_ImageString(h, t->q_async_name);
+    topic->cold->topic_options = ndw_ImageString(h, t->topic_options);
+    topic->cold->vendor_topic_options = ndw_ImageString(h, t->vendor_topic_options);
+    ndw_ImageNVPairs(h, t->first_nvpair, t->num_nvpairs, &(topic->cold->topic_options_nvpairs));
+    ndw_ImageNVPairs(h, t->first_vendor_nvpair, t->num_vendor_nvpairs, &(topic->cold->vendor_topic_options_nvpairs));
+
+    if (ndw_verbose) // One line per object would dominate the load time.
+        NDW_LOGX("Loading Topic: %s\n", topic->debug_desc);
+
+    if (! NDW_ISNULLCHARPTR(topic->cold->q_async_name)) {
+        ndw_CreateTopicAsyncQueue(topic);
+        ndw_ConfigureTopicAsyncQueue(topic);
+    }
+
+    HASH_ADD(hh_topic_id, conn->topics_by_id, topic_unique_id, sizeof(INT_T), topic);
+    HASH_ADD_KEYPTR(hh_topic_name, conn->topics_by_name, topic->topic_unique_name, strlen(topic->topic_unique_name), topic);
+} // end method ndw_ImageLoadTopic
+
+static void
+ndw_ImageLoadDomain(const ndw_RegistryImageHeader_T* h, const ndw_RegistryImageDomain_T* d)
+{
+    ndw_DomainHandle_T* dh = ndw_GetDomainHandle();
+    ndw_Domain_T* domain = (ndw_Domain_T*) calloc(1, sizeof(ndw_Domain_T));
+    domain->domain_handle = dh;
+    domain->domain_name = ndw_ImageString(h, d->domain_name);
+    domain->domain_id = d->domain_id;
+    domain->domain_description = ndw_ImageString(h, d->domain_description);
+    domain->debug_desc = ndw_ImageString(h, d->debug_desc);
+    if (ndw_verbose)
+        NDW_LOGX("Loading Domain: %s\n", domain->debug_desc);
+
+    HASH_ADD(hh_domain_id, dh->g_domains_by_id, domain_id, sizeof(INT_T), domain);
+    HASH_ADD_KEYPTR(hh_domain_name, dh->g_domains_by_name, domain->domain_name, strlen(domain->domain_name), domain);
+
+    const ndw_RegistryImageConnection_T* connections = (const ndw_RegistryImageConnection_T*) (ndw_registry_image + h->connections_offset);
+    const ndw_RegistryImageTopic_T* topics = (const ndw_RegistryImageTopic_T*) (ndw_registry_image + h->topics_offset);
+    for (UINT_T i = 0; i < d->num_connections; ++i) {
+        const ndw_RegistryImageConnection_T* c = &connections[d->first_connection + i];
+        ndw_Connection_T* conn = (ndw_Connection_T*) calloc(1, sizeof(ndw_Connection_T));
+        conn->domain_handle = dh;
+        conn->domain = domain;
+        conn->disabled = (0 != c->disabled);
+        conn->connection_unique_name = ndw_ImageString(h, c->connection_unique_name);
+        conn->connection_unique_id = c->connection_unique_id;
+        conn->vendor_name = ndw_ImageString(h, c->vendor_name);
+        conn->vendor_id = c->vendor_id;
+        conn->vendor_logical_version = c->vendor_logical_version;
+        conn->vendor_real_version = ndw_ImageString(h, c->vendor_real_version);
+        conn->tenant_id = c->tenant_id;
+        conn->connection_url = ndw_ImageString(h, c->connection_url);
+        conn->connection_comments = ndw_ImageString(h, c->connection_comments);
+        conn->debug_desc = ndw_ImageString(h, c->debug_desc);
+        conn->vendor_connection_options = ndw_ImageString(h, c->vendor_connection_options);
+        ndw_ImageNVPairs(h, c->first_nvpair, c->num_nvpairs, &(conn->vendor_connection_options_nvpairs));
+        if (ndw_verbose)
+            NDW_LOGX("Loading Connection: %s\n", conn->debug_desc);
+
+        HASH_ADD(hh_connection_id, domain->connections_by_id, connection_unique_id, sizeof(INT_T), conn);
+        HASH_ADD_KEYPTR(hh_connection_name, domain->connections_by_name, conn->connection_unique_name, strlen(conn->connection_unique_name), conn);
+
+        for (UINT_T j = 0; j < c->num_topics; ++j)
+            ndw_ImageLoadTopic(h, &topics[c->first_topic + j], domain, conn);
+    }
+} // end method ndw_ImageLoadDomain
+
+INT_T
+ndw_LoadDomainsFromImage(const CHAR_T* image_path, const CHAR_T* json_path, CHAR_T** domain_names)
+{
+    if (NULL != ndw_registry_image) {
+        return -1;  // Already set. This can be called only once!
+    }
+
+    if (NDW_ISNULLCHARPTR(image_path)) {
+        NDW_LOGERR("*** ERROR: NULL registry image path\n");
+        return -2;
+    }
+
+    INT_T fd = open(image_path, O_RDONLY);
+    if (fd < 0) {
+        NDW_LOGERR("*** ERROR: Failed to open registry image <%s> (%s)\n", image_path, strerror(errno));
+        return -2;
+    }
+
+    struct stat st;
+    if ((0 != fstat(fd, &st)) || (st.st_size < (off_t) sizeof(ndw_RegistryImageHeader_T))) {
+        NDW_LOGERR("*** ERROR: Registry image <%s>: cannot stat or too small\n", image_path);
+        close(fd);
+        return -3;
+    }
+
+    size_t size = st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapping) {
+        NDW_LOGERR("*** ERROR: Failed to map registry image <%s> (%s)\n", image_path, strerror(errno));
+        return -2;
+    }
+
+    const UCHAR_T* image = (const UCHAR_T*) mapping;
+    const ndw_RegistryImageHeader_T* h = (const ndw_RegistryImageHeader_T*) image;
+    INT_T ret = ndw_ValidateRegistryImage(image_path, image, size);
+    if ((0 == ret) && (NULL != json_path))
+        ret = ndw_CheckRegistryImageSource(h, image_path, json_path);
+
+    if (0 != ret) {
+        munmap(mapping, size);
+        return ret;
+    }
+
+    if (NULL == ndw_CreateDomainHandle()) {
+        munmap(mapping, size);
+        return -1;  // Already set. This can be called only once!
+    }
+
+    ndw_registry_image = image;
+    ndw_registry_image_size = size;
+
+    const ndw_RegistryImageDomain_T* domains = (const ndw_RegistryImageDomain_T*) (image + h->domains_offset);
+    if (NULL == domain_names) {
+        for (UINT_T i = 0; i < h->num_domains; ++i)
+            ndw_ImageLoadDomain(h, &domains[i]);
+    } else {
+        for (INT_T i = 0; NULL != domain_names[i]; ++i) {
+            for (UINT_T j = 0; j < h->num_domains; ++j) {
+                if (0 == strcmp(domain_names[i], ndw_ImageString(h, domains[j].domain_name))) {
+                    ndw_ImageLoadDomain(h, &domains[j]);
+                    break; // Found and loaded the target domain
+                }
+            }
+        }
+    }
+
+    if (0 != ndw_BuildTopicTable()) {
+        NDW_LOGERR("*** ERROR: Failed to build the Topic table\n");
+        return -5;
+    }
+
+    NDW_LOGX("Loaded registry image <%s>: Domains<%u> Connections<%u> Topics<%u> Bytes<%zu>\n",
+            image_path, h->num_domains, h->num_connections, h->num_topics, size);
+    return 0;
+} // end method ndw_LoadDomainsFromImage
+
+void
+ndw_RegistryFree(void* ptr)
+{
+    const UCHAR_T* p = (const UCHAR_T*) ptr;
+    if ((NULL != ndw_registry_image) && (p >= ndw_registry_image) && (p < (ndw_registry_image + ndw_registry_image_size)))
+        return; // Belongs to the image.
+
+    free(ptr);
+} // end method ndw_RegistryFree
+
+void
+ndw_UnmapRegistryImage()
+{
+    if (NULL != ndw_registry_image) {
+        munmap((void*) ndw_registry_image, ndw_registry_image_size);
+        ndw_registry_image = NULL;
+        ndw_registry_image_size = 0;
+    }
+} // end method ndw_UnmapRegistryImage
+
@@ -0,0 +1,595 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "VendorImpl.h"
+#include "MsgHeader_1.h"
+#include "AbstractMessaging.h"
+#include "NDW_RegistryImage.h"
+#include "NDW_RegistryReload.h"
+
+#define NDW_REGISTRY_WATCH_SLICE_MS 100     // Longest the watch thread sleeps before checking for a stop request.
+
+/*
+ * Changes made by one reload, for its summary.
+ */
+typedef struct ndw_ReloadCounts
+{
+    INT_T added_topics;
+    INT_T enabled_topics;
+    INT_T disabled_topics;
+    INT_T topic_options;
+    INT_T added_connections;
+    INT_T enabled_connections;
+    INT_T disabled_connections;
+    INT_T connection_options;
+    INT_T not_applied;
+} ndw_ReloadCounts_T;
+
+static pthread_mutex_t ndw_reload_lock = PTHREAD_MUTEX_INITIALIZER; // One reload at a time.
+
+// Cold records, options and name value pair arrays replaced by reloads. Freed by ndw_FreeRetiredRegistryData.
+static void** ndw_retired = NULL;
+static INT_T ndw_num_retired = 0;
+static INT_T ndw_retired_capacity = 0;
+
+// Keep replaced data until ndw_CleanupRegistry, as other threads may still read it.
+// If there is no memory to remember it, it is leaked, which is still safe.
+static void
+ndw_Retire(void* ptr)
+{
+    if (NULL == ptr)
+        return;
+
+    if (ndw_num_retired == ndw_retired_capacity) {
+        INT_T capacity = (0 == ndw_retired_capacity) ? 64 : (ndw_retired_capacity * 2);
+        void** more = realloc(ndw_retired, capacity * sizeof(void*));
+        if (NULL == more)
+            return;
+        ndw_retired = more;
+        ndw_retired_capacity = capacity;
+    }
+
+    ndw_retired[ndw_num_retired++] = ptr;
+} // end method ndw_Retire
+
+void
+ndw_FreeRetiredRegistryData()
+{
+    pthread_mutex_lock(&ndw_reload_lock);
+    for (INT_T i = 0; i < ndw_num_retired; ++i)
+        ndw_RegistryFree(ndw_retired[i]);
+
+    free(ndw_retired);
+    ndw_retired = NULL;
+    ndw_num_retired = 0;
+    ndw_retired_capacity = 0;
+    pthread_mutex_unlock(&ndw_reload_lock);
+} // end method ndw_FreeRetiredRegistryData
+
+static bool
+ndw_ReloadStringsDiffer(const CHAR_T* a, const CHAR_T* b)
+{
+    return 0 != strcmp((NULL == a) ? "" : a, (NULL == b) ? "" : b);
+} // end method ndw_ReloadStringsDiffer
+
+// Options strings are split in place when parsed, so compare the parsed name value pairs.
+static bool
+ndw_ReloadNVPairsDiffer(const NDW_NVPairs_T* a, const NDW_NVPairs_T* b)
+{
+    if (a->count != b->count)
+        return true;
+
+    for (INT_T i = 0; i < a->count; ++i) {
+        if (ndw_ReloadStringsDiffer(a->names[i], b->names[i]) || ndw_ReloadStringsDiffer(a->values[i], b->values[i]))
+            return true;
+    }
+
+    return false;
+} // end method ndw_ReloadNVPairsDiffer
+
+static ndw_ImplAPI_T*
+ndw_ReloadImpl(ndw_Connection_T* connection)
+{
+    INT_T impl_id = connection->vendor_id;
+    if ((impl_id <= 0) || (impl_id >= NDW_MAX_API_IMPLEMENTATIONS))
+        return NULL;
+
+    return get_Implementation_API(impl_id);
+} // end method ndw_ReloadImpl
+
+static void
+ndw_ReloadNotApplied(const CHAR_T* what, const CHAR_T* debug_desc, ndw_ReloadCounts_T* counts)
+{
+    ++counts->not_applied;
+    NDW_LOGERR("*** WARNING: Registry reload: %s changed for %s; takes effect on restart\n", what, debug_desc);
+} // end method ndw_ReloadNotApplied
+
+static void
+ndw_ReloadDisableTopic(ndw_Topic_T* topic, ndw_ReloadCounts_T* counts)
+{
+    if (topic->disabled)
+        return;
+
+    // Flag first so no thread starts new work on the Topic. The vendor code closes the subscription but keeps it
+    // until shutdown, for threads already inside a poll or the metrics exporter.
+    __atomic_store_n(&topic->disabled, true, __ATOMIC_RELEASE);
+
+    ndw_ImplAPI_T* impl = ndw_ReloadImpl(topic->connection);
+    if ((NULL != impl) && (NULL != impl->Unsubscribe) && topic->is_sub_enabled && (! topic->connection->disabled))
+        impl->Unsubscribe(topic);
+
+    ++counts->disabled_topics;
+    NDW_LOGX("Registry reload: disabled %s\n", topic->debug_desc);
+} // end method ndw_ReloadDisableTopic
+
+static void
+ndw_ReloadEnableTopic(ndw_Topic_T* topic, ndw_ReloadCounts_T* counts)
+{
+    if (! topic->disabled)
+        return;
+
+    // ndw_Connect only builds header templates for enabled Topics.
+    if (topic->is_pub_enabled && (0 == topic->pub_header_template_id))
+        ndw_MsgHeader1_BuildTemplate(topic);
+
+    __atomic_store_n(&topic->disabled, false, __ATOMIC_RELEASE);
+    ++counts->enabled_topics;
+    NDW_LOGX("Registry reload: enabled %s%s\n", topic->debug_desc,
+                topic->is_sub_enabled ? "; subscribe to it to receive messages" : "");
+} // end method ndw_ReloadEnableTopic
+
+static void
+ndw_ReloadTopicOptions(ndw_Topic_T* topic, ndw_Topic_T* staged, ndw_ReloadCounts_T* counts)
+{
+    ndw_TopicCold_T* old_cold = topic->cold;
+    if (! ndw_ReloadNVPairsDiffer(&(old_cold->topic_options_nvpairs), &(staged->cold->topic_options_nvpairs)))
+        return;
+
+    ndw_TopicCold_T* cold = malloc(sizeof(ndw_TopicCold_T));
+    if (NULL == cold) {
+        NDW_LOGERR("*** ERROR: Registry reload: Memory allocation failed for TopicOptions of %s\n", topic->debug_desc);
+        ++counts->not_applied;
+        return;
+    }
+
+    // Readers see either the old or the new record, each with consistent options and name value pairs.
+    memcpy(cold, old_cold, sizeof(ndw_TopicCold_T));
+    cold->topic_options = staged->cold->topic_options;
+    cold->topic_options_nvpairs = staged->cold->topic_options_nvpairs;
+    staged->cold->topic_options = NULL;
+    memset(&(staged->cold->topic_options_nvpairs), 0, sizeof(NDW_NVPairs_T));
+
+    __atomic_store_n(&topic->cold, cold, __ATOMIC_RELEASE);
+
+    ndw_Retire(old_cold->topic_options);
+    ndw_Retire(old_cold->topic_options_nvpairs.names);
+    ndw_Retire(old_cold->topic_options_nvpairs.values);
+    ndw_Retire(old_cold);
+
+    ++counts->topic_options;
+    NDW_LOGX("Registry reload: TopicOptions changed for %s\n", topic->debug_desc);
+
+    ndw_ImplAPI_T* impl = ndw_ReloadImpl(topic->connection);
+    if ((NULL != impl) && (NULL != impl->ReloadTopic))
+        impl->ReloadTopic(topic);
+} // end method ndw_ReloadTopicOptions
+
+static void
+ndw_ReloadTopic(ndw_Topic_T* topic, ndw_Topic_T* staged, ndw_ReloadCounts_T* counts)
+{
+    if (topic->topic_unique_id != staged->topic_unique_id)
+        ndw_ReloadNotApplied("TopicUniqueID", topic->debug_desc, counts);
+    if (ndw_ReloadStringsDiffer(topic->pub_key, staged->pub_key))
+        ndw_ReloadNotApplied("PubKey", topic->debug_desc, counts);
+    if (ndw_ReloadStringsDiffer(topic->sub_key, staged->sub_key))
+        ndw_ReloadNotApplied("SubKey", topic->debug_desc, counts);
+    if (ndw_ReloadStringsDiffer(topic->cold->q_async_name, staged->cold->q_async_name) ||
+        (topic->q_async_size != staged->q_async_size))
+        ndw_ReloadNotApplied("MsgQueueName or MsgQueueSize", topic->debug_desc, counts);
+    if (ndw_ReloadNVPairsDiffer(&(topic->cold->vendor_topic_options_nvpairs),
+                                &(staged->cold->vendor_topic_options_nvpairs)))
+        ndw_ReloadNotApplied("VendorTopicOptions", topic->debug_desc, counts);
+
+    ndw_ReloadTopicOptions(topic, staged, counts);
+
+    if (staged->disabled)
+        ndw_ReloadDisableTopic(topic, counts);
+    else
+        ndw_ReloadEnableTopic(topic, counts);
+} // end method ndw_ReloadTopic
+
+static void
+ndw_ReloadAddTopic(ndw_Domain_T* domain, ndw_Connection_T* connection, ndw_Topic_T* staged,
+                    ndw_ReloadCounts_T* counts)
+{
+    // Check first, so a bad vendor configuration neither reaches the registry nor stops the process.
+    if (0 != ndw_ValidateTopicConfiguration(staged, connection)) {
+        NDW_LOGERR("*** ERROR: Registry reload: Invalid vendor configuration, NOT adding %s\n", staged->debug_desc);
+        ++counts->not_applied;
+        return;
+    }
+
+    ndw_Topic_T* topic = ndw_AdoptStagedTopic(domain, connection, staged);
+    if (0 != ndw_ProcessTopicConfiguration(topic)) {
+        // Left out of the registry; its memory stays with the Topic slabs until shutdown.
+        NDW_LOGERR("*** ERROR: Registry reload: Vendor rejected the configuration, NOT adding %s\n", topic->debug_desc);
+        ++counts->not_applied;
+        return;
+    }
+
+    if ((! topic->disabled) && topic->is_pub_enabled)
+        ndw_MsgHeader1_BuildTemplate(topic);
+
+    ndw_ImplAPI_T* impl = ndw_ReloadImpl(connection);
+    if ((NULL != impl) && (NULL != impl->ReloadTopic))
+        impl->ReloadTopic(topic);
+
+    ndw_LockRegistryForUpdate();
+    HASH_ADD(hh_topic_id, connection->topics_by_id, topic_unique_id, sizeof(INT_T), topic);
+    HASH_ADD_KEYPTR(hh_topic_name, connection->topics_by_name, topic->topic_unique_name, strlen(topic->topic_unique_name), topic);
+    ndw_UnlockRegistryForUpdate();
+
+    ++counts->added_topics;
+    NDW_LOGX("Registry reload: added %s\n", topic->debug_desc);
+} // end method ndw_ReloadAddTopic
+
+static void
+ndw_ReloadDisableConnection(ndw_Connection_T* connection, ndw_ReloadCounts_T* counts)
+{
+    ndw_Topic_T *topic, *tmp;
+    HASH_ITER(hh_topic_id, connection->topics_by_id, topic, tmp) {
+        ndw_ReloadDisableTopic(topic, counts);
+    }
+
+    if (connection->disabled)
+        return;
+
+    // As for Topics: flag first; the vendor code closes the connection but keeps it until shutdown.
+    __atomic_store_n(&connection->disabled, true, __ATOMIC_RELEASE);
+
+    ndw_ImplAPI_T* impl = ndw_ReloadImpl(connection);
+    if ((NULL != impl) && (NULL != impl->Disconnect) && (NULL != connection->vendor_opaque))
+        impl->Disconnect(connection);
+
+    ++counts->disabled_connections;
+    NDW_LOGX("Registry reload: disconnected and disabled %s\n", connection->debug_desc);
+} // end method ndw_ReloadDisableConnection
+
+static void
+ndw_ReloadConnectionOptions(ndw_Connection_T* connection, ndw_Connection_T* staged, ndw_ReloadCounts_T* counts)
+{
+    if (! ndw_ReloadNVPairsDiffer(&(connection->vendor_connection_options_nvpairs),
+                                    &(staged->vendor_connection_options_nvpairs)))
+        return;
+
+    // Vendor code reads these only while configuring, which for a running process is done by the reload itself.
+    CHAR_T* old_options = connection->vendor_connection_options;
+    NDW_NVPairs_T old_nvpairs = connection->vendor_connection_options_nvpairs;
+    connection->vendor_connection_options = staged->vendor_connection_options;
+    connection->vendor_connection_options_nvpairs = staged->vendor_connection_options_nvpairs;
+    staged->vendor_connection_options = NULL;
+    memset(&(staged->vendor_connection_options_nvpairs), 0, sizeof(NDW_NVPairs_T));
+
+    ndw_Retire(old_options);
+    ndw_Retire(old_nvpairs.names);
+    ndw_Retire(old_nvpairs.values);
+
+    ++counts->connection_options;
+    NDW_LOGX("Registry reload: ConnectionOptions changed for %s\n", connection->debug_desc);
+
+    ndw_ImplAPI_T* impl = ndw_ReloadImpl(connection);
+    if ((NULL != impl) && (NULL != impl->ReloadConnection))
+        impl->ReloadConnection(connection);
+} // end method ndw_ReloadConnectionOptions
+
+static void
+ndw_ReloadConnection(ndw_Domain_T* domain, ndw_Connection_T* connection, ndw_Connection_T* staged,
+                        ndw_ReloadCounts_T* counts)
+{
+    if ((connection->connection_unique_id != staged->connection_unique_id) ||
+        (connection->vendor_id != staged->vendor_id) ||
+        (connection->vendor_logical_version != staged->vendor_logical_version) ||
+        (connection->tenant_id != staged->tenant_id) ||
+        ndw_ReloadStringsDiffer(connection->vendor_name, staged->vendor_name) ||
+        ndw_ReloadStringsDiffer(connection->vendor_real_version, staged->vendor_real_version) ||
+        ndw_ReloadStringsDiffer(connection->connection_url, staged->connection_url))
+        ndw_ReloadNotApplied("Connection URL, identifier, tenant or vendor", connection->debug_desc, counts);
+
+    if (connection->disabled && (! staged->disabled)) {
+        __atomic_store_n(&connection->disabled, false, __ATOMIC_RELEASE);
+        ++counts->enabled_connections;
+        NDW_LOGX("Registry reload: enabled %s; call ndw_Connect to connect it\n", connection->debug_desc);
+    }
+
+    ndw_ReloadConnectionOptions(connection, staged, counts);
+
+    // Removed Topics first: staged Topics are taken over below.
+    ndw_Topic_T *topic, *staged_topic, *tmp;
+    HASH_ITER(hh_topic_id, connection->topics_by_id, topic, tmp) {
+        HASH_FIND(hh_topic_name, staged->topics_by_name, topic->topic_unique_name, strlen(topic->topic_unique_name),
+                    staged_topic);
+        if (NULL == staged_topic)
+            ndw_ReloadDisableTopic(topic, counts);
+    }
+
+    HASH_ITER(hh_topic_id, staged->topics_by_id, staged_topic, tmp) {
+        HASH_FIND(hh_topic_name, connection->topics_by_name, staged_topic->topic_unique_name,
+                    strlen(staged_topic->topic_unique_name), topic);
+        if (NULL == topic)
+            ndw_ReloadAddTopic(domain, connection, staged_topic, counts);
+        else
+            ndw_ReloadTopic(topic, staged_topic, counts);
+    }
+
+    if (staged->disabled)
+        ndw_ReloadDisableConnection(connection, counts);
+} // end method ndw_ReloadConnection
+
+static void
+ndw_ReloadAddConnection(ndw_Domain_T* domain, ndw_Connection_T* staged, ndw_ReloadCounts_T* counts)
+{
+    if (NULL == ndw_ReloadImpl(staged)) {
+        NDW_LOGERR("*** ERROR: Registry reload: Invalid vendor_id <%d>, NOT adding %s\n",
+                    staged->vendor_id, staged->debug_desc);
+        ++counts->not_applied;
+        return;
+    }
+
+    ndw_Connection_T* connection = ndw_AdoptStagedConnection(domain, staged);
+
+    // The Connection is not in the registry yet, so a rejected Topic can still be taken out of it.
+    ndw_Topic_T *topic, *tmp;
+    HASH_ITER(hh_topic_id, connection->topics_by_id, topic, tmp) {
+        if (0 != ndw_ProcessTopicConfiguration(topic)) {
+            NDW_LOGERR("*** ERROR: Registry reload: Vendor rejected the configuration, NOT adding %s\n",
+                        topic->debug_desc);
+            HASH_DELETE(hh_topic_id, connection->topics_by_id, topic);
+            HASH_DELETE(hh_topic_name, connection->topics_by_name, topic);
+            ++counts->not_applied;
+            continue;
+        }
+
+        ++counts->added_topics;
+    }
+
+    ndw_LockRegistryForUpdate();
+    HASH_ADD(hh_connection_id, domain->connections_by_id, connection_unique_id, sizeof(INT_T), connection);
+    HASH_ADD_KEYPTR(hh_connection_name, domain->connections_by_name, connection->connection_unique_name,
+                    strlen(connection->connection_unique_name), connection);
+    ndw_UnlockRegistryForUpdate();
+
+    ++counts->added_connections;
+    NDW_LOGX("Registry reload: added %s%s\n", connection->debug_desc,
+                connection->disabled ? "" : "; call ndw_Connect to connect it");
+} // end method ndw_ReloadAddConnection
+
+static void
+ndw_ReloadDomain(ndw_Domain_T* domain, ndw_Domain_T* staged, ndw_ReloadCounts_T* counts)
+{
+    // Removed Connections first: staged Connections are taken over below.
+    ndw_Connection_T *connection, *staged_connection, *tmp;
+    HASH_ITER(hh_connection_id, domain->connections_by_id, connection, tmp) {
+        HASH_FIND(hh_connection_name, staged->connections_by_name, connection->connection_unique_name,
+                    strlen(connection->connection_unique_name), staged_connection);
+        if (NULL == staged_connection)
+            ndw_ReloadDisableConnection(connection, counts);
+    }
+
+    HASH_ITER(hh_connection_id, staged->connections_by_id, staged_connection, tmp) {
+        HASH_FIND(hh_connection_name, domain->connections_by_name, staged_connection->connection_unique_name,
+                    strlen(staged_connection->connection_unique_name), connection);
+        if (NULL == connection)
+            ndw_ReloadAddConnection(domain, staged_connection, counts);
+        else
+            ndw_ReloadConnection(domain, connection, staged_connection, counts);
+    }
+} // end method ndw_ReloadDomain
+
+INT_T
+ndw_ReloadRegistry(const CHAR_T* json_path)
+{
+    if (NDW_ISNULLCHARPTR(json_path))
+        json_path = getenv(NDW_APP_CONFIG_FILE);
+
+    if (NDW_ISNULLCHARPTR(json_path)) {
+        NDW_LOGERR("*** ERROR: No registry to reload: Env Variable <%s> NOT set!\n", NDW_APP_CONFIG_FILE);
+        return -2;
+    }
+
+    pthread_mutex_lock(&ndw_reload_lock);
+
+    if (NULL == ndw_GetDomainHandle()) {
+        pthread_mutex_unlock(&ndw_reload_lock);
+        return -1;
+    }
+
+    // The Domains loaded by ndw_Init; only this thread adds to the registry, so the list stays complete.
+    INT_T num_domains = 0;
+    ndw_Domain_T** domains = ndw_GetAllDomains(&num_domains);
+    CHAR_T** domain_names = calloc(num_domains + 1, sizeof(CHAR_T*));
+    if (NULL == domain_names) {
+        NDW_LOGERR("*** ERROR: Registry reload: Memory allocation failed for <%d> Domain names\n", num_domains);
+        free(domains);
+        pthread_mutex_unlock(&ndw_reload_lock);
+        return -3;
+    }
+
+    for (INT_T i = 0; i < num_domains; ++i)
+        domain_names[i] = domains[i]->domain_name;
+
+    INT_T ret = 0;
+    ndw_DomainHandle_T* staging = ndw_LoadStagingDomains(json_path, domain_names, &ret);
+    if (NULL == staging) {
+        NDW_LOGERR("*** ERROR: Registry reload: FAILED to load or parse <%s> with return code <%d>\n", json_path, ret);
+        free(domain_names);
+        free(domains);
+        pthread_mutex_unlock(&ndw_reload_lock);
+        return -3;
+    }
+
+    ndw_ReloadCounts_T counts;
+    memset(&counts, 0, sizeof(counts));
+
+    for (INT_T i = 0; i < num_domains; ++i) {
+        ndw_Domain_T* domain = domains[i];
+        ndw_Domain_T* staged = NULL;
+        HASH_FIND(hh_domain_name, staging->g_domains_by_name, domain->domain_name, strlen(domain->domain_name), staged);
+        if (NULL != staged) {
+            ndw_ReloadDomain(domain, staged, &counts);
+            continue;
+        }
+
+        NDW_LOGERR("*** WARNING: Registry reload: %s is not in <%s>; disabling its Connections\n",
+                    domain->debug_desc, json_path);
+        ndw_Connection_T *connection, *tmp;
+        HASH_ITER(hh_connection_id, domain->connections_by_id, connection, tmp) {
+            ndw_ReloadDisableConnection(connection, &counts);
+        }
+    }
+
+    ndw_FreeStagingDomains(staging);
+    free(domain_names);
+    free(domains);
+
+    // Existing Topics keep their handles; added Topics are numbered after them.
+    if ((counts.added_topics > 0) && (0 != ndw_BuildTopicTable()))
+        NDW_LOGERR("*** ERROR: Registry reload: FAILED to rebuild the Topic table; added Topics resolve by name only\n");
+
+    INT_T changes = counts.added_topics + counts.enabled_topics + counts.disabled_topics + counts.topic_options +
+                    counts.added_connections + counts.enabled_connections + counts.disabled_connections +
+                    counts.connection_options;
+
+    NDW_LOGX("Registry reload of <%s>: Topics added<%d> enabled<%d> disabled<%d> options<%d> "
+                "Connections added<%d> enabled<%d> disabled<%d> options<%d> not applied<%d>\n",
+                json_path, counts.added_topics, counts.enabled_topics, counts.disabled_topics, counts.topic_options,
+                counts.added_connections, counts.enabled_connections, counts.disabled_connections,
+                counts.connection_options, counts.not_applied);
+
+    pthread_mutex_unlock(&ndw_reload_lock);
+    return changes;
+} // end method ndw_ReloadRegistry
+
+/*
+ * BEGIN: Watch thread.
+ */
+
+static pthread_t ndw_watch_thread;
+static bool ndw_watch_running = false;
+static bool ndw_watch_stop = false;
+static CHAR_T* ndw_watch_path = NULL;
+static LONG_T ndw_watch_interval_ms = 0;
+
+static bool
+ndw_WatchSameFile(const struct stat* a, const struct stat* b)
+{
+    return (a->st_ino == b->st_ino) && (a->st_size == b->st_size) &&
+            (a->st_mtim.tv_sec == b->st_mtim.tv_sec) && (a->st_mtim.tv_nsec == b->st_mtim.tv_nsec);
+} // end method ndw_WatchSameFile
+
+// Sleep for one interval. Returns false once a stop is requested.
+static bool
+ndw_WatchSleep()
+{
+    LONG_T remaining_ms = ndw_watch_interval_ms;
+    while (remaining_ms > 0) {
+        if (__atomic_load_n(&ndw_watch_stop, __ATOMIC_ACQUIRE))
+            return false;
+
+        LONG_T slice_ms = (remaining_ms < NDW_REGISTRY_WATCH_SLICE_MS) ? remaining_ms : NDW_REGISTRY_WATCH_SLICE_MS;
+        struct timespec ts = { .tv_sec = slice_ms / 1000, .tv_nsec = (slice_ms % 1000) * 1000000L };
+        nanosleep(&ts, NULL);
+        remaining_ms -= slice_ms;
+    }
+
+    return ! __atomic_load_n(&ndw_watch_stop, __ATOMIC_ACQUIRE);
+} // end method ndw_WatchSleep
+
+static void*
+ndw_RegistryWatchThread(void* arg)
+{
+    (void) arg;
+
+    struct stat loaded;     // The file as last reloaded (or when the watch started).
+    struct stat changed;    // The file as first seen changed. Reloaded once it stays so for an interval.
+    bool have_loaded = (0 == stat(ndw_watch_path, &loaded));
+    bool have_changed = false;
+
+    while (ndw_WatchSleep()) {
+        struct stat current;
+        if (0 != stat(ndw_watch_path, &current)) {
+            have_changed = false; // Being replaced, or gone: keep running with the current registry.
+            continue;
+        }
+
+        if (have_loaded && ndw_WatchSameFile(&current, &loaded)) {
+            have_changed = false;
+            continue;
+        }
+
+        if ((! have_changed) || (! ndw_WatchSameFile(&current, &changed))) {
+            changed = current;
+            have_changed = true;
+            continue;
+        }
+
+        loaded = current;
+        have_loaded = true;
+        have_changed = false;
+
+        NDW_LOGX("Registry watch: <%s> changed, reloading\n", ndw_watch_path);
+        ndw_ReloadRegistry(ndw_watch_path);
+    }
+
+    return NULL;
+} // end method ndw_RegistryWatchThread
+
+INT_T
+ndw_StartRegistryWatch(const CHAR_T* json_path, LONG_T interval_ms)
+{
+    if (ndw_watch_running) {
+        NDW_LOGERR("*** WARNING: Registry watch is already running\n");
+        return -1;
+    }
+
+    if (NDW_ISNULLCHARPTR(json_path) || (interval_ms <= 0)) {
+        NDW_LOGERR("*** ERROR: Invalid registry watch path<%s> interval_ms<%ld>\n",
+                    (NULL == json_path) ? "" : json_path, interval_ms);
+        return -2;
+    }
+
+    ndw_watch_path = strdup(json_path);
+    ndw_watch_interval_ms = interval_ms;
+    __atomic_store_n(&ndw_watch_stop, false, __ATOMIC_RELEASE);
+
+    if (0 != pthread_create(&ndw_watch_thread, NULL, ndw_RegistryWatchThread, NULL)) {
+        NDW_LOGERR("*** ERROR: Failed to create registry watch thread\n");
+        free(ndw_watch_path);
+        ndw_watch_path = NULL;
+        return -3;
+    }
+
+    ndw_watch_running = true;
+    NDW_LOGX("Registry watch started: file<%s> interval_ms<%ld>\n", json_path, interval_ms);
+    return 0;
+} // end method ndw_StartRegistryWatch
+
+void
+ndw_StopRegistryWatch()
+{
+    if (! ndw_watch_running)
+        return;
+
+    __atomic_store_n(&ndw_watch_stop, true, __ATOMIC_RELEASE);
+    pthread_join(ndw_watch_thread, NULL);
+
+    free(ndw_watch_path);
+    ndw_watch_path = NULL;
+    ndw_watch_running = false;
+} // end method ndw_StopRegistryWatch
+
+/*
+ * END: Watch thread.
+ */
@@ -5,9 +5,94 @@
 #include "uthash.h"
 
 #include "RegistryData.h"
+#include "NDW_RegistryImage.h"
+#include "NDW_RegistryReload.h"
 
 ndw_DomainHandle_T* domain_handle = NULL; // global Domain Handle. Set once.
 
+extern INT_T ndw_capture_latency;
+
+// Topics are carved out of slabs so that they are contiguous: hot groups of neighbouring Topics stay close, and the
+// stride between Topics is sizeof(ndw_Topic_T) rather than whatever the allocator hands out (which, with the
+// Topic strings allocated in between, can be a power of 2 that maps every Topic to the same few cache sets).
+typedef struct ndw_TopicSlab
+{
+    struct ndw_TopicSlab* next;
+    INT_T used;
+    ndw_Topic_T topics[NDW_TOPIC_SLAB_SIZE];
+} ndw_TopicSlab_T;
+
+static ndw_TopicSlab_T* ndw_topic_slabs = NULL; // Current slab first. Freed by ndw_CleanupRegistry.
+
+// Taken for reading by the lookups below that walk the registry hash tables, and for writing by ndw_ReloadRegistry
+// while it links new Domains, Connections and Topics. Publishing through a Topic pointer or handle never takes it.
+static pthread_rwlock_t ndw_registry_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+// Zeroed Topic with its cold part. Exits on allocation failure.
+// Topics of a staging registry (see ndw_LoadStagingDomains) are allocated one by one, as most are freed again.
+static ndw_Topic_T*
+ndw_AllocateTopic(bool staging)
+{
+    if (staging) {
+        void* memptr = NULL;
+        if ((0 != posix_memalign(&memptr, NDW_TOPIC_CACHE_LINE_SIZE, sizeof(ndw_Topic_T))) || (NULL == memptr)) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to allocate memory for a Topic\n");
+            ndw_exit(EXIT_FAILURE);
+        }
+        memset(memptr, 0, sizeof(ndw_Topic_T));
+        ndw_Topic_T* topic = (ndw_Topic_T*) memptr;
+        if (NULL == (topic->cold = calloc(1, sizeof(ndw_TopicCold_T)))) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to allocate memory for Topic configuration\n");
+            ndw_exit(EXIT_FAILURE);
+        }
+        return topic;
+    }
+
+    if ((NULL == ndw_topic_slabs) || (NDW_TOPIC_SLAB_SIZE == ndw_topic_slabs->used)) {
+        void* memptr = NULL;
+        if ((0 != posix_memalign(&memptr, NDW_TOPIC_CACHE_LINE_SIZE, sizeof(ndw_TopicSlab_T))) || (NULL == memptr)) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to allocate memory for <%d> Topics\n", NDW_TOPIC_SLAB_SIZE);
+            ndw_exit(EXIT_FAILURE);
+        }
+
+        ndw_TopicSlab_T* slab = (ndw_TopicSlab_T*) memptr;
+        memset(slab, 0, sizeof(ndw_TopicSlab_T));
+        slab->next = ndw_topic_slabs;
+        ndw_topic_slabs = slab;
+    }
+
+    ndw_Topic_T* topic = &ndw_topic_slabs->topics[ndw_topic_slabs->used++];
+
+    if (NULL == (topic->cold = calloc(1, sizeof(ndw_TopicCold_T)))) {
+        NDW_LOGERR("*** FATAL ERROR: Failed to allocate memory for Topic configuration\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+
+    return topic;
+} // end method ndw_AllocateTopic
+
+static void
+ndw_FreeTopicSlabs()
+{
+    while (NULL != ndw_topic_slabs) {
+        ndw_TopicSlab_T* next = ndw_topic_slabs->next;
+        free(ndw_topic_slabs);
+        ndw_topic_slabs = next;
+    }
+} // end method ndw_FreeTopicSlabs
+
+void
+ndw_LockRegistryForUpdate()
+{
+    pthread_rwlock_wrlock(&ndw_registry_lock);
+} // end method ndw_LockRegistryForUpdate
+
+void
+ndw_UnlockRegistryForUpdate()
+{
+    pthread_rwlock_unlock(&ndw_registry_lock);
+} // end method ndw_UnlockRegistryForUpdate
+
 INT_T
 ndw_InitializeRegistry()
 {
@@ -18,6 +103,8 @@ ndw_InitializeRegistry()
 INT_T
 ndw_CleanupRegistry()
 {
+    ndw_CleanupTopicTable();
+
     ndw_DomainHandle_T* dh = domain_handle;
     if (NULL != dh) {
         if (NULL != dh->g_domains_by_name) {
@@ -28,6 +115,10 @@ ndw_CleanupRegistry()
         free(dh);
     }
 
+    ndw_FreeTopicSlabs();
+    ndw_FreeRetiredRegistryData();
+    ndw_UnmapRegistryImage(); // Last, registry strings may point into it.
+
     domain_handle = NULL;
 
     return 0;
@@ -106,16 +197,93 @@ ndw_SetConnectionDebugDesc(cJSON* conn_obj, ndw_Connection_T* conn)
     free(id_as_string);
 } // end method ndw_SetConnectionDebugDesc
 
-INT_T
-ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
+ndw_DomainHandle_T*
+ndw_CreateDomainHandle()
 {
     if (NULL != domain_handle) {
-        return -1;  // Already set. This can be called only once!
+        return NULL;  // Already set. This can be called only once!
     }
 
     domain_handle = calloc(1, sizeof(ndw_DomainHandle_T));
     domain_handle->creator_thread_id = pthread_self();
+    return domain_handle;
+} // end method ndw_CreateDomainHandle
+
+ndw_Topic_T*
+ndw_NewTopic(ndw_Domain_T* domain, ndw_Connection_T* conn)
+{
+    bool staging = domain->domain_handle->staging;
+    ndw_Topic_T *topic = ndw_AllocateTopic(staging);
+    topic->domain_handle = domain->domain_handle;
+    topic->domain = domain;
+    topic->connection = conn;
+    topic->stats_index = staging ? -1 : ndw_StatsRegisterTopic();
+    topic->topic_handle = NDW_INVALID_TOPIC_HANDLE;
+
+    if ((ndw_capture_latency > 0) && (! staging)) {
+        topic->latency_histogram = ndw_HistogramCreate();
+        topic->q_async_dwell_histogram = ndw_HistogramCreate();
+    }
+
+    return topic;
+} // end method ndw_NewTopic
 
+void
+ndw_CreateTopicAsyncQueue(ndw_Topic_T* topic)
+{
+    topic->q_async = ndw_CreateInboundDataQueue(topic->cold->q_async_name, topic->q_async_size);
+    if (NULL == topic->q_async) {
+        NDW_LOGERR("*** FATAL ERROR: Failed to create Asynchronous Queue based on Queue Name<%s> for Topic<%s>\n",
+                    topic->cold->q_async_name, topic->topic_unique_name);
+        ndw_exit(EXIT_FAILURE);
+    }
+    topic->q_async_enabled = true;
+} // end method ndw_CreateTopicAsyncQueue
+
+void
+ndw_ConfigureTopicAsyncQueue(ndw_Topic_T* topic)
+{
+    const CHAR_T* wait_spins = ndw_GetNVPairValue(NDW_QWAIT_SPINS, &(topic->cold->topic_options_nvpairs));
+    const CHAR_T* wait_yields = ndw_GetNVPairValue(NDW_QWAIT_YIELDS, &(topic->cold->topic_options_nvpairs));
+    const CHAR_T* wait_block = ndw_GetNVPairValue(NDW_QWAIT_BLOCK, &(topic->cold->topic_options_nvpairs));
+    ndw_QSetWaitStrategy(topic->q_async,
+                NDW_ISNULLCHARPTR(wait_spins) ? -1 : atoi(wait_spins),
+                NDW_ISNULLCHARPTR(wait_yields) ? -1 : atoi(wait_yields),
+                NDW_ISNULLCHARPTR(wait_block) || (0 != strcasecmp("false", wait_block)));
+
+    const CHAR_T* overflow_policy = ndw_GetNVPairValue(NDW_QOVERFLOW_POLICY, &(topic->cold->topic_options_nvpairs));
+    topic->q_async_overflow_policy = NDW_QOVERFLOW_DROP_NEWEST;
+    if (! NDW_ISNULLCHARPTR(overflow_policy)) {
+        if ((topic->q_async_overflow_policy = ndw_QOverflowPolicyFromName(overflow_policy)) < 0) {
+            NDW_LOGERR("*** FATAL ERROR: Invalid %s<%s> for Topic<%s>\n",
+                    NDW_QOVERFLOW_POLICY, overflow_policy, topic->topic_unique_name);
+            ndw_exit(EXIT_FAILURE);
+        }
+    }
+
+    const CHAR_T* block_timeout = ndw_GetNVPairValue(NDW_QOVERFLOW_BLOCK_TIMEOUT_US, &(topic->cold->topic_options_nvpairs));
+    topic->q_async_block_timeout_us = NDW_ISNULLCHARPTR(block_timeout) ?
+                NDW_QOVERFLOW_DEFAULT_BLOCK_TIMEOUT_US : atol(block_timeout);
+
+    if (NDW_QOVERFLOW_SPILL == topic->q_async_overflow_policy) {
+        const CHAR_T* spill_size = ndw_GetNVPairValue(NDW_QOVERFLOW_SPILL_SIZE, &(topic->cold->topic_options_nvpairs));
+        LONG_T spill_items = NDW_ISNULLCHARPTR(spill_size) ? topic->q_async_size : atol(spill_size);
+        if (NULL == (topic->q_async_spill = ndw_CreateQSpill(spill_items))) {
+            NDW_LOGERR("*** FATAL ERROR: Failed to create spill list of <%ld> items for Topic<%s>\n",
+                    spill_items, topic->topic_unique_name);
+            ndw_exit(EXIT_FAILURE);
+        }
+    }
+
+    NDW_LOGX("Topic<%s> asynchronous queue overflow policy<%s> block_timeout_us<%ld>\n",
+            topic->topic_unique_name, ndw_QOverflowPolicyName(topic->q_async_overflow_policy),
+            topic->q_async_block_timeout_us);
+} // end method ndw_ConfigureTopicAsyncQueue
+
+// Parse the Domains of the JSON file into dh. For a staging handle no asynchronous queues are created.
+static INT_T
+ndw_ParseDomains(ndw_DomainHandle_T* dh, const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
+{
     FILE *file = fopen(jsonfilenamepath, "rb");
     if (!file) {
         NDW_LOGERR( "Error opening file: %s\n", jsonfilenamepath);
@@ -169,7 +337,7 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
             if (name_item && strcmp(name_item->valuestring, target_domain_name) == 0)
             {
                 ndw_Domain_T *domain = (ndw_Domain_T *)calloc(1, sizeof(ndw_Domain_T));
-                domain->domain_handle = domain_handle;
+                domain->domain_handle = dh;
                 domain->domain_name = strdup(cJSON_GetObjectItem(domain_obj, "DomainName")->valuestring);
                 domain->domain_id = cJSON_GetObjectItem(domain_obj, "DomainID")->valueint;
                 domain->domain_description = strdup(cJSON_GetObjectItem(domain_obj, "DomainDescription")->valuestring);
@@ -179,8 +347,8 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
                 free(id_as_string);
                 NDW_LOGX("Parsing Domain: %s\n", domain->debug_desc);
 
-                HASH_ADD(hh_domain_id, domain_handle->g_domains_by_id, domain_id, sizeof(INT_T), domain);
-                HASH_ADD_KEYPTR(hh_domain_name, domain_handle->g_domains_by_name, domain->domain_name, strlen(domain->domain_name), domain);
+                HASH_ADD(hh_domain_id, dh->g_domains_by_id, domain_id, sizeof(INT_T), domain);
+                HASH_ADD_KEYPTR(hh_domain_name, dh->g_domains_by_name, domain->domain_name, strlen(domain->domain_name), domain);
 
 
                 cJSON *connections = cJSON_GetObjectItem(domain_obj, "Connections");
@@ -190,7 +358,7 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
                     cJSON_ArrayForEach(conn_obj, connections)
                     {
                         ndw_Connection_T *conn = (ndw_Connection_T *)calloc(1, sizeof(ndw_Connection_T));
-                        conn->domain_handle = domain_handle;
+                        conn->domain_handle = dh;
                         conn->domain = domain;
 
                         cJSON* conn_disabled_obj = cJSON_GetObjectItem(conn_obj, "Disabled");
@@ -229,10 +397,7 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
                             cJSON_ArrayForEach(topic_obj, topics)
                             {
                                 ++num_topics;
-                                ndw_Topic_T *topic = (ndw_Topic_T *)calloc(1, sizeof(ndw_Topic_T));
-                                topic->domain_handle = domain_handle;
-                                topic->domain = domain;
-                                topic->connection = conn;
+                                ndw_Topic_T *topic = ndw_NewTopic(domain, conn);
 
                                 if (conn->disabled) {
                                     topic->disabled = true; // If connection is disabled the Topic is also disabled.
@@ -248,7 +413,7 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
                                     }
                                 }
 
-                                topic->topic_description = strdup(cJSON_GetObjectItem(topic_obj, "TopicDescription")->valuestring);
+                                topic->cold->topic_description = strdup(cJSON_GetObjectItem(topic_obj, "TopicDescription")->valuestring);
                                 topic->topic_unique_id = cJSON_GetObjectItem(topic_obj, "TopicUniqueID")->valueint;
                                 topic->topic_unique_name = strdup(cJSON_GetObjectItem(topic_obj, "TopicUniqueName")->valuestring);
 
@@ -290,36 +455,33 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
                                             ndw_exit(EXIT_FAILURE);
                                         }
 
-                                        topic->q_async_name = strdup(q_name);
-
-                                        topic->q_async = ndw_CreateInboundDataQueue(topic->q_async_name, topic->q_async_size);
-                                        if (NULL == topic->q_async) {
-                                            NDW_LOGERR("*** FATAL ERROR: Failed to create Asynchronous Queue based on Queue Name<%s> for Topic<%s>\n",
-                                                        topic->q_async_name, topic->topic_unique_name);
-                                            ndw_exit(EXIT_FAILURE);
-                                        }
-                                        topic->q_async_enabled = true;
+                                        topic->cold->q_async_name = strdup(q_name);
+                                        if (! dh->staging)
+                                            ndw_CreateTopicAsyncQueue(topic);
                                     }
                                 }
 
                                 topic->debug_desc = ndw_ConcatStrings("Topic<", id_as_string, ", ", topic->topic_unique_name,
                                                     disabled_topic, ", (pk: \"", topic->pub_key,
                                                     "\") (sk: \"", topic->sub_key, "\")> ",
-                                                    "QAsync<", ((NULL == topic->q_async) ? "n" : "Y"), "> ",
+                                                    "QAsync<", (NDW_ISNULLCHARPTR(topic->cold->q_async_name) ? "n" : "Y"), "> ",
                                                     conn->debug_desc, NULL);
                                 free(id_as_string);
                                 NDW_LOGX("Parsing Topic: %s\n", topic->debug_desc);
 
-                                topic->topic_options = ndw_GetJsonItem(topic_obj, "TopicOptions", false);
-                                if ((NULL != topic->topic_options) && ('\0' != *(topic->topic_options))) {
-                                    ndw_ParseNVPairs(topic->topic_options, &(topic->topic_options_nvpairs));
-                                    ndw_PrintNVPairs("Topic Options", &(topic->topic_options_nvpairs));
+                                topic->cold->topic_options = ndw_GetJsonItem(topic_obj, "TopicOptions", false);
+                                if ((NULL != topic->cold->topic_options) && ('\0' != *(topic->cold->topic_options))) {
+                                    ndw_ParseNVPairs(topic->cold->topic_options, &(topic->cold->topic_options_nvpairs));
+                                    ndw_PrintNVPairs("Topic Options", &(topic->cold->topic_options_nvpairs));
                                 }
 
-                                topic->vendor_topic_options = ndw_GetJsonItem(topic_obj, "VendorTopicOptions", false);
-                                if ((NULL != topic->vendor_topic_options) && ('\0' != *(topic->vendor_topic_options))) {
-                                    ndw_ParseNVPairs(topic->vendor_topic_options, &(topic->vendor_topic_options_nvpairs));
-                                    ndw_PrintNVPairs("VENDOR Topic Options", &(topic->vendor_topic_options_nvpairs));
+                                if (NULL != topic->q_async)
+                                    ndw_ConfigureTopicAsyncQueue(topic);
+
+                                topic->cold->vendor_topic_options = ndw_GetJsonItem(topic_obj, "VendorTopicOptions", false);
+                                if ((NULL != topic->cold->vendor_topic_options) && ('\0' != *(topic->cold->vendor_topic_options))) {
+                                    ndw_ParseNVPairs(topic->cold->vendor_topic_options, &(topic->cold->vendor_topic_options_nvpairs));
+                                    ndw_PrintNVPairs("VENDOR Topic Options", &(topic->cold->vendor_topic_options_nvpairs));
                                 }
 
                                 HASH_ADD(hh_topic_id, conn->topics_by_id, topic_unique_id, sizeof(INT_T), topic);
@@ -345,16 +507,87 @@ ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
     } // end for i
 
     cJSON_Delete(root);
+    return 0;
+} // end method ndw_ParseDomains
+
+INT_T
+ndw_LoadDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names)
+{
+    ndw_DomainHandle_T* dh = ndw_CreateDomainHandle();
+    if (NULL == dh) {
+        return -1;  // Already set. This can be called only once!
+    }
+
+    INT_T ret = ndw_ParseDomains(dh, jsonfilenamepath, domain_names);
+    if (0 != ret)
+        return ret;
+
+    if (0 != ndw_BuildTopicTable()) {
+        NDW_LOGERR("*** ERROR: Failed to build the Topic table\n");
+        return -7;
+    }
 
     return 0;
 } // end ndw_LoadDomains
 
+ndw_DomainHandle_T*
+ndw_LoadStagingDomains(const CHAR_T *jsonfilenamepath, CHAR_T **domain_names, INT_T* ret)
+{
+    ndw_DomainHandle_T* dh = calloc(1, sizeof(ndw_DomainHandle_T));
+    if (NULL == dh) {
+        *ret = -3;
+        return NULL;
+    }
+
+    dh->creator_thread_id = pthread_self();
+    dh->staging = true;
+
+    if (0 != (*ret = ndw_ParseDomains(dh, jsonfilenamepath, domain_names))) {
+        ndw_FreeStagingDomains(dh);
+        return NULL;
+    }
+
+    return dh;
+} // end method ndw_LoadStagingDomains
+
+ndw_Topic_T*
+ndw_AdoptStagedTopic(ndw_Domain_T* domain, ndw_Connection_T* conn, ndw_Topic_T* staged)
+{
+    ndw_Topic_T* topic = ndw_NewTopic(domain, conn);
+
+    topic->disabled = staged->disabled;
+    topic->is_pub_enabled = staged->is_pub_enabled;
+    topic->is_sub_enabled = staged->is_sub_enabled;
+    topic->topic_unique_id = staged->topic_unique_id;
+    topic->q_async_size = staged->q_async_size;
+
+    // Take over the strings and configuration; the staged Topic keeps empty ones for ndw_FreeStagingDomains.
+    topic->topic_unique_name = staged->topic_unique_name;
+    topic->pub_key = staged->pub_key;
+    topic->sub_key = staged->sub_key;
+    topic->debug_desc = staged->debug_desc;
+    staged->topic_unique_name = staged->pub_key = staged->sub_key = staged->debug_desc = NULL;
+
+    ndw_TopicCold_T* cold = topic->cold;
+    topic->cold = staged->cold;
+    staged->cold = cold;
+
+    if (! NDW_ISNULLCHARPTR(topic->cold->q_async_name)) {
+        ndw_CreateTopicAsyncQueue(topic);
+        ndw_ConfigureTopicAsyncQueue(topic);
+    }
+
+    return topic;
+} // end method ndw_AdoptStagedTopic
+
 ndw_Domain_T*
 ndw_GetDomainById(INT_T domain_id)
 {
     ndw_DomainHandle_T* dh = ndw_GetDomainHandleInternal();
     ndw_Domain_T* domain = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_domain_id, dh->g_domains_by_id, &domain_id, sizeof(INT_T), domain);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return domain;
 } // ndw_GetDomainById
 
@@ -366,7 +599,9 @@ ndw_GetDomainByName(const CHAR_T* domain_name)
 
     ndw_Domain_T* domain = NULL;
     ndw_DomainHandle_T* dh = ndw_GetDomainHandleInternal();
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_domain_name, dh->g_domains_by_name, domain_name, strlen(domain_name), domain);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return domain;
 }
 
@@ -381,7 +616,9 @@ ndw_GetConnectionByName(const CHAR_T* domain_name, const CHAR_T* connection_name
         return NULL;
 
     ndw_Connection_T* connection = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_connection_name, domain->connections_by_name, connection_name, strlen(connection_name), connection);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return connection;
 } // end method ndw_GetConnectionByName
 
@@ -394,7 +631,9 @@ ndw_GetConnectionByNameFromDomain(ndw_Domain_T* domain, const CHAR_T* connection
     }
 
     ndw_Connection_T* connection = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_connection_name, domain->connections_by_name, connection_name, strlen(connection_name), connection);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return connection;
 }
 
@@ -406,7 +645,9 @@ ndw_GetConnectionByIdFromDomain(ndw_Domain_T* domain, INT_T connection_id)
     }
 
     ndw_Connection_T* connection = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_connection_id, domain->connections_by_id, &connection_id, sizeof(INT_T), connection);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return connection;
 }
 
@@ -418,7 +659,9 @@ ndw_GetTopicByNameFromConnection(ndw_Connection_T* connection, const CHAR_T* top
     }
 
     ndw_Topic_T* topic = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_topic_name, connection->topics_by_name, topic_name, strlen(topic_name), topic);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return topic;
 }
 
@@ -430,7 +673,9 @@ ndw_GetTopicByIdFromConnection(ndw_Connection_T* connection, INT_T topic_id)
     }
 
     ndw_Topic_T* topic = NULL;
+    pthread_rwlock_rdlock(&ndw_registry_lock);
     HASH_FIND(hh_topic_id, connection->topics_by_id, &topic_id, sizeof(INT_T), topic);
+    pthread_rwlock_unlock(&ndw_registry_lock);
     return topic;
 }
 
@@ -443,16 +688,19 @@ ndw_GetAllTopicsFromConnection(ndw_Connection_T* connection, INT_T* total_topics
     INT_T num_topics = 0;
     ndw_Topic_T *curr, *tmp;
 
+    pthread_rwlock_rdlock(&ndw_registry_lock);
+
     // Count the number of topics
     HASH_ITER(hh_topic_name, connection->topics_by_name, curr, tmp) {
         num_topics++;
     }
 
-    if (num_topics == 0) return NULL;
-
     // Allocate array with space for NULL terminator
-    ndw_Topic_T** topics_array = (ndw_Topic_T**)malloc(sizeof(ndw_Topic_T*) * (num_topics + 1));
-    if (!topics_array) return NULL;
+    ndw_Topic_T** topics_array = (num_topics == 0) ? NULL : (ndw_Topic_T**)malloc(sizeof(ndw_Topic_T*) * (num_topics + 1));
+    if (!topics_array) {
+        pthread_rwlock_unlock(&ndw_registry_lock);
+        return NULL;
+    }
 
     // Fill the array
     INT_T index = 0;
@@ -461,6 +709,8 @@ ndw_GetAllTopicsFromConnection(ndw_Connection_T* connection, INT_T* total_topics
     }
     topics_array[index] = NULL; // NULL terminator
 
+    pthread_rwlock_unlock(&ndw_registry_lock);
+
     *total_topics = index;
 
     return topics_array;
@@ -477,16 +727,20 @@ ndw_GetAllConnectionsFromDomain(ndw_Domain_T* domain, INT_T* total_connections)
     INT_T num_connections = 0;
     ndw_Connection_T *curr, *tmp;
 
+    pthread_rwlock_rdlock(&ndw_registry_lock);
+
     // Count number of connections
     HASH_ITER(hh_connection_name, domain->connections_by_name, curr, tmp) {
         num_connections++;
     }
 
-    if (num_connections == 0) return NULL;
-
     // Allocate array with space for NULL terminator
-    ndw_Connection_T** connections_array = (ndw_Connection_T**)malloc(sizeof(ndw_Connection_T*) * (num_connections + 1));
-    if (!connections_array) return NULL;
+    ndw_Connection_T** connections_array = (num_connections == 0) ? NULL :
+                (ndw_Connection_T**)malloc(sizeof(ndw_Connection_T*) * (num_connections + 1));
+    if (!connections_array) {
+        pthread_rwlock_unlock(&ndw_registry_lock);
+        return NULL;
+    }
 
     // Populate array
     INT_T index = 0;
@@ -495,6 +749,8 @@ ndw_GetAllConnectionsFromDomain(ndw_Domain_T* domain, INT_T* total_connections)
     }
     connections_array[index] = NULL; // NULL-terminate
 
+    pthread_rwlock_unlock(&ndw_registry_lock);
+
     *total_connections = index;
 
     return connections_array;
@@ -513,16 +769,19 @@ ndw_GetAllDomains(INT_T* total_domains)
     INT_T count = 0;
     ndw_Domain_T *current, *tmp;
 
+    pthread_rwlock_rdlock(&ndw_registry_lock);
+
     // Count the number of domains
     HASH_ITER(hh_domain_name, dh->g_domains_by_name, current, tmp) {
         count++;
     }
 
-    if (count == 0) return NULL;
-
     // Allocate array of ndw_Domain_T POINTERS (+1 for NULL terminator)
-    ndw_Domain_T **domain_list = malloc((count + 1) * sizeof(ndw_Domain_T*));
-    if (!domain_list) return NULL;
+    ndw_Domain_T **domain_list = (count == 0) ? NULL : malloc((count + 1) * sizeof(ndw_Domain_T*));
+    if (!domain_list) {
+        pthread_rwlock_unlock(&ndw_registry_lock);
+        return NULL;
+    }
 
     // Populate array
     INT_T i = 0;
@@ -531,6 +790,8 @@ ndw_GetAllDomains(INT_T* total_domains)
     }
     domain_list[i] = NULL;
 
+    pthread_rwlock_unlock(&ndw_registry_lock);
+
     *total_domains = i;
 
     return domain_list;
@@ -546,7 +807,7 @@ ndw_PrintTopicJson(ndw_Topic_T *topic, INT_T indent)
     NDW_LOG("%*s\"Topic DISABLED?\": %s,\n", indent + 2, "", topic->disabled ? "TRUE" : "false");
     NDW_LOG("%*s\"TopicUniqueID\": %d,\n", indent + 2, "", topic->topic_unique_id);
     NDW_LOG("%*s\"TopicUniqueName\": \"%s\",\n", indent + 2, "", topic->topic_unique_name);
-    NDW_LOG("%*s\"TopicDescription\": \"%s\"\n", indent + 2, "", topic->topic_description);
+    NDW_LOG("%*s\"TopicDescription\": \"%s\"\n", indent + 2, "", topic->cold->topic_description);
     NDW_LOG("%*s\"NOTE: Connection ID\": %d,\n", indent + 2, "", topic->connection->connection_unique_id);
     NDW_LOG("%*s\"NOTE: Connection Name\": %s,\n", indent + 2, "", topic->connection->connection_unique_name);
     NDW_LOG("%*s\"NOTE: PubKey \": %s,\n", indent + 2, "", topic->pub_key);
@@ -654,6 +915,11 @@ ndw_FreeDomainConnectionTopicNames(CHAR_T** topic_path)
 ndw_Topic_T*
 ndw_GetTopicFromFullPath(const CHAR_T* path)
 {
+    ndw_Topic_T* topic = ndw_GetTopicByHandle(ndw_GetTopicHandle(path));
+    if (NULL != topic)
+        return topic;
+
+    // Not in the Topic table: resolve by names, which also logs what part of the path is wrong.
     INT_T length = 0;
     CHAR_T** dct_list = ndw_GetDomainConnectionTopicNames(path, &length);
     if (3 != length) {
@@ -750,6 +1016,14 @@ ndw_GetDomainConnectionTopicFromPath(const CHAR_T* topic_path, ndw_Domain_T** p_
     if ((NULL == topic_path) || ('\0' == *topic_path))
         return -1;
 
+    ndw_Topic_T* topic = ndw_GetTopicByHandle(ndw_GetTopicHandle(topic_path));
+    if (NULL != topic) {
+        *p_domain = topic->domain;
+        *p_connection = topic->connection;
+        *p_topic = topic;
+        return 0;
+    }
+
     INT_T path_length = 0;
     CHAR_T** domain_connection_topic_names = ndw_GetDomainConnectionTopicNames(topic_path, &path_length);
     if (NULL == domain_connection_topic_names) {
@@ -1020,21 +1294,29 @@ ndw_free_topics(ndw_Topic_T **topics_by_id, ndw_Topic_T **topics_by_name)
     HASH_ITER(hh_topic_id, *topics_by_id, current_topic, tmp) {
         HASH_DELETE(hh_topic_id, *topics_by_id, current_topic);
         HASH_DELETE(hh_topic_name, *topics_by_name, current_topic); // Remove from name hash too
-        free(current_topic->topic_description);
-        free(current_topic->topic_unique_name);
-        free(current_topic->pub_key);
-        free(current_topic->sub_key);
-        free(current_topic->debug_desc);
-        ndw_FreeNVPairs(&(current_topic->topic_options_nvpairs));
-        free(current_topic->topic_options);
-        ndw_FreeNVPairs(&(current_topic->vendor_topic_options_nvpairs));
-        free(current_topic->vendor_topic_options);
-        free(current_topic->q_async_name);
+        ndw_RegistryFree(current_topic->cold->topic_description);
+        ndw_RegistryFree(current_topic->topic_unique_name);
+        ndw_RegistryFree(current_topic->pub_key);
+        ndw_RegistryFree(current_topic->sub_key);
+        ndw_RegistryFree(current_topic->debug_desc);
+        ndw_FreeNVPairs(&(current_topic->cold->topic_options_nvpairs));
+        ndw_RegistryFree(current_topic->cold->topic_options);
+        ndw_FreeNVPairs(&(current_topic->cold->vendor_topic_options_nvpairs));
+        ndw_RegistryFree(current_topic->cold->vendor_topic_options);
+        ndw_RegistryFree(current_topic->cold->q_async_name);
+        // Items still spilled are queue items, so they are released like the ones in q_async.
+        ndw_QSpillCleanup(current_topic->q_async_spill, ndw_QAsync_CleanupOperator);
+        current_topic->q_async_spill = NULL;
         if (NULL != current_topic->q_async) {
             free(current_topic->q_async);
             current_topic->q_async = NULL;
         }
-        free(current_topic); // Only once
+        free(current_topic->q_async_batch_data);
+        ndw_HistogramDestroy(current_topic->latency_histogram);
+        ndw_HistogramDestroy(current_topic->q_async_dwell_histogram);
+        free(current_topic->cold);
+        if (current_topic->domain_handle->staging)
+            free(current_topic); // Else the Topic belongs to a slab.
     }
 } // end method ndw_free_topics
 
@@ -1050,14 +1332,14 @@ ndw_free_connections(ndw_Connection_T **connections_by_id, ndw_Connection_T **co
         // Free nested topics
         ndw_free_topics(&current_conn->topics_by_id, &current_conn->topics_by_name);
 
-        free(current_conn->connection_unique_name);
-        free(current_conn->vendor_name);
-        free(current_conn->vendor_real_version);
-        free(current_conn->connection_url);
-        free(current_conn->connection_comments);
+        ndw_RegistryFree(current_conn->connection_unique_name);
+        ndw_RegistryFree(current_conn->vendor_name);
+        ndw_RegistryFree(current_conn->vendor_real_version);
+        ndw_RegistryFree(current_conn->connection_url);
+        ndw_RegistryFree(current_conn->connection_comments);
         ndw_FreeNVPairs(&(current_conn->vendor_connection_options_nvpairs));
-        free(current_conn->vendor_connection_options);
-        free(current_conn->debug_desc);
+        ndw_RegistryFree(current_conn->vendor_connection_options);
+        ndw_RegistryFree(current_conn->debug_desc);
         free(current_conn); // Only once
     }
 } // end method ndw_free_connections
@@ -1074,9 +1356,9 @@ ndw_free_domains(ndw_Domain_T **domains_by_id, ndw_Domain_T **domains_by_name)
         // Free nested connections
         ndw_free_connections(&current_domain->connections_by_id, &current_domain->connections_by_name);
 
-        free(current_domain->domain_name);
-        free(current_domain->domain_description);
-        free(current_domain->debug_desc);
+        ndw_RegistryFree(current_domain->domain_name);
+        ndw_RegistryFree(current_domain->domain_description);
+        ndw_RegistryFree(current_domain->debug_desc);
         free(current_domain); // Only once
     }
 } // end method ndw_free_domains
@@ -1090,6 +1372,42 @@ ndw_CleanupAllDomainsConnectionsTopics()
     dh->g_domains_by_name = 0;
 } // end method ndw_CleanupAllDomainsConnectionsTopics
 
+void
+ndw_FreeStagingDomains(ndw_DomainHandle_T* dh)
+{
+    if ((NULL == dh) || (! dh->staging))
+        return;
+
+    ndw_free_domains(&dh->g_domains_by_id, &dh->g_domains_by_name);
+    free(dh);
+} // end method ndw_FreeStagingDomains
+
+ndw_Connection_T*
+ndw_AdoptStagedConnection(ndw_Domain_T* domain, ndw_Connection_T* staged)
+{
+    ndw_Domain_T* staged_domain = staged->domain;
+    HASH_DELETE(hh_connection_id, staged_domain->connections_by_id, staged);
+    HASH_DELETE(hh_connection_name, staged_domain->connections_by_name, staged);
+
+    staged->domain = domain;
+    staged->domain_handle = domain->domain_handle;
+
+    ndw_Topic_T* staged_topics_by_id = staged->topics_by_id;
+    ndw_Topic_T* staged_topics_by_name = staged->topics_by_name;
+    staged->topics_by_id = NULL;
+    staged->topics_by_name = NULL;
+
+    ndw_Topic_T *staged_topic, *tmp;
+    HASH_ITER(hh_topic_id, staged_topics_by_id, staged_topic, tmp) {
+        ndw_Topic_T* topic = ndw_AdoptStagedTopic(domain, staged, staged_topic);
+        HASH_ADD(hh_topic_id, staged->topics_by_id, topic_unique_id, sizeof(INT_T), topic);
+        HASH_ADD_KEYPTR(hh_topic_name, staged->topics_by_name, topic->topic_unique_name, strlen(topic->topic_unique_name), topic);
+    }
+
+    ndw_free_topics(&staged_topics_by_id, &staged_topics_by_name);
+    return staged;
+} // end method ndw_AdoptStagedConnection
+
 /*
  * This method will return Connection and Domain POINTERS.
  * If force_exit is set and Connection and Domain POINTERS are NOT found,
@@ -0,0 +1,180 @@
+
+#include "NDW_Stats.h"
+#include "NDW_Utils.h"
+
+#include <string.h>
+
+pthread_key_t ndw_tls_stats_shard;
+static pthread_once_t ndw_tls_stats_shard_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t ndw_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ndw_StatsShard_T* ndw_stats_shards = NULL;  // Head of the list of all shards.
+static INT_T ndw_stats_next_index = 0;
+
+static const CHAR_T* ndw_topic_stats_names[NDW_TOPIC_STATS_COUNTERS] = {
+    "published_msgs",
+    "received_msgs",
+    "bad_msgs_received",
+    "msgs_commits",
+    "msgs_acks",
+    "msgs_failed_acks",
+    "vendor_published_msgs",
+    "vendor_request_replies"
+};
+
+// Thread is exiting. Keep the shard and its counts; the next new thread takes it over.
+static void
+ndw_TLSDestructor_StatsShard(void* ptr)
+{
+    ndw_StatsShard_T* shard = (ndw_StatsShard_T*) ptr;
+    if (NULL != shard)
+        __atomic_store_n(&shard->in_use, false, __ATOMIC_RELEASE);
+} // end method ndw_TLSDestructor_StatsShard
+
+static void
+ndw_tls_stats_shard_Init()
+{
+    if (0 != pthread_key_create(&ndw_tls_stats_shard, ndw_TLSDestructor_StatsShard))
+    {
+        NDW_LOGERR("*** FATAL ERROR: Failed to create ndw_tls_stats_shard!\n");
+        ndw_exit(EXIT_FAILURE);
+    }
+}
+
+void
+ndw_StatsInit()
+{
+    pthread_once(&ndw_tls_stats_shard_once, ndw_tls_stats_shard_Init);
+} // end method ndw_StatsInit
+
+INT_T
+ndw_StatsRegisterTopic()
+{
+    ndw_StatsInit();
+
+    INT_T index = __atomic_fetch_add(&ndw_stats_next_index, 1, __ATOMIC_RELAXED);
+    if (index >= NDW_STATS_MAX_TOPICS) {
+        if (NDW_STATS_MAX_TOPICS == index) // Once, not for every Topic after the limit.
+            NDW_LOGERR("*** WARNING: More than <%d> Topics; statistics are not kept for the rest\n", NDW_STATS_MAX_TOPICS);
+        return -1;
+    }
+
+    return index;
+} // end method ndw_StatsRegisterTopic
+
+static ndw_StatsShard_T*
+ndw_StatsAttachShard()
+{
+    pthread_mutex_lock(&ndw_stats_mutex);
+
+    ndw_StatsShard_T* shard = ndw_stats_shards;
+    for (; NULL != shard; shard = shard->next) {
+        if (! __atomic_load_n(&shard->in_use, __ATOMIC_ACQUIRE))
+            break;
+    }
+
+    if (NULL == shard) {
+        void* memptr = NULL;
+        if ((0 != posix_memalign(&memptr, 64, sizeof(ndw_StatsShard_T))) || (NULL == memptr)) {
+            pthread_mutex_unlock(&ndw_stats_mutex);
+            NDW_LOGERR("Failed to allocate memory for ndw_StatsShard_T\n");
+            return NULL;
+        }
+
+        shard = (ndw_StatsShard_T*) memptr;
+        memset(shard, 0, sizeof(ndw_StatsShard_T));
+        shard->next = ndw_stats_shards;
+        __atomic_store_n(&ndw_stats_shards, shard, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&shard->in_use, true, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ndw_stats_mutex);
+
+    pthread_setspecific(ndw_tls_stats_shard, shard);
+    return shard;
+} // end method ndw_StatsAttachShard
+
+ndw_TopicStatsRow_T*
+ndw_StatsGetChunk(INT_T stats_index)
+{
+    if ((stats_index < 0) || (stats_index >= NDW_STATS_MAX_TOPICS))
+        return NULL;
+
+    ndw_StatsInit();
+
+    ndw_StatsShard_T* shard = (ndw_StatsShard_T*) pthread_getspecific(ndw_tls_stats_shard);
+    if ((NULL == shard) && (NULL == (shard = ndw_StatsAttachShard())))
+        return NULL;
+
+    INT_T chunk_index = stats_index >> NDW_STATS_CHUNK_BITS;
+    ndw_TopicStatsRow_T* chunk = shard->chunks[chunk_index];
+    if (NULL != chunk)
+        return chunk;
+
+    void* memptr = NULL;
+    size_t size = NDW_STATS_CHUNK_TOPICS * sizeof(ndw_TopicStatsRow_T);
+    if ((0 != posix_memalign(&memptr, 64, size)) || (NULL == memptr)) {
+        NDW_LOGERR("Failed to allocate <%zu> bytes for Topic statistics\n", size);
+        return NULL;
+    }
+
+    chunk = (ndw_TopicStatsRow_T*) memptr;
+    memset(chunk, 0, size);
+    __atomic_store_n(&shard->chunks[chunk_index], chunk, __ATOMIC_RELEASE);
+    return chunk;
+} // end method ndw_StatsGetChunk
+
+void
+ndw_TopicStatsSnapshot(INT_T stats_index, ndw_TopicStats_T* stats)
+{
+    if (NULL == stats)
+        return;
+
+    memset(stats, 0, sizeof(ndw_TopicStats_T));
+    if ((stats_index < 0) || (stats_index >= NDW_STATS_MAX_TOPICS))
+        return;
+
+    INT_T chunk_index = stats_index >> NDW_STATS_CHUNK_BITS;
+    INT_T row_index = stats_index & (NDW_STATS_CHUNK_TOPICS - 1);
+
+    ndw_StatsShard_T* shard = __atomic_load_n(&ndw_stats_shards, __ATOMIC_ACQUIRE);
+    for (; NULL != shard; shard = shard->next) {
+        ndw_TopicStatsRow_T* chunk = __atomic_load_n(&shard->chunks[chunk_index], __ATOMIC_ACQUIRE);
+        if (NULL == chunk)
+            continue;
+
+        for (INT_T i = 0; i < NDW_TOPIC_STATS_COUNTERS; i++)
+            stats->counters[i] += __atomic_load_n(&chunk[row_index].counters[i], __ATOMIC_RELAXED);
+    }
+} // end method ndw_TopicStatsSnapshot
+
+LONG_T
+ndw_TopicStatsGet(INT_T stats_index, INT_T counter)
+{
+    if ((counter < 0) || (counter >= NDW_TOPIC_STATS_COUNTERS) ||
+        (stats_index < 0) || (stats_index >= NDW_STATS_MAX_TOPICS))
+        return 0;
+
+    INT_T chunk_index = stats_index >> NDW_STATS_CHUNK_BITS;
+    INT_T row_index = stats_index & (NDW_STATS_CHUNK_TOPICS - 1);
+
+    LONG_T total = 0;
+    ndw_StatsShard_T* shard = __atomic_load_n(&ndw_stats_shards, __ATOMIC_ACQUIRE);
+    for (; NULL != shard; shard = shard->next) {
+        ndw_TopicStatsRow_T* chunk = __atomic_load_n(&shard->chunks[chunk_index], __ATOMIC_ACQUIRE);
+        if (NULL != chunk)
+            total += __atomic_load_n(&chunk[row_index].counters[counter], __ATOMIC_RELAXED);
+    }
+
+    return total;
+} // end method ndw_TopicStatsGet
+
+const CHAR_T*
+ndw_TopicStatsName(INT_T counter)
+{
+    if ((counter < 0) || (counter >= NDW_TOPIC_STATS_COUNTERS))
+        return "unknown";
+
+    return ndw_topic_stats_names[counter];
+} // end method ndw_TopicStatsName
+
@@ -0,0 +1,387 @@
+#include "RegistryData.h"
+
+#include <string.h>
+
+#define NDW_TOPIC_TABLE_MAX_SEED 65536  // Seeds tried per bucket before the slot array is doubled.
+#define NDW_TOPIC_TABLE_MAX_BUILDS 8    // Slot array doublings before giving up.
+
+ndw_TopicTable_T* ndw_g_topic_table = NULL;
+
+typedef struct ndw_TopicTableKey
+{
+    ndw_Topic_T* topic;
+    CHAR_T* path;
+} ndw_TopicTableKey_T;
+
+// FNV-1a folded with the murmur3 finalizer so that both the high (bucket) and low (slot) bits are well mixed.
+static inline ULONG_T
+ndw_TopicTableHash(const CHAR_T* path, size_t length)
+{
+    ULONG_T h = 0xcbf29ce484222325UL;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= (UCHAR_T) path[i];
+        h *= 0x100000001b3UL;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return h;
+} // end method ndw_TopicTableHash
+
+static inline UINT_T
+ndw_TopicTableBucket(const ndw_TopicTable_T* table, ULONG_T h)
+{
+    return ((UINT_T) (h >> 32)) & (table->num_buckets - 1);
+} // end method ndw_TopicTableBucket
+
+static inline UINT_T
+ndw_TopicTableSlot(const ndw_TopicTable_T* table, ULONG_T h, UINT_T seed)
+{
+    ULONG_T x = h ^ (seed * 0x9e3779b97f4a7c15UL);
+    x ^= x >> 31;
+    x *= 0xbf58476d1ce4e5b9UL;
+    x ^= x >> 29;
+    return ((UINT_T) x) & (table->num_slots - 1);
+} // end method ndw_TopicTableSlot
+
+static UINT_T
+ndw_TopicTablePowerOf2(UINT_T n)
+{
+    UINT_T p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+} // end method ndw_TopicTablePowerOf2
+
+static int
+ndw_TopicTableCompareKeys(const void* a, const void* b)
+{
+    return strcmp(((const ndw_TopicTableKey_T*) a)->path, ((const ndw_TopicTableKey_T*) b)->path);
+} // end method ndw_TopicTableCompareKeys
+
+// Topics that already have a handle keep it, in handle order, followed by new Topics in path order.
+static int
+ndw_TopicTableCompareHandles(const void* a, const void* b)
+{
+    const ndw_TopicTableKey_T* key_a = (const ndw_TopicTableKey_T*) a;
+    const ndw_TopicTableKey_T* key_b = (const ndw_TopicTableKey_T*) b;
+    INT_T handle_a = key_a->topic->topic_handle;
+    INT_T handle_b = key_b->topic->topic_handle;
+
+    if ((NDW_INVALID_TOPIC_HANDLE == handle_a) && (NDW_INVALID_TOPIC_HANDLE == handle_b))
+        return strcmp(key_a->path, key_b->path);
+    if (NDW_INVALID_TOPIC_HANDLE == handle_a)
+        return 1;
+    if (NDW_INVALID_TOPIC_HANDLE == handle_b)
+        return -1;
+    return (handle_a > handle_b) - (handle_a < handle_b);
+} // end method ndw_TopicTableCompareHandles
+
+// Bucket with its size, so the placement order can be sorted without state shared between builds.
+typedef struct ndw_TopicTableBucketOrder
+{
+    UINT_T bucket;
+    INT_T size;
+} ndw_TopicTableBucketOrder_T;
+
+static int
+ndw_TopicTableCompareBuckets(const void* a, const void* b)
+{
+    INT_T size_a = ((const ndw_TopicTableBucketOrder_T*) a)->size;
+    INT_T size_b = ((const ndw_TopicTableBucketOrder_T*) b)->size;
+    return (size_b > size_a) - (size_b < size_a); // Largest bucket first.
+} // end method ndw_TopicTableCompareBuckets
+
+/*
+ * Find a seed for each bucket, largest buckets first, that places all its paths in unused slots.
+ * Returns false if some bucket needed more than NDW_TOPIC_TABLE_MAX_SEED tries.
+ */
+static bool
+ndw_TopicTablePlace(ndw_TopicTable_T* table)
+{
+    INT_T n = table->num_topics;
+    UINT_T nb = table->num_buckets;
+
+    INT_T* bucket_sizes = calloc(nb, sizeof(INT_T));
+    INT_T* bucket_start = calloc(nb + 1, sizeof(INT_T));
+    INT_T* bucket_members = malloc(n * sizeof(INT_T));
+    ndw_TopicTableBucketOrder_T* bucket_order = malloc(nb * sizeof(ndw_TopicTableBucketOrder_T));
+    UINT_T* placed = malloc(n * sizeof(UINT_T));
+    bool success = (NULL != bucket_sizes) && (NULL != bucket_start) && (NULL != bucket_members) &&
+                    (NULL != bucket_order) && (NULL != placed);
+
+    if (success) {
+        for (INT_T i = 0; i < n; ++i)
+            ++bucket_sizes[ndw_TopicTableBucket(table, table->entries[i].path_hash)];
+        for (UINT_T b = 0; b < nb; ++b) {
+            bucket_start[b + 1] = bucket_start[b] + bucket_sizes[b];
+            bucket_order[b].bucket = b;
+            bucket_order[b].size = bucket_sizes[b];
+        }
+
+        INT_T* fill = calloc(nb, sizeof(INT_T));
+        if (NULL == fill) {
+            success = false;
+        } else {
+            for (INT_T i = 0; i < n; ++i) {
+                UINT_T b = ndw_TopicTableBucket(table, table->entries[i].path_hash);
+                bucket_members[bucket_start[b] + fill[b]++] = i;
+            }
+            free(fill);
+        }
+    }
+
+    if (success) {
+        qsort(bucket_order, nb, sizeof(ndw_TopicTableBucketOrder_T), ndw_TopicTableCompareBuckets);
+
+        for (UINT_T s = 0; s < table->num_slots; ++s)
+            table->slots[s] = NDW_INVALID_TOPIC_HANDLE;
+        memset(table->seeds, 0, nb * sizeof(UINT_T));
+
+        for (UINT_T k = 0; (k < nb) && success; ++k) {
+            UINT_T b = bucket_order[k].bucket;
+            INT_T size = bucket_sizes[b];
+            if (0 == size)
+                break; // Sorted, so the remaining buckets are empty too.
+
+            INT_T* members = &bucket_members[bucket_start[b]];
+            UINT_T seed = 0;
+            for (; seed < NDW_TOPIC_TABLE_MAX_SEED; ++seed) {
+                INT_T num_placed = 0;
+                for (; num_placed < size; ++num_placed) {
+                    UINT_T s = ndw_TopicTableSlot(table, table->entries[members[num_placed]].path_hash, seed);
+                    if (NDW_INVALID_TOPIC_HANDLE != table->slots[s])
+                        break;
+                    table->slots[s] = members[num_placed];
+                    placed[num_placed] = s;
+                }
+
+                if (num_placed == size)
+                    break;
+
+                for (INT_T j = 0; j < num_placed; ++j)
+                    table->slots[placed[j]] = NDW_INVALID_TOPIC_HANDLE;
+            }
+
+            if (NDW_TOPIC_TABLE_MAX_SEED == seed)
+                success = false;
+            else
+                table->seeds[b] = seed;
+        }
+    }
+
+    free(bucket_sizes);
+    free(bucket_start);
+    free(bucket_members);
+    free(bucket_order);
+    free(placed);
+
+    return success;
+} // end method ndw_TopicTablePlace
+
+static void
+ndw_FreeTopicTable(ndw_TopicTable_T* table)
+{
+    while (NULL != table) {
+        ndw_TopicTable_T* replaced = table->replaced;
+        free(table->entries);
+        free(table->seeds);
+        free(table->slots);
+        free(table->paths);
+        free(table);
+        table = replaced;
+    }
+} // end method ndw_FreeTopicTable
+
+/*
+ * Collect every Topic of the registry with its full path, sorted by path.
+ * Returns the number of Topics, else -1 on memory allocation failure.
+ */
+static INT_T
+ndw_TopicTableCollectKeys(ndw_TopicTableKey_T** p_keys)
+{
+    *p_keys = NULL;
+
+    INT_T num_keys = 0;
+    INT_T capacity = 0;
+    ndw_TopicTableKey_T* keys = NULL;
+    bool success = true;
+
+    INT_T total_domains = 0;
+    ndw_Domain_T** domains = ndw_GetAllDomains(&total_domains);
+    for (INT_T d = 0; (d < total_domains) && success; ++d) {
+        INT_T total_connections = 0;
+        ndw_Connection_T** connections = ndw_GetAllConnectionsFromDomain(domains[d], &total_connections);
+        for (INT_T c = 0; (c < total_connections) && success; ++c) {
+            INT_T total_topics = 0;
+            ndw_Topic_T** topics = ndw_GetAllTopicsFromConnection(connections[c], &total_topics);
+            for (INT_T t = 0; (t < total_topics) && success; ++t) {
+                if (num_keys == capacity) {
+                    capacity = (0 == capacity) ? 64 : (capacity * 2);
+                    ndw_TopicTableKey_T* more = realloc(keys, capacity * sizeof(ndw_TopicTableKey_T));
+                    if (NULL == more) {
+                        success = false;
+                        break;
+                    }
+                    keys = more;
+                }
+
+                keys[num_keys].topic = topics[t];
+                keys[num_keys].path = ndw_ConcatStrings(domains[d]->domain_name, "^",
+                                        connections[c]->connection_unique_name, "^", topics[t]->topic_unique_name, NULL);
+                if (NULL == keys[num_keys].path)
+                    success = false;
+                else
+                    ++num_keys;
+            }
+            free(topics);
+        }
+        free(connections);
+    }
+    free(domains);
+
+    if (! success) {
+        for (INT_T i = 0; i < num_keys; ++i)
+            free(keys[i].path);
+        free(keys);
+        return -1;
+    }
+
+    if (num_keys > 1)
+        qsort(keys, num_keys, sizeof(ndw_TopicTableKey_T), ndw_TopicTableCompareKeys);
+
+    *p_keys = keys;
+    return num_keys;
+} // end method ndw_TopicTableCollectKeys
+
+INT_T
+ndw_BuildTopicTable()
+{
+    ndw_TopicTableKey_T* keys = NULL;
+    INT_T n = ndw_TopicTableCollectKeys(&keys);
+    if (n < 0) {
+        NDW_LOGERR("*** ERROR: Memory allocation failed while collecting Topics for the Topic table\n");
+        return -1;
+    }
+
+    INT_T rc = 0;
+    size_t paths_size = 0;
+    for (INT_T i = 0; i < n; ++i) {
+        if ((i > 0) && (0 == strcmp(keys[i - 1].path, keys[i].path))) {
+            NDW_LOGERR("*** ERROR: Duplicate Topic path <%s>\n", keys[i].path);
+            rc = -2;
+        }
+        paths_size += strlen(keys[i].path) + 1;
+    }
+
+    if ((0 == rc) && (n > 1))
+        qsort(keys, n, sizeof(ndw_TopicTableKey_T), ndw_TopicTableCompareHandles);
+
+    ndw_TopicTable_T* table = NULL;
+    if (0 == rc) {
+        table = calloc(1, sizeof(ndw_TopicTable_T));
+        if (NULL != table) {
+            table->num_topics = n;
+            table->num_buckets = ndw_TopicTablePowerOf2((n / 2) + 1);
+            table->num_slots = ndw_TopicTablePowerOf2(n + (n / 4) + 1);
+            table->entries = calloc((n > 0) ? n : 1, sizeof(ndw_TopicTableEntry_T));
+            table->seeds = calloc(table->num_buckets, sizeof(UINT_T));
+            table->paths = malloc((paths_size > 0) ? paths_size : 1);
+        }
+
+        if ((NULL == table) || (NULL == table->entries) || (NULL == table->seeds) || (NULL == table->paths)) {
+            NDW_LOGERR("*** ERROR: Memory allocation failed for the Topic table of <%d> Topics\n", n);
+            rc = -1;
+        }
+    }
+
+    if (0 == rc) {
+        CHAR_T* p = table->paths;
+        for (INT_T i = 0; i < n; ++i) {
+            ndw_TopicTableEntry_T* entry = &table->entries[i];
+            entry->topic = keys[i].topic;
+            entry->path_length = (INT_T) strlen(keys[i].path);
+            entry->path = p;
+            memcpy(p, keys[i].path, entry->path_length + 1);
+            p += entry->path_length + 1;
+            entry->path_hash = ndw_TopicTableHash(entry->path, entry->path_length);
+        }
+
+        rc = -3;
+        for (INT_T attempt = 0; attempt < NDW_TOPIC_TABLE_MAX_BUILDS; ++attempt) {
+            free(table->slots);
+            if (NULL == (table->slots = malloc(table->num_slots * sizeof(INT_T)))) {
+                NDW_LOGERR("*** ERROR: Memory allocation failed for <%u> Topic table slots\n", table->num_slots);
+                rc = -1;
+                break;
+            }
+
+            if (ndw_TopicTablePlace(table)) {
+                rc = 0;
+                break;
+            }
+
+            table->num_slots *= 2;
+        }
+
+        if (-3 == rc)
+            NDW_LOGERR("*** ERROR: Failed to build the perfect hash for <%d> Topics\n", n);
+    }
+
+    for (INT_T i = 0; i < n; ++i)
+        free(keys[i].path);
+    free(keys);
+
+    if (0 != rc) {
+        ndw_FreeTopicTable(table);
+        return rc;
+    }
+
+    for (INT_T i = 0; i < n; ++i)
+        table->entries[i].topic->topic_handle = i;
+
+    // Readers may still hold the current table, so it is only freed with the new one.
+    table->replaced = ndw_GetTopicTable();
+    __atomic_store_n(&ndw_g_topic_table, table, __ATOMIC_RELEASE);
+
+    NDW_LOGX("Topic table built: Topics<%d> buckets<%u> slots<%u>\n", n, table->num_buckets, table->num_slots);
+    return 0;
+} // end method ndw_BuildTopicTable
+
+void
+ndw_CleanupTopicTable()
+{
+    ndw_TopicTable_T* table = __atomic_exchange_n(&ndw_g_topic_table, NULL, __ATOMIC_ACQ_REL);
+    ndw_FreeTopicTable(table);
+} // end method ndw_CleanupTopicTable
+
+INT_T
+ndw_GetTopicHandle(const CHAR_T* path)
+{
+    ndw_TopicTable_T* table = ndw_GetTopicTable();
+    if ((NULL == table) || (NULL == path) || (0 == table->num_topics))
+        return NDW_INVALID_TOPIC_HANDLE;
+
+    size_t length = strlen(path);
+    ULONG_T h = ndw_TopicTableHash(path, length);
+    UINT_T seed = table->seeds[ndw_TopicTableBucket(table, h)];
+    INT_T handle = table->slots[ndw_TopicTableSlot(table, h, seed)];
+    if (NDW_INVALID_TOPIC_HANDLE == handle)
+        return NDW_INVALID_TOPIC_HANDLE;
+
+    const ndw_TopicTableEntry_T* entry = &table->entries[handle];
+    if ((entry->path_hash != h) || (((size_t) entry->path_length) != length) || (0 != memcmp(entry->path, path, length)))
+        return NDW_INVALID_TOPIC_HANDLE;
+
+    return handle;
+} // end method ndw_GetTopicHandle
+
+INT_T
+ndw_GetTopicCount()
+{
+    ndw_TopicTable_T* table = ndw_GetTopicTable();
+    return (NULL == table) ? 0 : table->num_topics;
+} // end method ndw_GetTopicCount
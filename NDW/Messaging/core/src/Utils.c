@@ -143,8 +143,16 @@ ndw_InitThreadSafeLogger()
     if (NULL == ndw_err_file)
         ndw_err_file = stdout;
 
+    const CHAR_T* log_async = getenv(NDW_LOG_ASYNC);
+    if ((NULL != log_async) && ('\0' != *log_async) && (NDW_LOG_SYNC != atoi(log_async))) {
+        const CHAR_T* buffer_kb = getenv(NDW_LOG_ASYNC_BUFFER_KB);
+        if (0 != ndw_LogAsyncStart(atoi(log_async), ((NULL == buffer_kb) ? 0 : atoi(buffer_kb)))) {
+            NDW_LOGERR("*** WARNING: Invalid %s<%s>; logging is synchronous\n", NDW_LOG_ASYNC, log_async);
+        }
+    }
+
     if (ndw_verbose) {
-        NDW_LOGX("...\n");
+        NDW_LOGX("... log_mode<%d>\n", ndw_log_mode);
     }
 } // end method ndw_InitThreadSafeLogger()
 
@@ -155,6 +163,8 @@ ndw_DestroyThreadSafeLogger()
         NDW_LOGX("...\n");
     }
 
+    ndw_LogAsyncStop();
+
     pthread_mutex_destroy(&ndw_log_mutex);
 } // end method ndw_DestroyThreadSafeLogger()
 
@@ -166,6 +176,13 @@ ndw_print(const CHAR_T* filename, INT_T line_number, const CHAR_T* function_name
     }
 
     va_list args;
+    if (NDW_LOG_SYNC != __atomic_load_n(&ndw_log_mode, __ATOMIC_RELAXED)) {
+        va_start(args, format);
+        ndw_LogAsyncV(stream, filename, line_number, function_name, format, args);
+        va_end(args);
+        return;
+    }
+
     pthread_mutex_lock(&ndw_log_mutex);
     va_start(args, format);
     if (NULL != filename) {
@@ -185,6 +202,13 @@ ndw_fprintf(FILE *stream, const CHAR_T *format, ...)
     }
 
     va_list args;
+    if (NDW_LOG_SYNC != __atomic_load_n(&ndw_log_mode, __ATOMIC_RELAXED)) {
+        va_start(args, format);
+        ndw_LogAsyncV(stream, NULL, -1, NULL, format, args);
+        va_end(args);
+        return;
+    }
+
     pthread_mutex_lock(&ndw_log_mutex);
     va_start(args, format);
     vfprintf(stream, format, args);
@@ -197,6 +221,13 @@ void
 ndw_printf(const CHAR_T *format, ...)
 {
     va_list args;
+    if (NDW_LOG_SYNC != __atomic_load_n(&ndw_log_mode, __ATOMIC_RELAXED)) {
+        va_start(args, format);
+        ndw_LogAsyncV(stdout, NULL, -1, NULL, format, args);
+        va_end(args);
+        return;
+    }
+
     pthread_mutex_lock(&ndw_log_mutex);
     va_start(args, format);
     vfprintf(stdout, format, args);
@@ -263,34 +294,13 @@ ndw_free_string_list(CHAR_T **list)
 ULONG_T
 ndw_GetCurrentNanoSeconds()
 {
-    struct timespec ts;
-     
-    // CLOCK_REALTIME or CLOCK_MONOTONIC (monotonic is preferred for Intervals)
-    if (clock_gettime(CLOCK_REALTIME, &ts) == 0)
-    {
-#if 0
-        NDW_LOG("Seconds: %ld\n", ts.tv_sec);
-        NDW_LOG("Nanoseconds: %ld\n", ts.tv_nsec);
-        NDW_LOG("Current time (ns): %ld\n", ts.tv_sec * 1000000000L + ts.tv_nsec);
-#endif
-    } else {
-        perror("clock_gettime");
-        return 1;
-    }
-
-    return (ULONG_T)ts.tv_sec * 1000000000ULL + (ULONG_T)ts.tv_nsec;
+    return ndw_ClockNowNanos();
 } // end method ndw_GetCurrentNanoSeconds
 
 ULONG_T
 ndw_GetCurrentUTCNanoseconds()
 {
-    struct timespec ts;
-    if (clock_gettime(CLOCK_REALTIME, &ts) != 0) {
-        perror("clock_gettime");
-        return 0; // error case
-    }
-
-    return (ULONG_T)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    return ndw_ClockNowNanos();
 } // end method ndw_GetCurrentUTCNanoseconds
 
 void
@@ -316,108 +326,6 @@ ndw_PrintTimeFromNanos(ULONG_T nanos)
 } // end method ndw_PrintTimeFromNanos
 
 
-static const size_t NUM_MICROSECONDS = 1000;
-static const size_t NUM_MILLISECONDS = 1000;
-static const size_t NUM_SECONDS = 60;
-
-void
-ndw_AddToLatencyTimeBucket(ndw_LatencyBuckets_T* buckets, ULONG_T delta_ns)
-{
-    buckets->counter += 1;
-
-    if (delta_ns < 1000) {
-        buckets->submicro_underflow += 1;
-        return;
-    }
-
-    if (delta_ns < 1000000ULL) {
-        size_t index = delta_ns / 1000;  // microseconds bucket (0-999)
-        if (index < NUM_MICROSECONDS) {
-            buckets->microseconds[index]++;
-        }
-    } else if (delta_ns < 1000000000ULL) {
-        size_t index = delta_ns / 1000000;  // milliseconds bucket (0-999)
-        if (index < NUM_MILLISECONDS) {
-            buckets->milliseconds[index]++;
-        }
-    } else if (delta_ns < 60000000000ULL) {
-        size_t index = delta_ns / 1000000000;  // seconds bucket (0-59)
-        if (index < NUM_SECONDS) {
-            buckets->seconds[index]++;
-        }
-    } else {
-        buckets->seconds_overflow++;
-    }
-} // end method ndw_AddToLatencyTimeBucket
-
-static long
-ndw_PercentileLookup(const long *counts, size_t size, double percentile)
-{
-    long total = 0;
-    for (size_t i = 0; i < size; i++) {
-        total += counts[i];
-    }
-    if (total == 0) {
-        return -1;
-    }
-    long threshold = (long)(total * percentile + 0.5); // round to nearest
-    if (threshold == 0) threshold = 1;
-
-    long cum = 0;
-    for (size_t i = 0; i < size; i++) {
-        cum += counts[i];
-        if (cum >= threshold) {
-            return (long)i;
-        }
-    }
-    return (long)(size - 1);
-} // end method ndw_PercentileLookup
-
-void
-ndw_PrintLatencyBuckets(const ndw_LatencyBuckets_T* buckets)
-{
-    const double percentiles[] = {0.0, 0.25, 0.5, 0.75, 0.80, 0.90, 1.0};
-    const CHAR_T* labels[] = {"P0", "P25", "P50", "P75", "P80", "P90", "P100"};
-    const size_t n = sizeof(percentiles) / sizeof(percentiles[0]);
-
-    NDW_LOG("Sub-micro Underflow: %ld\n", buckets->seconds_overflow); // Overflow
-
-    // Microseconds
-    NDW_LOG("Microseconds: ");
-    for (size_t i = 0; i < n; i++) {
-        long slot = ndw_PercentileLookup(buckets->microseconds, NUM_MICROSECONDS, percentiles[i]);
-        if (slot >= 0)
-            NDW_LOG("%s<%ld> ", labels[i], slot);
-        else
-            NDW_LOG("%s<-> ", labels[i]);  // no data
-    }
-    NDW_LOG("\n");
-
-    // Milliseconds
-    NDW_LOG("Milliseconds: ");
-    for (size_t i = 0; i < n; i++) {
-        long slot = ndw_PercentileLookup(buckets->milliseconds, NUM_MILLISECONDS, percentiles[i]);
-        if (slot >= 0)
-            NDW_LOG("%s<%ld> ", labels[i], slot);
-        else
-            NDW_LOG("%s<-> ", labels[i]);
-    }
-    NDW_LOG("\n");
-
-    // Seconds
-    NDW_LOG("Seconds: ");
-    for (size_t i = 0; i < n; i++) {
-        long slot = ndw_PercentileLookup(buckets->seconds, NUM_SECONDS, percentiles[i]);
-        if (slot >= 0)
-            NDW_LOG("%s<%ld> ", labels[i], slot);
-        else
-            NDW_LOG("%s<-> ", labels[i]);
-    }
-    NDW_LOG("\n");
-
-    NDW_LOG("Seconds Overflow: %ld\n", buckets->seconds_overflow); // Overflow
-} // end method ndw_PrintLatencyBuckets
-
 bool
 ndw_atol(const CHAR_T* str, long* value)
 {
@@ -879,6 +787,8 @@ ndw_CounterCheck(ndw_Counter_T* counter, long check_value, long long sleep_durat
 // For Debug binary with DEBUG defined, call abort to get backtrace and dump
 void ndw_exit(int status)
 {
+    ndw_LogAsyncFlush(); // So the fatal error logged just before is not lost.
+
 #if defined(DEBUG)
     abort();
 #else
@@ -215,9 +215,9 @@ func setCommitCounters(topic *C.ndw_Topic_T) {
 	if topic != nil {
 		aTopic := (*AppTopic)(unsafe.Pointer(topic.app_opaque))
 		if aTopic != nil {
-			aTopic.MsgsCommitCount = int64(topic.msgs_commit_count)
-			aTopic.MsgsAckCount = int64(topic.msgs_ack_count)
-			aTopic.MsgsFailedAckCount = int64(topic.msgs_failed_ack_count)
+			aTopic.MsgsCommitCount = int64(C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_MSGS_COMMITS))
+			aTopic.MsgsAckCount = int64(C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_MSGS_ACKS))
+			aTopic.MsgsFailedAckCount = int64(C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_MSGS_FAILED_ACKS))
 		}
 	}
 }
@@ -503,10 +503,10 @@ func ndwHandleAsyncMessage(topic *C.ndw_Topic_T, opaque unsafe.Pointer) C.int {
 	var queuedMsgs C.uint64_t
 	C.ndw_GetQueuedMsgCount(topic, &queuedMsgs)
 
-	if topic.total_received_msgs%printFrequencyModulo == 0 {
+	if C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_RECEIVED_MSGS)%printFrequencyModulo == 0 {
 		fmt.Fprintf(os.Stderr, "<<<Received ASYNC Message: TopicId<%d, %s> num_async_msgs<%d> topic->total_received_msgs<%d> queued_msgs<%d> msg_size<%d> msg<%s>\n",
 			int(topic.topic_unique_id), C.GoString(topic.topic_unique_name), numAsyncMsgs,
-			int(topic.total_received_msgs), uint64(queuedMsgs), msgSize, C.GoString(msg))
+			int(C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_RECEIVED_MSGS)), uint64(queuedMsgs), msgSize, C.GoString(msg))
 	}
 
 	if aTopic.FunctionCommitData.Function == nil {
@@ -711,9 +711,9 @@ func threadSubscriberPoll(arg unsafe.Pointer) unsafe.Pointer {
 				msg := C.GoString((*C.char)(unsafe.Pointer(topic.last_msg_received)))
 				msgSize := int(topic.last_msg_received_size)
 
-				if topic.total_received_msgs%printFrequencyModulo == 0 {
+				if C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_RECEIVED_MSGS)%printFrequencyModulo == 0 {
 					logX("<<< Received POLL Message: [%s, %d] msg<%s> msg_size<%d> ON %s\n",
-						&aTopic.TopicName, topic.total_received_msgs, msg, msgSize, C.GoString(topic.debug_desc))
+						&aTopic.TopicName, C.ndw_TopicStatsGet(topic.stats_index, C.NDW_TOPIC_STAT_RECEIVED_MSGS), msg, msgSize, C.GoString(topic.debug_desc))
 				}
 
 				commitCode := aTopic.FunctionCommitData.Function(topic)
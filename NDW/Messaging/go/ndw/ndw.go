@@ -6,6 +6,7 @@ package ndw
 #include "RegistryData.h"
 #include "MsgHeaders.h"
 #include "MsgHeader_1.h"
+#include "MsgHeader_2.h"
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -93,6 +94,7 @@ type NDW_TopicData struct {
     DomainPtr     *C.ndw_Domain_T
     ConnectionPtr *C.ndw_Connection_T
     TopicPtr      *C.ndw_Topic_T
+    TopicHandle   int32 // Handle in the C Topic table, see NDW_GetTopicByHandle.
 }
 
 var TopicList []NDW_TopicData
@@ -126,6 +128,7 @@ func ndwGoMessageHandler(topic *C.ndw_Topic_T) {
     IncrementTotalMsgsReceived()
 
     msg := NDW_BuildReceivedMsg(unsafe.Pointer(topic))
+    msg.Sequence = topicData.TotalMsgsReceived
 
     //NDW_LOG("ndwGoMessageHandler: Topic = %s, MsgSize = %d TotalMsgsReceived = %d\n", topicData.TopicName, msg.MsgSize, topicData.TotalMsgsReceived)
 
@@ -342,6 +345,7 @@ func NDW_SynchronousPollForMsg(topic_data *NDW_TopicData, timeout_us int64, drop
 
     if ret == 1 {
         // One message obtained.
+        topic_data.TotalMsgsReceived += 1
         IncrementTotalMsgsReceived()
         return int32(ret)
     } else if ret == 0 {
@@ -365,6 +369,7 @@ func NDW_PollAsyncQeueue(topic_data *NDW_TopicData, timeout_us int64) int32 {
 
     if ret == 1 {
         // One message obtained.
+        topic_data.TotalMsgsReceived += 1
         IncrementTotalMsgsReceived()
         return int32(ret)
     } else if ret == 0 {
@@ -455,6 +460,7 @@ func NDW_GetLastReceivedMsg(topic_data *NDW_TopicData) *NDW_ReceivedMsg {
     }
 
     msg := NDW_BuildReceivedMsg(unsafe.Pointer(topic_data.TopicPtr))
+    msg.Sequence = topic_data.TotalMsgsReceived
     return msg
 }
 
@@ -464,9 +470,9 @@ func NDW_GetMsgCommitAckCounters(topic_data *NDW_TopicData, commit_counter *int6
         return
     }
 
-    *commit_counter = int64(topic_data.TopicPtr.msgs_commit_count)
-    *ack_counter = int64(topic_data.TopicPtr.msgs_ack_count)
-    *failed_ack_counter = int64(topic_data.TopicPtr.msgs_failed_ack_count)
+    *commit_counter = int64(C.ndw_TopicStatsGet(topic_data.TopicPtr.stats_index, C.NDW_TOPIC_STAT_MSGS_COMMITS))
+    *ack_counter = int64(C.ndw_TopicStatsGet(topic_data.TopicPtr.stats_index, C.NDW_TOPIC_STAT_MSGS_ACKS))
+    *failed_ack_counter = int64(C.ndw_TopicStatsGet(topic_data.TopicPtr.stats_index, C.NDW_TOPIC_STAT_MSGS_FAILED_ACKS))
 }
 
 func NDW_SetTopicSequenceNumber(topic_data *NDW_TopicData, sequence_number int64) {
@@ -573,12 +579,38 @@ func getTopicByName(conn *C.ndw_Connection_T, topicName string) *C.ndw_Topic_T {
 }
 
 
+// Resolve a Domain^Connection^Topic path with the C Topic table. Returns -1 if not found.
+func NDW_GetTopicHandle(path string) int32 {
+    cPath := C.CString(path)
+    defer C.free(unsafe.Pointer(cPath))
+    return int32(C.ndw_GetTopicHandle(cPath))
+}
+
+// Returns nil if the handle is not valid.
+func NDW_GetTopicByHandle(handle int32) *C.ndw_Topic_T {
+    return C.ndw_GetTopicByHandle(C.INT_T(handle))
+}
+
 func getTopicFromPath(path string) *NDW_TopicData {
     if path == "" {
         NDW_LOGERR("nil for path: %s\n", path)
         return nil;
     }
 
+    handle := NDW_GetTopicHandle(path)
+    if topic_ptr := NDW_GetTopicByHandle(handle); topic_ptr != nil {
+        return &NDW_TopicData {
+            DomainName:     C.GoString(topic_ptr.domain.domain_name),
+            ConnectionName: C.GoString(topic_ptr.connection.connection_unique_name),
+            TopicName:      C.GoString(topic_ptr.topic_unique_name),
+
+            DomainPtr:      topic_ptr.domain,
+            ConnectionPtr:  topic_ptr.connection,
+            TopicPtr:       topic_ptr,
+            TopicHandle:    handle,
+        }
+    }
+
     tokens, num_tokens := SplitStringToTokens(path, "^")
     if num_tokens != 3 {
         NDW_LOGERR("Invalid argument: path: %s\n", path)
@@ -634,7 +666,7 @@ func getTopicFromPath(path string) *NDW_TopicData {
         DomainPtr:      domain_ptr,
         ConnectionPtr:  connection_ptr,
         TopicPtr:       topic_ptr,
-         
+        TopicHandle:    int32(topic_ptr.topic_handle),
     }
 }
 
@@ -648,22 +680,30 @@ func PopulateTopicData() int {
         topic.TotalMsgsPublished = 0
         topic.TotalMsgsReceived = 0
 
-        topic.DomainPtr = getDomainByName(topic.DomainName)
-        if topic.DomainPtr == nil {
-            NDW_LOGERR("*** ERROR: TopicConfig[%d]: domain lookup failed for '%s'\n", i, topic.DomainName)
-            return -1
-        }
+        // Resolve once through the Topic table. Fall back to the name lookups, which report what is missing.
+        topic.TopicHandle = NDW_GetTopicHandle(topic.DomainName + "^" + topic.ConnectionName + "^" + topic.TopicName)
+        topic.TopicPtr = NDW_GetTopicByHandle(topic.TopicHandle)
+        if topic.TopicPtr != nil {
+            topic.DomainPtr = topic.TopicPtr.domain
+            topic.ConnectionPtr = topic.TopicPtr.connection
+        } else {
+            topic.DomainPtr = getDomainByName(topic.DomainName)
+            if topic.DomainPtr == nil {
+                NDW_LOGERR("*** ERROR: TopicConfig[%d]: domain lookup failed for '%s'\n", i, topic.DomainName)
+                return -1
+            }
 
-        topic.ConnectionPtr = getConnectionByName(topic.DomainPtr, topic.ConnectionName)
-        if topic.ConnectionPtr == nil {
-            NDW_LOGERR("*** ERROR: TopicConfig[%d]: connection lookup failed for '%s'\n", i, topic.ConnectionName)
-            return -1
-        }
+            topic.ConnectionPtr = getConnectionByName(topic.DomainPtr, topic.ConnectionName)
+            if topic.ConnectionPtr == nil {
+                NDW_LOGERR("*** ERROR: TopicConfig[%d]: connection lookup failed for '%s'\n", i, topic.ConnectionName)
+                return -1
+            }
 
-        topic.TopicPtr = getTopicByName(topic.ConnectionPtr, topic.TopicName)
-        if topic.TopicPtr == nil {
-            NDW_LOGERR("*** ERROR: TopicConfig[%d]: topic lookup failed for '%s'\n", i, topic.TopicName)
-            return -1
+            topic.TopicPtr = getTopicByName(topic.ConnectionPtr, topic.TopicName)
+            if topic.TopicPtr == nil {
+                NDW_LOGERR("*** ERROR: TopicConfig[%d]: topic lookup failed for '%s'\n", i, topic.TopicName)
+                return -1
+            }
         }
 
         //topic.ToString = topic.DomainName + "^" + topic.ConnectionName + "^" + topic.TopicName
@@ -699,6 +739,8 @@ type NDW_ReceivedMsg struct {
     Timestamp     string
 }
 
+// Sequence is left for the caller to set from NDW_TopicData.TotalMsgsReceived; the C counters are summed over
+// all thread shards, so they are read on demand (NDW_GetMsgCommitAckCounters) and not for every message.
 func NDW_BuildReceivedMsg(topic_ptr unsafe.Pointer) *NDW_ReceivedMsg {
     topic := (*C.ndw_Topic_T)(topic_ptr)
 
@@ -732,7 +774,6 @@ func NDW_BuildReceivedMsg(topic_ptr unsafe.Pointer) *NDW_ReceivedMsg {
         TopicPtr:      topic,
         TopicID:       topicID,
         TopicName:     topicName,
-        Sequence:      int64(topic.total_received_msgs),
         MsgBody:       msg,
         MsgSize:       msgSize,
         Header:        hdr,
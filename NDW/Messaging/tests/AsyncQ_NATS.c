@@ -218,7 +218,7 @@ ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
     NDW_LOGX("<<<ASYNC<<< Received Message: TopicId<%d, %s> num_async_msgs<%ld> "
             "total_received_msgs<%ld> queued_msgs<%" PRIu64 "> msg_size<%d> msg<%s>\n",
             topic->topic_unique_id, topic->topic_unique_name, num_async_msgs,
-            topic->total_received_msgs, queued_msgs,
+            ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS), queued_msgs,
             msg_size, ((NULL == msg) ? "*** NULL! ***" : msg));
     }
 
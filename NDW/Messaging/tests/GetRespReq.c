@@ -85,9 +85,9 @@ static void set_commit_counters(ndw_Topic_T* topic)
     if (NULL != topic) {
         AppTopic_T* a_topic = (AppTopic_T*) topic->app_opaque;
         if (NULL != a_topic) {
-            a_topic->msgs_commit_count = topic->msgs_commit_count;
-            a_topic->msgs_ack_count = topic->msgs_ack_count;
-            a_topic->msgs_failed_ack_count = topic->msgs_failed_ack_count;
+            a_topic->msgs_commit_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_COMMITS);
+            a_topic->msgs_ack_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_ACKS);
+            a_topic->msgs_failed_ack_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_FAILED_ACKS);
         }
     }
 }
@@ -473,11 +473,11 @@ ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
         return -101;
     }
 
-    if (0 == (topic->total_received_msgs % print_frequency_modulo)) {
+    if (0 == (ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS) % print_frequency_modulo)) {
         NDW_LOGX("<<<Received ASYNC Message: TopicId<%d, %s> num_async_msgs<%ld> "
             "topic->total_received_msgs<%ld> queued_msgs<%" PRIu64 "> msg_size<%d> msg<%s>\n",
             topic->topic_unique_id, topic->topic_unique_name, num_async_msgs,
-            topic->total_received_msgs, queued_msgs,
+            ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS), queued_msgs,
             msg_size, ((NULL == msg) ? "*** NULL! ***" : msg));
     }
 
@@ -195,7 +195,7 @@ poll_for_messages()
 
             char* msg = (char*) topic->last_msg_received;
             int msg_size = topic->last_msg_received_size;
-            long total_topic_msgs = topic->total_received_msgs;
+            long total_topic_msgs = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS);
 
             if ((NULL == msg) || (msg_size < 4)) {
                 NDW_LOGERR("*** ERROR: Invalid msg_size: %d for %s\n", msg_size, topic->debug_desc);
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "NDW_Essentials.h"
+#include "NDW_RegistryReload.h"
+
+/*
+ * Rejection of two asynchronous JetStream Topics publishing on the same PubKey over one connection.
+ * Asynchronous publish acks only carry the subject, so the acks could not be told apart.
+ *
+ * Checks that:
+ *  - ndw_Init fails when the registry has two such Topics (JSPubKey_Duplicate.JSON),
+ *  - a registry reload adding such a Topic to a running process skips it, keeps running,
+ *    and still adds a Topic on another PubKey.
+ * Nothing connects, so no messaging server is needed.
+ *
+ * Usage: JSPubKey.out [registry] [duplicate_registry]
+ */
+
+#define TOPIC_PAYMENTS "DomainA^NATSConnPayments^ACME.Payments"
+#define TOPIC_PAYMENTS_COPY "DomainA^NATSConnPayments^ACME.PaymentsCopy"
+#define TOPIC_REFUNDS "DomainA^NATSConnPayments^ACME.Refunds"
+
+static int
+test_init_rejects(const char* duplicate_registry)
+{
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+
+    if (0 == pid) {
+        setenv(NDW_APP_CONFIG_FILE, duplicate_registry, 1);
+        if (0 != ndw_Init())
+            _exit(2);
+        _exit(0); // ndw_Init accepted the duplicate PubKey.
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    bool rejected = WIFSIGNALED(status) || (WIFEXITED(status) && (0 != WEXITSTATUS(status)));
+    printf("init with a duplicate PubKey: %s\n", rejected ? "rejected OK" : "accepted FAILED");
+    return rejected ? 0 : 1;
+} // end method test_init_rejects
+
+static int
+test_reload_skips(const char* registry, const char* duplicate_registry)
+{
+    setenv(NDW_APP_CONFIG_FILE, registry, 1);
+    if (0 != ndw_Init()) {
+        fprintf(stderr, "*** FAILED: ndw_Init() with <%s>\n", registry);
+        return 1;
+    }
+
+    INT_T changes = ndw_ReloadRegistry(duplicate_registry);
+
+    ndw_Topic_T* payments = ndw_GetTopicFromFullPath(TOPIC_PAYMENTS);
+    ndw_Topic_T* copy = ndw_GetTopicFromFullPath(TOPIC_PAYMENTS_COPY);
+    ndw_Topic_T* refunds = ndw_GetTopicFromFullPath(TOPIC_REFUNDS);
+
+    int failed = 0;
+    if ((NULL == payments) || payments->disabled) {
+        fprintf(stderr, "*** FAILED: %s is missing or disabled after the reload\n", TOPIC_PAYMENTS);
+        failed = 1;
+    }
+
+    if (NULL != copy) {
+        fprintf(stderr, "*** FAILED: reload added %s on a PubKey already in use\n", TOPIC_PAYMENTS_COPY);
+        failed = 1;
+    }
+
+    if ((NULL == refunds) || (1 != changes)) {
+        fprintf(stderr, "*** FAILED: reload made <%d> changes, expected only %s to be added\n", changes, TOPIC_REFUNDS);
+        failed = 1;
+    }
+
+    printf("reload with a duplicate PubKey: changes<%d> %s\n", changes, failed ? "FAILED" : "skipped OK");
+
+    ndw_Shutdown();
+    return failed;
+} // end method test_reload_skips
+
+int main(int argc, char** argv)
+{
+    const char* registry = (argc > 1) ? argv[1] : "./JSPubKey_Registry.JSON";
+    const char* duplicate_registry = (argc > 2) ? argv[2] : "./JSPubKey_Duplicate.JSON";
+
+    setenv(NDW_APP_DOMAINS, "DomainA", 0);
+    setenv(NDW_APP_ID, "777", 0);
+
+    int failed = test_init_rejects(duplicate_registry);
+    failed |= test_reload_skips(registry, duplicate_registry);
+
+    return failed;
+} /* end method main */
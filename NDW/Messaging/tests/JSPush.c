@@ -37,7 +37,7 @@ int ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
 {
     char* msg = (char*) topic->last_msg_received;
     int msg_size = topic->last_msg_received_size;
-    int total_received_msgs = topic->total_received_msgs;
+    int total_received_msgs = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS);
     if (0 == (total_received_msgs % print_frequency)) {
         NDW_LOGX("<<< RECEIVED MSG<%s>: msg_size<%d> msg<%s> total_received_msgs<%ld> "
                 "IPAddr<%s> DurableAcKSequence<%lu> DurableAckGlobalSequence<%lu> "
@@ -45,7 +45,7 @@ int ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
                 " ON %s\n",
                 topic->topic_unique_name, msg_size,
                 ((NULL == msg) ? "*** NULL! ***" : msg),
-                topic->total_received_msgs,
+                ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS),
                 topic->last_received_ip_address,
                 topic->last_received_durable_ack_sequence,
                 topic->last_received_durable_ack_global_sequence,
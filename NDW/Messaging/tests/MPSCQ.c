@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "MPSCQ.h"
+
+/*
+ * Stress test of the bounded MPSC queue (ndw_MPSCQ_T).
+ *
+ * Checks that:
+ *  - an undrained queue accepts exactly its capacity and then returns NDW_MPSCQ_FULL,
+ *  - with many producers racing on a small queue every item is delivered exactly once
+ *    and in order per producer, with producers retrying on NDW_MPSCQ_FULL.
+ * No messaging server is needed.
+ *
+ * Usage: MPSCQ.out [producers] [items_per_producer] [queue_size]
+ */
+
+typedef struct Producer
+{
+    pthread_t thread;
+    ndw_MPSCQ_T* queue;
+    long id;
+    long items;
+    long* values;           // values[i] = (id * items) + i, inserted in order.
+    long full_retries;
+} Producer_T;
+
+static void*
+producer_main(void* arg)
+{
+    Producer_T* p = (Producer_T*) arg;
+    for (long i = 0; i < p->items; ++i) {
+        INT_T rc;
+        while (NDW_MPSCQ_FULL == (rc = ndw_mpscq_insert(p->queue, &p->values[i]))) {
+            ++p->full_retries;
+            sched_yield();
+        }
+
+        if (NDW_MPSCQ_OK != rc) {
+            fprintf(stderr, "*** FAILED: producer<%ld> insert returned <%d>\n", p->id, rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return NULL;
+} /* end method producer_main */
+
+static int
+test_full(long queue_size)
+{
+    ndw_MPSCQ_T* queue = ndw_CreateMPSCQueue(queue_size);
+    if (NULL == queue) {
+        fprintf(stderr, "*** FAILED: cannot create queue of size <%ld>\n", queue_size);
+        return 1;
+    }
+
+    long item = 1;
+    ULONG_T accepted = 0;
+    while (NDW_MPSCQ_OK == ndw_mpscq_insert(queue, &item))
+        ++accepted;
+
+    int failed = 0;
+    if (accepted != queue->capacity) {
+        fprintf(stderr, "*** FAILED: accepted <%lu> items, capacity is <%lu>\n", accepted, queue->capacity);
+        failed = 1;
+    }
+
+    if ((1 != atomic_load(&queue->producer_full_count)) || ((LONG_T) queue->capacity != ndw_mpscq_size(queue))) {
+        fprintf(stderr, "*** FAILED: full count <%ld> size <%ld> after filling the queue\n",
+                atomic_load(&queue->producer_full_count), ndw_mpscq_size(queue));
+        failed = 1;
+    }
+
+    // One get frees exactly one slot.
+    if ((NULL == ndw_mpscq_get(queue, 0)) || (NDW_MPSCQ_OK != ndw_mpscq_insert(queue, &item)) ||
+        (NDW_MPSCQ_FULL != ndw_mpscq_insert(queue, &item))) {
+        fprintf(stderr, "*** FAILED: queue did not accept exactly one item after a get\n");
+        failed = 1;
+    }
+
+    printf("full: capacity<%lu> accepted<%lu> %s\n", queue->capacity, accepted, failed ? "FAILED" : "OK");
+
+    ndw_mpscq_cleanup(queue);
+    free(queue);
+    return failed;
+} /* end method test_full */
+
+static int
+test_producers(long num_producers, long items, long queue_size)
+{
+    ndw_MPSCQ_T* queue = ndw_CreateMPSCQueue(queue_size);
+    Producer_T* producers = calloc(num_producers, sizeof(Producer_T));
+    long* next_expected = calloc(num_producers, sizeof(long));
+    if ((NULL == queue) || (NULL == producers) || (NULL == next_expected)) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (long p = 0; p < num_producers; ++p) {
+        producers[p].queue = queue;
+        producers[p].id = p;
+        producers[p].items = items;
+        producers[p].values = malloc(items * sizeof(long));
+        if (NULL == producers[p].values) {
+            fprintf(stderr, "Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        for (long i = 0; i < items; ++i)
+            producers[p].values[i] = (p * items) + i;
+    }
+
+    for (long p = 0; p < num_producers; ++p)
+        pthread_create(&producers[p].thread, NULL, producer_main, &producers[p]);
+
+    int failed = 0;
+    long total = num_producers * items;
+    for (long received = 0; received < total; ) {
+        long* value = (long*) ndw_mpscq_get(queue, 100);
+        if (NULL == value)
+            continue;
+
+        long p = *value / items;
+        if ((p < 0) || (p >= num_producers) || ((*value % items) != next_expected[p])) {
+            fprintf(stderr, "*** FAILED: unexpected value <%ld>\n", *value);
+            failed = 1;
+            break;
+        }
+
+        ++next_expected[p];
+        ++received;
+    }
+
+    long full_retries = 0;
+    for (long p = 0; p < num_producers; ++p) {
+        pthread_join(producers[p].thread, NULL);
+        full_retries += producers[p].full_retries;
+        free(producers[p].values);
+    }
+
+    if ((! failed) && (0 != ndw_mpscq_size(queue))) {
+        fprintf(stderr, "*** FAILED: <%ld> items left in the queue\n", ndw_mpscq_size(queue));
+        failed = 1;
+    }
+
+    printf("producers<%ld> items<%ld> queue<%lu> pulled<%ld> full retries<%ld> %s\n",
+            num_producers, items, queue->capacity, queue->consumer_pull_count, full_retries,
+            failed ? "FAILED" : "OK");
+
+    ndw_mpscq_cleanup(queue);
+    free(queue);
+    free(producers);
+    free(next_expected);
+    return failed;
+} /* end method test_producers */
+
+int main(int argc, char** argv)
+{
+    long num_producers = (argc > 1) ? atol(argv[1]) : 8;
+    long items = (argc > 2) ? atol(argv[2]) : 1000000;
+    long queue_size = (argc > 3) ? atol(argv[3]) : 64;
+    if ((num_producers <= 0) || (items <= 0) || (queue_size <= 0)) {
+        fprintf(stderr, "Usage: %s [producers] [items_per_producer] [queue_size]\n", argv[0]);
+        return 1;
+    }
+
+    int failed = test_full(queue_size);
+    failed |= test_producers(num_producers, items, queue_size);
+
+    return failed;
+} /* end method main */
@@ -87,7 +87,7 @@ int main(int argc, char** argv)
     
             char* msg = (char*) topic->last_msg_received;
             int msg_size = topic->last_msg_received_size;
-            long total_topic_msgs = topic->total_received_msgs;
+            long total_topic_msgs = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS);
             if ((NULL != msg) && (msg_size > 0)) {
                 ndw_CounterUpdate(&counter_received, 1);
                 NDW_LOG("Total Messages:[%ld] Topic Total Messages:[%ld] "
@@ -37,12 +37,12 @@ int ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
 {
     char* msg = (char*) topic->last_msg_received;
     int msg_size = topic->last_msg_received_size;
-    int total_received_msgs = topic->total_received_msgs;
+    int total_received_msgs = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS);
     uint64_t queued_msgs = 0;
     ndw_GetQueuedMsgCount(topic, &queued_msgs);
     if (0 == (total_received_msgs % print_frequency)) {
         NDW_LOGX("<<< Received Message: TopicId<%d, %s> total_received_msgs<%ld> queued_msgs<%" PRIu64 "> msg_size<%d> msg<%s>\n",
-                topic->topic_unique_id, topic->topic_unique_name, topic->total_received_msgs, queued_msgs,
+                topic->topic_unique_id, topic->topic_unique_name, ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS), queued_msgs,
                 msg_size, ((NULL == msg) ? "*** NULL! ***" : msg));
     }
     ndw_CounterUpdate(&counter_received, 1);
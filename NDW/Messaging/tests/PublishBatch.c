@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "NDW_Essentials.h"
+#include "MsgHeader_2.h"
+
+/*
+ * Round trip of ndw_PublishBatch with the compact variable size header (NDW_MSGHEADER_2).
+ *
+ * Publishes batches on core NATS Topics, subscribes to the same Topics and checks that every message
+ * arrives as a good MsgHeader_2 message: header identifier, payload size and topic id decoded from the wire,
+ * and the message body unchanged. Needs the NATS server of Registry.JSON (see run_PublishBatch.sh).
+ *
+ * Usage: PublishBatch.out [batches] [batch_size]
+ */
+
+#define NUM_TOPICS 2
+#define MAX_BATCH_SIZE 256
+#define MSG_PREFIX "PublishBatch MsgHeader_2 message "
+
+static long wait_time_millis = 2 * 1000;
+
+const char *domainNames[] = { "DomainA", NULL, };
+
+char* topic_names[NUM_TOPICS + 1] = {
+    "DomainA^NATSConn1^ACME.Orders",
+    "DomainA^NATSConn1^ACME.Invoices",
+    NULL,
+};
+
+ndw_Topic_T* topic_array[NUM_TOPICS + 1];
+
+static ndw_Counter_T counter_received;
+static ndw_Counter_T counter_bad;
+
+
+void ndw_HandleBadMessage(ndw_BadMessage_T* bad_msg) {
+    ndw_print_BadMessage(bad_msg);
+    ndw_CounterUpdate(&counter_bad, 1);
+}
+
+int ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
+{
+    ndw_MsgHeader2_T* header = (ndw_MsgHeader2_T*) topic->last_msg_header_received;
+    char* msg = (char*) topic->last_msg_received;
+    int msg_size = topic->last_msg_received_size;
+
+    if ((NULL == header) || (NDW_MSGHEADER_2 != header->header_number) || (msg_size != header->payload_size) ||
+        (topic->topic_unique_id != header->topic_id) || (NULL == msg) ||
+        (0 != strncmp(msg, MSG_PREFIX, strlen(MSG_PREFIX))) || ('\0' != msg[msg_size - 1])) {
+        NDW_LOGERR("*** FAILED: header_id<%d> payload_size<%d> topic_id<%d> msg_size<%d> msg<%s> for %s\n",
+                    (NULL == header) ? -1 : header->header_number, (NULL == header) ? -1 : header->payload_size,
+                    (NULL == header) ? -1 : header->topic_id, msg_size, (NULL == msg) ? "NULL" : msg,
+                    topic->debug_desc);
+        ndw_CounterUpdate(&counter_bad, 1);
+        return 0;
+    }
+
+    ndw_CounterUpdate(&counter_received, 1);
+    return 0;
+} // end method ndw_HandleAsyncMessage
+
+static int
+test_publish_batches(long batches, int batch_size, long* published)
+{
+    ndw_PublishBatchItem_T items[MAX_BATCH_SIZE];
+    char bodies[MAX_BATCH_SIZE][128];
+
+    for (long b = 0; b < batches; b++) {
+        memset(items, 0, sizeof(items));
+        for (int i = 0; i < batch_size; i++) {
+            // Vary the body size so frames of different lengths sit next to each other in the batch buffer.
+            int size = snprintf(bodies[i], sizeof(bodies[i]), MSG_PREFIX "%ld.%d%.*s", b, i, i % 40,
+                                "........................................") + 1;
+            items[i].topic = topic_array[i % NUM_TOPICS];
+            items[i].header_id = NDW_MSGHEADER_2;
+            items[i].msg_encoding_format = NDW_ENCODING_FORMAT_STRING;
+            items[i].msg = (UCHAR_T*) bodies[i];
+            items[i].msg_size = size;
+        }
+
+        INT_T failures = ndw_PublishBatch(items, batch_size, 1000);
+        for (int i = 0; i < batch_size; i++) {
+            if (0 != items[i].ret_code)
+                continue;
+
+            if ((NULL == items[i].frame) || (NDW_MSGHEADER_2 != items[i].frame[0]) ||
+                (items[i].frame_size != items[i].frame[1] + items[i].msg_size)) {
+                NDW_LOGERR("*** FAILED: batch<%ld> item<%d> frame does not start with its MsgHeader_2 header\n", b, i);
+                return -1;
+            }
+
+            *published += 1;
+        }
+
+        if (0 != failures) {
+            NDW_LOGERR("*** FAILED: ndw_PublishBatch() batch<%ld> had <%d> failures\n", b, failures);
+            return -2;
+        }
+    }
+
+    return 0;
+} // end method test_publish_batches
+
+int main(int argc, char** argv)
+{
+    long batches = (argc > 1) ? atol(argv[1]) : 100;
+    int batch_size = (argc > 2) ? atoi(argv[2]) : 64;
+    if ((batches <= 0) || (batch_size <= 0) || (batch_size > MAX_BATCH_SIZE)) {
+        fprintf(stderr, "Usage: %s [batches] [batch_size <= %d]\n", argv[0], MAX_BATCH_SIZE);
+        return 1;
+    }
+
+    if (0 != ndw_Init())
+        exit(-1);
+
+    ndw_ConnectToDomains(domainNames);
+
+    for (int i = 0; i < NUM_TOPICS; i++)
+        topic_array[i] = ndw_GetTopicFromFullPath(topic_names[i]);
+
+    if (ndw_SubscribeAsyncToTopicNames(topic_names) < 0) {
+        ndw_Shutdown();
+        exit(-2);
+    }
+
+    long published = 0;
+    int failed = (0 != test_publish_batches(batches, batch_size, &published));
+
+    long expected = batches * batch_size;
+    while (! failed) {
+        long prev_msg_count = ndw_CounterCurrentValue(&counter_received);
+        if (ndw_CounterCheck(&counter_received, expected, wait_time_millis))
+            break;
+
+        if (prev_msg_count == ndw_CounterCurrentValue(&counter_received)) {
+            NDW_LOGERR("*** FAILED: no new messages in <%ld> milliseconds, received<%ld> expected<%ld>\n",
+                        wait_time_millis, ndw_CounterCurrentValue(&counter_received), expected);
+            failed = 1;
+        }
+    }
+
+    if ((published != expected) || (0 != ndw_CounterCurrentValue(&counter_bad)))
+        failed = 1;
+
+    NDW_LOGX("NOTE: Published<%ld> Received<%ld> Bad<%ld> Expected<%ld> %s\n", published,
+                ndw_CounterCurrentValue(&counter_received), ndw_CounterCurrentValue(&counter_bad), expected,
+                failed ? "FAILED" : "OK");
+
+    for (int i = 0; i < NUM_TOPICS; i++)
+        ndw_Unsubscribe(topic_array[i]);
+
+    ndw_Shutdown();
+    return failed;
+} /* end method main */
@@ -87,9 +87,9 @@ static void set_commit_counters(ndw_Topic_T* topic)
     if (NULL != topic) {
         AppTopic_T* a_topic = (AppTopic_T*) topic->app_opaque;
         if (NULL != a_topic) {
-            a_topic->msgs_commit_count = topic->msgs_commit_count;
-            a_topic->msgs_ack_count = topic->msgs_ack_count;
-            a_topic->msgs_failed_ack_count = topic->msgs_failed_ack_count;
+            a_topic->msgs_commit_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_COMMITS);
+            a_topic->msgs_ack_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_ACKS);
+            a_topic->msgs_failed_ack_count = ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_MSGS_FAILED_ACKS);
         }
     }
 }
@@ -458,11 +458,11 @@ ndw_HandleAsyncMessage(ndw_Topic_T* topic, void* opaque)
 
     ndw_GetQueuedMsgCount(topic, &queued_msgs);
 
-    if (0 == (topic->total_received_msgs % print_frequency_modulo)) {
+    if (0 == (ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS) % print_frequency_modulo)) {
         NDW_LOGX("<<<Received ASYNC Message: TopicId<%d, %s> num_async_msgs<%ld> "
             "topic->total_received_msgs<%ld> queued_msgs<%" PRIu64 "> msg_size<%d> msg<%s>\n",
             topic->topic_unique_id, topic->topic_unique_name, num_async_msgs,
-            topic->total_received_msgs, queued_msgs,
+            ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS), queued_msgs,
             msg_size, ((NULL == msg) ? "*** NULL! ***" : msg));
     }
 
@@ -725,9 +725,9 @@ thread_subscriber_poll(void* arg)
                 char* msg = (char*) topic->last_msg_received;
                 int msg_size = topic->last_msg_received_size;
 
-                if (0 == (topic->total_received_msgs % print_frequency_modulo)) {
+                if (0 == (ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS) % print_frequency_modulo)) {
                     NDW_LOGX("<<< Received POLL Message: [%s, %ld] msg<%s> msg_size<%d> ON %s\n",
-                                a_topic->TopicName, topic->total_received_msgs, msg, msg_size, topic->debug_desc);
+                                a_topic->TopicName, ndw_TopicStatsGet(topic->stats_index, NDW_TOPIC_STAT_RECEIVED_MSGS), msg, msg_size, topic->debug_desc);
                 }
 
                 INT_T commit_code = a_topic->function_commit_data.function(topic);
@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "NDW_Essentials.h"
+
+/*
+ * Benchmark of the ndw_Topic_T layout on the publish and receive paths.
+ *
+ * Touches the same Topic fields as ndw_CreateOutMsgCxt / ndw_PublishMsg (publish) and
+ * ndw_HandleVendorAsyncMessage (receive), on randomly chosen Topics, for:
+ *  - legacy: the Topic layout before the hot / cold split (fields in declaration order, cold data inline).
+ *  - current: ndw_Topic_T.
+ * Allocation follows ndw_LoadDomains: legacy Topics one by one with their strings in between (as it used to),
+ * current Topics contiguously from slabs with the strings and cold part allocated separately.
+ * No messaging server is needed.
+ *
+ * Usage: TopicLayout.out [iterations] [num_topics ...]
+ */
+
+typedef struct LegacyTopic
+{
+    bool disabled;
+    bool is_pub_enabled;
+    bool is_sub_enabled;
+    bool durable_topic;
+    CHAR_T* topic_description;
+    INT_T topic_unique_id;
+    CHAR_T* topic_unique_name;
+    CHAR_T* pub_key;
+    CHAR_T* sub_key;
+    bool q_async_enabled;
+    char* q_async_name;
+    int q_async_size;
+    NDW_Q_T* q_async;
+    void* q_async_closure;
+    void* q_async_batch_data;
+    int q_async_batch_capacity;
+    int q_async_overflow_policy;
+    LONG_T q_async_block_timeout_us;
+    NDW_QSpill_T* q_async_spill;
+    LONG_T q_async_dropped_newest;
+    LONG_T q_async_dropped_oldest;
+    LONG_T q_async_blocked;
+    LONG_T q_async_block_timeouts;
+    LONG_T q_async_spilled;
+    UT_hash_handle hh_topic_id;
+    UT_hash_handle hh_topic_name;
+    CHAR_T* debug_desc;
+    ndw_Connection_T* connection;
+    ndw_Domain_T* domain;
+    ndw_DomainHandle_T* domain_handle;
+    ndw_Histogram_T* latency_histogram;
+    ndw_Histogram_T* q_async_dwell_histogram;
+    LONG_T latency_clock_skew;
+    void* app_opaque;
+    void* ndw_opaque;
+    void* vendor_opaque;
+    CHAR_T* topic_options;
+    NDW_NVPairs_T topic_options_nvpairs;
+    CHAR_T* vendor_topic_options;
+    NDW_NVPairs_T vendor_topic_options_nvpairs;
+    LONG_T sequence_number;
+    INT_T stats_index;
+    LONG_T last_msg_received_time;
+    UCHAR_T* last_msg_header_received;
+    UCHAR_T* last_msg_received;
+    INT_T last_msg_received_size;
+    void* last_msg_closure;
+    void* last_msg_vendor_closure;
+    CHAR_T  last_received_ip_address[60];
+    ULONG_T last_received_durable_ack_sequence;
+    ULONG_T last_received_durable_ack_global_sequence;
+    ULONG_T last_received_durable_total_delivered;
+    ULONG_T last_received_durable_total_pending;
+    void (*publish_ack_handler)(struct ndw_PublishAck* ack, void* closure);
+    void* publish_ack_closure;
+    LONG_T publish_acks;
+    LONG_T publish_ack_failures;
+    bool synchronous_subscription;
+    INT_T pub_header_template_id;
+    ULONG_T pub_header_template[NDW_HEADER_TEMPLATE_SIZE / sizeof(ULONG_T)];
+} LegacyTopic_T;
+
+#define BENCH_PASSES 5
+
+static LONG_T bench_stats[1 << 16];     // Stands in for the per thread statistics shard.
+static ULONG_T bench_sink = 0;          // Keeps the compiler from dropping the reads.
+
+static double
+now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1e9) + ts.tv_nsec;
+} /* end method now_ns */
+
+static char*
+padding_string(int i)
+{
+    char buf[96];
+    snprintf(buf, sizeof(buf), "Topic<%d, Bench.Topic.%d> Connection<1, Bench> Domain<1, Bench>", i, i);
+    return strdup(buf);
+} /* end method padding_string */
+
+/*
+ * The operations are written once and expanded for both layouts so both execute identical code.
+ */
+#define BENCH_OPS(TYPE, NAME)                                                           \
+static void                                                                             \
+publish_##NAME(TYPE* t)                                                                 \
+{                                                                                       \
+    if (t->disabled || (! t->is_pub_enabled) || (NULL == t->connection))               \
+        return;                                                                         \
+    ULONG_T header[NDW_HEADER_TEMPLATE_SIZE / sizeof(ULONG_T)];                         \
+    if (t->pub_header_template_id > 0)                                                  \
+        memcpy(header, t->pub_header_template, sizeof(header));                         \
+    header[1] = (ULONG_T) ++t->sequence_number;                                         \
+    bench_sink += header[0] + header[1] + (ULONG_T) t->domain + (ULONG_T) t->vendor_opaque \
+                    + (ULONG_T) t->pub_key[0];                                          \
+    ++bench_stats[t->stats_index];                                                      \
+}                                                                                       \
+                                                                                        \
+static void                                                                             \
+receive_##NAME(TYPE* t, UCHAR_T* msg, INT_T msg_size, double now)                       \
+{                                                                                       \
+    if ((NULL == t->connection) || t->q_async_enabled)                                  \
+        return;                                                                         \
+    if ((NULL != t->last_msg_header_received) || (NULL != t->last_msg_received) ||      \
+        (0 != t->last_msg_received_size))                                               \
+        return;                                                                         \
+    t->last_msg_received_time = (LONG_T) now;                                           \
+    t->last_msg_header_received = msg;                                                  \
+    t->last_msg_received = msg + 16;                                                    \
+    t->last_msg_received_size = msg_size;                                               \
+    ++bench_stats[t->stats_index + 1];                                                  \
+    t->last_msg_vendor_closure = msg;                                                   \
+    bench_sink += (ULONG_T) t->app_opaque + t->last_msg_received[0];                    \
+    t->last_msg_vendor_closure = NULL;                                                  \
+    t->last_msg_header_received = NULL;                                                 \
+    t->last_msg_received = NULL;                                                        \
+    t->last_msg_received_size = 0;                                                      \
+}
+
+BENCH_OPS(LegacyTopic_T, legacy)
+BENCH_OPS(ndw_Topic_T, current)
+
+#define BENCH_FILL(t, i, conn, strings)                                           \
+    do {                                                                                \
+        (t)->is_pub_enabled = true;                                                     \
+        (t)->is_sub_enabled = true;                                                     \
+        (t)->connection = (conn);                                                       \
+        (t)->pub_key = (strings)[(i) * 2];                                              \
+        (t)->debug_desc = (strings)[((i) * 2) + 1];                                     \
+        (t)->stats_index = ((i) * 2) % ((sizeof(bench_stats) / sizeof(LONG_T)) - 1);    \
+        (t)->pub_header_template_id = 1;                                                \
+    } while (0)
+
+static void
+run(int num_topics, long iterations)
+{
+    ndw_Connection_T connection;
+    memset(&connection, 0, sizeof(connection));
+
+    char** strings = calloc(num_topics * 4, sizeof(char*));
+    LegacyTopic_T** legacy = calloc(num_topics, sizeof(LegacyTopic_T*));
+    ndw_Topic_T** current = calloc(num_topics, sizeof(ndw_Topic_T*));
+    int* order = malloc(iterations * sizeof(int));
+    if ((NULL == strings) || (NULL == legacy) || (NULL == current) || (NULL == order)) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < num_topics; ++i) {
+        strings[i * 2] = padding_string(i);
+        strings[(i * 2) + 1] = padding_string(i);
+        legacy[i] = calloc(1, sizeof(LegacyTopic_T));
+        BENCH_FILL(legacy[i], i, &connection, strings);
+    }
+
+    void* slab = NULL;
+    if (0 != posix_memalign(&slab, NDW_TOPIC_CACHE_LINE_SIZE, num_topics * sizeof(ndw_Topic_T))) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(slab, 0, num_topics * sizeof(ndw_Topic_T));
+
+    for (int i = 0; i < num_topics; ++i) {
+        current[i] = &((ndw_Topic_T*) slab)[i];
+        current[i]->cold = calloc(1, sizeof(ndw_TopicCold_T));
+        strings[(num_topics * 2) + (i * 2)] = padding_string(i);
+        strings[(num_topics * 2) + (i * 2) + 1] = padding_string(i);
+        BENCH_FILL(current[i], i, &connection, &strings[num_topics * 2]);
+    }
+
+    srand(42);
+    for (long i = 0; i < iterations; ++i)
+        order[i] = rand() % num_topics;
+
+    UCHAR_T msg[64];
+    memset(msg, 1, sizeof(msg));
+
+    // Best of BENCH_PASSES passes, alternating the layouts, to filter out noise from other activity on the host.
+    double results[4] = { 1e30, 1e30, 1e30, 1e30 };
+    for (int pass = 0; pass < BENCH_PASSES; ++pass) {
+        double elapsed[4];
+        double start = now_ns();
+        for (long i = 0; i < iterations; ++i)
+            publish_legacy(legacy[order[i]]);
+        elapsed[0] = now_ns() - start;
+
+        start = now_ns();
+        for (long i = 0; i < iterations; ++i)
+            publish_current(current[order[i]]);
+        elapsed[1] = now_ns() - start;
+
+        start = now_ns();
+        for (long i = 0; i < iterations; ++i)
+            receive_legacy(legacy[order[i]], msg, sizeof(msg), start);
+        elapsed[2] = now_ns() - start;
+
+        start = now_ns();
+        for (long i = 0; i < iterations; ++i)
+            receive_current(current[order[i]], msg, sizeof(msg), start);
+        elapsed[3] = now_ns() - start;
+
+        for (int k = 0; k < 4; ++k) {
+            if ((elapsed[k] / iterations) < results[k])
+                results[k] = elapsed[k] / iterations;
+        }
+    }
+
+    printf("%8d  %10.2f  %10.2f  %10.2f  %10.2f\n", num_topics, results[0], results[1], results[2], results[3]);
+
+    for (int i = 0; i < num_topics; ++i) {
+        free(legacy[i]);
+        free(current[i]->cold);
+    }
+    free(slab);
+    for (int i = 0; i < num_topics * 4; ++i)
+        free(strings[i]);
+    free(strings);
+    free(legacy);
+    free(current);
+    free(order);
+} /* end method run */
+
+int main(int argc, char** argv)
+{
+    long iterations = (argc > 1) ? atol(argv[1]) : 10000000;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations] [num_topics ...]\n", argv[0]);
+        return 1;
+    }
+
+    printf("sizeof legacy Topic<%zu> sizeof ndw_Topic_T<%zu> + ndw_TopicCold_T<%zu>; %ld random Topic accesses\n",
+            sizeof(LegacyTopic_T), sizeof(ndw_Topic_T), sizeof(ndw_TopicCold_T), iterations);
+    printf("%8s  %10s  %10s  %10s  %10s   (ns per message)\n",
+            "topics", "pub legacy", "pub split", "recv legacy", "recv split");
+
+    if (argc > 2) {
+        for (int i = 2; i < argc; ++i)
+            run(atoi(argv[i]), iterations);
+    } else {
+        int counts[] = { 64, 256, 1024, 4096, 16384, 65536 };
+        for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i)
+            run(counts[i], iterations);
+    }
+
+    printf("checksum<%lu>\n", bench_sink);
+    return 0;
+} /* end method main */
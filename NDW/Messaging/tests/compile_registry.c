@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "NDW_Essentials.h"
+#include "NDW_RegistryImage.h"
+
+/*
+ * Registry compiler: writes the binary registry image of a JSON registry (see NDW_RegistryImage.h).
+ * Point NDW_APP_CONFIG_IMAGE at the image to load it instead of parsing NDW_APP_CONFIG_FILE.
+ *
+ * With Domain names, both are then loaded for those Domains and the load times compared. No messaging server is needed.
+ *
+ * Usage: compile_registry.out <registry.JSON> <registry image> [DomainName ...]
+ */
+
+static double
+now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1e3) + (ts.tv_nsec / 1e6);
+} /* end method now_ms */
+
+static INT_T
+count_topics()
+{
+    INT_T total = 0;
+    INT_T num_domains = 0;
+    ndw_Domain_T** domains = ndw_GetAllDomains(&num_domains);
+    for (INT_T i = 0; i < num_domains; ++i) {
+        INT_T num_connections = 0;
+        ndw_Connection_T** connections = ndw_GetAllConnectionsFromDomain(domains[i], &num_connections);
+        for (INT_T j = 0; j < num_connections; ++j) {
+            INT_T num_topics = 0;
+            free(ndw_GetAllTopicsFromConnection(connections[j], &num_topics));
+            total += num_topics;
+        }
+        free(connections);
+    }
+    free(domains);
+    return total;
+} /* end method count_topics */
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <registry.JSON> <registry image> [DomainName ...]\n", argv[0]);
+        return 1;
+    }
+
+    ndw_InitThreadSafeLogger();
+
+    const char* json_path = argv[1];
+    const char* image_path = argv[2];
+    if (0 != ndw_CompileRegistry(json_path, image_path)) {
+        fprintf(stderr, "Failed to compile <%s> into <%s>\n", json_path, image_path);
+        ndw_DestroyThreadSafeLogger();
+        return 1;
+    }
+
+    if (argc > 3) {
+        char** domains = &argv[3];
+
+        double start = now_ms();
+        INT_T ret = ndw_LoadDomains(json_path, domains);
+        double json_ms = now_ms() - start;
+        INT_T json_topics = (0 == ret) ? count_topics() : -1;
+        ndw_CleanupRegistry();
+
+        start = now_ms();
+        ret = ndw_LoadDomainsFromImage(image_path, json_path, domains);
+        double image_ms = now_ms() - start;
+        INT_T image_topics = (0 == ret) ? count_topics() : -1;
+        ndw_CleanupRegistry();
+
+        printf("JSON  load: %10.3f ms  Topics<%d>\n", json_ms, json_topics);
+        printf("Image load: %10.3f ms  Topics<%d>\n", image_ms, image_topics);
+        if ((json_topics < 0) || (json_topics != image_topics)) {
+            fprintf(stderr, "JSON registry and registry image do not match\n");
+            ndw_DestroyThreadSafeLogger();
+            return 1;
+        }
+    }
+
+    ndw_DestroyThreadSafeLogger();
+    return 0;
+} /* end method main */
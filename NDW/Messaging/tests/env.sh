@@ -16,3 +16,18 @@ export NDW_APP_DOMAINS="DomainA"
 export NDW_APP_ID=777
 export NDW_CAPTURE_LATENCY=1
 
+
+# Statistics exporter: curl http://127.0.0.1:9464/metrics (or /metrics.json).
+#export NDW_METRICS_PORT=9464
+#export NDW_METRICS_FILE="/tmp/ndw_metrics.prom"
+#export NDW_METRICS_INTERVAL_MS=5000
+
+# Asynchronous logging: 1 drops lines when a thread's buffer is full, 2 waits for room.
+#export NDW_LOG_ASYNC=1
+#export NDW_LOG_ASYNC_BUFFER_KB=1024
+
+# Precompiled registry image (./compile_registry.out ./Registry.JSON ./Registry.img); falls back to the JSON file.
+#export NDW_APP_CONFIG_IMAGE="./Registry.img"
+
+# Reload the registry when NDW_APP_CONFIG_FILE changes, checking every N ms (or call ndw_ReloadRegistry).
+#export NDW_APP_CONFIG_WATCH_MS=1000
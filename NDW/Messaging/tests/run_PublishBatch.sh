@@ -0,0 +1,24 @@
+
+#set -x
+
+source ./env.sh
+
+if [ -z "$NDW_APP_CONFIG_FILE" ]; then
+    echo "NDW_APP_CONFIG_FILE not set"
+    exit 1
+fi
+
+if [ ! -f $NDW_APP_CONFIG_FILE ]; then
+    echo "NDW_APP_CONFIG_FILE file: " $NDW_APP_CONFIG_FILE " does not exists!"
+    exit 2
+fi
+
+EXEC_FILE="./PublishBatch.out"
+OUT_FILE=see_publishbatch.txt
+
+$EXEC_FILE $* >$OUT_FILE 2>&1
+ret_code=$?
+
+grep "NOTE: Published" $OUT_FILE
+grep "FAILED" $OUT_FILE
+exit $ret_code